@@ -13,7 +13,13 @@
 attribute vec3 position;
 attribute vec2 uv;
 
+#ifdef INSTANCING
+attribute mat4 instanceModelToWorldMatrix;
+# define modelToWorldMatrix instanceModelToWorldMatrix
+#else
 uniform mat4 modelToWorldMatrix;
+#endif
+
 uniform mat4 worldToScreenMatrix;
 uniform vec2 uvScale;
 uniform vec2 uvOffset;
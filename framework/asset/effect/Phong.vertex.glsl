@@ -15,7 +15,13 @@ attribute vec2 uv;
 attribute vec3 normal;
 attribute vec3 tangent;
 
+#ifdef INSTANCING
+attribute mat4 instanceModelToWorldMatrix;
+# define modelToWorldMatrix instanceModelToWorldMatrix
+#else
 uniform mat4 modelToWorldMatrix;
+#endif
+
 uniform mat4 worldToScreenMatrix;
 uniform vec2 uvScale;
 uniform vec2 uvOffset;
@@ -32,6 +32,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include <algorithm>
 #include <typeinfo>
+#include <type_traits>
+#include <new>
 
 namespace minko
 {
@@ -49,6 +51,25 @@ namespace minko
 
     class Any
     {
+    public:
+        // values up to this size (scalars, int/float 4-tuples, raw and shared pointers) are stored inline
+        static const unsigned int INLINE_VALUE_SIZE = 2 * sizeof(void*);
+
+    private:
+        // the holder vtable pointer is stored with the value
+        static const unsigned int INLINE_STORAGE_SIZE = INLINE_VALUE_SIZE + sizeof(void*);
+        static const unsigned int INLINE_STORAGE_ALIGNMENT = std::alignment_of<void*>::value;
+
+        // inline holders are destroyed through their virtual destructor, but swapping them copies their
+        // values: only values copied without throwing are stored inline
+        template <typename ValueType>
+        struct IsInline
+        {
+            static const bool value = sizeof(ValueType) <= INLINE_VALUE_SIZE
+                && std::alignment_of<ValueType>::value <= INLINE_STORAGE_ALIGNMENT
+                && std::is_nothrow_copy_constructible<ValueType>::value;
+        };
+
     public:
         Any() :
             _content(0)
@@ -57,24 +78,36 @@ namespace minko
 
         template <typename ValueType>
         Any(const ValueType & value) :
-            _content(new Holder<ValueType>(value))
+            _content(create(value))
         {
         }
 
         Any(const Any& other) :
-            _content(other._content ? other._content->clone() : 0)
+            _content(other._content ? other._content->clone(other.isInline() ? &_storage : 0) : 0)
         {
         }
 
         ~Any()
         {
-            delete _content;
+            destroy();
         }
 
         Any&
         swap(Any& rhs)
         {
-            std::swap(_content, rhs._content);
+            if (!isInline() && !rhs.isInline())
+            {
+                std::swap(_content, rhs._content);
+
+                return *this;
+            }
+
+            // inline values live in the storage of their Any: swap copies
+            Any tmp(rhs);
+
+            rhs.assign(*this);
+            assign(tmp);
+
             return *this;
         }
 
@@ -82,14 +115,24 @@ namespace minko
         Any&
         operator=(const ValueType& rhs)
         {
-            Any(rhs).swap(*this);
+            // same type: update the held value in place instead of building a new holder
+            if (_content && _content->type() == typeid(ValueType))
+                static_cast<Any::Holder<ValueType>*>(_content)->_held = rhs;
+            else
+            {
+                destroy();
+                _content = create(rhs);
+            }
+
             return *this;
         }
 
         Any&
-        operator=(Any rhs)
+        operator=(const Any& rhs)
         {
-            rhs.swap(*this);
+            if (&rhs != this)
+                assign(rhs);
+
             return *this;
         }
 
@@ -191,8 +234,9 @@ namespace minko
             virtual const std::type_info&
             type() const = 0;
 
+            // clone in the given inline storage, or on the heap if null
             virtual Placeholder*
-            clone() const = 0;
+            clone(void* storage) const = 0;
         };
 
         template <typename ValueType>
@@ -212,9 +256,9 @@ namespace minko
             }
 
             virtual Placeholder*
-            clone() const
+            clone(void* storage) const
             {
-                return new Holder(_held);
+                return storage ? new (storage) Holder(_held) : new Holder(_held);
             }
 
         public:
@@ -225,6 +269,52 @@ namespace minko
             Holder& operator=(const Holder &);
         };
 
+    private:
+        template <typename ValueType>
+        typename std::enable_if<IsInline<ValueType>::value, Placeholder*>::type
+        create(const ValueType& value)
+        {
+            static_assert(sizeof(Holder<ValueType>) <= INLINE_STORAGE_SIZE, "inline storage is too small");
+
+            return new (&_storage) Holder<ValueType>(value);
+        }
+
+        template <typename ValueType>
+        typename std::enable_if<!IsInline<ValueType>::value, Placeholder*>::type
+        create(const ValueType& value)
+        {
+            return new Holder<ValueType>(value);
+        }
+
+        inline
+        bool
+        isInline() const
+        {
+            return _content == reinterpret_cast<const Placeholder*>(&_storage);
+        }
+
+        void
+        assign(const Any& other)
+        {
+            destroy();
+            _content = other._content ? other._content->clone(other.isInline() ? &_storage : 0) : 0;
+        }
+
+        void
+        destroy()
+        {
+            if (isInline())
+                _content->~Placeholder();
+            else
+                delete _content;
+
+            _content = 0;
+        }
+
+    public:
         Placeholder* _content;
+
+    private:
+        typename std::aligned_storage<INLINE_STORAGE_SIZE, INLINE_STORAGE_ALIGNMENT>::type _storage;
     };
 }
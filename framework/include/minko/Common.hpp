@@ -78,6 +78,7 @@ namespace minko
         enum class TextureFilter;
         enum class MipFilter;
         enum class StencilOperation;
+        enum class DrawCallSortMode;
         typedef std::tuple<WrapMode, TextureFilter, MipFilter>    SamplerState;
 
         class States;
@@ -89,10 +90,14 @@ namespace minko
         class AbstractResource;
         class Shader;
         class Program;
+        class ProgramCache;
+        class TextureStreamer;
+        class ImageResampler;
         class ProgramSignature;
         class VertexFormat;
         class VertexBuffer;
         class IndexBuffer;
+        class ReadbackQueue;
 
         enum class TextureType
         {
@@ -175,6 +180,8 @@ namespace minko
         template <class ProviderClass, class Enable = void>
         class AbstractRootDataComponent;
         class SceneManager;
+        template <typename T>
+        class ComponentRegistry;
         class Transform;
         class Surface;
         class Renderer;
@@ -206,6 +213,7 @@ namespace minko
     namespace data
     {
         class Provider;
+        class PropertyId;
         class ArrayProvider;
         class StructureProvider;
         class ValueBase;
@@ -266,6 +274,7 @@ namespace minko
         class QuadGeometry;
         class TeapotGeometry;
         class LineGeometry;
+        class TriangleBvh;
     }
 
     namespace animation
@@ -340,6 +349,7 @@ namespace minko
         class Options;
         class Loader;
         class AbstractProtocol;
+        class MemoryMappedFile;
         class AbstractParser;
         class EffectParser;
         class AssetLibrary;
@@ -391,6 +401,8 @@ namespace minko
     namespace async
     {
         class Worker;
+        class ThreadPool;
+        class TaskScheduler;
     }
 
     namespace log
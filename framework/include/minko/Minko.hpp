@@ -37,6 +37,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/ProgramSignature.hpp"
 #include "minko/render/CompareMode.hpp"
 #include "minko/render/StencilOperation.hpp"
+#include "minko/render/DrawCallSortMode.hpp"
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Vector4.hpp"
@@ -48,6 +49,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Signal.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
+#include "minko/data/PropertyId.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/data/StructureProvider.hpp"
@@ -60,6 +62,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/Renderer.hpp"
 #include "minko/component/PerspectiveCamera.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/component/ComponentRegistry.hpp"
 #include "minko/component/AbstractLight.hpp"
 #include "minko/component/AmbientLight.hpp"
 #include "minko/component/AbstractDiscreteLight.hpp"
@@ -81,18 +84,23 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/JobManager.hpp"
 #include "minko/render/AbstractResource.hpp"
 #include "minko/render/Program.hpp"
+#include "minko/render/ProgramCache.hpp"
+#include "minko/render/TextureStreamer.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/render/IndexBuffer.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/Priority.hpp"
+#include "minko/render/ReadbackQueue.hpp"
 #include "minko/geometry/Geometry.hpp"
 #include "minko/geometry/CubeGeometry.hpp"
 #include "minko/geometry/SphereGeometry.hpp"
 #include "minko/geometry/QuadGeometry.hpp"
 #include "minko/geometry/TeapotGeometry.hpp"
 #include "minko/geometry/LineGeometry.hpp"
+#include "minko/geometry/TriangleBvh.hpp"
 #include "minko/file/File.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/Loader.hpp"
@@ -110,3 +118,5 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/input/Touch.hpp"
 #include "minko/scene/Layout.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/ThreadPool.hpp"
+#include "minko/async/TaskScheduler.hpp"
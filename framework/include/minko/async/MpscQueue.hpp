@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+
+namespace minko
+{
+    namespace async
+    {
+        /**
+         * Unbounded lock-free queue any number of threads can push values to while a single thread pops
+         * them. Values are moved in and out of the queue: they are never copied.
+         */
+        template <typename T>
+        class MpscQueue
+        {
+        private:
+            struct Node
+            {
+                std::atomic<Node*>  next;
+                T                   value;
+
+                Node() :
+                    next(nullptr),
+                    value()
+                {
+                }
+
+                Node(T&& value) :
+                    next(nullptr),
+                    value(std::move(value))
+                {
+                }
+            };
+
+        private:
+            // producers append after _head, the consumer pops after _tail, which is a node whose value was
+            // already popped
+            std::atomic<Node*>  _head;
+            Node*               _tail;
+
+        public:
+            MpscQueue() :
+                _head(nullptr),
+                _tail(new Node())
+            {
+                _head = _tail;
+            }
+
+            MpscQueue(const MpscQueue&) = delete;
+
+            MpscQueue&
+            operator=(const MpscQueue&) = delete;
+
+            ~MpscQueue()
+            {
+                while (_tail != nullptr)
+                {
+                    auto next = _tail->next.load(std::memory_order_relaxed);
+
+                    delete _tail;
+                    _tail = next;
+                }
+            }
+
+            // Can be called from any thread.
+            void
+            push(T value)
+            {
+                auto node = new Node(std::move(value));
+                auto previous = _head.exchange(node, std::memory_order_acq_rel);
+
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            // Must only be called from the consumer thread. Returns false if the queue is empty.
+            bool
+            pop(T& value)
+            {
+                auto next = _tail->next.load(std::memory_order_acquire);
+
+                if (next == nullptr)
+                    return false;
+
+                value = std::move(next->value);
+
+                delete _tail;
+                _tail = next;
+
+                return true;
+            }
+
+            // Must only be called from the consumer thread.
+            bool
+            empty() const
+            {
+                return _tail->next.load(std::memory_order_acquire) == nullptr;
+            }
+        };
+    }
+}
@@ -0,0 +1,200 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace minko
+{
+    namespace async
+    {
+        /**
+         * Runs graphs of tasks on one worker thread per core besides the main one. Each worker pops the
+         * tasks it scheduled itself from the back of its own deque and steals from the front of the others'
+         * when it runs out of work. A task only starts once all its dependencies are complete. Tasks
+         * scheduled on the main thread are queued until runMainThreadTasks() is called there, which is what
+         * JobManager does every frame: they are used as continuations of background work that must touch
+         * the scene or the rendering context.
+         */
+        class TaskScheduler
+        {
+        public:
+            typedef std::shared_ptr<TaskScheduler>      Ptr;
+
+            class Task
+            {
+                friend class TaskScheduler;
+
+            public:
+                typedef std::shared_ptr<Task>           Ptr;
+                typedef std::function<void()>           Function;
+                typedef std::function<uint()>           CostFunction;
+
+            private:
+                Function                                _function;
+                bool                                    _mainThread;
+                CostFunction                            _cost;
+                std::atomic<uint>                       _numPendingDependencies;
+                std::atomic<bool>                       _complete;
+                std::vector<Ptr>                        _continuations;
+                std::mutex                              _mutex;
+                std::exception_ptr                      _exception;
+
+            public:
+                inline
+                bool
+                complete() const
+                {
+                    return _complete;
+                }
+
+                inline
+                bool
+                mainThread() const
+                {
+                    return _mainThread;
+                }
+
+                // the exception thrown by the function of the task, if any, once complete
+                inline
+                std::exception_ptr
+                exception() const
+                {
+                    return _exception;
+                }
+
+            private:
+                Task(const Function& function, bool mainThread, const CostFunction& cost);
+            };
+
+            typedef Task::Ptr                           TaskPtr;
+
+        private:
+            struct WorkerQueue
+            {
+                std::mutex                              mutex;
+                std::deque<TaskPtr>                     tasks;
+            };
+
+        private:
+            std::vector<std::thread>                    _threads;
+            std::vector<std::thread::id>                _threadIds;
+            std::vector<std::shared_ptr<WorkerQueue>>   _workerQueues;
+            std::atomic<uint>                           _nextWorkerQueue;
+            std::atomic<uint>                           _numQueuedTasks;
+            std::deque<TaskPtr>                         _mainThreadTasks;
+            std::mutex                                  _mainThreadMutex;
+            std::mutex                                  _mutex;
+            std::condition_variable                     _taskQueued;
+            bool                                        _stopped;
+
+        public:
+            inline static
+            Ptr
+            create(uint numWorkers)
+            {
+                auto scheduler = std::shared_ptr<TaskScheduler>(new TaskScheduler());
+
+                scheduler->initialize(numWorkers);
+
+                return scheduler;
+            }
+
+            /**
+             * The scheduler shared by the engine, with one worker per core besides the main thread. On
+             * platforms without threads, it has no worker and every task runs in runMainThreadTasks().
+             * ThreadPool::instance() splits its loops between the same workers.
+             */
+            static
+            Ptr
+            instance();
+
+            ~TaskScheduler();
+
+            inline
+            uint
+            numWorkers() const
+            {
+                return _threads.size();
+            }
+
+            /**
+             * Schedules function to run once every task of dependencies is complete, on a worker thread
+             * or, when mainThread is true, during the next call to runMainThreadTasks(). Functions can
+             * schedule other tasks, including tasks depending on themselves. The cost of a main thread
+             * task, such as the number of bytes it uploads, is evaluated right before it runs.
+             */
+            TaskPtr
+            schedule(const Task::Function&          function,
+                     const std::vector<TaskPtr>&    dependencies    = std::vector<TaskPtr>(),
+                     bool                           mainThread      = false,
+                     const Task::CostFunction&      cost            = nullptr);
+
+            /**
+             * Runs the tasks queued for the main thread until none is left, maxDuration seconds elapsed or
+             * the next task would bring their total cost over maxCost, and returns how many ran. The first
+             * task with a cost always runs so that a task costing more than maxCost is not starved. Negative
+             * values do not limit the duration or the cost.
+             */
+            uint
+            runMainThreadTasks(float maxDuration = -1.f, int maxCost = -1);
+
+            /**
+             * Blocks until task is complete, running the other pending tasks meanwhile, and rethrows the
+             * exception thrown by its function if any. Main thread tasks are only run if this is called
+             * from the main thread.
+             */
+            void
+            wait(TaskPtr task, bool mainThread = true);
+
+        private:
+            TaskScheduler();
+
+            void
+            initialize(uint numWorkers);
+
+            int
+            workerIndex() const;
+
+            void
+            enqueue(TaskPtr task);
+
+            void
+            release(TaskPtr task);
+
+            void
+            execute(TaskPtr task);
+
+            TaskPtr
+            popWorkerTask(int workerIndex);
+
+            TaskPtr
+            popMainThreadTask();
+
+            void
+            run(uint workerIndex);
+        };
+    }
+}
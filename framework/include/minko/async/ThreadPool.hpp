@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace minko
+{
+    namespace async
+    {
+        /**
+         * Splits data-parallel loops between the workers of a TaskScheduler. The thread calling parallelFor()
+         * processes chunks of the loop along with the workers, so a scheduler with no worker runs everything
+         * inline: this is the case of the shared instance() on platforms without threads.
+         */
+        class ThreadPool
+        {
+        public:
+            typedef std::shared_ptr<ThreadPool>         Ptr;
+            typedef std::function<void(uint, uint)>     RangeFunction;
+
+        private:
+            typedef std::shared_ptr<TaskScheduler>      TaskSchedulerPtr;
+
+            struct Loop
+            {
+                RangeFunction           function;
+                uint                    begin;
+                uint                    end;
+                uint                    grainSize;
+                uint                    numChunks;
+                std::atomic<uint>       nextChunk;
+                std::atomic<uint>       numDoneChunks;
+                std::exception_ptr      exception;
+                std::mutex              mutex;
+                std::condition_variable done;
+            };
+
+            typedef std::shared_ptr<Loop>               LoopPtr;
+
+        private:
+            TaskSchedulerPtr                            _scheduler;
+
+        public:
+            inline static
+            Ptr
+            create(TaskSchedulerPtr scheduler)
+            {
+                return std::shared_ptr<ThreadPool>(new ThreadPool(scheduler));
+            }
+
+            /**
+             * Creates a pool with its own scheduler of numThreads workers.
+             */
+            static
+            Ptr
+            create(uint numThreads);
+
+            /**
+             * The pool shared by the engine, running on the workers of TaskScheduler::instance() so that
+             * loops and tasks share one thread per core besides the main one.
+             */
+            static
+            Ptr
+            instance();
+
+            uint
+            numThreads() const;
+
+            /**
+             * Calls function(chunkBegin, chunkEnd) on consecutive chunks of at most grainSize indices
+             * covering [begin, end), from several threads, and returns once all of them are done. The first
+             * exception thrown by function is rethrown.
+             */
+            void
+            parallelFor(uint begin, uint end, uint grainSize, const RangeFunction& function);
+
+        private:
+            ThreadPool(TaskSchedulerPtr scheduler);
+
+            static
+            void
+            runChunks(LoopPtr loop);
+        };
+    }
+}
@@ -20,79 +20,160 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #pragma once
 
 #include "minko/async/Worker.hpp"
+#include "minko/async/MpscQueue.hpp"
+
+#include <condition_variable>
 
 #if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
 # error "ThreadWorkerImpl is not available under Emscripten"
 #endif
 
+#if defined(_MSC_VER)
+# define MINKO_WORKER_THREAD_LOCAL __declspec(thread)
+#else
+# define MINKO_WORKER_THREAD_LOCAL __thread
+#endif
+
 namespace minko
 {
     namespace async
     {
         class Worker::WorkerImpl // ThreadWorkerImpl
         {
+        private:
+            typedef std::function<void()>   Request;
+
+            // Long-lived threads shared by all the workers, so that starting a worker does not spawn a thread.
+            class RequestPool
+            {
+            private:
+                std::mutex                  _mutex;
+                std::condition_variable     _requestPushed;
+                std::queue<Request>         _requests;
+                uint                        _numThreads;
+                uint                        _numIdleThreads;
+
+            public:
+                static
+                RequestPool&
+                instance()
+                {
+                    // never destroyed: at exit, a thread may still be blocked in a request
+                    static auto pool = new RequestPool();
+
+                    return *pool;
+                }
+
+                void
+                push(Request&& request)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    _requests.push(std::move(request));
+
+                    // idle threads only stop being idle when they wake up: each of them takes one of the queued
+                    // requests, a thread is missing when there are more of them
+                    // requests mostly wait for I/O: use at least a few threads even on a single core
+                    if (_requests.size() > _numIdleThreads
+                        && _numThreads < std::max(std::thread::hardware_concurrency(), 4u))
+                    {
+                        ++_numThreads;
+                        std::thread(&RequestPool::run, this).detach();
+                    }
+
+                    if (_numIdleThreads != 0)
+                        _requestPushed.notify_one();
+                }
+
+            private:
+                RequestPool() :
+                    _numThreads(0),
+                    _numIdleThreads(0)
+                {
+                }
+
+                void
+                run()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+
+                    while (true)
+                    {
+                        while (_requests.empty())
+                        {
+                            ++_numIdleThreads;
+                            _requestPushed.wait(lock);
+                            --_numIdleThreads;
+                        }
+
+                        auto request = std::move(_requests.front());
+
+                        _requests.pop();
+
+                        lock.unlock();
+                        request();
+                        lock.lock();
+                    }
+                }
+            };
+
         public:
-            void
+            uint
             start(const std::vector<char>& input)
             {
-                //std::cout << "ThreadWorkerImpl::start()" << std::endl;;
+                auto worker = _that->shared_from_this();
+                auto requestId = ++_numRequests;
 
-                _input = input;
+                RequestPool::instance().push([=]()
+                {
+                    _currentRequestId = requestId;
+                    worker->run(input);
+                    _currentRequestId = 0;
+                });
 
-                std::thread(&Worker::run, _that->shared_from_this(), std::ref(_input)).detach();
+                return requestId;
             }
 
             void
             poll()
             {
-                // std::cout << "ThreadWorkerImpl::poll()" << std::endl;;
-
-                std::lock_guard<std::mutex> lock(_mutex);
+                Message message;
 
-                while (!_messages.empty())
-                {
-                    //std::cout << "ThreadWorkerImpl::poll(): message execute" << std::endl;
-                    _message->execute(_that->shared_from_this(), _messages.front());
-                    _messages.pop();
-                }
+                while (_messages.pop(message))
+                    _that->dispatch(message);
             }
 
             void
-            post(Message message)
+            post(Message&& message)
             {
-                //std::cout << "ThreadWorkerImpl::post(): " << message.type << std::endl;
-                std::lock_guard<std::mutex> lock(_mutex);
+                message.requestId = _currentRequestId;
 
-                // FIXME: Optimize here (useless copy).
-                _messages.push(message);
+                _messages.push(std::move(message));
             }
 
-            Signal<Ptr, Message>::Ptr
+            Signal<Ptr, const Message&>::Ptr
             message()
             {
                 return _message;
             }
 
-            ~WorkerImpl()
-            {
-                //std::cout << "ThreadWorkerImpl::~ThreadWorkerImpl()" << std::endl;
-            }
-
             WorkerImpl(Worker* that, const std::string& name) :
                 _that(that),
                 _name(name),
-                _message(Signal<Ptr, Message>::create())
+                _numRequests(0),
+                _message(Signal<Ptr, const Message&>::create())
             {
-                //std::cout << "ThreadWorkerImpl::ThreadWorkerImpl()" << std::endl;
             }
 
         private:
             Worker*                                         _that;
             std::string                                     _name;
-            std::mutex                                      _mutex;
-            std::queue<Message>                             _messages;
-            std::shared_ptr<Signal<Ptr, Message>>           _message;
-            std::vector<char>                               _input;
+            uint                                            _numRequests;
+            MpscQueue<Message>                              _messages;
+            std::shared_ptr<Signal<Ptr, const Message&>>    _message;
+
+            // the id of the request run by the current thread, 0 outside of a request
+            static MINKO_WORKER_THREAD_LOCAL uint           _currentRequestId;
         };
     }
 }
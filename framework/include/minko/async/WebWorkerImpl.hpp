@@ -34,7 +34,7 @@ namespace minko
         class Worker::WorkerImpl
         {
         public:
-            void
+            uint
             start(const std::vector<char>& input)
             {
                 std::cout << "WebWorkerImpl::start()" << std::endl;;
@@ -42,6 +42,10 @@ namespace minko
                 char* data = const_cast<char*>(&*input.begin());
 
                 emscripten_call_worker(_handle, "minkoWorkerEntryPoint", data, input.size(), &messageHandler, this);
+
+                _requestIds.push(++_numRequests);
+
+                return _numRequests;
             }
 
             void
@@ -52,19 +56,21 @@ namespace minko
                 if (!_messages.empty())
                 {
                     std::cout << "WebWorkerImpl::poll(): message execute" << std::endl;
-                    _message->execute(_that->shared_from_this(), _messages.front());
+                    auto message = std::move(_messages.front());
+
                     _messages.pop();
+                    _that->dispatch(message);
                 }
             }
 
             void
-            post(Message message)
+            post(Message&& message)
             {
                 emscripten_worker_respond(const_cast<char*>(message.type.c_str()), message.type.size());
                 emscripten_worker_respond(&*message.data.begin(), message.data.size());
             }
 
-            Signal<Ptr, Message>::Ptr
+            Signal<Ptr, const Message&>::Ptr
             message()
             {
                 return _message;
@@ -77,18 +83,21 @@ namespace minko
 
             WorkerImpl(Worker* that, const std::string& name) :
                 _that(that),
-                _message(Signal<Ptr, Message>::create())
+                _numRequests(0),
+                _message(Signal<Ptr, const Message&>::create())
             {
                 std::string path = "minko-worker-" + name + ".js";
                 _handle = emscripten_create_worker(path.c_str());
             }
 
         private:
-            Worker*                                     _that;
-            std::string                                 _messageType;
-            std::queue<Message>                         _messages;
-            std::shared_ptr<Signal<Ptr, Message>>       _message;
-            int                                         _handle;
+            Worker*                                         _that;
+            std::string                                     _messageType;
+            uint                                            _numRequests;
+            std::queue<uint>                                _requestIds;
+            std::queue<Message>                             _messages;
+            std::shared_ptr<Signal<Ptr, const Message&>>    _message;
+            int                                             _handle;
 
             static
             void
@@ -107,7 +116,17 @@ namespace minko
                 {
                     std::cout << "WebWorkerImpl::messageHandler(): reading data" << std::endl;
 
-                    worker->_messages.push(Message { worker->_messageType }.set(std::vector<char>(data, data + size)));
+                    // a web worker runs its calls one after the other: the messages belong to the oldest
+                    // request until it posts its "complete" or "error" message
+                    auto message = Message { worker->_messageType };
+
+                    message.set(std::vector<char>(data, data + size));
+                    message.requestId = worker->_requestIds.empty() ? 0 : worker->_requestIds.front();
+
+                    if (!worker->_requestIds.empty() && (message.type == "complete" || message.type == "error"))
+                        worker->_requestIds.pop();
+
+                    worker->_messages.push(std::move(message));
                     worker->_messageType.erase();
                 }
             }
@@ -40,6 +40,15 @@ namespace minko
             {
                 std::string type;
                 std::vector<char> data;
+                // the value returned by the start() call whose run() posted the message
+                uint requestId;
+
+                Message(const std::string& type = "") :
+                    type(type),
+                    data(),
+                    requestId(0)
+                {
+                }
 
                 template<typename T>
                 Message&
@@ -57,18 +66,34 @@ namespace minko
                     data = value;
                     return *this;
                 }
+
+                Message&
+                set(std::vector<char>&& value)
+                {
+                    data = std::move(value);
+                    return *this;
+                }
             };
 
+            typedef std::function<void(const Message&)>                               MessageHandler;
+
         public:
-            // Starts the worker.
-            void
+            // Starts the worker. Returns an id identifying the messages posted by this run of the worker.
+            uint
             start(const std::vector<char>& input);
 
-            // Must be called. Register on this signal to get updates from the worker.
-            Signal<Ptr, Message>::Ptr
+            // Starts the worker and calls handler with the messages posted by this run only, until its "complete"
+            // or "error" message. Prefer it to message() when many requests share the same worker.
+            uint
+            start(const std::vector<char>& input, const MessageHandler& handler);
+
+            // Must be called. Register on this signal to get updates from the worker. The same worker can be
+            // started several times concurrently: filter the messages by Message::requestId.
+            Signal<Ptr, const Message&>::Ptr
             message();
 
-            // Can be called from the worker code to send data back to the application.
+            // Can be called from the worker code to send data back to the application. The message is moved
+            // to the application thread, not copied.
             void
             post(Message message);
 
@@ -88,9 +113,14 @@ namespace minko
         protected:
             Worker(const std::string& name);
 
+        private:
+            void
+            dispatch(const Message& message);
+
         private:
             class WorkerImpl;
-            std::unique_ptr<WorkerImpl> _impl;
+            std::unique_ptr<WorkerImpl>                 _impl;
+            std::unordered_map<uint, MessageHandler>    _handlers;
         };
     }
 }
@@ -0,0 +1,230 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        /**
+         * Keeps every component of type T found in the scene of its target in a dense array, so that
+         * systems can iterate over them without walking the scene graph.
+         */
+        template <typename T>
+        class ComponentRegistry :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<ComponentRegistry<T>>                   Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                            NodePtr;
+            typedef std::shared_ptr<T>                                      ComponentPtr;
+
+        private:
+            std::vector<ComponentPtr>                                       _components;
+            std::unordered_map<ComponentPtr, unsigned int>                  _componentToIndex;
+            NodePtr                                                         _root;
+
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                   _targetAddedSlot;
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                   _targetRemovedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                         _addedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                         _removedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot     _childrenAddedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot     _childrenRemovedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot          _componentAddedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot          _componentRemovedSlot;
+
+        public:
+            static
+            Ptr
+            create()
+            {
+                auto ctrl = std::shared_ptr<ComponentRegistry<T>>(new ComponentRegistry<T>());
+
+                ctrl->initialize();
+
+                return ctrl;
+            }
+
+            inline
+            const std::vector<ComponentPtr>&
+            components() const
+            {
+                return _components;
+            }
+
+            inline
+            bool
+            contains(ComponentPtr component) const
+            {
+                return _componentToIndex.count(component) != 0;
+            }
+
+        private:
+            ComponentRegistry() :
+                _components(),
+                _componentToIndex(),
+                _root(nullptr)
+            {
+            }
+
+            void
+            initialize()
+            {
+                _targetAddedSlot = targetAdded()->connect([=](AbstractComponent::Ptr ctrl, NodePtr target)
+                {
+                    if (targets().size() > 1)
+                        throw std::logic_error("ComponentRegistry cannot have more than one target.");
+
+                    auto updateRootCallback = [=](NodePtr node, NodePtr target, NodePtr ancestor)
+                    {
+                        updateRoot(targets()[0]->root());
+                    };
+
+                    _addedSlot = target->added()->connect(updateRootCallback);
+                    _removedSlot = target->removed()->connect(updateRootCallback);
+
+                    updateRoot(target->root());
+                });
+
+                _targetRemovedSlot = targetRemoved()->connect([=](AbstractComponent::Ptr ctrl, NodePtr target)
+                {
+                    _addedSlot = nullptr;
+                    _removedSlot = nullptr;
+
+                    updateRoot(nullptr);
+                });
+            }
+
+            void
+            updateRoot(NodePtr root)
+            {
+                if (root == _root)
+                    return;
+
+                _components.clear();
+                _componentToIndex.clear();
+
+                _childrenAddedSlot = nullptr;
+                _childrenRemovedSlot = nullptr;
+                _componentAddedSlot = nullptr;
+                _componentRemovedSlot = nullptr;
+
+                _root = root;
+
+                if (_root == nullptr)
+                    return;
+
+                _childrenAddedSlot = _root->childrenAdded()->connect(
+                    [=](NodePtr node, const std::vector<NodePtr>& children, NodePtr parent)
+                    {
+                        addDescendants(children);
+                    }
+                );
+
+                _childrenRemovedSlot = _root->childrenRemoved()->connect(
+                    [=](NodePtr node, const std::vector<NodePtr>& children, NodePtr parent)
+                    {
+                        auto descendants = scene::NodeSet::create(children)->descendants(true);
+
+                        for (auto descendant : descendants->nodes())
+                            for (auto component : descendant->components<T>())
+                                remove(component);
+                    }
+                );
+
+                _componentAddedSlot = _root->componentAdded()->connect(
+                    [=](NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+                    {
+                        auto component = std::dynamic_pointer_cast<T>(ctrl);
+
+                        if (component != nullptr)
+                            add(component);
+                    }
+                );
+
+                _componentRemovedSlot = _root->componentRemoved()->connect(
+                    [=](NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+                    {
+                        auto component = std::dynamic_pointer_cast<T>(ctrl);
+
+                        if (component != nullptr)
+                            remove(component);
+                    }
+                );
+
+                addDescendants(std::vector<NodePtr>(1, _root));
+            }
+
+            void
+            addDescendants(const std::vector<NodePtr>& nodes)
+            {
+                auto descendants = scene::NodeSet::create(nodes)->descendants(true);
+
+                for (auto descendant : descendants->nodes())
+                    for (auto component : descendant->components<T>())
+                        add(component);
+            }
+
+            void
+            add(ComponentPtr component)
+            {
+                // a component added to a node before its batch is committed is notified twice
+                if (_componentToIndex.count(component) != 0)
+                    return;
+
+                _componentToIndex[component] = _components.size();
+                _components.push_back(component);
+            }
+
+            void
+            remove(ComponentPtr component)
+            {
+                auto indexIt = _componentToIndex.find(component);
+
+                if (indexIt == _componentToIndex.end())
+                    return;
+
+                // the same component can still be attached to other nodes of the scene
+                for (auto target : component->targets())
+                    if (target->root() == _root)
+                        return;
+
+                // swap with the last component to keep the array dense
+                auto index = indexIt->second;
+                auto last  = _components.back();
+
+                _components[index] = last;
+                _componentToIndex[last] = index;
+
+                _components.pop_back();
+                _componentToIndex.erase(component);
+            }
+        };
+    }
+}
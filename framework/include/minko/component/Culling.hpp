@@ -37,18 +37,29 @@ namespace minko
         private:
             typedef std::shared_ptr<scene::Node>                                NodePtr;
             typedef std::shared_ptr<math::AbstractShape>                        ShapePtr;
+            typedef std::shared_ptr<Surface>                                    SurfacePtr;
+            typedef std::shared_ptr<SceneManager>                               SceneManagerPtr;
+            typedef std::shared_ptr<render::AbstractTexture>                    AbsTexturePtr;
 
         private:
-            static std::shared_ptr<math::OctTree>                               _octTree;
+            std::shared_ptr<math::OctTree>                                      _octTree;
 
             std::shared_ptr<math::AbstractShape>                                _frustum;
 
+            std::unordered_map<NodePtr, std::vector<SurfacePtr>>                _nodeToSurfaces;
+            std::unordered_set<SurfacePtr>                                      _visibleSurfaces;
+            std::unordered_set<SurfacePtr>                                      _newVisibleSurfaces;
+
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetRemovedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot         _addedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot         _removedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedToSceneSlot;
             Signal<NodePtr, NodePtr>::Slot                                      _layoutChangedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentAddedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentRemovedSlot;
             Signal<std::shared_ptr<data::Container>, const std::string&>::Slot  _viewMatrixChangedSlot;
+            Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot                  _renderingBeginSlot;
 
             std::string                                                         _bindProperty;
 
@@ -79,11 +90,29 @@ namespace minko
             targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
 
             void
-            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+            addedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr ancestor);
+
+            void
+            removedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr ancestor);
 
             void
             layoutChangedHandler(NodePtr node, NodePtr target);
 
+            void
+            componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component);
+
+            void
+            componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component);
+
+            void
+            renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget);
+
+            void
+            insertNode(NodePtr node);
+
+            void
+            removeNode(NodePtr node);
+
             void
             worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName);
 
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/component/AbstractScript.hpp"
+#include "minko/async/TaskScheduler.hpp"
 #include "minko/Signal.hpp"
 
 namespace minko
@@ -43,6 +44,7 @@ namespace minko
                 std::shared_ptr<JobManager>     _jobManager;
                 bool                            _running;
                 bool                            _oneStepPerFrame;
+                bool                            _offMainThread;
 
                 Signal<float>::Ptr              _priorityChanged;
 
@@ -95,6 +97,26 @@ namespace minko
                     _oneStepPerFrame = value;
                 }
 
+                inline
+                bool
+                offMainThread()
+                {
+                    return _offMainThread;
+                }
+
+                /**
+                 * Runs every step() of the job in a row on a worker thread of the scheduler instead of
+                 * time-slicing them on the main thread. beforeFirstStep() and afterLastStep() still run on
+                 * the main thread, so step() and complete() must not touch the scene or the rendering context.
+                 * Ignored when the scheduler has no worker.
+                 */
+                inline
+                void
+                offMainThread(bool value)
+                {
+                    _offMainThread = value;
+                }
+
                 inline
                 std::shared_ptr<JobManager>
                 jobManager()
@@ -119,19 +141,30 @@ namespace minko
         private:
             typedef std::shared_ptr<scene::Node>    NodePtr;
 
+            typedef std::shared_ptr<async::TaskScheduler>                   TaskSchedulerPtr;
+            typedef std::chrono::steady_clock                               Clock;
+
         private:
             unsigned int                                                    _loadingFramerate;
             float                                                           _frameTime;
-            std::list<Job::Ptr>                                             _jobs;
+            TaskSchedulerPtr                                                _scheduler;
+            std::vector<Job::Ptr>                                           _jobs;
+            bool                                                            _sortNeeded;
             std::unordered_map<Job::Ptr, Signal<float>::Slot>               _jobPriorityChangedSlots;
-            clock_t                                                         _frameStartTime;
+            std::vector<async::TaskScheduler::TaskPtr>                      _offMainThreadJobs;
+            Clock::time_point                                               _frameStartTime;
 
         public:
+            /**
+             * Creates a manager running jobs for at most 1 / loadingFramerate seconds of wall time per
+             * frame. Off-main-thread jobs, and the main thread tasks of scheduler, are run by scheduler,
+             * which defaults to async::TaskScheduler::instance().
+             */
             static
             Ptr
-            create(unsigned int loadingFramerate)
+            create(unsigned int loadingFramerate, TaskSchedulerPtr scheduler = nullptr)
             {
-                Ptr taskManager(new JobManager(loadingFramerate));
+                Ptr taskManager(new JobManager(loadingFramerate, scheduler ? scheduler : async::TaskScheduler::instance()));
 
                 taskManager->initialize();
 
@@ -148,10 +181,13 @@ namespace minko
             end(NodePtr target);
 
         private:
-            JobManager(unsigned int loadingFramerate);
+            JobManager(unsigned int loadingFramerate, TaskSchedulerPtr scheduler);
+
+            float
+            elapsedFrameTime() const;
 
             void
-            insertJob(Job::Ptr job);
+            runOffMainThread(Job::Ptr job);
         };
     }
 }
\ No newline at end of file
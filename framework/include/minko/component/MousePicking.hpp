@@ -55,8 +55,12 @@ namespace minko
             std::shared_ptr<math::Vector3>                      _previousRayOrigin;
             NodePtr                                             _lastItemUnderCursor;
 
+            // broad phase: every descendant with a BoundingBox, whatever its layouts
+            std::shared_ptr<math::OctTree>                      _octTree;
+
             Signal<AbstractComponent::Ptr, NodePtr>::Slot       _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot       _targetRemovedSlot;
+            std::unordered_map<NodePtr, std::list<Any>>         _targetToSlots;
 
         public:
             inline static
@@ -92,6 +96,31 @@ namespace minko
 
             void
             initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            removedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component);
+
+            void
+            componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component);
+
+            /**
+             * Casts the ray on the triangles of the surfaces of node. distance must be initialized with the
+             * distance to the bounding box of node: it is kept when no surface has CPU side triangles.
+             */
+            bool
+            castSurfaces(NodePtr node, RayPtr ray, float& distance);
         };
     }
 }
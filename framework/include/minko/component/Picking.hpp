@@ -46,6 +46,39 @@ namespace minko
             typedef std::shared_ptr<data::ArrayProvider>        ArrayProviderPtr;
             typedef std::shared_ptr<data::StructureProvider>    StructureProviderPtr;
             typedef std::shared_ptr<AbstractCanvas>             AbstractCanvasPtr;
+            typedef std::shared_ptr<render::AbstractTexture>    AbsTexturePtr;
+            typedef std::shared_ptr<render::ReadbackQueue>      ReadbackQueuePtr;
+            typedef std::function<void(NodePtr)>                PickCallback;
+
+        private:
+            class Event
+            {
+            public:
+                static const uint MOUSE_MOVE            = 1 << 0;
+                static const uint MOUSE_RIGHT_DOWN      = 1 << 1;
+                static const uint MOUSE_LEFT_DOWN       = 1 << 2;
+                static const uint MOUSE_RIGHT_UP        = 1 << 3;
+                static const uint MOUSE_LEFT_UP         = 1 << 4;
+                static const uint MOUSE_RIGHT_CLICK     = 1 << 5;
+                static const uint MOUSE_LEFT_CLICK      = 1 << 6;
+                static const uint TOUCH_DOWN            = 1 << 7;
+                static const uint TOUCH_UP              = 1 << 8;
+                static const uint TOUCH_MOVE            = 1 << 9;
+                static const uint TAP                   = 1 << 10;
+                static const uint DOUBLE_TAP            = 1 << 11;
+                static const uint LONG_HOLD             = 1 << 12;
+            };
+
+            // a pixel to pick: either the pointer, executing the handlers of events, or a call to pick()
+            struct PickRequest
+            {
+                float           x;
+                float           y;
+                uint            events;
+                PickCallback    callback;
+            };
+
+            static const uint                                   MAX_NUM_PICK_REQUESTS;
 
         private:
             TexturePtr                                          _renderTarget;
@@ -62,6 +95,10 @@ namespace minko
             uint                                                _pickingId;
             ContextPtr                                          _context;
             StructureProviderPtr                                _pickingProvider;
+            bool                                                _asynchronous;
+            ReadbackQueuePtr                                    _readbackQueue;
+            std::vector<PickRequest>                            _pickRequests;
+            bool                                                _renderingPickRequests;
 
             std::vector<NodePtr>                                _descendants;
 
@@ -69,10 +106,14 @@ namespace minko
             Signal<AbsCtrlPtr, NodePtr>::Slot                   _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot             _addedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot             _removedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot _childrenAddedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot _childrenRemovedSlot;
             Signal<RendererPtr>::Slot                           _renderingBeginSlot;
             Signal<RendererPtr>::Slot                           _renderingEndSlot;
             Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot          _componentAddedSlot;
             Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot          _componentRemovedSlot;
+            Signal<SceneManagerPtr, float, float>::Slot         _frameBeginSlot;
+            Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot  _sceneRenderingEndSlot;
 
             Signal<NodePtr>::Ptr                                _mouseOver;
             Signal<NodePtr>::Ptr                                _mouseRightDown;
@@ -108,31 +149,22 @@ namespace minko
             Signal<TouchPtr, float, float>::Slot                _touchDoubleTapSlot;
             Signal<TouchPtr, float, float>::Slot                _touchLongHoldSlot;
 
-            bool                                                _executeMoveHandler;
-            bool                                                _executeRightClickHandler;
-            bool                                                _executeLeftClickHandler;
-            bool                                                _executeRightDownHandler;
-            bool                                                _executeLeftDownHandler;
-            bool                                                _executeRightUpHandler;
-            bool                                                _executeLeftUpHandler;
-            bool                                                _executeTouchDownHandler;
-            bool                                                _executeTouchUpHandler;
-            bool                                                _executeTouchMoveHandler;
-            bool                                                _executeTapHandler;
-            bool                                                _executeDoubleTapHandler;
-            bool                                                _executeLongHoldHandler;
-
             bool                                                _addPickingLayout;
             bool                                                _emulateMouseWithTouch;
 
+            uint                                                _pendingEvents;
+
         public:
             inline static
             Ptr
-            create(NodePtr camera, bool addPickingLayoutToNodes = true, bool emulateMouseWithTouch = true)
+            create(NodePtr  camera,
+                   bool     addPickingLayoutToNodes = true,
+                   bool     emulateMouseWithTouch   = true,
+                   bool     asynchronous            = false)
             {
                 Ptr picking = std::shared_ptr<Picking>(new Picking());
 
-                picking->initialize(camera, addPickingLayoutToNodes, emulateMouseWithTouch);
+                picking->initialize(camera, addPickingLayoutToNodes, emulateMouseWithTouch, asynchronous);
 
                 return picking;
             }
@@ -249,9 +281,29 @@ namespace minko
                 return _lastPickedSurface;
             }
 
+            /**
+             * In asynchronous mode, picked surfaces are read back from the GPU one or more frames after
+             * they are rendered instead of stalling the rendering pipeline: mouse and touch signals are
+             * executed with the same latency.
+             */
+            inline
+            bool
+            asynchronous() const
+            {
+                return _asynchronous;
+            }
+
+            /**
+             * Picks the surface rendered at the (x, y) canvas coordinates during the next frame and
+             * executes callback with its target, or nullptr if there is none. In asynchronous mode,
+             * callback is executed at the beginning of a later frame.
+             */
+            void
+            pick(float x, float y, const PickCallback& callback);
+
         private:
             void
-            initialize(NodePtr camera, bool addPickingLayout, bool emulateMouseWithTouch);
+            initialize(NodePtr camera, bool addPickingLayout, bool emulateMouseWithTouch, bool asynchronous);
 
             void
             targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
@@ -268,6 +320,12 @@ namespace minko
             void
             removedHandler(NodePtr node, NodePtr target, NodePtr parent);
 
+            void
+            childrenAddedHandler(NodePtr node, const std::vector<NodePtr>& children, NodePtr parent);
+
+            void
+            childrenRemovedHandler(NodePtr node, const std::vector<NodePtr>& children, NodePtr parent);
+
             void
             componentAddedHandler(NodePtr node, NodePtr target, AbsCtrlPtr    ctrl);
 
@@ -292,6 +350,30 @@ namespace minko
             void
             renderingEnd(RendererPtr renderer);
 
+            void
+            frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
+            void
+            sceneRenderingEndHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget);
+
+            void
+            renderPickRequests();
+
+            void
+            resolvePickRequests(const std::vector<PickRequest>& requests, const std::vector<unsigned char>& pixels);
+
+            SurfacePtr
+            pickedSurface(const unsigned char* color);
+
+            void
+            updatePickedSurface(SurfacePtr surface);
+
+            void
+            executeHandlers(uint events);
+
+            void
+            requestEvent(uint event);
+
             Picking();
 
             void
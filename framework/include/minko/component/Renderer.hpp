@@ -53,6 +53,15 @@ namespace minko
             typedef Signal<SurfacePtr, const std::string&, bool>::Slot          SurfaceTechniqueChangedSlot;
             typedef Signal<AbsFilterPtr, SurfacePtr>::Slot                      FilterChangedSlot;
             typedef Signal<Ptr, AbsFilterPtr, data::BindingSource, SurfacePtr>  RendererFilterChangedSignal;
+            typedef std::shared_ptr<math::Matrix4x4>                            Matrix4x4Ptr;
+
+            // size covered on screen by a surface, computed again when its bounding box or the projection change
+            struct ScreenSize
+            {
+                std::array<float, 6>    box;
+                uint                    projectionId;
+                float                   size;
+            };
 
         private:
             std::string                                                         _name;
@@ -74,13 +83,18 @@ namespace minko
             EffectPtr                                                           _effect;
             float                                                               _priority;
             bool                                                                _enabled;
+            bool                                                                _instancing;
+            std::shared_ptr<render::TextureStreamer>                            _textureStreamer;
+            std::unordered_map<SurfacePtr, ScreenSize>                          _screenSizes;
+            std::array<float, 18>                                               _screenSizeProjection; // world to screen matrix and viewport size
+            uint                                                                _screenSizeProjectionId;
 
             Signal<AbsCmpPtr, NodePtr>::Slot                                    _targetAddedSlot;
             Signal<AbsCmpPtr, NodePtr>::Slot                                    _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _removedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _rootDescendantAddedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _rootDescendantRemovedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot         _rootDescendantAddedSlot;
+            Signal<NodePtr, const std::vector<NodePtr>&, NodePtr>::Slot         _rootDescendantRemovedSlot;
             Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot                           _componentAddedSlot;
             Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot                           _componentRemovedSlot;
             Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot                  _renderingBeginSlot;
@@ -150,6 +164,13 @@ namespace minko
                 return _drawCalls.size();
             }
 
+            inline
+            const DrawCallList&
+            drawCalls() const
+            {
+                return _drawCalls;
+            }
+
             inline
             unsigned int
             backgroundColor()
@@ -256,6 +277,57 @@ namespace minko
             render(std::shared_ptr<render::AbstractContext> context,
                    AbsTexturePtr renderTarget = nullptr);
 
+            render::DrawCallSortMode
+            sortMode() const;
+
+            Ptr
+            sortMode(render::DrawCallSortMode);
+
+            // culled surfaces keep their draw calls but are not rendered, see Culling
+            bool
+            culled(SurfacePtr) const;
+
+            void
+            culled(SurfacePtr, bool);
+
+            // batch surfaces sharing the same geometry, material and effect in instanced draw calls
+            // when the context supports it
+            inline
+            bool
+            instancing() const
+            {
+                return _instancing;
+            }
+
+            inline
+            Ptr
+            instancing(bool value)
+            {
+                _instancing = value;
+
+                return std::static_pointer_cast<Renderer>(shared_from_this());
+            }
+
+            inline
+            std::shared_ptr<render::TextureStreamer>
+            textureStreamer() const
+            {
+                return _textureStreamer;
+            }
+
+            /**
+             * Requests the textures of each rendered draw call from streamer at the size its surface covers
+             * on screen, then updates streamer at the end of each frame.
+             */
+            inline
+            Ptr
+            textureStreamer(std::shared_ptr<render::TextureStreamer> streamer)
+            {
+                _textureStreamer = streamer;
+
+                return std::static_pointer_cast<Renderer>(shared_from_this());
+            }
+
             inline
             Signal<Ptr>::Ptr
             renderingBegin()
@@ -327,10 +399,10 @@ namespace minko
             removedHandler(NodePtr node, NodePtr target, NodePtr parent);
 
             void
-            rootDescendantAddedHandler(NodePtr node, NodePtr target, NodePtr parent);
+            rootDescendantAddedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr parent);
 
             void
-            rootDescendantRemovedHandler(NodePtr node, NodePtr target, NodePtr parent);
+            rootDescendantRemovedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr parent);
 
             void
             componentAddedHandler(NodePtr node, NodePtr target, AbsCmpPtr    ctrl);
@@ -355,6 +427,16 @@ namespace minko
                                               uint                             frameId,
                                               AbsTexturePtr                    renderTarget);
 
+            Matrix4x4Ptr
+            updateScreenSizeProjection(AbsContext context);
+
+            void
+            requestTextures(DrawCallPtr drawCall, Matrix4x4Ptr worldToScreen);
+
+            static
+            float
+            computeScreenSize(const float* worldToScreen, const std::array<float, 6>& box, float width, float height);
+
             void
             findSceneManager();
 
@@ -59,6 +59,22 @@ namespace minko
             typedef Signal<NodePtr, NodePtr, NodePtr>               AddedOrRemovedSignal;
             typedef Signal<SceneManagerPtr>                         SceneManagerSignal;
 
+            // everything a thread needs to skin a range of vertices in software
+            struct SoftwareSkinningData
+            {
+                const float*                                        boneMatrices;
+                const uint*                                         vertexBoneOffsets;
+                const float*                                        vertexBoneWeights;
+                uint                                                numVertexBones;
+                const char*                                         changedBones;       // nullptr to skin every vertex
+                const float*                                        inputPositions;
+                float*                                              outputPositions;
+                uint                                                positionStride;
+                const float*                                        inputNormals;       // nullptr without normals
+                float*                                              outputNormals;
+                uint                                                normalStride;
+            };
+
         public:
             static const std::string                                PNAME_NUM_BONES;
             static const std::string                                PNAME_BONE_MATRICES;
@@ -71,6 +87,7 @@ namespace minko
         private:
             static const std::string                                ATTRNAME_POSITION;
             static const std::string                                ATTRNAME_NORMAL;
+            static const uint                                       SOFTWARE_SKINNING_GRAIN_SIZE;
 
         private:
 			SkinPtr													_skin;
@@ -85,6 +102,12 @@ namespace minko
             std::unordered_map<NodePtr, GeometryPtr>                _targetGeometry;
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputPositions;  // only for software skinning
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputNormals;    // only for software skinning
+            std::unordered_map<NodePtr, int>                        _targetSkinnedFrameId;  // only for software skinning
+
+            // only for software skinning: the bones of each vertex, padded with null weights to the same number
+            uint                                                    _numPaddedVertexBones;
+            std::vector<uint>                                       _paddedVertexBoneOffsets;
+            std::vector<float>                                      _paddedVertexBoneWeights;
 
             TargetAddedOrRemovedSignal::Slot                        _targetAddedSlot;
 
@@ -138,14 +161,14 @@ namespace minko
             targetAddedHandler(AbsCmpPtr, NodePtr);
 
             void
-            performSoftwareSkinning(NodePtr, const std::vector<float>&);
+            initializeSoftwareSkinning();
+
+            void
+            performSoftwareSkinning(NodePtr, uint frameId);
 
+            static
             void
-            performSoftwareSkinning(render::VertexBuffer::AttributePtr,
-                                    render::VertexBuffer::Ptr,
-                                    const std::vector<float>&,
-                                    const std::vector<float>&,
-                                    bool doDeltaTransform);
+            skinVertices(const SoftwareSkinningData& data, uint begin, uint end, uint& dirtyBegin, uint& dirtyEnd);
 
             render::VertexBuffer::Ptr
             createVertexBufferForBones() const;
@@ -174,22 +174,19 @@ namespace minko
             void
             addedOrRemovedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
 
-#ifdef MINKO_TEST
-        public:
-#else
         private:
-#endif // MINKO_TEST
             class RootTransform :
                 public AbstractComponent
             {
             public:
-                typedef std::shared_ptr<RootTransform>              Ptr;
+                typedef std::shared_ptr<RootTransform>                      Ptr;
 
             private:
-                typedef std::shared_ptr<Renderer>                   RendererCtrlPtr;
-                typedef std::shared_ptr<render::AbstractTexture>    AbsTexPtr;
-                typedef std::shared_ptr<SceneManager>               SceneMgrPtr;
-                typedef Signal<RendererCtrlPtr>::Slot               EnterFrameCallback;
+                typedef std::shared_ptr<Renderer>                           RendererCtrlPtr;
+                typedef std::shared_ptr<render::AbstractTexture>            AbsTexPtr;
+                typedef std::shared_ptr<SceneManager>                       SceneMgrPtr;
+                typedef Signal<RendererCtrlPtr>::Slot                       EnterFrameCallback;
+                typedef std::aligned_storage<sizeof(float) * 16, 16>::type  MatrixStorage;
 
             public:
                 inline static
@@ -212,21 +209,33 @@ namespace minko
             private:
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _transforms;
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _modelToWorld;
+                std::vector<MatrixStorage>                      _worldMatrices;
+                std::vector<unsigned char>                      _worldChanged;
+                std::vector<unsigned int>                       _changedIds;
+                std::vector<std::shared_ptr<math::Matrix4x4>>   _changedMatrices;
 
-                std::map<NodePtr, unsigned int>                 _nodeToId;
+                std::unordered_map<NodePtr, unsigned int>       _nodeToId;
                 std::vector<NodePtr>                            _idToNode;
                 std::vector<int>                                _parentId;
-                std::vector<unsigned int>                       _firstChildId;
-                std::vector<unsigned int>                       _numChildren;
+                unsigned int                                    _numHoles;
                 bool                                            _invalidLists;
 
                 std::list<Any>                                  _targetSlots;
                 Signal<SceneMgrPtr, uint, AbsTexPtr>::Slot      _renderingBeginSlot;
 
             private:
+                RootTransform();
+
                 void
                 initialize();
 
+                inline
+                float*
+                worldMatrix(unsigned int nodeId)
+                {
+                    return reinterpret_cast<float*>(&_worldMatrices[nodeId]);
+                }
+
                 void
                 targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
 
@@ -245,23 +254,43 @@ namespace minko
                 void
                 addedHandler(NodePtr node, NodePtr target, NodePtr parent);
 
+                void
+                childrenRemovedHandler(NodePtr node, const std::vector<NodePtr>& children, NodePtr parent);
+
+                void
+                childrenAddedHandler(NodePtr node, const std::vector<NodePtr>& children, NodePtr parent);
+
                 void
                 updateTransformsList();
 
+                void
+                insertSubtree(NodePtr node);
+
+                void
+                removeSubtree(NodePtr node);
+
+                void
+                appendSubtree(NodePtr node, int parentId);
+
+                unsigned int
+                appendNode(NodePtr node, int parentId);
+
+                void
+                compactLists();
+
                 void
                 updateTransforms();
 
                 void
                 updateTransformPath(const std::vector<unsigned int>& path);
 
+                void
+                publishWorldMatrices();
+
                 void
                 renderingBeginHandler(std::shared_ptr<SceneManager>             sceneManager,
                                       uint                                      frameId,
                                       std::shared_ptr<render::AbstractTexture>  abstractTexture);
-
-                static
-                void
-                juxtaposeSiblings(std::vector<NodePtr>&);
             };
         };
     }
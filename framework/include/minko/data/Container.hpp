@@ -42,10 +42,19 @@ namespace minko
             typedef Signal<ProviderPtr, const std::string&>                 ProviderPropertyChangedSignal;
             typedef ProviderPropertyChangedSignal::Slot                     ProviderPropertyChangedSlot;
 
+            struct PropertyEntry
+            {
+                ProviderPtr     provider;
+                std::string     providerPropertyName; // empty when the provider does not format the property name
+            };
+
             std::list<ProviderPtr>                                          _providers;
-            std::unordered_map<std::string, ProviderPtr>                    _propertyNameToProvider;
+            std::unordered_map<std::string, PropertyEntry>                  _propertyNameToProvider;
+            // ids are interned once when a property is added and erased with it
+            std::unordered_map<PropertyId, std::pair<ProviderPtr, PropertyId>>  _propertyIdToProvider;
             std::unordered_map<ProviderPtr, uint>                           _providersToNumUse;
             std::unordered_map<ProviderPtr, uint>                           _providerToIndex;
+            std::unordered_map<ProviderPtr, std::string>                    _arrayProviderToPrefix;
 
             std::shared_ptr<Provider>                                       _arrayLengths;
 
@@ -98,6 +107,9 @@ namespace minko
             bool
             hasProperty(const std::string&) const;
 
+            bool
+            hasProperty(const PropertyId&) const;
+
             bool
             isLengthProperty(const std::string&) const;
 
@@ -114,12 +126,26 @@ namespace minko
             T
             get(const std::string& propertyName) const
             {
-                assertPropertyExists(propertyName);
+                const auto foundIt = _propertyNameToProvider.find(propertyName);
 
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+                if (foundIt == _propertyNameToProvider.end())
+                    throw std::invalid_argument(propertyName);
+
+                const auto& entry = foundIt->second;
+
+                return entry.provider->get<T>(
+                    entry.providerPropertyName.empty() ? propertyName : entry.providerPropertyName,
+                    true
+                );
+            }
+
+            template <typename T>
+            T
+            get(const PropertyId& propertyId) const
+            {
+                const auto& providerAndId = getProviderAndPropertyId(propertyId);
 
-                return provider->get<T>(unformatedPropertyName, true);
+                return providerAndId.first->get<T>(providerAndId.second);
             }
 
             template <typename T>
@@ -128,7 +154,7 @@ namespace minko
             {
                 assertPropertyExists(propertyName);
 
-                auto provider = _propertyNameToProvider[propertyName];
+                auto provider = _propertyNameToProvider[propertyName].provider;
                 auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
 
                 provider->set<T>(unformatedPropertyName, value);
@@ -140,13 +166,22 @@ namespace minko
             {
                 assertPropertyExists(propertyName);
 
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
+                const auto& provider = _propertyNameToProvider.find(propertyName)->second.provider;
 
                 auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
 
                 return provider->propertyHasType<T>(unformatedPropertyName, skipPropertyNameFormatting);
             }
 
+            template <typename T>
+            bool
+            propertyHasType(const PropertyId& propertyId) const
+            {
+                const auto& providerAndId = getProviderAndPropertyId(propertyId);
+
+                return providerAndId.first->propertyHasType<T>(providerAndId.second);
+            }
+
             inline
             PropertyChangedSignalPtr
             propertyAdded() const
@@ -188,6 +223,14 @@ namespace minko
                 return _providers;
             }
 
+            // provider of the "<arrayName>.length" properties, derived from the array providers of the container
+            inline
+            ProviderPtr
+            arrayLengths() const
+            {
+                return _arrayLengths;
+            }
+
             inline
             const std::vector<std::string>
             properties() const
@@ -209,6 +252,12 @@ namespace minko
             void
             assertPropertyExists(const std::string& propertyName) const;
 
+            const std::pair<ProviderPtr, PropertyId>*
+            findProviderAndPropertyId(const PropertyId&) const;
+
+            const std::pair<ProviderPtr, PropertyId>&
+            getProviderAndPropertyId(const PropertyId&) const;
+
             void
             providerPropertyAddedHandler(ProviderPtr, const std::string& propertyName);
 
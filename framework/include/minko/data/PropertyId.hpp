@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace data
+    {
+        // interned property name: comparing and hashing a PropertyId is as cheap as for an integer
+        class PropertyId
+        {
+        private:
+            struct NameTable;
+
+        private:
+            uint    _id;
+
+        public:
+            inline
+            PropertyId() :
+                _id(0)
+            {
+            }
+
+            inline explicit
+            PropertyId(const std::string& name) :
+                _id(intern(name))
+            {
+            }
+
+            inline explicit
+            PropertyId(const char* name) :
+                _id(intern(name))
+            {
+            }
+
+            inline
+            uint
+            id() const
+            {
+                return _id;
+            }
+
+            const std::string&
+            name() const;
+
+            inline
+            bool
+            operator==(const PropertyId& x) const
+            {
+                return _id == x._id;
+            }
+
+            inline
+            bool
+            operator!=(const PropertyId& x) const
+            {
+                return _id != x._id;
+            }
+
+            inline
+            bool
+            operator<(const PropertyId& x) const
+            {
+                return _id < x._id;
+            }
+
+        private:
+            static
+            NameTable&
+            nameTable();
+
+            static
+            uint
+            intern(const std::string& name);
+        };
+    }
+}
+
+namespace std
+{
+    template<>
+    struct hash<minko::data::PropertyId>
+    {
+        inline
+        size_t
+        operator()(const minko::data::PropertyId& x) const
+        {
+            return x.id();
+        }
+    };
+}
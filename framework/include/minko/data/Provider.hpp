@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Any.hpp"
 #include "minko/Signal.hpp"
 #include "minko/data/Value.hpp"
+#include "minko/data/PropertyId.hpp"
 
 namespace minko
 {
@@ -44,6 +45,7 @@ namespace minko
         private:
             std::vector<std::string>                                _names;
             std::unordered_map<std::string, Any>                    _values;
+            std::unordered_map<PropertyId, Any*>                    _valuesById; // points into _values
             std::unordered_map<std::string, ChangedSignalSlot>      _valueChangedSlots;
             std::unordered_map<std::string, ChangedSignalSlot>      _referenceChangedSlots;
 
@@ -83,6 +85,13 @@ namespace minko
             bool
             hasProperty(const std::string&, bool skipPropertyNameFormatting = false) const;
 
+            inline
+            bool
+            hasProperty(const PropertyId& formattedPropertyId) const
+            {
+                return _valuesById.count(formattedPropertyId) != 0;
+            }
+
             inline
             const std::unordered_map<std::string, Any>&
             values() const
@@ -146,6 +155,19 @@ namespace minko
                 return get<T>(propertyName, false);
             }
 
+            // the id of a property is built from its formatted name
+            template <typename T>
+            T
+            get(const PropertyId& formattedPropertyId) const
+            {
+                auto foundIt = _valuesById.find(formattedPropertyId);
+
+                if (foundIt == _valuesById.end())
+                    throw std::invalid_argument("propertyName");
+
+                return Any::unsafe_cast<T>(*foundIt->second);
+            }
+
             template <typename T>
             bool
             propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
@@ -160,6 +182,18 @@ namespace minko
 
             }
 
+            template <typename T>
+            bool
+            propertyHasType(const PropertyId& formattedPropertyId) const
+            {
+                auto foundIt = _valuesById.find(formattedPropertyId);
+
+                if (foundIt == _valuesById.end())
+                    throw std::invalid_argument("propertyName");
+
+                return Any::cast<T>(foundIt->second) != nullptr;
+            }
+
             template <typename T>
             typename std::enable_if<!std::is_convertible<T, Value::Ptr>::value, Provider::Ptr>::type
             set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
@@ -169,14 +203,15 @@ namespace minko
                 const auto    foundValueIt     = _values.find(formattedName);
                 const bool    isNewValue       = foundValueIt == _values.end();
 
-                _values[formattedName] = value;
-
                 if (isNewValue)
                 {
+                    _valuesById[PropertyId(formattedName)] = &_values.insert(std::make_pair(formattedName, Any(value))).first->second;
                     _names.push_back(formattedName);
 
                     _propertyAdded->execute(shared_from_this(), formattedName);
                 }
+                else
+                    foundValueIt->second = value; // updated in place when the type does not change
 
                 _propReferenceChanged->execute(shared_from_this(), formattedName);
                 _propValueChanged->execute(shared_from_this(), formattedName);
@@ -193,7 +228,10 @@ namespace minko
                 const auto    foundValueIt     = _values.find(formattedName);
                 const bool    isNewValue       = (foundValueIt == _values.end());
 
-                _values[formattedName] = value;
+                if (isNewValue)
+                    _valuesById[PropertyId(formattedName)] = &_values.insert(std::make_pair(formattedName, Any(value))).first->second;
+                else
+                    foundValueIt->second = value;
 
                 if (isNewValue)
                 {
@@ -254,6 +292,10 @@ namespace minko
             {
                 return propertyName;
             }
+
+        private:
+            void
+            indexValues();
         };
     }
 }
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
+#include "minko/file/File.hpp"
 
 namespace minko
 {
@@ -58,6 +59,64 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary) = 0;
 
+            /**
+             * Called by the Loader instead of parse() with the loaded file. The file can be memory-mapped:
+             * parsers able to read file->bytes() and file->size() directly should override this method to
+             * avoid the copy made by file->data(). The file outlives the call.
+             */
+            virtual
+            void
+            parseFile(std::shared_ptr<File>            file,
+                      std::shared_ptr<Options>         options,
+                      std::shared_ptr<AssetLibrary>    assetLibrary)
+            {
+                parse(file->filename(), file->resolvedFilename(), options, file->data(), assetLibrary);
+            }
+
+            /**
+             * Whether the parser splits its work between decode() and commit(), in which case the Loader
+             * can call decode() from a worker thread when Options::parseAsynchronously() is true.
+             */
+            virtual
+            bool
+            threadSafe() const
+            {
+                return false;
+            }
+
+            /**
+             * Decodes file into staging data kept by the parser. Can run on any thread: must not use the
+             * rendering context, the asset library or the scene.
+             */
+            virtual
+            void
+            decode(std::shared_ptr<File>, std::shared_ptr<Options>)
+            {
+            }
+
+            /**
+             * Creates the resources from the data staged by decode() and executes complete(). Runs on
+             * the main thread.
+             */
+            virtual
+            void
+            commit(std::shared_ptr<File>,
+                   std::shared_ptr<Options>,
+                   std::shared_ptr<AssetLibrary>)
+            {
+            }
+
+            /**
+             * Number of bytes staged by decode() that commit() will upload, counted against the upload
+             * budget of the main thread.
+             */
+            virtual
+            uint
+            stagedSize() const
+            {
+                return 0;
+            }
+
         protected:
             AbstractParser() :
                 _complete(Signal<Ptr>::create()),
@@ -125,6 +125,13 @@ namespace minko
             {
                 return _file->_data;
             }
+
+            inline
+            void
+            mappedFile(std::shared_ptr<MemoryMappedFile> mappedFile)
+            {
+                _file->_mappedFile = mappedFile;
+            }
         };
 
     }
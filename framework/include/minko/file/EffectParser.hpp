@@ -151,9 +151,22 @@ namespace minko
                   const std::vector<unsigned char>& data,
                   std::shared_ptr<AssetLibrary>     assetLibrary);
 
+            void
+            parseFile(std::shared_ptr<File>             file,
+                      std::shared_ptr<Options>          options,
+                      std::shared_ptr<AssetLibrary>     assetLibrary);
+
         private:
             EffectParser();
 
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  std::size_t                       size,
+                  std::shared_ptr<AssetLibrary>     assetLibrary);
+
             data::MacroBindingMap
             initializeDefaultMacroBindings() const;
 
@@ -36,6 +36,7 @@ namespace minko
             std::string                         _filename;
 
             std::vector<unsigned char>          _data;
+            std::shared_ptr<MemoryMappedFile>   _mappedFile;
             std::string                         _resolvedFilename;
 
         public:
@@ -60,11 +61,24 @@ namespace minko
                 return _resolvedFilename;
             }
 
-            inline
+            /**
+             * The content of the file. If the file was memory-mapped, it is copied on the first call:
+             * use bytes() and size() to read it without copying.
+             */
             const std::vector<unsigned char>&
-            data()
+            data();
+
+            const unsigned char*
+            bytes() const;
+
+            std::size_t
+            size() const;
+
+            inline
+            std::shared_ptr<MemoryMappedFile>
+            mappedFile() const
             {
-                return _data;
+                return _mappedFile;
             }
 
             static
@@ -47,15 +47,23 @@ namespace minko
             bool
             fileExists(const std::string& filename);
 
+            // The number of bytes read between two progress notifications when loading size bytes.
+            static
+            std::size_t
+            progressChunkSize(std::size_t size);
+
         protected:
             FileProtocol();
 
+        private:
+            // reads the file on the "file-protocol" worker, or only reads its pages from the disk when it is mapped
+            void
+            loadWithWorker(const std::string& filename, uint64_t offset, uint64_t length, bool prefetchOnly);
+
         private:
             static
             std::list<std::shared_ptr<FileProtocol>>
             _runningLoaders;
-
-            std::list<Any> _workerSlots;
         };
     }
 }
@@ -179,10 +179,13 @@ namespace minko
             finalize();
 
             bool
-            processData(const std::string&                 filename,
-                        const std::string&                 resolvedFilename,
-                        std::shared_ptr<Options>           options,
-                        const std::vector<unsigned char>&  data);
+            processData(std::shared_ptr<File>       file,
+                        std::shared_ptr<Options>    options);
+
+            void
+            parseAsynchronously(std::shared_ptr<AbstractParser>  parser,
+                                std::shared_ptr<File>            file,
+                                std::shared_ptr<Options>         options);
 
             void
             parserCompleteHandler(std::shared_ptr<AbstractParser> parser);
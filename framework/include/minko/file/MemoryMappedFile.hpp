@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        /**
+         * Read-only memory mapping of a range of a file. The bytes are only read from the disk when they
+         * are accessed, and belong to the page cache: mapping a file does not allocate any memory.
+         */
+        class MemoryMappedFile
+        {
+        public:
+            typedef std::shared_ptr<MemoryMappedFile>   Ptr;
+
+        private:
+            void*                                       _mapping;
+            std::size_t                                 _mappingSize;
+            const unsigned char*                        _data;
+            std::size_t                                 _size;
+#if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+            void*                                       _fileHandle;
+            void*                                       _mappingHandle;
+#endif
+
+        public:
+            /**
+             * Maps length bytes of filename starting at offset, or every byte after offset if length is 0.
+             * Throws if the file cannot be mapped.
+             */
+            static
+            Ptr
+            create(const std::string& filename, uint64_t offset = 0, std::size_t length = 0);
+
+            static
+            bool
+            supported();
+
+            ~MemoryMappedFile();
+
+            inline
+            const unsigned char*
+            data() const
+            {
+                return _data;
+            }
+
+            inline
+            std::size_t
+            size() const
+            {
+                return _size;
+            }
+
+            // Reads the pages of the given range from the disk, so that accessing them later does not block.
+            void
+            prefetch(std::size_t offset, std::size_t size) const;
+
+        private:
+            MemoryMappedFile();
+
+            void
+            initialize(const std::string& filename, uint64_t offset, std::size_t length);
+
+            static
+            std::size_t
+            pageSize();
+        };
+    }
+}
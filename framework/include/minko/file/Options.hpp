@@ -72,13 +72,18 @@ namespace minko
             bool                                                _isCubeTexture;
             bool                                                _startAnimation;
             bool                                                _loadAsynchronously;
+            bool                                                _memoryMapFiles;
+            bool                                                _parseAsynchronously;
             bool                                                _disposeIndexBufferAfterLoading;
             bool                                                _disposeVertexBufferAfterLoading;
             bool                                                _disposeTextureAfterLoading;
             bool                                                _storeDataIfNotParsed;
             unsigned int                                        _skinningFramerate;
             component::SkinningMethod                            _skinningMethod;
+            float                                               _skinningCompressionTolerance;
             std::shared_ptr<render::Effect>                     _effect;
+            std::shared_ptr<render::ProgramCache>               _programCache;
+            std::shared_ptr<render::TextureStreamer>            _textureStreamer;
             MaterialPtr                                            _material;
             std::list<render::TextureFormat>                    _textureFormats;
             MaterialFunction                                    _materialFunction;
@@ -90,8 +95,8 @@ namespace minko
             EffectFunction                                        _effectFunction;
             TextureFormatFunction                               _textureFormatFunction;
 
-            int                                                 _seekingOffset;
-            int                                                 _seekedLength;
+            uint64_t                                            _seekingOffset;
+            uint64_t                                            _seekedLength;
 			
             static ProtocolFunction                                _defaultProtocolFunction;
 
@@ -138,7 +143,10 @@ namespace minko
                 opt->_disposeTextureAfterLoading = options->_disposeTextureAfterLoading;
                 opt->_skinningFramerate = options->_skinningFramerate;
                 opt->_skinningMethod = options->_skinningMethod;
+                opt->_skinningCompressionTolerance = options->_skinningCompressionTolerance;
                 opt->_effect = options->_effect;
+                opt->_programCache = options->_programCache;
+                opt->_textureStreamer = options->_textureStreamer;
                 opt->_materialFunction = options->_materialFunction;
                 opt->_geometryFunction = options->_geometryFunction;
                 opt->_protocolFunction = options->_protocolFunction;
@@ -146,6 +154,8 @@ namespace minko
                 opt->_uriFunction = options->_uriFunction;
                 opt->_nodeFunction = options->_nodeFunction;
                 opt->_loadAsynchronously = options->_loadAsynchronously;
+                opt->_memoryMapFiles = options->_memoryMapFiles;
+                opt->_parseAsynchronously = options->_parseAsynchronously;
 
                 return opt;
             }
@@ -251,6 +261,48 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            bool
+            memoryMapFiles() const
+            {
+                return _memoryMapFiles;
+            }
+
+            /**
+             * Makes FileProtocol map the files (or their seekingOffset/seekedLength range) in memory instead
+             * of reading them: parsers then read the bytes straight from the mapping, without any copy.
+             * Ignored on platforms without memory-mapped files.
+             */
+            inline
+            Ptr
+            memoryMapFiles(bool value)
+            {
+                _memoryMapFiles = value;
+
+                return shared_from_this();
+            }
+
+            inline
+            bool
+            parseAsynchronously() const
+            {
+                return _parseAsynchronously;
+            }
+
+            /**
+             * Makes the Loader decode the files whose parser is thread-safe on the workers of
+             * async::TaskScheduler::instance(). The resources are then created by main thread tasks of the
+             * scheduler: the canvas, or a JobManager, must run them every frame for the loading to complete.
+             */
+            inline
+            Ptr
+            parseAsynchronously(bool value)
+            {
+                _parseAsynchronously = value;
+
+                return shared_from_this();
+            }
+
             inline
             bool
             resizeSmoothly() const
@@ -379,6 +431,26 @@ namespace minko
                 return shared_from_this();
             }
 
+            /**
+             * When strictly positive, skins are stored as compressed keyframes reproducing the sampled
+             * bone matrices within this tolerance instead of one set of matrices per frame.
+             */
+            inline
+            float
+            skinningCompressionTolerance() const
+            {
+                return _skinningCompressionTolerance;
+            }
+
+            inline
+            Ptr
+            skinningCompressionTolerance(float value)
+            {
+                _skinningCompressionTolerance = value;
+
+                return shared_from_this();
+            }
+
             inline
             std::shared_ptr<render::Effect>
             effect() const
@@ -395,6 +467,46 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            std::shared_ptr<render::ProgramCache>
+            programCache() const
+            {
+                return _programCache;
+            }
+
+            /**
+             * The passes of the effects loaded with these options load their programs from and store them
+             * in cache, and build the variants it recorded for them as soon as they are loaded.
+             */
+            inline
+            Ptr
+            programCache(std::shared_ptr<render::ProgramCache> cache)
+            {
+                _programCache = cache;
+
+                return shared_from_this();
+            }
+
+            inline
+            std::shared_ptr<render::TextureStreamer>
+            textureStreamer() const
+            {
+                return _textureStreamer;
+            }
+
+            /**
+             * The mipmapped textures loaded with these options are registered to streamer: only their
+             * smallest mip levels are uploaded while loading, the streamer raises their resolution later.
+             */
+            inline
+            Ptr
+            textureStreamer(std::shared_ptr<render::TextureStreamer> streamer)
+            {
+                _textureStreamer = streamer;
+
+                return shared_from_this();
+            }
+
             inline
             MaterialPtr
             material() const
@@ -549,7 +661,7 @@ namespace minko
             }
 
             inline
-            int
+            uint64_t
 			seekingOffset() const
 			{
 				return _seekingOffset;
@@ -557,7 +669,7 @@ namespace minko
 
 			inline
 			Ptr
-			seekingOffset(int value)
+			seekingOffset(uint64_t value)
 			{
 				_seekingOffset = value;
 
@@ -565,7 +677,7 @@ namespace minko
 			}
 
             inline
-			int
+			uint64_t
 			seekedLength() const
 			{
 				return _seekedLength;
@@ -573,7 +685,7 @@ namespace minko
 
 			inline
 			Ptr
-			seekedLength(int value)
+			seekedLength(uint64_t value)
 			{
 				_seekedLength = value;
 
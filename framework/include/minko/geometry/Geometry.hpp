@@ -43,6 +43,7 @@ namespace minko
             unsigned int                                        _numVertices;
             std::list<VBPtr>                                    _vertexBuffers;
             std::shared_ptr<render::IndexBuffer>                _indexBuffer;
+            std::shared_ptr<TriangleBvh>                        _triangleBvh;
 
             std::unordered_map<VBPtr, Signal<VBPtr, int>::Slot> _vbToVertexSizeChangedSlot;
 
@@ -112,6 +113,7 @@ namespace minko
             indices(std::shared_ptr<render::IndexBuffer> indices)
             {
                 _indexBuffer = indices;
+                _triangleBvh = nullptr;
                 _data->set("indices", indices);
             }
 
@@ -160,6 +162,21 @@ namespace minko
                                      std::vector<std::vector<float>>&    vertices,
                                      uint                                numVertices);
 
+            /**
+             * Returns the hierarchy used by cast(), built on the first call from the CPU copy of the
+             * position and index buffers. It is reset when the vertex buffers or the indices change:
+             * call invalidateTriangleBvh() after editing the positions in place, as software skinning does.
+             */
+            std::shared_ptr<TriangleBvh>
+            triangleBvh();
+
+            inline
+            void
+            invalidateTriangleBvh()
+            {
+                _triangleBvh = nullptr;
+            }
+
             bool
             cast(std::shared_ptr<math::Ray>        ray,
                  float&                            distance,
@@ -168,6 +185,15 @@ namespace minko
                  std::shared_ptr<math::Vector2>    hitUv         = nullptr,
                  std::shared_ptr<math::Vector3>    hitNormal     = nullptr);
 
+            /**
+             * Casts all the rays at once. Missed rays get an infinite distance.
+             * Returns the number of rays that hit the geometry.
+             */
+            uint
+            cast(const std::vector<std::shared_ptr<math::Ray>>&   rays,
+                 std::vector<float>&                              distances,
+                 std::vector<uint>&                               triangles);
+
             void
             upload();
 
@@ -219,10 +245,10 @@ namespace minko
             removeVertexBuffer(std::list<VBPtr>::iterator vertexBufferIt);
 
             void
-            getHitUv(uint triangle, std::shared_ptr<math::Vector2> lambda, std::shared_ptr<math::Vector2> hitUv);
+            getHitUv(uint triangle, float u, float v, std::shared_ptr<math::Vector2> hitUv);
 
             void
-            getHitNormal(uint triangle, std::shared_ptr<math::Vector3> hitNormal);
+            getHitNormal(uint triangle, float u, float v, std::shared_ptr<math::Vector3> hitNormal);
         };
     }
 }
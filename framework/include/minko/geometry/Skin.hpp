@@ -37,13 +37,52 @@ namespace minko
             typedef std::shared_ptr<Bone>               BonePtr;
             typedef std::shared_ptr<math::Matrix4x4>    Matrix4x4Ptr;
 
+            // keyframes of a 3 components channel, values quantized to 16 bits over the [min, min + extent] box
+            struct Vector3Track
+            {
+                std::vector<unsigned short>             frames;
+                std::vector<unsigned short>             values;
+                float                                   min[3];
+                float                                   extent[3];
+            };
+
+            // keyframes of a rotation, quaternions quantized with the "smallest three" 64 bits encoding
+            struct RotationTrack
+            {
+                std::vector<unsigned short>             frames;
+                std::vector<uint64_t>                   values;
+            };
+
+            struct BoneTrack
+            {
+                Vector3Track                            translation;
+                RotationTrack                           rotation;
+                Vector3Track                            scale;
+            };
+
+            struct CachedPose
+            {
+                int                                     frameId;
+                uint                                    lastUse;
+                std::vector<float>                      matrices;
+            };
+
+            static const uint                           POSE_CACHE_SIZE;
+            static const float                          MIN_TRACK_TOLERANCE;
+
         private:
             const unsigned int                          _numBones;
             std::vector<BonePtr>                        _bones;
 
             const uint                                  _duration;               // in milliseconds
             const float                                 _timeFactor;
-            std::vector<std::vector<float>>             _boneMatricesPerFrame;
+            unsigned int                                _numFrames;
+            std::vector<std::vector<float>>             _boneMatricesPerFrame;   // empty once compressed
+            bool                                        _transposedMatrices;
+
+            std::vector<BoneTrack>                      _boneTracks;             // empty unless compressed
+            mutable std::vector<CachedPose>             _poseCache;              // not thread-safe
+            mutable uint                                _poseCacheClock;
 
             unsigned int                                _maxNumVertexBones;
             std::vector<unsigned int>                   _numVertexBones;         // size = #vertices
@@ -59,8 +98,8 @@ namespace minko
                 return std::shared_ptr<Skin>(new Skin(numBones, duration, numFrames));
             }
 
-			Ptr
-			clone();
+            Ptr
+            clone();
 
             inline
             unsigned int
@@ -84,13 +123,13 @@ namespace minko
             }
 
             inline
-			void
-			bones(std::vector<BonePtr> bones)
-			{
-				_bones = bones;
-			}
+            void
+            bones(std::vector<BonePtr> bones)
+            {
+                _bones = bones;
+            }
 
-			inline
+            inline
             BonePtr
             bone(unsigned int boneId) const
             {
@@ -118,30 +157,48 @@ namespace minko
             unsigned int
             numFrames() const
             {
-                return _boneMatricesPerFrame.size();
+                return _numFrames;
             }
 
+            void
+            setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame);
+
+            std::vector<std::vector<float>>
+            getBoneMatricesPerFrame();
+
+            /**
+             * The matrices of every bone for the given frame. Once compressed, they are evaluated from the
+             * keyframes and kept in a small cache: the returned reference stays valid until a few other
+             * frames are requested. That cache is not synchronized: a compressed skin must not be
+             * sampled from several threads at once.
+             */
             inline
-			void
-			setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame)
-			{
-				_boneMatricesPerFrame = boneMatricesPerFrame;
-			}
-
-			inline
-			std::vector<std::vector<float>>
-			getBoneMatricesPerFrame()
-			{
-				return _boneMatricesPerFrame;
-			}
-
-			inline
             const std::vector<float>&
             matrices(unsigned int frameId) const
             {
-                return _boneMatricesPerFrame[frameId];
+                return _boneTracks.empty() ? _boneMatricesPerFrame[frameId] : cachedPose(frameId);
             }
 
+            inline
+            bool
+            compressed() const
+            {
+                return !_boneTracks.empty();
+            }
+
+            /**
+             * Replaces the matrices sampled for every frame by translation, rotation and scale keyframes
+             * for each bone. Keyframes are only kept where interpolating linearly between their neighbours
+             * would move an element of a bone matrix by more than tolerance. Bone matrices must not have
+             * any shear.
+             */
+            Ptr
+            compress(float tolerance = 1e-3f);
+
+            // total number of translation, rotation and scale keyframes, once compressed
+            unsigned int
+            numKeyframes() const;
+
             void
             matrix(unsigned int frameId, unsigned int boneId, Matrix4x4Ptr);
 
@@ -184,11 +241,59 @@ namespace minko
         private:
             Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames);
 
-			Skin(const Skin& skin);
+            Skin(const Skin& skin);
 
             unsigned short
             lastVertexId() const;
 
+            const std::vector<float>&
+            cachedPose(unsigned int frameId) const;
+
+            void
+            evaluatePose(unsigned int frameId, float* matrices) const;
+
+            void
+            evaluateBone(unsigned int frameId, unsigned int boneId, float* matrix) const;
+
+            bool
+            boneTrackFits(unsigned int boneId, float tolerance) const;
+
+            static
+            void
+            decompose(const float* matrix, float* translation, float* rotation, float* scale);
+
+            static
+            void
+            compose(const float* translation, const float* rotation, const float* scale, float* matrix);
+
+            static
+            std::vector<unsigned short>
+            selectKeyframes(unsigned int numFrames, const std::function<bool(unsigned int, unsigned int, unsigned int)>& interpolates);
+
+            static
+            void
+            fitTrack(const std::vector<float>& values, Vector3Track& track, float tolerance);
+
+            static
+            void
+            fitTrack(const std::vector<float>& values, RotationTrack& track, float tolerance);
+
+            static
+            void
+            sampleTrack(const Vector3Track& track, unsigned int frameId, float* value);
+
+            static
+            void
+            sampleTrack(const RotationTrack& track, unsigned int frameId, float* value);
+
+            static
+            uint64_t
+            encodeRotation(const float* rotation);
+
+            static
+            void
+            decodeRotation(uint64_t encoded, float* rotation);
+
             inline
             unsigned int
             vertexArraysIndex(unsigned int vertexId, unsigned int j) const
@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        /**
+         * Bounding volume hierarchy over the triangles of an indexed mesh, used for ray casts.
+         * Triangles are stored by packets of 4 (vertex and edges in structure of arrays) so
+         * that each ray is tested against 4 triangles at once with SSE or NEON (see MINKO_SIMD).
+         *
+         * The hierarchy is a copy of the vertex data: it must be rebuilt when positions or indices change.
+         */
+        class TriangleBvh
+        {
+        public:
+            typedef std::shared_ptr<TriangleBvh> Ptr;
+
+        private:
+            static const uint MAX_LEAF_SIZE = 8;
+
+            struct Node
+            {
+                float   min[3];
+                float   max[3];
+                uint    offset;     // first packet for leaves, second child for inner nodes (first child is next)
+                uint    numPackets; // 0 for inner nodes
+            };
+
+            struct TrianglePacket
+            {
+                float   v0[3][4];
+                float   edge1[3][4];
+                float   edge2[3][4];
+                uint    triangle[4];
+            };
+
+        private:
+            std::vector<Node>                   _nodes;
+            std::vector<TrianglePacket>         _packets;
+            uint                                _numTriangles;
+
+        public:
+            /**
+             * Builds the hierarchy. The position of the i-th vertex is read at xyz[i * vertexSize].
+             * Triangles are identified by the offset of their first index, as in Geometry::cast().
+             */
+            inline static
+            Ptr
+            create(const float*                         xyz,
+                   uint                                 vertexSize,
+                   const std::vector<unsigned short>&   indices)
+            {
+                auto bvh = std::shared_ptr<TriangleBvh>(new TriangleBvh());
+
+                bvh->build(xyz, vertexSize, indices);
+
+                return bvh;
+            }
+
+            inline
+            uint
+            numTriangles() const
+            {
+                return _numTriangles;
+            }
+
+            inline
+            uint
+            numNodes() const
+            {
+                return _nodes.size();
+            }
+
+            /**
+             * Returns the closest intersection in front of the origin. The direction does not have
+             * to be normalized: distance is expressed in multiples of its length. u and v are the
+             * barycentric coordinates of the hit relative to the second and third vertices.
+             */
+            bool
+            cast(const float*   origin,
+                 const float*   direction,
+                 float&         distance,
+                 uint&          triangle,
+                 float&         u,
+                 float&         v) const;
+
+            /**
+             * Casts numRays rays stored as consecutive xyz triplets. Missed rays get an infinite distance.
+             * Returns the number of rays that hit the mesh.
+             */
+            uint
+            cast(const float*   origins,
+                 const float*   directions,
+                 uint           numRays,
+                 float*         distances,
+                 uint*          triangles) const;
+
+        private:
+            TriangleBvh() :
+                _numTriangles(0)
+            {
+            }
+
+            void
+            build(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices);
+
+            static
+            bool
+            intersectBox(const Node&    node,
+                         const float*   origin,
+                         const float*   invDirection,
+                         float          maxDistance,
+                         float&         distance);
+
+            bool
+            intersectPacket(const TrianglePacket&   packet,
+                            const float*            origin,
+                            const float*            direction,
+                            float&                  distance,
+                            uint&                   triangle,
+                            float&                  u,
+                            float&                  v) const;
+        };
+    }
+}
@@ -145,6 +145,14 @@ namespace minko
                 return prependTranslation(value->x(), value->y(), value->z());
             }
 
+            /**
+             * Computes out = a * b on raw row-major 4x4 matrices. out may alias a or b.
+             * Uses SSE or NEON when available (see MINKO_SIMD).
+             */
+            static
+            void
+            multiply(const float* a, const float* b, float* out);
+
             Ptr
             appendRotationX(float radians);
 
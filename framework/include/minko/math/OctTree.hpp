@@ -27,6 +27,14 @@ namespace minko
 {
     namespace math
     {
+        /**
+         * Dynamic loose octree. Each node is stored in the deepest octant whose cell contains the center
+         * of its world space bounding box and whose half size is at least the radius of that box: the
+         * octant bounds are loosened by a factor 2 so that they always contain their whole content.
+         *
+         * Nodes are (re)placed lazily by update() when they are inserted or when their
+         * transform.modelToWorldMatrix changes. The root octant grows to contain any world extent.
+         */
         class OctTree :
             public std::enable_shared_from_this<OctTree>
         {
@@ -34,29 +42,28 @@ namespace minko
             typedef std::shared_ptr<OctTree> Ptr;
 
         private:
-            typedef std::shared_ptr<scene::Node> NodePtr;
-
-        private:
-            static const uint _k = 2;
+            typedef std::shared_ptr<scene::Node>                                        NodePtr;
+            typedef std::shared_ptr<component::BoundingBox>                             BoundingBoxPtr;
+            typedef std::function<void(NodePtr)>                                        NodeCallback;
+            typedef std::function<void(NodePtr, float)>                                 RayCallback;
 
         private:
             uint                                                                        _maxDepth;
             uint                                                                        _depth;
             bool                                                                        _splitted;
-            Ptr                                                                         _parent;
+            OctTree*                                                                    _parent;
             std::vector<Ptr>                                                            _children; //x, y, z in {0, 1}, child index : x + y << 1 + z << 2
-            std::list<NodePtr>                                                          _content;
-            std::list<NodePtr>                                                          _childrenContent;
-            float                                                                       _worldSize;
+            std::vector<NodePtr>                                                        _content;
+            std::vector<BoundingBoxPtr>                                                 _contentBoxes;
+            uint                                                                        _numNodes; // in this octant and its descendants
+            float                                                                       _halfSize;
             std::shared_ptr<math::Vector3>                                              _center;
-            std::unordered_map<NodePtr, Ptr>                                            _nodeToOctant;
-            std::unordered_map<NodePtr, data::Container::PropertyChangedSignal::Slot>   _nodeToTransformChangedSlot;
-            std::unordered_map<std::shared_ptr<math::Matrix4x4>, NodePtr>               _matrixToNode;
             std::shared_ptr<math::Box>                                                  _octantBox;
 
-
-            bool _inside;
-            NodePtr debugNode;
+            // root octant only
+            std::unordered_map<NodePtr, OctTree*>                                       _nodeToOctant;
+            std::unordered_map<NodePtr, data::Container::PropertyChangedSignal::Slot>   _nodeToTransformChangedSlot;
+            std::unordered_set<NodePtr>                                                 _invalidNodes;
 
         public:
             inline static
@@ -75,41 +82,83 @@ namespace minko
             Ptr
             remove(NodePtr node);
 
+            inline
+            bool
+            hasNode(NodePtr node) const
+            {
+                return _nodeToTransformChangedSlot.count(node) != 0;
+            }
+
+            inline
             uint
-            computeDepth(NodePtr node);
+            numNodes() const
+            {
+                return _numNodes + _invalidNodes.size();
+            }
+
+            /**
+             * Places the nodes inserted or moved since the last call. Called by testFrustum().
+             */
+            void
+            update();
 
             NodePtr
             generateVisual(std::shared_ptr<file::AssetLibrary>              assetLibrary,
                            NodePtr                                          rootNode = nullptr);
 
-            uint
-            testFrustum(std::shared_ptr<math::Frustum>                      frustum);
+            void
+            testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
+                        std::function<void(std::shared_ptr<scene::Node>)>   insideFrustumCallback);
 
             void
             testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
                         std::function<void(std::shared_ptr<scene::Node>)>   insideFrustumCallback,
                         std::function<void(std::shared_ptr<scene::Node>)>   outsideFustumCallback);
 
+            /**
+             * Calls hitCallback with each node whose world space bounding box is hit by the ray, along
+             * with the distance to that box. Nodes are not sorted.
+             */
+            void
+            testRay(std::shared_ptr<math::Ray>                          ray,
+                    std::function<void(NodePtr, float)>                 hitCallback);
+
         private:
+            void
+            place(NodePtr node);
+
+            void
+            detach(NodePtr node, OctTree* octant);
 
             bool
-            nodeChangedOctant(NodePtr node);
+            fits(const std::shared_ptr<math::Box>& box, float radius) const;
+
+            void
+            grow(const std::shared_ptr<math::Box>& box);
 
             void
-            nodeModelToWorldChanged(std::shared_ptr<data::Container>        data,
-                                    const std::string&                      propertyName);
+            shiftDepth();
 
             void
             split();
 
-            float
-            computeRadius(std::shared_ptr<component::BoundingBox>           boundingBox);
+            void
+            visit(std::shared_ptr<math::AbstractShape>                      frustum,
+                  const NodeCallback&                                       insideFrustumCallback,
+                  const NodeCallback&                                       outsideFustumCallback);
 
             void
-            addChildContent(NodePtr                                         node);
+            visit(std::shared_ptr<math::Ray>                                ray,
+                  const RayCallback&                                        hitCallback);
 
             void
-            removeChildContent(NodePtr                                      node);
+            forEachNode(const NodeCallback&                                 callback);
+
+            void
+            updateOctantBox();
+
+            float
+            computeRadius(std::shared_ptr<math::Box>                        box);
 
             float
             edgeLength();
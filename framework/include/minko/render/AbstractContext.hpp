@@ -92,6 +92,18 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles) = 0;
 
+            virtual
+            bool
+            supportsInstancing() = 0;
+
+            virtual
+            void
+            drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances) = 0;
+
+            virtual
+            void
+            setVertexAttributeDivisor(const uint position, const uint divisor) = 0;
+
             virtual
             const uint
             createVertexBuffer(const uint size) = 0;
@@ -220,6 +232,22 @@ namespace minko
             void
             deleteProgram(const uint program) = 0;
 
+            /**
+             * Copies the driver specific binary of a linked program. Returns false when program binaries
+             * are not supported.
+             */
+            virtual
+            bool
+            getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary) = 0;
+
+            /**
+             * Links program from a binary returned by getProgramBinary(). Returns false when the binary
+             * is rejected, for instance after a driver update: the program must then be built from sources.
+             */
+            virtual
+            bool
+            setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary) = 0;
+
             virtual void
             setProgram(const uint program) = 0;
 
@@ -356,6 +384,22 @@ namespace minko
             void
             readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels) = 0;
 
+            /**
+             * Starts reading back a region of the current render target without waiting for the GPU to
+             * complete the commands that render it. The returned id must be passed to readPixelsAsyncResult().
+             */
+            virtual
+            uint
+            readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height) = 0;
+
+            /**
+             * Copies the RGBA pixels of a read started with readPixelsAsync() and releases it. Returns
+             * false, leaving pixels untouched, as long as the read is not complete yet.
+             */
+            virtual
+            bool
+            readPixelsAsyncResult(uint read, unsigned char* pixels) = 0;
+
             virtual
             void
             setTriangleCulling(TriangleCulling triangleCulling) = 0;
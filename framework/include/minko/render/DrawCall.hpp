@@ -44,6 +44,24 @@ namespace minko
         public:
             typedef std::shared_ptr<DrawCall>                               Ptr;
 
+            // program input resolved against the bindings of a pass, before property names are formatted
+            struct InputBinding
+            {
+                ProgramInputs::Type                 type;
+                std::string                         inputName;
+                std::string                         propertyName;
+                std::string                         arraySuffix;    // "[i].member" part of GLSL struct array uniforms
+                bool                                formatted;      // the property name still contains "${...}" variables
+                data::PropertyId                    propertyId;     // interned property name + array suffix when not formatted
+                data::BindingSource                 source;
+                int                                 location;
+                uint                                index;          // vertex buffer or texture index
+                SamplerState                        samplerState;
+            };
+
+            typedef std::vector<InputBinding>                               InputBindings;
+            typedef std::shared_ptr<const InputBindings>                    InputBindingsPtr;
+
         private:
             enum class ContainerId{ COMPLETE = 0, FILTERED };
 
@@ -60,11 +78,35 @@ namespace minko
             typedef std::tuple<int, int, int>                               Int3;
             typedef std::tuple<int, int, int, int>                          Int4;
 
+            enum class UniformSource
+            {
+                VALUE,          // copied in the draw call uniform values when bound
+                VECTOR,         // read from a math::Vector2/3/4 before each upload
+                MATRIX,         // read from a math::Matrix4x4 before each upload
+                FLOAT_ARRAY,
+                INT_ARRAY
+            };
+
+            // one uniform upload, replayed in order by render()
+            struct UniformCommand
+            {
+                ProgramInputs::Type                 type;
+                UniformSource                       source;
+                int                                 location;
+                uint                                offset;     // first component in _uniformFloatValues or _uniformIntValues
+                bool                                dirty;
+                std::shared_ptr<math::Vector2>      vector;
+                const float*                        matrix;
+                data::UniformArrayPtr<float>        floatArray;
+                data::UniformArrayPtr<int>          intArray;
+            };
+
         private:
             static const unsigned int                                       MAX_NUM_TEXTURES;
             static const unsigned int                                       MAX_NUM_VERTEXBUFFERS;
 
             static SamplerState                                             _defaultSamplerState;
+            static uint                                                     _lastUniformsStamp;
 
             std::shared_ptr<render::Pass>                                   _pass;
 
@@ -78,6 +120,7 @@ namespace minko
             std::shared_ptr<data::Container>                                _fullRootData;
 
             std::shared_ptr<Program>                                        _program;
+            InputBindingsPtr                                                _inputBindings;
 
             std::list<Signal<ContainerPtr, ProviderPtr>::Slot>              _containerUpdateSlots;
 
@@ -88,7 +131,9 @@ namespace minko
             std::vector<int>                                                _vertexSizes;
             std::vector<int>                                                _vertexAttributeSizes;
             std::vector<int>                                                _vertexAttributeOffsets;
+            std::vector<uint>                                               _vertexAttributeDivisors;
             std::vector<int>                                                _textureIds;
+            std::vector<AbsTexturePtr>                                      _textures;
             std::vector<int>                                                _textureLocations;
             std::vector<WrapMode>                                           _textureWrapMode;
             std::vector<TextureFilter>                                      _textureFilters;
@@ -96,6 +141,8 @@ namespace minko
             std::vector<TextureType>                                        _textureTypes;
             uint                                                            _numIndices;
             uint                                                            _indexBuffer;
+            uint                                                            _numInstances;
+            bool                                                            _culled;
             AbsTexturePtr                                                   _target;
             render::Blending::Mode                                          _blendMode;
             bool                                                            _colorMask;
@@ -113,30 +160,18 @@ namespace minko
             Layouts                                                         _layouts;
             float                                                           _priority;
             bool                                                            _zsorted;
-            std::unordered_map<uint, float>                                 _uniformFloat;
-            std::unordered_map<uint, std::shared_ptr<math::Vector2>>        _uniformFloat2;
-            std::unordered_map<uint, std::shared_ptr<math::Vector3>>        _uniformFloat3;
-            std::unordered_map<uint, std::shared_ptr<math::Vector4>>        _uniformFloat4;
-            std::unordered_map<uint, const float*>                          _uniformFloat16;
-            std::unordered_map<uint, int>                                   _uniformInt;
-            std::unordered_map<uint, Int2>                                  _uniformInt2;
-            std::unordered_map<uint, Int3>                                  _uniformInt3;
-            std::unordered_map<uint, Int4>                                  _uniformInt4;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats2;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats3;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats4;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats16;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts2;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts3;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts4;
+            std::vector<UniformCommand>                                     _uniformCommands;
+            std::unordered_map<int, uint>                                   _locationToUniformCommand;
+            std::vector<float>                                              _uniformFloatValues;
+            std::vector<int>                                                _uniformIntValues;
+            uint                                                            _uniformsStamp;
 
             std::unordered_map<std::string, std::list<Any>>                                           _referenceChangedSlots;        // Any = PropertyChangedSlot
             std::list<PropertyChangedSlot>                                                            _macroAddedOrRemovedSlots;
             std::unordered_map<ContainerPtr, std::unordered_map<std::string, PropertyChangedSlot>>    _macroChangedSlots;            // Any = PropertyChangedSlot
             Signal<std::shared_ptr<IndexBuffer>>::Slot                                                _indicesChangedSlot;
             Signal<ContainerPtr, const std::string&>::Slot                                            _layoutsPropertyChangedSlot;
+            Signal<ContainerPtr, const std::string&>::Slot                                            _numInstancesChangedSlot;
 
             Signal<Ptr>::Ptr                                                _zsortNeeded;
             Signal<Ptr, ContainerPtr, const std::string&>::Ptr              _macroChanged;
@@ -223,6 +258,78 @@ namespace minko
                 return _layouts;
             }
 
+            inline
+            ProgramPtr
+            program() const
+            {
+                return _program;
+            }
+
+            inline
+            InputBindingsPtr
+            inputBindings() const
+            {
+                return _inputBindings;
+            }
+
+            inline
+            const std::vector<int>&
+            textureIds() const
+            {
+                return _textureIds;
+            }
+
+            inline
+            const std::vector<AbsTexturePtr>&
+            textures() const
+            {
+                return _textures;
+            }
+
+            inline
+            render::Blending::Mode
+            blendMode() const
+            {
+                return _blendMode;
+            }
+
+            inline
+            bool
+            depthMask() const
+            {
+                return _depthMask;
+            }
+
+            inline
+            render::CompareMode
+            depthFunc() const
+            {
+                return _depthFunc;
+            }
+
+            // number of instances drawn at once, 0 when the draw call is not instanced
+            inline
+            uint
+            numInstances() const
+            {
+                return _numInstances;
+            }
+
+            // culled draw calls are skipped by the renderer but keep their state and bindings
+            inline
+            bool
+            culled() const
+            {
+                return _culled;
+            }
+
+            inline
+            void
+            culled(bool value)
+            {
+                _culled = value;
+            }
+
             inline
             bool
             zSorted() const
@@ -231,23 +338,35 @@ namespace minko
             }
 
 
+            // the input bindings only depend on the pass, the program and the property name formatting:
+            // draw calls sharing all three can share them (see DrawCallPool), they are resolved again
+            // when none are provided
             void
             configure(ProgramPtr,
                       FormatNameFunction,
-                      ContainerPtr    fullTargetData, // original containers
-                      ContainerPtr    fullRendererData,
-                      ContainerPtr    fullRootData,
-                      ContainerPtr    targetData, // filtered containers
-                      ContainerPtr    rendererData,
-                      ContainerPtr    rootData);
+                      ContainerPtr      fullTargetData, // original containers
+                      ContainerPtr      fullRendererData,
+                      ContainerPtr      fullRootData,
+                      ContainerPtr      targetData, // filtered containers
+                      ContainerPtr      rendererData,
+                      ContainerPtr      rootData,
+                      InputBindingsPtr  inputBindings = nullptr);
+
+            // property names with variables are formatted and interned once when a formatting function is provided
+            static
+            InputBindingsPtr
+            resolveInputBindings(std::shared_ptr<Pass>, ProgramPtr, FormatNameFunction = nullptr);
 
             void
             unbind();
 
+            // previous is the draw call rendered right before this one on the same context, if any:
+            // the program, texture, vertex buffer and state calls it already issued are skipped
             void
             render(const std::shared_ptr<AbstractContext>&  context,
                    AbsTexturePtr                            renderTarget,
-                   const render::ScissorBox&                viewport);
+                   const render::ScissorBox&                viewport,
+                   const Ptr&                               previous = nullptr);
 
             void
             initialize(ContainerPtr                                 data,
@@ -289,6 +408,18 @@ namespace minko
             void
             trackMacros();
 
+            void
+            drawInstances(const AbsCtxPtr&);
+
+            void
+            setVertexAttributeDivisors(const AbsCtxPtr&, bool enabled);
+
+            bool
+            hasSameTextures(const DrawCall&) const;
+
+            bool
+            hasSameVertexAttributes(const DrawCall&) const;
+
             void
             bindProgramDefaultUniforms();
 
@@ -298,6 +429,9 @@ namespace minko
             void
             bindIndexBuffer();
 
+            void
+            bindInstancing();
+
             void
             bindTargetLayouts();
 
@@ -305,13 +439,25 @@ namespace minko
             bindStates();
 
             void
-            bindVertexAttribute(const std::string& propertyName, int location, uint vertexBufferIndex);
+            bindVertexAttribute(const InputBinding&);
+
+            void
+            bindTextureSampler(const InputBinding&);
+
+            void
+            bindUniform(const InputBinding&);
+
+            void
+            bindUniformValue(const InputBinding&, const data::PropertyId&);
+
+            UniformCommand&
+            getUniformCommand(int location, ProgramInputs::Type, UniformSource);
 
             void
-            bindTextureSampler(const std::string& propertyName, int location, uint textureIndex, const SamplerState&);
+            uploadUniforms(const AbsCtxPtr&);
 
             void
-            bindUniform(const std::string& propertyName, ProgramInputs::Type, int location);
+            uploadUniform(const AbsCtxPtr&, const UniformCommand&);
 
             void
             bindUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
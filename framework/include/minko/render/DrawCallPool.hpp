@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
+#include "minko/scene/Layout.hpp"
+#include "minko/render/DrawCall.hpp"
 
 namespace std
 {
@@ -61,6 +63,58 @@ namespace minko
             typedef std::shared_ptr<scene::Node>                                                        NodePtr;
             typedef std::shared_ptr<data::ArrayProvider>                                                ArrayProviderPtr;
             typedef std::shared_ptr<data::AbstractFilter>                                               AbstractFilterPtr;
+            typedef std::shared_ptr<data::StructureProvider>                                            StructureProviderPtr;
+            typedef std::shared_ptr<render::VertexBuffer>                                               VertexBufferPtr;
+            typedef std::shared_ptr<geometry::Geometry>                                                 GeometryPtr;
+            typedef std::shared_ptr<material::Material>                                                 MaterialPtr;
+            typedef std::shared_ptr<render::Effect>                                                     EffectPtr;
+            typedef std::shared_ptr<data::Provider>                                                     ProviderPtr;
+
+            // only the transform is instanced: the other providers of the instances must be shared
+            typedef std::tuple<GeometryPtr, MaterialPtr, EffectPtr, std::string, Layouts, std::vector<ProviderPtr>>
+                                                                                                        InstanceBatchKey;
+
+            // surfaces rendered by a single instanced draw call, generated for the leader surface only
+            struct InstanceBatch
+            {
+                InstanceBatchKey                                                                        key;
+                SurfacePtr                                                                              leader;
+                std::vector<SurfacePtr>                                                                 surfaces;
+                StructureProviderPtr                                                                    provider;
+                VertexBufferPtr                                                                         matrices;
+            };
+
+            typedef std::shared_ptr<InstanceBatch>                                                      InstanceBatchPtr;
+
+            // an instance leaves its batch when its key changes, and marks it dirty when its transform changes
+            struct InstanceSlots
+            {
+                Signal<NodePtr, NodePtr>::Slot                                                          layoutsChanged;
+                Signal<ContainerPtr, ProviderPtr>::Slot                                                 providerAdded;
+                Signal<ContainerPtr, ProviderPtr>::Slot                                                 providerRemoved;
+                Signal<ContainerPtr, const std::string&>::Slot                                          transformChanged;
+            };
+
+            typedef std::tuple<const render::Pass*, int, int>                                           DrawCallTemplateKey; // pass, geometryId, materialId
+            typedef std::list<DrawCallPtr>::iterator                                                    DrawCallIterator;
+
+            // program selected for one set of macro values, with the input bindings of its draw calls
+            struct DrawCallVariant
+            {
+                std::weak_ptr<render::Program>                                                          program;
+                DrawCall::InputBindingsPtr                                                              inputBindings;
+                std::list<std::string>                                                                  integerMacros;
+                std::list<std::string>                                                                  incorrectIntegerMacros;
+            };
+
+            // shared by the draw calls of a pass whose property names are formatted with the same ids:
+            // the macro properties are resolved once, and a program is selected once per set of macro values
+            struct DrawCallTemplate
+            {
+                std::weak_ptr<render::Pass>                                                             pass;
+                std::vector<data::PropertyId>                                                           macroPropertyIds;
+                std::map<std::vector<int>, DrawCallVariant>                                             variants;
+            };
 
             typedef std::unordered_set<std::string>                                                     Techniques;
 
@@ -82,12 +136,16 @@ namespace minko
             // surface that will generate new draw call next frame
             std::set<SurfacePtr>                                                                        _toCollect;
             std::set<SurfacePtr>                                                                        _toRemove;
+            // the draw calls of invisible surfaces are parked: kept up to date but not rendered
             std::set<SurfacePtr>                                                                        _invisibleSurfaces;
+            std::unordered_set<SurfacePtr>                                                              _culledSurfaces;
 
             std::unordered_map<SurfacePtr, std::list<DrawCallPtr>>                                      _surfaceToDrawCalls;
             std::unordered_map<DrawCallPtr, SurfacePtr>                                                 _drawcallToSurface;
             std::unordered_map<DrawCallPtr, DrawCallMacroChanged::Slot>                                 _drawcallToMacroChangedSlot;
             std::unordered_map<DrawCallPtr, ZSortNeeded::Slot>                                          _drawcallToZSortNeededSlot;
+            // position of the rendered draw calls in _drawCalls, parked draw calls have none
+            std::unordered_map<DrawCallPtr, DrawCallIterator>                                           _drawcallToIterator;
             std::unordered_map<SurfacePtr, ContainerPtr>                                                _surfaceToRootContainer;
             std::unordered_map<SurfacePtr, uint>                                                        _surfaceToMaterialProviderIndex;
             std::list<DrawCallPtr>                                                                      _drawCalls;
@@ -95,6 +153,24 @@ namespace minko
             std::set<DrawCallPtr>                                                                       _dirtyDrawCalls;
             bool                                                                                        _mustZSort; // forces z-sorting at next frame
 
+            DrawCallSortMode                                                                            _sortMode;
+            std::vector<DrawCallIterator>                                                               _sortedDrawCalls;
+            std::vector<float>                                                                          _sortPriorities;
+            std::vector<uint64_t>                                                                       _sortKeys;
+            std::vector<uint64_t>                                                                       _sortKeysBuffer;
+            std::vector<uint>                                                                           _sortIndices;
+            std::vector<uint>                                                                           _sortIndicesBuffer;
+
+            bool                                                                                        _instancing;
+            std::map<InstanceBatchKey, InstanceBatchPtr>                                                _instanceBatches;
+            std::unordered_map<SurfacePtr, InstanceBatchPtr>                                            _surfaceToInstanceBatch;
+            std::unordered_map<SurfacePtr, InstanceSlots>                                               _surfaceToInstanceSlots;
+            std::unordered_set<InstanceBatchPtr>                                                        _dirtyInstanceBatches;
+
+            std::map<DrawCallTemplateKey, DrawCallTemplate>                                             _drawCallTemplates;
+            std::vector<int>                                                                            _macroValues;
+            bool                                                                                        _mustPurgeTemplates;
+
             std::unordered_map<SurfacePtr, TechniqueChanged::Slot>                                      _surfaceToTechniqueChangedSlot;
             std::unordered_multimap<SurfacePtr, VisibilityChanged::Slot>                                _surfaceToVisibilityChangedSlots;
             std::unordered_multimap<SurfacePtr, ArrayIndexChanged::Slot>                                _surfaceToIndexChangedSlots;
@@ -119,12 +195,51 @@ namespace minko
             const std::list<std::shared_ptr<DrawCall>>&
             drawCalls();
 
+            inline
+            DrawCallSortMode
+            sortMode() const
+            {
+                return _sortMode;
+            }
+
+            void
+            sortMode(DrawCallSortMode);
+
+            inline
+            bool
+            instancing() const
+            {
+                return _instancing;
+            }
+
+            void
+            instancing(bool);
+
+            inline
+            SurfacePtr
+            surface(DrawCallPtr drawCall) const
+            {
+                auto surfaceIt = _drawcallToSurface.find(drawCall);
+
+                return surfaceIt != _drawcallToSurface.end() ? surfaceIt->second : nullptr;
+            }
+
             void
             addSurface(SurfacePtr);
 
             void
             removeSurface(SurfacePtr);
 
+            inline
+            bool
+            culled(SurfacePtr surface) const
+            {
+                return _culledSurfaces.count(surface) != 0;
+            }
+
+            void
+            culled(SurfacePtr, bool);
+
         private:
             explicit
             DrawCallPool(RendererPtr renderer);
@@ -138,9 +253,10 @@ namespace minko
                                PassPtr,
                                DrawCallPtr = nullptr);
 
-            std::shared_ptr<Program>
+            const DrawCallVariant&
             getWorkingProgram(SurfacePtr,
                               PassPtr,
+                              DrawCallTemplate&,
                               FormatNameFunction,
                               ContainerPtr fullTargetData,
                               ContainerPtr fullRendererData,
@@ -149,6 +265,20 @@ namespace minko
                               ContainerPtr rendererData,
                               ContainerPtr rootData);
 
+            DrawCallTemplate&
+            getDrawCallTemplate(PassPtr, int geometryId, int materialId, FormatNameFunction);
+
+            const DrawCallVariant&
+            getDrawCallVariant(PassPtr,
+                               DrawCallTemplate&,
+                               FormatNameFunction,
+                               ContainerPtr targetData,
+                               ContainerPtr rendererData,
+                               ContainerPtr rootData);
+
+            void
+            purgeDrawCallTemplates();
+
             std::list<DrawCallPtr>&
             generateDrawCall(SurfacePtr, unsigned int numAttempts);
 
@@ -158,9 +288,42 @@ namespace minko
             void
             deleteDrawCalls(SurfacePtr);
 
+            void
+            insertDrawCall(DrawCallPtr);
+
+            void
+            eraseDrawCall(DrawCallPtr);
+
+            void
+            parkDrawCalls(SurfacePtr);
+
+            void
+            unparkDrawCalls(SurfacePtr);
+
             void
             cleanSurface(SurfacePtr);
 
+            bool
+            collectInstance(SurfacePtr);
+
+            void
+            removeInstance(SurfacePtr);
+
+            InstanceBatchKey
+            getInstanceBatchKey(SurfacePtr);
+
+            void
+            watchInstance(SurfacePtr);
+
+            void
+            instanceKeyChangedHandler(SurfacePtr);
+
+            bool
+            canBeInstanced(SurfacePtr);
+
+            void
+            updateInstanceBatch(InstanceBatchPtr);
+
             void
             techniqueChangedHandler(SurfacePtr, const std::string& technique, bool updateDrawCall);
 
@@ -196,6 +359,20 @@ namespace minko
             static
             bool
             compareDrawCalls(DrawCallPtr, DrawCallPtr);
+
+            void
+            sortDrawCallsByState();
+
+            static
+            uint64_t
+            getDrawCallStateKey(DrawCallPtr, uint priorityRank);
+
+            static
+            void
+            radixSort(std::vector<uint64_t>&    keys,
+                      std::vector<uint>&        indices,
+                      std::vector<uint64_t>&    keysBuffer,
+                      std::vector<uint>&        indicesBuffer);
         };
     }
 }
@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /**
+         * Resamples RGBA images and generates their mip chains on the CPU. Images are filtered in linear
+         * space, as two separable passes vectorized over the 4 channels of each pixel and split over rows
+         * between the threads of async::ThreadPool::instance(). sRGB images are converted to linear space
+         * before filtering and back to sRGB afterwards. Nearest resizing copies the texels as they are.
+         */
+        class ImageResampler
+        {
+        public:
+            enum class Filter
+            {
+                NEAREST,
+                LINEAR,
+                BOX,
+                KAISER
+            };
+
+        private:
+            // the source pixels and weights of each pixel of a resampled row or column
+            struct Kernel
+            {
+                std::vector<uint>   firsts;
+                std::vector<uint>   sizes;
+                std::vector<uint>   offsets;
+                std::vector<float>  weights;
+            };
+
+        private:
+            static const uint       GRAIN_SIZE;
+            static const float      KAISER_RADIUS;
+            static const float      KAISER_ALPHA;
+
+        public:
+            /**
+             * Resizes the width x height RGBA image data to newWidth x newHeight pixels in newData.
+             * Alpha is filtered as any other channel: it might not be a coverage.
+             */
+            static
+            void
+            resize(uint                         width,
+                   uint                         height,
+                   const unsigned char*         data,
+                   uint                         newWidth,
+                   uint                         newHeight,
+                   Filter                       filter,
+                   bool                         sRGB,
+                   std::vector<unsigned char>&  newData);
+
+            /**
+             * Appends all the mip levels of the width x height RGBA image data to mipChain, from the image
+             * itself down to 1x1, and returns their number. Each level is filtered from the previous one.
+             * When alpha is a coverage, premultiplyAlpha filters the colors with premultiplied alpha so
+             * that transparent pixels do not bleed into their neighbours.
+             */
+            static
+            uint
+            generateMipChain(uint                           width,
+                             uint                           height,
+                             const unsigned char*           data,
+                             Filter                         filter,
+                             bool                           sRGB,
+                             std::vector<unsigned char>&    mipChain,
+                             bool                           premultiplyAlpha = false);
+
+            static
+            uint
+            numMipLevels(uint width, uint height);
+
+        private:
+            static
+            void
+            resizeNearest(uint                  width,
+                          uint                  height,
+                          const unsigned char*  data,
+                          uint                  newWidth,
+                          uint                  newHeight,
+                          unsigned char*        newData);
+
+            static
+            void
+            decode(uint                     width,
+                   uint                     height,
+                   const unsigned char*     data,
+                   bool                     sRGB,
+                   bool                     premultiplyAlpha,
+                   std::vector<float>&      pixels);
+
+            static
+            void
+            encode(uint                         width,
+                   uint                         height,
+                   const std::vector<float>&    pixels,
+                   bool                         sRGB,
+                   bool                         premultiplyAlpha,
+                   unsigned char*               data);
+
+            static
+            void
+            resample(uint                       width,
+                     uint                       height,
+                     const std::vector<float>&  pixels,
+                     uint                       newWidth,
+                     uint                       newHeight,
+                     Filter                     filter,
+                     std::vector<float>&        newPixels);
+
+            static
+            void
+            computeKernel(uint size, uint newSize, Filter filter, Kernel& kernel);
+
+            static
+            float
+            filterWeight(Filter filter, float x, float radius);
+
+            static
+            uint
+            grainSize(uint width);
+        };
+    }
+}
@@ -43,6 +43,18 @@ namespace minko
             typedef std::unordered_map<unsigned int, unsigned int>        TextureToBufferMap;
             typedef std::pair<uint, uint>                                TextureSize;
 
+            struct PixelRead
+            {
+                uint                        x;
+                uint                        y;
+                uint                        width;
+                uint                        height;
+                uint                        target;
+                uint                        buffer;
+                void*                       fence;
+                std::vector<unsigned char>  pixels;
+            };
+
         protected:
             static BlendFactorsMap                    _blendingFactors;
             static CompareFuncsMap                    _compareFuncs;
@@ -84,6 +96,12 @@ namespace minko
             std::vector<int>                          _currentVertexSize;
             std::vector<int>                          _currentVertexStride;
             std::vector<int>                          _currentVertexOffset;
+            std::vector<uint>                         _currentVertexDivisor;
+            bool                                      _instancingSupported;
+            bool                                      _pixelPackBufferSupported;
+            bool                                      _programBinarySupported;
+            uint                                      _nextPixelRead;
+            std::unordered_map<uint, PixelRead>       _pixelReads;
             uint                                      _currentBoundTexture;
             std::vector<int>                          _currentTexture;
             std::unordered_map<uint, WrapMode>        _currentWrapMode;
@@ -186,6 +204,19 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles);
 
+            inline
+            bool
+            supportsInstancing()
+            {
+                return _instancingSupported;
+            }
+
+            void
+            drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
+            void
+            setVertexAttributeDivisor(const uint position, const uint divisor);
+
             const uint
             createVertexBuffer(const uint size);
 
@@ -293,6 +324,12 @@ namespace minko
             void
             deleteProgram(const uint program);
 
+            bool
+            getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary);
+
+            bool
+            setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary);
+
             void
             compileShader(const uint shader);
 
@@ -405,6 +442,12 @@ namespace minko
             void
             readPixels(unsigned char* pixels);
 
+            uint
+            readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+
+            bool
+            readPixelsAsyncResult(uint read, unsigned char* pixels);
+
             void
             setTriangleCulling(TriangleCulling triangleCulling);
 
@@ -59,6 +59,8 @@ namespace minko
             data::BindingMap                        _uniformBindings;
             data::BindingMap                        _stateBindings;
             data::MacroBindingMap                   _macroBindings;
+            // interned macro property names in _macroBindings order, default when the name has to be formatted
+            std::vector<data::PropertyId>           _macroPropertyIds;
             StatesPtr                               _states;
             std::string                             _fallback;
             SignatureProgramMap                     _signatureToProgram;
@@ -69,6 +71,8 @@ namespace minko
             std::set<std::string>                   _undefinedMacros;
             std::set<std::string>                   _definedBoolMacros;
             std::unordered_map<std::string, int>    _definedIntMacros;
+            std::shared_ptr<ProgramCache>           _programCache;
+            uint64_t                                _programSourceHash;
 
         public:
             inline static
@@ -114,6 +118,8 @@ namespace minko
                 p->_uniformFunctions = pass->_uniformFunctions;
                 p->_attributeFunctions = pass->_attributeFunctions;
                 p->_indexFunction = pass->_indexFunction;
+                p->_programCache = pass->_programCache;
+                p->_programSourceHash = pass->_programSourceHash;
 
                 if (pass->_programTemplate->isReady())
                 {
@@ -170,6 +176,13 @@ namespace minko
                 return _macroBindings;
             }
 
+            inline
+            const std::vector<data::PropertyId>&
+            macroPropertyIds() const
+            {
+                return _macroPropertyIds;
+            }
+
             inline
             StatesPtr
             states() const
@@ -184,6 +197,27 @@ namespace minko
                 return _fallback;
             }
 
+            inline
+            std::shared_ptr<ProgramCache>
+            programCache() const
+            {
+                return _programCache;
+            }
+
+            /**
+             * Programs are then loaded from and stored in cache. Must be set once the sources of the
+             * shaders are final.
+             */
+            void
+            programCache(std::shared_ptr<ProgramCache> cache);
+
+            /**
+             * Builds the programs of all the variants the program cache recorded for this pass, so that
+             * selectProgram() does not have to compile them when they are first needed.
+             */
+            void
+            prewarm();
+
             std::shared_ptr<Program>
             selectProgram(FormatNameFunction,
                           std::shared_ptr<data::Container>   targetData,
@@ -302,7 +336,10 @@ namespace minko
             }
 
             ProgramPtr
-            finalizeProgram(ProgramPtr program);
+            createProgram(const std::string& defines);
+
+            ProgramPtr
+            finalizeProgram(ProgramPtr program, const ProgramSignature& signature, const std::string& defines);
         };
 
         template <>
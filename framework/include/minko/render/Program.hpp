@@ -61,6 +61,8 @@ namespace minko
             std::unordered_map<int, VertexBufferPtr>            _vertexBuffers;
             IndexBufferPtr                                      _indexBuffer;
 
+            uint                                                _uniformsStamp;
+
         public:
             inline static
             Ptr
@@ -176,9 +178,31 @@ namespace minko
                 return _indexBuffer;
             }
 
+            // identifies the draw call whose uniform values were uploaded last, 0 when unknown
+            inline
+            uint
+            uniformsStamp() const
+            {
+                return _uniformsStamp;
+            }
+
+            inline
+            void
+            uniformsStamp(uint value)
+            {
+                _uniformsStamp = value;
+            }
+
             void
             upload();
 
+            /**
+             * Links the program from a binary returned by AbstractContext::getProgramBinary() instead of
+             * its shaders. Returns false, leaving the program not ready, when the driver rejects it.
+             */
+            bool
+            upload(uint binaryFormat, const std::vector<unsigned char>& binary);
+
             void
             dispose();
 
@@ -193,6 +217,7 @@ namespace minko
 
                 _context->setProgram(_id);
                 _context->setUniform(_inputs->location(name), values...);
+                _uniformsStamp = 0;
                 _context->setProgram(oldProgram);
             }
 
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/render/ProgramSignature.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /**
+         * Keeps the binaries of the programs built by the passes that use it in a file, so that they are
+         * not compiled and linked again on the next launches. Each program is identified by the hash of
+         * the sources of its pass and by its macro definitions. The ProgramSignature of each variant is
+         * recorded along with its binary, so that a pass can build all the variants it used in the past
+         * while loading (see Pass::prewarm()) instead of on the first frame that needs them.
+         *
+         * Binaries are dropped when the driver info of the context changes, but the variants are kept
+         * and will be built from sources, then stored again.
+         */
+        class ProgramCache
+        {
+        public:
+            typedef std::shared_ptr<ProgramCache>                       Ptr;
+            typedef std::pair<ProgramSignature, std::string>            Variant;
+
+        private:
+            typedef std::shared_ptr<AbstractContext>                    ContextPtr;
+            typedef std::shared_ptr<Program>                            ProgramPtr;
+
+            struct Entry
+            {
+                uint64_t                    sourceHash;
+                ProgramSignature            signature;
+                std::string                 defines;
+                uint                        binaryFormat;
+                std::vector<unsigned char>  binary;
+            };
+
+        private:
+            static const uint                                           MAGIC_NUMBER;
+            static const uint                                           VERSION;
+
+            ContextPtr                                                  _context;
+            std::string                                                 _filename;
+            std::unordered_map<uint64_t, Entry>                         _entries;
+            bool                                                        _changed;
+
+        public:
+            /**
+             * Creates a cache stored in filename, loading the programs it already contains.
+             */
+            inline static
+            Ptr
+            create(ContextPtr context, const std::string& filename)
+            {
+                auto cache = std::shared_ptr<ProgramCache>(new ProgramCache(context, filename));
+
+                cache->load();
+
+                return cache;
+            }
+
+            inline
+            const std::string&
+            filename() const
+            {
+                return _filename;
+            }
+
+            inline
+            uint
+            numPrograms() const
+            {
+                return _entries.size();
+            }
+
+            /**
+             * True when programs were stored or binaries dropped since the file was loaded or saved.
+             */
+            inline
+            bool
+            changed() const
+            {
+                return _changed;
+            }
+
+            /**
+             * Uploads program from its stored binary. Returns false when there is none or when the driver
+             * rejects it: the program must then be built from its shaders and stored.
+             */
+            bool
+            upload(ProgramPtr program, uint64_t sourceHash, const std::string& defines);
+
+            /**
+             * Stores the binary of a program built from its shaders and records its variant.
+             */
+            void
+            store(ProgramPtr                program,
+                  uint64_t                  sourceHash,
+                  const ProgramSignature&   signature,
+                  const std::string&        defines);
+
+            /**
+             * The variants recorded for the program sources identified by sourceHash.
+             */
+            void
+            variants(uint64_t sourceHash, std::list<Variant>& variants) const;
+
+            /**
+             * Writes the cache to its file if it changed.
+             */
+            void
+            save();
+
+            /**
+             * Identifies the sources of a program and the macro bindings of its pass: the signatures of the
+             * recorded variants depend on both.
+             */
+            static
+            uint64_t
+            sourceHash(ProgramPtr program, const data::MacroBindingMap& macroBindings);
+
+        private:
+            ProgramCache(ContextPtr context, const std::string& filename);
+
+            void
+            load();
+
+            static
+            uint64_t
+            hash(const std::string& value, uint64_t seed);
+
+            static
+            uint64_t
+            key(uint64_t sourceHash, const std::string& defines);
+        };
+    }
+}
@@ -41,6 +41,14 @@ namespace minko
             {
             }
 
+            inline
+            ProgramSignature(uint mask, const std::vector<int>& values):
+                _mask(mask),
+                _values(values)
+            {
+                _values.resize(MAX_NUM_BINDINGS, 0);
+            }
+
             void
             build(std::shared_ptr<render::Pass>,
                   FormatNameFunction,
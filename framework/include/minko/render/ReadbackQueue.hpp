@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /**
+         * Reads back regions of render targets without stalling the rendering pipeline. Each read is started
+         * with AbstractContext::readPixelsAsync() and its callback is executed by a later call to update(),
+         * once the GPU is done with it. Callbacks are always executed in the order the reads were started.
+         */
+        class ReadbackQueue
+        {
+        public:
+            typedef std::shared_ptr<ReadbackQueue>                          Ptr;
+            typedef std::function<void(const std::vector<unsigned char>&)>  Callback;
+
+        private:
+            typedef std::shared_ptr<AbstractContext>                        ContextPtr;
+
+            struct Read
+            {
+                uint        id;
+                uint        size;
+                Callback    callback;
+            };
+
+        private:
+            ContextPtr                                                      _context;
+            std::list<Read>                                                 _reads;
+            std::vector<unsigned char>                                      _pixels;
+
+        public:
+            inline static
+            Ptr
+            create(ContextPtr context)
+            {
+                return std::shared_ptr<ReadbackQueue>(new ReadbackQueue(context));
+            }
+
+            inline
+            uint
+            numPendingReads() const
+            {
+                return _reads.size();
+            }
+
+            /**
+             * Starts reading the RGBA pixels of a region of the current render target. The callback will be
+             * executed by update() when they are available.
+             */
+            void
+            read(uint x, uint y, uint width, uint height, const Callback& callback);
+
+            /**
+             * Executes the callbacks of the completed reads. Returns the number of reads still pending.
+             */
+            uint
+            update();
+
+        private:
+            ReadbackQueue(ContextPtr context);
+        };
+    }
+}
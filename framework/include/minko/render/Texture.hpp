@@ -38,6 +38,7 @@ namespace minko
 
         private:
             std::vector<unsigned char>                  _data;
+            uint                                        _firstMipLevel;
 
         public:
             inline static
@@ -98,6 +99,29 @@ namespace minko
             uploadMipLevel(uint              level,
                            unsigned char*    data);
 
+            /**
+             * The mip level of the full resolution texture stored as the base level on the GPU: 0 unless
+             * the texture is streamed (see TextureStreamer).
+             */
+            inline
+            uint
+            firstMipLevel() const
+            {
+                return _firstMipLevel;
+            }
+
+            /**
+             * (Re)defines the GPU storage of the texture from the mip level firstLevel of the full resolution
+             * texture: levels[i] holds the data of the mip level firstLevel + i. The identifier of the
+             * texture does not change, so it doesn't have to be bound again.
+             */
+            void
+            uploadMipChain(uint                                             firstLevel,
+                           const std::vector<std::vector<unsigned char>>&   levels);
+
+            uint
+            mipLevelSize(uint level) const;
+
             ~Texture()
             {
                 dispose();
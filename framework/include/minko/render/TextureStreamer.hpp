@@ -0,0 +1,204 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /**
+         * Keeps the GPU memory used by mipmapped textures under a budget. Textures are added with a function
+         * that provides the data of each of their mip levels: only the smallest levels are uploaded at
+         * first. The renderers then request each texture at the size it covers on screen, and update()
+         * raises the resolution of the requested textures one mip level at a time. When the budget is
+         * exceeded, the least recently used textures are lowered to coarser mip levels.
+         *
+         * The streamer does not keep the textures alive: textures that are destroyed or disposed are
+         * forgotten by the next update().
+         */
+        class TextureStreamer
+        {
+        public:
+            typedef std::shared_ptr<TextureStreamer>                                Ptr;
+            typedef std::function<bool(uint level, std::vector<unsigned char>&)>   MipLevelFunction;
+
+            struct Statistics
+            {
+                uint    numTextures;
+                uint    numFullyResident;
+                uint    residentSize;
+                uint    requestedSize;
+                uint    numUploads;
+                uint    numEvictions;
+            };
+
+        private:
+            typedef std::shared_ptr<Texture>                                        TexturePtr;
+            typedef std::shared_ptr<AbstractTexture>                                AbsTexturePtr;
+
+            struct Entry
+            {
+                std::weak_ptr<Texture>  texture;
+                std::vector<uint>       levelSizes;
+                bool                    mipMapping;
+                uint                    numLevels;
+                MipLevelFunction        mipLevelFunction;
+                uint                    minLevel;
+                uint                    residentLevel;
+                uint                    residentSize;
+                uint                    targetLevel;
+                uint                    requestedLevel;
+                uint                    lastUsed;
+            };
+
+        private:
+            uint                                                                    _budget;
+            uint                                                                    _minResidentSize;
+            uint                                                                    _maxUploadSize;
+            std::unordered_map<const AbstractTexture*, Entry>                       _entries;
+            uint                                                                    _frame;
+            uint                                                                    _residentSize;
+            uint                                                                    _numUploads;
+            uint                                                                    _numEvictions;
+
+        public:
+            /**
+             * Creates a streamer keeping the textures it manages under budget bytes of GPU memory.
+             */
+            inline static
+            Ptr
+            create(uint budget)
+            {
+                return std::shared_ptr<TextureStreamer>(new TextureStreamer(budget));
+            }
+
+            inline
+            uint
+            budget() const
+            {
+                return _budget;
+            }
+
+            inline
+            void
+            budget(uint value)
+            {
+                _budget = value;
+            }
+
+            /**
+             * The size (in pixels) of the largest mip level of each texture that is always resident.
+             */
+            inline
+            uint
+            minResidentSize() const
+            {
+                return _minResidentSize;
+            }
+
+            inline
+            void
+            minResidentSize(uint value)
+            {
+                _minResidentSize = value;
+            }
+
+            /**
+             * The number of bytes update() can upload to the GPU. At least one texture is raised by each
+             * call, whatever its size.
+             */
+            inline
+            uint
+            maxUploadSize() const
+            {
+                return _maxUploadSize;
+            }
+
+            inline
+            void
+            maxUploadSize(uint value)
+            {
+                _maxUploadSize = value;
+            }
+
+            bool
+            contains(AbsTexturePtr texture) const;
+
+            /**
+             * Adds a texture with numLevels mip levels, and uploads its smallest ones. mipLevelFunction
+             * fills the data of the requested mip level, and returns false if it is not available yet.
+             */
+            void
+            add(TexturePtr texture, uint numLevels, const MipLevelFunction& mipLevelFunction);
+
+            /**
+             * Stops managing a texture. It keeps the mip levels that are currently resident.
+             */
+            void
+            remove(AbsTexturePtr texture);
+
+            /**
+             * Requests a texture for this frame at a size (in pixels) on screen. Textures that are not
+             * managed by the streamer are ignored.
+             */
+            void
+            requestSize(AbsTexturePtr texture, float screenSize);
+
+            /**
+             * Returns the first mip level of the texture resident on the GPU.
+             */
+            uint
+            residentLevel(AbsTexturePtr texture) const;
+
+            /**
+             * Applies the requests made since the previous call: raises the resolution of the requested
+             * textures and lowers the least recently used ones to stay under the budget.
+             */
+            void
+            update();
+
+            Statistics
+            statistics() const;
+
+        private:
+            TextureStreamer(uint budget);
+
+            Entry*
+            find(AbsTexturePtr texture);
+
+            const Entry*
+            find(AbsTexturePtr texture) const;
+
+            void
+            removeDisposedTextures();
+
+            uint
+            chainSize(const Entry& entry, uint level) const;
+
+            bool
+            upload(Entry& entry, uint level);
+
+            void
+            evict(uint budget);
+        };
+    }
+}
@@ -85,8 +85,8 @@ namespace minko
             inline static
             Ptr
             create(std::shared_ptr<render::AbstractContext>   context,
-                   float*                                     begin,
-                   float*                                     end)
+                   const float*                               begin,
+                   const float*                               end)
             {
                 return std::shared_ptr<VertexBuffer>(new VertexBuffer(
                     context,
@@ -194,8 +194,8 @@ namespace minko
                             std::vector<float>::const_iterator       end);
 
             VertexBuffer(std::shared_ptr<render::AbstractContext>    context,
-                         float*                                      begin,
-                         float*                                      end);
+                         const float*                                begin,
+                         const float*                                end);
 
             void
             vertexSize(unsigned int value);
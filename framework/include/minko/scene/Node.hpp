@@ -33,11 +33,21 @@ namespace minko
         {
         public:
             typedef std::shared_ptr<Node>                           Ptr;
+            typedef Signal<Ptr, const std::vector<Ptr>&, Ptr>       ChildrenChangedSignal;
 
         private:
 			typedef std::shared_ptr<component::AbstractComponent>	AbsCmpPtr;
 
+            struct TypedComponents
+            {
+                uint                                                typeId;
+                std::shared_ptr<void>                               (*cast)(const AbsCmpPtr&);
+                std::vector<std::shared_ptr<void>>                  components;
+            };
+
             static uint                                             _lastId;
+            static uint                                             _numBatches;
+            static uint                                             _numComponentTypes;
             uint                                                    _id;
 
         protected:
@@ -50,11 +60,20 @@ namespace minko
             std::shared_ptr<data::Container>                        _container;
             std::shared_ptr<data::Provider>                         _data;
 			std::list<AbsCmpPtr>									_components;
+            // components matching each queried type, sorted by componentTypeId<T>() and filled lazily
+            std::vector<TypedComponents>                            _typedComponents;
 
             uint                                                    _depth;
 
+            uint                                                    _batchDepth;
+            std::vector<Ptr>                                        _batchAdded;
+            std::vector<Ptr>                                        _batchRemoved;
+            Ptr                                                     _batchRemovedFrom;
+
             std::shared_ptr<Signal<Ptr, Ptr, Ptr>>                  _added;
             std::shared_ptr<Signal<Ptr, Ptr, Ptr>>                  _removed;
+            std::shared_ptr<ChildrenChangedSignal>                  _childrenAdded;
+            std::shared_ptr<ChildrenChangedSignal>                  _childrenRemoved;
             std::shared_ptr<Signal<Ptr, Ptr>>                       _layoutsChanged;
 			std::shared_ptr<Signal<Ptr, Ptr, AbsCmpPtr>>			_componentAdded;
 			std::shared_ptr<Signal<Ptr, Ptr, AbsCmpPtr>>			_componentRemoved;
@@ -211,6 +230,22 @@ namespace minko
                 return _removed;
             }
 
+            // executed once on the parent and each of its ancestors for all the children added
+            // by a single addChild() call or by a whole batch (see beginBatch())
+            inline
+            ChildrenChangedSignal::Ptr
+            childrenAdded() const
+            {
+                return _childrenAdded;
+            }
+
+            inline
+            ChildrenChangedSignal::Ptr
+            childrenRemoved() const
+            {
+                return _childrenRemoved;
+            }
+
             inline
             Signal<Ptr, Ptr>::Ptr
             layoutsChanged() const
@@ -241,6 +276,24 @@ namespace minko
             Ptr
             removeChildren();
 
+            Ptr
+            addChildren(const std::vector<Ptr>& children);
+
+            // until the matching commitBatch(), the ancestors of this node are not notified when its children
+            // are added or removed: they receive all the changes at once when the batch is committed
+            Ptr
+            beginBatch();
+
+            Ptr
+            commitBatch();
+
+            inline
+            bool
+            batching() const
+            {
+                return _batchDepth != 0;
+            }
+
             bool
             contains(Ptr Node);
 
@@ -258,22 +311,19 @@ namespace minko
             bool
             hasComponent()
             {
-                return component<T>() != nullptr;
+                return !typedComponents<T>().empty();
             }
 
             template <typename T>
             std::vector<std::shared_ptr<T>>
             components()
             {
+                const auto&                     typedComponents = this->typedComponents<T>();
                 std::vector<std::shared_ptr<T>> result;
 
-                for (auto component : _components)
-                {
-                    std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
-
-                    if (typedComponent != nullptr)
-                        result.push_back(typedComponent);
-                }
+                result.reserve(typedComponents.size());
+                for (const auto& component : typedComponents)
+                    result.push_back(std::static_pointer_cast<T>(component));
 
                 return result;
             }
@@ -282,22 +332,11 @@ namespace minko
             std::shared_ptr<T>
             component(const unsigned int position = 0)
             {
-                unsigned int counter = 0;
+                const auto& typedComponents = this->typedComponents<T>();
 
-                for (auto component : _components)
-                {
-                    std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
-
-                    if (typedComponent != nullptr)
-                    {
-                        if (counter == position)
-                            return typedComponent;
-                        else
-                            ++counter;
-                    }
-                }
-
-                return nullptr;
+                return position < typedComponents.size()
+                    ? std::static_pointer_cast<T>(typedComponents[position])
+                    : nullptr;
             }
 
             virtual
@@ -324,6 +363,73 @@ namespace minko
         private:
             void
             initialize();
+
+            template <typename T>
+            static
+            uint
+            componentTypeId()
+            {
+                static const uint typeId = _numComponentTypes++;
+
+                return typeId;
+            }
+
+            template <typename T>
+            static
+            std::shared_ptr<void>
+            castComponent(const AbsCmpPtr& component)
+            {
+                return std::dynamic_pointer_cast<T>(component);
+            }
+
+            // the pointers are stored already cast to T: components can inherit AbstractComponent virtually
+            template <typename T>
+            const std::vector<std::shared_ptr<void>>&
+            typedComponents()
+            {
+                const auto  typeId  = componentTypeId<T>();
+                auto        it      = std::lower_bound(
+                    _typedComponents.begin(),
+                    _typedComponents.end(),
+                    typeId,
+                    [](const TypedComponents& typedComponents, uint id) { return typedComponents.typeId < id; }
+                );
+
+                if (it == _typedComponents.end() || it->typeId != typeId)
+                {
+                    it = _typedComponents.insert(it, TypedComponents());
+                    it->typeId = typeId;
+                    it->cast = &castComponent<T>;
+
+                    for (const auto& component : _components)
+                    {
+                        auto typedComponent = it->cast(component);
+
+                        if (typedComponent != nullptr)
+                            it->components.push_back(typedComponent);
+                    }
+                }
+
+                return it->components;
+            }
+
+            void
+            addTypedComponent(AbsCmpPtr component);
+
+            void
+            removeTypedComponent(AbsCmpPtr component);
+
+            void
+            flushBatches();
+
+            void
+            flushBatch();
+
+            void
+            notifyChildrenAdded(const std::vector<Ptr>& children);
+
+            void
+            notifyChildrenRemoved(const std::vector<Ptr>& children);
         };
     }
 }
@@ -0,0 +1,339 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/TaskScheduler.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+TaskScheduler::Task::Task(const Function& function, bool mainThread, const CostFunction& cost) :
+    _function(function),
+    _mainThread(mainThread),
+    _cost(cost),
+    _numPendingDependencies(0),
+    _complete(false),
+    _continuations(),
+    _exception()
+{
+}
+
+TaskScheduler::TaskScheduler() :
+    _threads(),
+    _threadIds(),
+    _workerQueues(),
+    _nextWorkerQueue(0),
+    _numQueuedTasks(0),
+    _mainThreadTasks(),
+    _stopped(false)
+{
+}
+
+void
+TaskScheduler::initialize(uint numWorkers)
+{
+    // workers wait for this lock before looking for tasks: their ids are all known by then
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (uint i = 0; i < numWorkers; ++i)
+        _workerQueues.push_back(std::make_shared<WorkerQueue>());
+
+    for (uint i = 0; i < numWorkers; ++i)
+    {
+        _threads.push_back(std::thread(&TaskScheduler::run, this, i));
+        _threadIds.push_back(_threads.back().get_id());
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _stopped = true;
+    }
+
+    _taskQueued.notify_all();
+
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+/*static*/
+TaskScheduler::Ptr
+TaskScheduler::instance()
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    static auto scheduler = create(0);
+#else
+    static auto scheduler = create(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+#endif
+
+    return scheduler;
+}
+
+TaskScheduler::TaskPtr
+TaskScheduler::schedule(const Task::Function&       function,
+                        const std::vector<TaskPtr>& dependencies,
+                        bool                        mainThread,
+                        const Task::CostFunction&   cost)
+{
+    auto task = TaskPtr(new Task(function, mainThread, cost));
+
+    // the extra dependency keeps the task from starting before all the actual ones are registered
+    task->_numPendingDependencies = 1;
+
+    for (auto& dependency : dependencies)
+    {
+        if (dependency == nullptr)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dependency->_mutex);
+
+        if (!dependency->_complete)
+        {
+            ++task->_numPendingDependencies;
+            dependency->_continuations.push_back(task);
+        }
+    }
+
+    release(task);
+
+    return task;
+}
+
+uint
+TaskScheduler::runMainThreadTasks(float maxDuration, int maxCost)
+{
+    const auto  startTime   = std::chrono::steady_clock::now();
+    uint        numTasks    = 0;
+    uint        totalCost   = 0;
+
+    while (maxDuration < 0.f
+        || std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() < maxDuration)
+    {
+        auto task = popMainThreadTask();
+
+        if (task == nullptr)
+            break;
+
+        if (task->_cost && maxCost >= 0)
+        {
+            const auto cost = task->_cost();
+
+            if (totalCost != 0 && totalCost + cost > uint(maxCost))
+            {
+                // keep the task first in line for the next call
+                std::lock_guard<std::mutex> lock(_mainThreadMutex);
+
+                _mainThreadTasks.push_front(task);
+
+                break;
+            }
+
+            totalCost += cost;
+        }
+
+        execute(task);
+        ++numTasks;
+    }
+
+    return numTasks;
+}
+
+void
+TaskScheduler::wait(TaskPtr task, bool mainThread)
+{
+    while (!task->complete())
+    {
+        auto pendingTask = mainThread ? popMainThreadTask() : nullptr;
+
+        if (pendingTask == nullptr)
+            pendingTask = popWorkerTask(workerIndex());
+
+        if (pendingTask != nullptr)
+            execute(pendingTask);
+        else
+            std::this_thread::yield();
+    }
+
+    if (task->_exception)
+        std::rethrow_exception(task->_exception);
+}
+
+int
+TaskScheduler::workerIndex() const
+{
+    const auto threadId = std::this_thread::get_id();
+
+    for (uint i = 0; i < _threadIds.size(); ++i)
+        if (_threadIds[i] == threadId)
+            return i;
+
+    return -1;
+}
+
+void
+TaskScheduler::enqueue(TaskPtr task)
+{
+    if (task->_mainThread || _workerQueues.empty())
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadMutex);
+
+        _mainThreadTasks.push_back(task);
+
+        return;
+    }
+
+    // a worker keeps the tasks it schedules for itself, the others are spread among the workers
+    auto index = workerIndex();
+
+    if (index < 0)
+        index = _nextWorkerQueue++ % _workerQueues.size();
+
+    auto& queue = *_workerQueues[index];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.tasks.push_back(task);
+    }
+
+    ++_numQueuedTasks;
+
+    {
+        // a worker testing _numQueuedTasks right before this increment is waiting once the lock is released
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+
+    _taskQueued.notify_one();
+}
+
+void
+TaskScheduler::release(TaskPtr task)
+{
+    if (--task->_numPendingDependencies == 0)
+        enqueue(task);
+}
+
+void
+TaskScheduler::execute(TaskPtr task)
+{
+    try
+    {
+        task->_function();
+    }
+    catch (...)
+    {
+        task->_exception = std::current_exception();
+    }
+
+    std::vector<TaskPtr> continuations;
+
+    {
+        std::lock_guard<std::mutex> lock(task->_mutex);
+
+        task->_complete = true;
+        continuations.swap(task->_continuations);
+    }
+
+    // release whatever the function captured
+    task->_function = nullptr;
+
+    for (auto& continuation : continuations)
+        release(continuation);
+}
+
+TaskScheduler::TaskPtr
+TaskScheduler::popWorkerTask(int workerIndex)
+{
+    if (_numQueuedTasks == 0)
+        return nullptr;
+
+    const auto numQueues = _workerQueues.size();
+
+    // the most recent task of its own queue is likely to still have its data in cache, the oldest
+    // ones of the other queues are likely to be the largest pieces of work left
+    for (uint i = 0; i < numQueues; ++i)
+    {
+        const auto  index   = workerIndex < 0 ? i : (workerIndex + i) % numQueues;
+        auto&       queue   = *_workerQueues[index];
+        TaskPtr     task;
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                continue;
+
+            if (int(index) == workerIndex)
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+        }
+
+        --_numQueuedTasks;
+
+        return task;
+    }
+
+    return nullptr;
+}
+
+TaskScheduler::TaskPtr
+TaskScheduler::popMainThreadTask()
+{
+    std::lock_guard<std::mutex> lock(_mainThreadMutex);
+
+    if (_mainThreadTasks.empty())
+        return nullptr;
+
+    auto task = _mainThreadTasks.front();
+
+    _mainThreadTasks.pop_front();
+
+    return task;
+}
+
+void
+TaskScheduler::run(uint workerIndex)
+{
+    while (true)
+    {
+        auto task = popWorkerTask(workerIndex);
+
+        if (task != nullptr)
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        _taskQueued.wait(lock, [&]() { return _stopped || _numQueuedTasks > 0; });
+
+        if (_stopped)
+            return;
+    }
+}
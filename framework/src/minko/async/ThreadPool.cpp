@@ -0,0 +1,132 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/ThreadPool.hpp"
+
+#include "minko/async/TaskScheduler.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+ThreadPool::ThreadPool(TaskSchedulerPtr scheduler) :
+    _scheduler(scheduler)
+{
+    if (_scheduler == nullptr)
+        throw std::invalid_argument("scheduler");
+}
+
+/*static*/
+ThreadPool::Ptr
+ThreadPool::create(uint numThreads)
+{
+    return create(TaskScheduler::create(numThreads));
+}
+
+/*static*/
+ThreadPool::Ptr
+ThreadPool::instance()
+{
+    static auto pool = create(TaskScheduler::instance());
+
+    return pool;
+}
+
+uint
+ThreadPool::numThreads() const
+{
+    return _scheduler->numWorkers();
+}
+
+void
+ThreadPool::parallelFor(uint begin, uint end, uint grainSize, const RangeFunction& function)
+{
+    if (end <= begin)
+        return;
+
+    grainSize = std::max(grainSize, 1u);
+
+    auto numChunks = (end - begin + grainSize - 1) / grainSize;
+
+    if (numChunks == 1 || _scheduler->numWorkers() == 0)
+    {
+        for (auto chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+            function(chunkBegin, std::min(chunkBegin + grainSize, end));
+
+        return;
+    }
+
+    auto loop = std::make_shared<Loop>();
+
+    loop->function = function;
+    loop->begin = begin;
+    loop->end = end;
+    loop->grainSize = grainSize;
+    loop->numChunks = numChunks;
+    loop->nextChunk = 0;
+    loop->numDoneChunks = 0;
+
+    // busy workers pick their task up late: it returns right away if every chunk is started by then
+    const auto numTasks = std::min(numChunks - 1, _scheduler->numWorkers());
+
+    for (uint i = 0; i < numTasks; ++i)
+        _scheduler->schedule([=]() { runChunks(loop); });
+
+    runChunks(loop);
+
+    // the chunks left are running on other threads
+    {
+        std::unique_lock<std::mutex> lock(loop->mutex);
+
+        loop->done.wait(lock, [&]() { return loop->numDoneChunks == loop->numChunks; });
+    }
+
+    if (loop->exception)
+        std::rethrow_exception(loop->exception);
+}
+
+/*static*/
+void
+ThreadPool::runChunks(LoopPtr loop)
+{
+    uint chunk;
+
+    while ((chunk = loop->nextChunk++) < loop->numChunks)
+    {
+        auto chunkBegin = loop->begin + chunk * loop->grainSize;
+
+        try
+        {
+            loop->function(chunkBegin, std::min(chunkBegin + loop->grainSize, loop->end));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(loop->mutex);
+
+            if (!loop->exception)
+                loop->exception = std::current_exception();
+        }
+
+        if (++loop->numDoneChunks == loop->numChunks)
+        {
+            std::lock_guard<std::mutex> lock(loop->mutex);
+
+            loop->done.notify_all();
+        }
+    }
+}
@@ -29,21 +29,37 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::async;
 
-Worker::Worker(const std::string& name)
+#if defined(MINKO_WORKER_IMPL_THREAD)
+MINKO_WORKER_THREAD_LOCAL uint Worker::WorkerImpl::_currentRequestId = 0;
+#endif
+
+Worker::Worker(const std::string& name) :
+    _handlers()
 {
     _impl.reset(new WorkerImpl(this, name));
 }
 
-void
+uint
 Worker::start(const std::vector<char>& input)
 {
-    _impl->start(input);
+    return _impl->start(input);
+}
+
+uint
+Worker::start(const std::vector<char>& input, const MessageHandler& handler)
+{
+    auto requestId = _impl->start(input);
+
+    // messages are only dispatched by poll(), on this thread: the handler cannot miss any of them
+    _handlers[requestId] = handler;
+
+    return requestId;
 }
 
 void
 Worker::post(Message message)
 {
-    _impl->post(message);
+    _impl->post(std::move(message));
 }
 
 void
@@ -52,12 +68,32 @@ Worker::poll()
     _impl->poll();
 }
 
-Signal<Worker::Ptr, Worker::Message>::Ptr
+Signal<Worker::Ptr, const Worker::Message&>::Ptr
 Worker::message()
 {
     return _impl->message();
 }
 
+void
+Worker::dispatch(const Message& message)
+{
+    _impl->message()->execute(shared_from_this(), message);
+
+    auto handlerIt = _handlers.find(message.requestId);
+
+    if (handlerIt == _handlers.end())
+        return;
+
+    // the handler can start new requests: only the references to the elements remain valid
+    auto isLastMessage = message.type == "complete" || message.type == "error";
+    const auto& handler = handlerIt->second;
+
+    handler(message);
+
+    if (isLastMessage)
+        _handlers.erase(message.requestId);
+}
+
 Worker::~Worker()
 {
 }
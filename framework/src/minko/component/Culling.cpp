@@ -32,11 +32,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::component;
 
-/*static*/ std::shared_ptr<math::OctTree>    Culling::_octTree;
-
 Culling::Culling(ShapePtr shape,
                  const std::string& bindProperty):
     AbstractComponent(scene::Layout::Group::CULLING),
+    _octTree(math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0))),
     _frustum(shape),
     _bindProperty(bindProperty)
 {
@@ -51,8 +50,8 @@ Culling::initialize()
         std::placeholders::_1,
         std::placeholders::_2
     ));
-    _targetRemovedSlot = targetAdded()->connect(std::bind(
-        &Culling::targetAddedHandler,
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Culling::targetRemovedHandler,
         std::static_pointer_cast<Culling>(shared_from_this()),
         std::placeholders::_1,
         std::placeholders::_2
@@ -67,12 +66,6 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
     if (target->components<component::PerspectiveCamera>().size() < 1)
         throw std::logic_error("Culling must be added to a camera");
 
-
-    // compute scene bounding box
-
-    if (_octTree == nullptr)
-        _octTree = math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0));
-
     if (target->root()->hasComponent<SceneManager>())
         targetAddedToSceneHandler(nullptr, target, nullptr);
     else
@@ -94,14 +87,36 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 void
 Culling::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
-    _addedSlot            = nullptr;
-    _layoutChangedSlot    = nullptr;
+    _addedSlot              = nullptr;
+    _removedSlot            = nullptr;
+    _addedToSceneSlot       = nullptr;
+    _layoutChangedSlot      = nullptr;
+    _componentAddedSlot     = nullptr;
+    _componentRemovedSlot   = nullptr;
+    _viewMatrixChangedSlot  = nullptr;
+    _renderingBeginSlot     = nullptr;
+
+    // every surface indexed by this culling is rendered again
+    auto renderer = target->component<Renderer>();
+
+    if (renderer)
+        for (auto& nodeAndSurfaces : _nodeToSurfaces)
+            for (auto& surface : nodeAndSurfaces.second)
+                renderer->culled(surface, false);
+
+    for (auto& nodeAndSurfaces : _nodeToSurfaces)
+        _octTree->remove(nodeAndSurfaces.first);
+
+    _nodeToSurfaces.clear();
+    _visibleSurfaces.clear();
 }
 
 void
 Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-    if (target->root()->hasComponent<SceneManager>())
+    auto sceneManager = target->root()->component<SceneManager>();
+
+    if (sceneManager)
     {
         _addedToSceneSlot = nullptr;
 
@@ -112,53 +127,185 @@ Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancesto
             std::placeholders::_2
         ));
 
-        _addedSlot = target->root()->added()->connect(std::bind(
+        _addedSlot = target->root()->childrenAdded()->connect(std::bind(
             &Culling::addedHandler,
             std::static_pointer_cast<Culling>(shared_from_this()),
             std::placeholders::_1,
             std::placeholders::_2,
             std::placeholders::_3
         ));
+
+        _removedSlot = target->root()->childrenRemoved()->connect(std::bind(
+            &Culling::removedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        _componentAddedSlot = target->root()->componentAdded()->connect(std::bind(
+            &Culling::componentAddedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        _componentRemovedSlot = target->root()->componentRemoved()->connect(std::bind(
+            &Culling::componentRemovedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        // the default priority makes sure world matrices have been updated by the RootTransform
+        _renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
+            &Culling::renderingBeginHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        addedHandler(target->root(), std::vector<NodePtr>(1, target->root()), nullptr);
     }
 }
 
 void
-Culling::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+Culling::addedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr ancestor)
 {
     auto layoutMask = this->layoutMask();
-    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(target)->descendants(true)->where([layoutMask](NodePtr descendant)
+    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(targets)->descendants(true)->where([layoutMask](NodePtr descendant)
     {
-        return (descendant->layouts() & layoutMask) != 0;
+        return (descendant->layouts() & layoutMask) != 0 && descendant->hasComponent<Surface>();
     });
 
     for (auto n : nodeSet->nodes())
-        _octTree->insert(n);
+        insertNode(n);
+}
+
+void
+Culling::removedHandler(NodePtr node, const std::vector<NodePtr>& targets, NodePtr ancestor)
+{
+    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(targets)->descendants(true);
+
+    for (auto n : nodeSet->nodes())
+        removeNode(n);
 }
 
 void
 Culling::layoutChangedHandler(NodePtr node, NodePtr target)
 {
-    if ((target->layouts() & layoutMask()) != 0)
-        _octTree->insert(target);
+    if ((target->layouts() & layoutMask()) != 0 && target->hasComponent<Surface>())
+        insertNode(target);
     else
-        _octTree->remove(target);
+        removeNode(target);
+}
+
+void
+Culling::componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component)
+{
+    if (std::dynamic_pointer_cast<Surface>(component) == nullptr
+        || (target->layouts() & layoutMask()) == 0)
+        return;
+
+    // the list of surfaces of the node has changed
+    removeNode(target);
+    insertNode(target);
+}
+
+void
+Culling::componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component)
+{
+    auto surface = std::dynamic_pointer_cast<Surface>(component);
+
+    if (surface == nullptr || _nodeToSurfaces.count(target) == 0)
+        return;
+
+    auto renderer = targets()[0]->component<Renderer>();
+
+    if (renderer)
+        renderer->culled(surface, false);
+
+    removeNode(target);
+    if (target->hasComponent<Surface>())
+        insertNode(target);
+}
+
+void
+Culling::insertNode(NodePtr node)
+{
+    if (_nodeToSurfaces.count(node) != 0)
+        return;
+
+    auto& surfaces = _nodeToSurfaces[node];
+
+    surfaces = node->components<Surface>();
+    _octTree->insert(node);
+
+    // culled until the next frustum test says otherwise
+    auto renderer = targets()[0]->component<Renderer>();
+
+    if (renderer)
+        for (auto& surface : surfaces)
+            renderer->culled(surface, true);
+}
+
+void
+Culling::removeNode(NodePtr node)
+{
+    auto surfacesIt = _nodeToSurfaces.find(node);
+
+    if (surfacesIt == _nodeToSurfaces.end())
+        return;
+
+    auto renderer = targets()[0]->component<Renderer>();
+
+    for (auto& surface : surfacesIt->second)
+    {
+        _visibleSurfaces.erase(surface);
+        if (renderer)
+            renderer->culled(surface, false);
+    }
+
+    _nodeToSurfaces.erase(surfacesIt);
+    _octTree->remove(node);
 }
 
 void
 Culling::worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName)
 {
     _frustum->updateFromMatrix(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
+}
 
+void
+Culling::renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget)
+{
     auto renderer = targets()[0]->component<Renderer>();
 
+    if (renderer == nullptr)
+        return;
+
+    _newVisibleSurfaces.clear();
     _octTree->testFrustum(
         _frustum,
         [&](NodePtr node)
         {
-            node->component<Surface>()->computedVisibility(renderer, true);
-        },
-        [&](NodePtr node)
-        {
-            node->component<Surface>()->computedVisibility(renderer, false);
-        });
-}
\ No newline at end of file
+            auto& surfaces = _nodeToSurfaces[node];
+
+            _newVisibleSurfaces.insert(surfaces.begin(), surfaces.end());
+        }
+    );
+
+    // only notify the surfaces whose visibility changed since the last frame
+    for (auto& surface : _visibleSurfaces)
+        if (_newVisibleSurfaces.count(surface) == 0)
+            renderer->culled(surface, true);
+
+    for (auto& surface : _newVisibleSurfaces)
+        if (_visibleSurfaces.count(surface) == 0)
+            renderer->culled(surface, false);
+
+    _visibleSurfaces.swap(_newVisibleSurfaces);
+}
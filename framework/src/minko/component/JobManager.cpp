@@ -30,12 +30,16 @@ JobManager::Job::Job() :
     _jobManager(),
     _running(false),
     _oneStepPerFrame(false),
+    _offMainThread(false),
     _priorityChanged(Signal<float>::create())
 {
 }
 
-JobManager::JobManager(unsigned int loadingFramerate):
-    _loadingFramerate(loadingFramerate)
+JobManager::JobManager(unsigned int loadingFramerate, TaskSchedulerPtr scheduler):
+    _loadingFramerate(loadingFramerate),
+    _scheduler(scheduler),
+    _sortNeeded(false),
+    _frameStartTime(Clock::now())
 {
     _frameTime = 1.f / loadingFramerate;
 }
@@ -45,20 +49,15 @@ JobManager::pushJob(Job::Ptr job)
 {
     _jobPriorityChangedSlots.insert(std::make_pair(
         job,
-        job->priorityChanged()->connect([=](float priority) -> void 
+        job->priorityChanged()->connect([=](float priority) -> void
         {
-            auto jobIt = std::find(_jobs.begin(), _jobs.end(), job);
-
-            if (jobIt != _jobs.end())
-            {
-                _jobs.erase(jobIt);
-            }
-
-            insertJob(job);
+            _sortNeeded = true;
         }))
     );
 
-    insertJob(job);
+    // jobs with the same priority run in the order they were pushed
+    _jobs.insert(_jobs.begin(), job);
+    _sortNeeded = true;
 
     return std::static_pointer_cast<JobManager>(shared_from_this());
 }
@@ -66,19 +65,47 @@ JobManager::pushJob(Job::Ptr job)
 void
 JobManager::update(NodePtr target)
 {
-    _frameStartTime = std::clock();
+    _frameStartTime = Clock::now();
 }
 
 void
 JobManager::end(NodePtr target)
 {
+    // continuations of the off-main-thread jobs, among others
+    _scheduler->runMainThreadTasks(std::max(0.f, _frameTime - elapsedFrameTime()));
+
+    for (auto taskIt = _offMainThreadJobs.begin(); taskIt != _offMainThreadJobs.end();)
+    {
+        auto task = *taskIt;
+
+        if (!task->complete())
+        {
+            ++taskIt;
+            continue;
+        }
+
+        taskIt = _offMainThreadJobs.erase(taskIt);
+
+        if (task->exception())
+            std::rethrow_exception(task->exception());
+    }
+
     if (_jobs.empty())
         return;
 
-    auto consumeTime        = float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC;
-    Job::Ptr currentJob     = nullptr;
+    if (_sortNeeded)
+    {
+        std::stable_sort(_jobs.begin(), _jobs.end(), [](Job::Ptr left, Job::Ptr right) -> bool
+        {
+            return left->priority() < right->priority();
+        });
+
+        _sortNeeded = false;
+    }
+
+    Job::Ptr currentJob = nullptr;
 
-    while (consumeTime < _frameTime)
+    while (elapsedFrameTime() < _frameTime)
     {
         if (currentJob == nullptr)
         {
@@ -89,13 +116,24 @@ JobManager::end(NodePtr target)
                 currentJob->_jobManager = std::dynamic_pointer_cast<JobManager>(shared_from_this());
                 currentJob->running(true);
                 currentJob->beforeFirstStep();
+
+                if (currentJob->offMainThread() && _scheduler->numWorkers() > 0)
+                {
+                    _jobs.pop_back();
+                    _jobPriorityChangedSlots.erase(currentJob);
+                    runOffMainThread(currentJob);
+                    currentJob = nullptr;
+
+                    if (_jobs.empty())
+                        return;
+
+                    continue;
+                }
             }
         }
 
         currentJob->step();
 
-        consumeTime = (float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC);
-
         if (currentJob->complete())
         {
             _jobs.pop_back();
@@ -106,30 +144,35 @@ JobManager::end(NodePtr target)
             if (_jobs.empty())
                 return;
         }
-        else
-        {
-            if (currentJob->oneStepPerFrame())
-            {
-                _jobs.push_back(currentJob);
-                currentJob = nullptr;
-                consumeTime = _frameTime;
-            }
-        }
+        else if (currentJob->oneStepPerFrame())
+            return;
     }
 }
 
+float
+JobManager::elapsedFrameTime() const
+{
+    return std::chrono::duration<float>(Clock::now() - _frameStartTime).count();
+}
+
 void
-JobManager::insertJob(Job::Ptr job)
+JobManager::runOffMainThread(Job::Ptr job)
 {
-    auto jobPosition = std::lower_bound(
-        _jobs.begin(),
-        _jobs.end(),
-        job,
-        [&](Job::Ptr left, Job::Ptr right) -> bool
-        {
-            return left->priority() < right->priority();
-        }
-    );
+    auto steps = _scheduler->schedule([=]()
+    {
+        while (!job->complete())
+            job->step();
+    });
 
-    _jobs.insert(jobPosition, job);
+    _offMainThreadJobs.push_back(_scheduler->schedule(
+        [=]()
+        {
+            if (steps->exception())
+                std::rethrow_exception(steps->exception());
+
+            job->afterLastStep();
+        },
+        { steps },
+        true
+    ));
 }
@@ -24,6 +24,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/BoundingBox.hpp"
 #include "minko/math/AbstractShape.hpp"
 #include "minko/math/Ray.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/data/Container.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -37,7 +43,8 @@ MousePicking::MousePicking() :
     _rollOut(MouseSignal::create()),
     _leftButtonUp(MouseSignal::create()),
     _leftButtonDown(MouseSignal::create()),
-    _previousRayOrigin(math::Vector3::create())
+    _previousRayOrigin(math::Vector3::create()),
+    _octTree(math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0)))
 {
 
 }
@@ -45,43 +52,167 @@ MousePicking::MousePicking() :
 void
 MousePicking::initialize()
 {
-    /*
-    _targetAddedSlot = targetAdded()->connect([&](AbstractComponent::Ptr cmp, scene::Node::Ptr target)
-    {
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &MousePicking::targetAddedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &MousePicking::targetRemovedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
 
-    });
+void
+MousePicking::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    auto& slots = _targetToSlots[target];
+
+    slots.push_back(target->added()->connect(std::bind(
+        &MousePicking::addedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
+    slots.push_back(target->removed()->connect(std::bind(
+        &MousePicking::removedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
+    slots.push_back(target->componentAdded()->connect(std::bind(
+        &MousePicking::componentAddedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
+    slots.push_back(target->componentRemoved()->connect(std::bind(
+        &MousePicking::componentRemovedHandler,
+        std::static_pointer_cast<MousePicking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
+
+    addedHandler(target, target, target->parent());
+}
 
-    _targetRemovedSlot = targetRemoved()->connect([&](AbstractComponent::Ptr cmp, scene::Node::Ptr target)
-    {
+void
+MousePicking::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    _targetToSlots.erase(target);
 
-    });
-    */
+    removedHandler(target, target, target->parent());
 }
 
 void
-MousePicking::pick(std::shared_ptr<math::Ray>    ray)
+MousePicking::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-    MousePicking::HitList hits;
-
-    auto descendants = scene::NodeSet::create(targets())
+    auto descendants = scene::NodeSet::create(target)
         ->descendants(true)
-        ->where([&](scene::Node::Ptr node)
+        ->where([](scene::Node::Ptr descendant) { return descendant->hasComponent<BoundingBox>(); });
+
+    for (auto& descendant : descendants->nodes())
+        _octTree->insert(descendant);
+}
+
+void
+MousePicking::removedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    for (auto& descendant : scene::NodeSet::create(target)->descendants(true)->nodes())
+        _octTree->remove(descendant);
+}
+
+void
+MousePicking::componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component)
+{
+    if (std::dynamic_pointer_cast<BoundingBox>(component) != nullptr)
+        _octTree->insert(target);
+}
+
+void
+MousePicking::componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component)
+{
+    if (std::dynamic_pointer_cast<BoundingBox>(component) != nullptr && !target->hasComponent<BoundingBox>())
+        _octTree->remove(target);
+}
+
+bool
+MousePicking::castSurfaces(NodePtr node, RayPtr ray, float& distance)
+{
+    auto hit            = false;
+    auto modelRay       = ray;
+    auto numCastable    = 0;
+    auto boxDistance    = distance;
+
+    distance = std::numeric_limits<float>::infinity();
+
+    for (auto& surface : node->components<Surface>())
+    {
+        auto geometry = surface->geometry();
+
+        if (!geometry->hasVertexAttribute("position") || geometry->vertexBuffer("position")->data().empty()
+            || geometry->indices() == nullptr || geometry->indices()->data().empty())
+            continue;
+
+        ++numCastable;
+        if (modelRay == ray && node->data()->hasProperty("transform.modelToWorldMatrix"))
         {
-            return (node->layouts() & layoutMask()) != 0
-                &&  node->hasComponent<BoundingBox>();
+            // the direction is not normalized so that distances remain expressed in world space
+            auto worldToModel = math::Matrix4x4::create(
+                node->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix")
+            )->invert();
+
+            modelRay = math::Ray::create(
+                worldToModel->transform(ray->origin()),
+                worldToModel->deltaTransform(ray->direction())
+            );
         }
-    );
 
-    std::unordered_map<scene::Node::Ptr, float> distance;
+        auto    surfaceDistance = 0.f;
+        uint    triangle        = 0;
 
-    for (auto& descendant : descendants->nodes())
-        for (auto& box : descendant->components<BoundingBox>())
+        if (geometry->cast(modelRay, surfaceDistance, triangle) && surfaceDistance < distance)
         {
-            auto distance = 0.f;
-
-            if (box->shape()->cast(ray, distance))
-                hits.push_back(Hit(descendant, distance));
+            distance = surfaceDistance;
+            hit = true;
         }
+    }
+
+    // surfaces without CPU triangles are picked by their bounding box
+    if (numCastable == 0)
+    {
+        distance = boxDistance;
+
+        return true;
+    }
+
+    return hit;
+}
+
+void
+MousePicking::pick(std::shared_ptr<math::Ray>    ray)
+{
+    MousePicking::HitList hits;
+
+    // bounding boxes are only a broad phase when the triangles of the surfaces are available
+    _octTree->testRay(ray, [&](scene::Node::Ptr node, float boxDistance)
+    {
+        if ((node->layouts() & layoutMask()) == 0)
+            return;
+
+        auto distance = boxDistance;
+
+        if (castSurfaces(node, ray, distance))
+            hits.push_back(Hit(node, distance));
+    });
 
     hits.sort([&](Hit& a, Hit& b) { return a.second < b.second; });
 
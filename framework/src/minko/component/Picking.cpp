@@ -26,6 +26,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/PerspectiveCamera.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/render/AbstractContext.hpp"
+#include "minko/render/ReadbackQueue.hpp"
 #include "minko/input/Mouse.hpp"
 #include "minko/input/Touch.hpp"
 #include "minko/math/Matrix4x4.hpp"
@@ -41,6 +42,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace component;
 
+/*static*/ const uint Picking::MAX_NUM_PICK_REQUESTS = 16;
 
 Picking::Picking() :
     _sceneManager(nullptr),
@@ -51,6 +53,9 @@ Picking::Picking() :
     _pickingId(0),
     _pickingProjection(math::Matrix4x4::create()),
     _pickingProvider(data::StructureProvider::create("picking")),
+    _asynchronous(false),
+    _readbackQueue(nullptr),
+    _renderingPickRequests(false),
     _mouseMove(Signal<NodePtr>::create()),
     _mouseLeftClick(Signal<NodePtr>::create()),
     _mouseRightClick(Signal<NodePtr>::create()),
@@ -67,18 +72,21 @@ Picking::Picking() :
     _doubleTap(Signal<NodePtr>::create()),
     _longHold(Signal<NodePtr>::create()),
     _addPickingLayout(true),
-    _emulateMouseWithTouch(true)
+    _emulateMouseWithTouch(true),
+    _pendingEvents(0)
 {
 }
 
 void
 Picking::initialize(NodePtr             camera,
                     bool                addPickingLayout, 
-                    bool                emulateMouseWithTouch)
+                    bool                emulateMouseWithTouch,
+                    bool                asynchronous)
 {
     _camera = camera;
     _emulateMouseWithTouch = emulateMouseWithTouch;
     _addPickingLayout = addPickingLayout;
+    _asynchronous = asynchronous;
 
     _pickingProvider->set("projection", _pickingProjection);
 
@@ -183,19 +191,7 @@ Picking::bindSignals()
         std::placeholders::_2,
         std::placeholders::_3));
 
-        _executeMoveHandler = false;
-        _executeRightClickHandler = false;
-        _executeLeftClickHandler = false;
-        _executeRightDownHandler = false;
-        _executeLeftDownHandler = false;
-        _executeRightUpHandler = false;
-        _executeLeftUpHandler = false;
-        _executeTouchDownHandler = false;
-        _executeTouchUpHandler = false;
-        _executeTouchMoveHandler = false;
-        _executeTapHandler = false;
-        _executeDoubleTapHandler = false;
-        _executeLongHoldHandler = false;
+    _pendingEvents = 0;
 }
 
 void
@@ -216,6 +212,33 @@ Picking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
     _renderer = Renderer::create(0xFFFF00FF, nullptr, _sceneManager->assets()->effect("effect/Picking.effect"), 1000.f, "Picking Renderer");
     _renderer->scissor(0, 0, 1, 1);
     _renderer->layoutMask(scene::Layout::Group::PICKING);
+
+    // each pick request of a frame is rendered into its own pixel of a single target
+    _renderTarget = render::Texture::create(_context, MAX_NUM_PICK_REQUESTS, 1, false, true);
+    _renderTarget->upload();
+
+    if (_asynchronous)
+    {
+        // the pointer is picked along with the other requests: the renderer is only enabled to render them
+        _renderer->enabled(false);
+        _readbackQueue = render::ReadbackQueue::create(_context);
+    }
+
+    _frameBeginSlot = _sceneManager->frameBegin()->connect(std::bind(
+        &Picking::frameBeginHandler,
+        std::static_pointer_cast<Picking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
+    _sceneRenderingEndSlot = _sceneManager->renderingEnd()->connect(std::bind(
+        &Picking::sceneRenderingEndHandler,
+        std::static_pointer_cast<Picking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ), _renderer->priority());
     
     updateDescendants(target);
 
@@ -235,6 +258,22 @@ Picking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
         std::placeholders::_3
     ));
 
+    _childrenAddedSlot = target->childrenAdded()->connect(std::bind(
+        &Picking::childrenAddedHandler,
+        std::static_pointer_cast<Picking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
+    _childrenRemovedSlot = target->childrenRemoved()->connect(std::bind(
+        &Picking::childrenRemovedHandler,
+        std::static_pointer_cast<Picking>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
     if (target->parent() != nullptr || target->hasComponent<SceneManager>())
         addedHandler(target, target, target->parent());
 
@@ -253,9 +292,18 @@ Picking::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
 {
     _renderer = nullptr;
     _sceneManager = nullptr;
+    _renderTarget->dispose();
+    _renderTarget = nullptr;
+    _readbackQueue = nullptr;
+    _pickRequests.clear();
+
+    _frameBeginSlot = nullptr;
+    _sceneRenderingEndSlot = nullptr;
 
     _addedSlot = nullptr;
     _removedSlot = nullptr;
+    _childrenAddedSlot = nullptr;
+    _childrenRemovedSlot = nullptr;
 
     removedHandler(target->root(), target, target->parent());
 }
@@ -263,6 +311,10 @@ Picking::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
 void
 Picking::addedHandler(NodePtr target, NodePtr child, NodePtr parent)
 {
+    // added descendants are handled all at once by childrenAddedHandler()
+    if (child->depth() > target->depth())
+        return;
+
     updateDescendants(target);
 
     if (std::find(_descendants.begin(), _descendants.end(), child) == _descendants.end())
@@ -392,6 +444,10 @@ Picking::removeSurface(SurfacePtr surface, NodePtr node)
 void
 Picking::removedHandler(NodePtr target, NodePtr child, NodePtr parent)
 {
+    // removed descendants are handled all at once by childrenRemovedHandler()
+    if (child->root() != target->root())
+        return;
+
     if (std::find(_descendants.begin(), _descendants.end(), child) == _descendants.end())
         return;
 
@@ -406,6 +462,25 @@ Picking::removedHandler(NodePtr target, NodePtr child, NodePtr parent)
     updateDescendants(target);
 }
 
+void
+Picking::childrenAddedHandler(NodePtr target, const std::vector<NodePtr>& children, NodePtr parent)
+{
+    updateDescendants(target);
+
+    // parent is target or one of its descendants: so are all the children
+    for (auto child : children)
+        addSurfacesForNode(child);
+}
+
+void
+Picking::childrenRemovedHandler(NodePtr target, const std::vector<NodePtr>& children, NodePtr parent)
+{
+    for (auto child : children)
+        removeSurfacesForNode(child);
+
+    updateDescendants(target);
+}
+
 void
 Picking::addSurfacesForNode(NodePtr node)
 {
@@ -443,6 +518,9 @@ Picking::removeSurfacesForNode(NodePtr node)
 void
 Picking::renderingBegin(RendererPtr renderer)
 {
+    if (_renderingPickRequests)
+        return;
+
     float mouseX = (float)_mouse->x();
     float mouseY = (float)_mouse->y();
 
@@ -460,146 +538,254 @@ Picking::renderingBegin(RendererPtr renderer)
 void
 Picking::renderingEnd(RendererPtr renderer)
 {
+    if (_renderingPickRequests)
+        return;
+
     _context->readPixels(0, 0, 1, 1, &_lastColor[0]);
 
-    uint pickedSurfaceId = (_lastColor[0] << 16) + (_lastColor[1] << 8) + _lastColor[2];
+    updatePickedSurface(pickedSurface(&_lastColor[0]));
 
-    if (_lastPickedSurface != _pickingIdToSurface[pickedSurfaceId])
-    {
-        if (_lastPickedSurface && _mouseOut->numCallbacks() > 0)
-            _mouseOut->execute(_lastPickedSurface->targets()[0]);
+    auto events = _pendingEvents;
 
-        _lastPickedSurface = _pickingIdToSurface[pickedSurfaceId];
+    _pendingEvents = 0;
 
-        if (_lastPickedSurface && _mouseOver->numCallbacks() > 0)
-            _mouseOver->execute(_lastPickedSurface->targets()[0]);
-    }
+    if (!(_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0))
+        _renderer->enabled(false);
 
-    if (_executeMoveHandler && _lastPickedSurface)
-    {
-        _mouseMove->execute(_lastPickedSurface->targets()[0]);
-    }
+    executeHandlers(events);
+}
 
-    if (_executeRightDownHandler && _lastPickedSurface)
-    {
-        _mouseRightDown->execute(_lastPickedSurface->targets()[0]);
-    }
+void
+Picking::pick(float x, float y, const PickCallback& callback)
+{
+    PickRequest request;
 
-    if (_executeLeftDownHandler && _lastPickedSurface)
-    {
-        _mouseLeftDown->execute(_lastPickedSurface->targets()[0]);
-    }
+    request.x = x;
+    request.y = y;
+    request.events = 0;
+    request.callback = callback;
 
-    if (_executeRightClickHandler && _lastPickedSurface)
-    {
-        _mouseRightClick->execute(_lastPickedSurface->targets()[0]);
-    }
+    _pickRequests.push_back(request);
+}
 
-    if (_executeLeftClickHandler && _lastPickedSurface)
-    {
-        _mouseLeftClick->execute(_lastPickedSurface->targets()[0]);
-    }
+void
+Picking::frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+    if (_readbackQueue)
+        _readbackQueue->update();
+}
 
-    if (_executeRightUpHandler && _lastPickedSurface)
+void
+Picking::sceneRenderingEndHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget)
+{
+    if (_asynchronous && (_pendingEvents != 0 || _mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0))
     {
-        _mouseRightUp->execute(_lastPickedSurface->targets()[0]);
-    }
+        PickRequest request;
 
-    if (_executeLeftUpHandler && _lastPickedSurface)
-    {
-        _mouseLeftUp->execute(_lastPickedSurface->targets()[0]);
-    }
+        request.x = (float)_mouse->x();
+        request.y = (float)_mouse->y();
+        request.events = _pendingEvents;
+        request.callback = nullptr;
 
-    if (_executeTouchDownHandler && _lastPickedSurface)
-    {
-        _touchDown->execute(_lastPickedSurface->targets()[0]);
+        _pickRequests.push_back(request);
+        _pendingEvents = 0;
     }
 
-    if (_executeTouchUpHandler && _lastPickedSurface)
-    {
-        _touchUp->execute(_lastPickedSurface->targets()[0]);
-    }
+    if (!_pickRequests.empty())
+        renderPickRequests();
+}
+
+void
+Picking::renderPickRequests()
+{
+    auto numRequests    = std::min<uint>(_pickRequests.size(), MAX_NUM_PICK_REQUESTS);
+    auto requests       = std::vector<PickRequest>(_pickRequests.begin(), _pickRequests.begin() + numRequests);
 
-    if (_executeTouchMoveHandler && _lastPickedSurface)
+    _pickRequests.erase(_pickRequests.begin(), _pickRequests.begin() + numRequests);
+
+    auto viewportWidth      = (float)_context->viewportWidth();
+    auto viewportHeight     = (float)_context->viewportHeight();
+    auto perspectiveCamera  = _camera->component<component::PerspectiveCamera>();
+    auto projection         = math::Matrix4x4::create()->perspective(perspectiveCamera->fieldOfView(), perspectiveCamera->aspectRatio(), perspectiveCamera->zNear(), perspectiveCamera->zFar());
+    auto& p                 = projection->data();
+    auto enabled            = _renderer->enabled();
+
+    std::vector<float> pickingProjectionData(16);
+
+    _renderingPickRequests = true;
+    _renderer->enabled(true);
+
+    for (uint i = 0; i < numRequests; ++i)
     {
-        _touchMove->execute(_lastPickedSurface->targets()[0]);
+        // scale the projection around the requested pixel so that it covers the whole 1x1 viewport
+        auto x = 2.f * (requests[i].x + .5f) / viewportWidth - 1.f;
+        auto y = 1.f - 2.f * (requests[i].y + .5f) / viewportHeight;
+
+        for (uint j = 0; j < 4; ++j)
+        {
+            pickingProjectionData[j] = viewportWidth * (p[j] - x * p[12 + j]);
+            pickingProjectionData[4 + j] = viewportHeight * (p[4 + j] - y * p[12 + j]);
+            pickingProjectionData[8 + j] = p[8 + j];
+            pickingProjectionData[12 + j] = p[12 + j];
+        }
+
+        _pickingProjection->initialize(pickingProjectionData);
+
+        _renderer->viewport(i, 0, 1, 1);
+        _renderer->scissor(i, 0, 1, 1);
+        _renderer->render(_context, _renderTarget);
     }
 
-    if (_executeTapHandler && _lastPickedSurface)
+    _renderer->viewport(0, 0, -1, -1);
+    _renderer->scissor(0, 0, 1, 1);
+    _renderer->enabled(enabled);
+    _renderingPickRequests = false;
+
+    _context->setRenderToTexture(_renderTarget->id(), true);
+
+    if (_asynchronous)
     {
-        _tap->execute(_lastPickedSurface->targets()[0]);
-    }
+        // the queue is owned by this component: its callbacks cannot outlive it
+        _readbackQueue->read(0, 0, numRequests, 1, [=](const std::vector<unsigned char>& pixels)
+        {
+            resolvePickRequests(requests, pixels);
+        });
 
-    if (_executeDoubleTapHandler && _lastPickedSurface)
+        _context->setRenderToBackBuffer();
+    }
+    else
     {
-        _doubleTap->execute(_lastPickedSurface->targets()[0]);
+        std::vector<unsigned char> pixels(numRequests * 4);
+
+        _context->readPixels(0, 0, numRequests, 1, &pixels[0]);
+        _context->setRenderToBackBuffer();
+
+        resolvePickRequests(requests, pixels);
     }
+}
 
-    if (_executeLongHoldHandler && _lastPickedSurface)
+void
+Picking::resolvePickRequests(const std::vector<PickRequest>&    requests,
+                             const std::vector<unsigned char>&  pixels)
+{
+    for (uint i = 0; i < requests.size(); ++i)
     {
-        _longHold->execute(_lastPickedSurface->targets()[0]);
+        auto& request = requests[i];
+        auto surface = pickedSurface(&pixels[i * 4]);
+
+        if (request.callback)
+            request.callback(surface ? surface->targets()[0] : nullptr);
+        else
+        {
+            updatePickedSurface(surface);
+            executeHandlers(request.events);
+        }
     }
+}
 
-    if (!(_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0))
-        _renderer->enabled(false);
+Picking::SurfacePtr
+Picking::pickedSurface(const unsigned char* color)
+{
+    uint pickedSurfaceId = (color[0] << 16) + (color[1] << 8) + color[2];
+    auto surfaceIt = _pickingIdToSurface.find(pickedSurfaceId);
 
-    _executeMoveHandler = false;
-    _executeRightDownHandler = false;
-    _executeLeftDownHandler = false;
-    _executeRightClickHandler = false;
-    _executeLeftClickHandler = false;
-    _executeRightUpHandler = false;
-    _executeLeftUpHandler = false;
+    return surfaceIt != _pickingIdToSurface.end() ? surfaceIt->second : nullptr;
+}
+
+void
+Picking::updatePickedSurface(SurfacePtr surface)
+{
+    if (_lastPickedSurface == surface)
+        return;
+
+    if (_lastPickedSurface && _mouseOut->numCallbacks() > 0)
+        _mouseOut->execute(_lastPickedSurface->targets()[0]);
+
+    _lastPickedSurface = surface;
+
+    if (_lastPickedSurface && _mouseOver->numCallbacks() > 0)
+        _mouseOver->execute(_lastPickedSurface->targets()[0]);
+}
+
+void
+Picking::executeHandlers(uint events)
+{
+    if (!_lastPickedSurface)
+        return;
+
+    auto target = _lastPickedSurface->targets()[0];
+
+    if (events & Event::MOUSE_MOVE)
+        _mouseMove->execute(target);
+    if (events & Event::MOUSE_RIGHT_DOWN)
+        _mouseRightDown->execute(target);
+    if (events & Event::MOUSE_LEFT_DOWN)
+        _mouseLeftDown->execute(target);
+    if (events & Event::MOUSE_RIGHT_CLICK)
+        _mouseRightClick->execute(target);
+    if (events & Event::MOUSE_LEFT_CLICK)
+        _mouseLeftClick->execute(target);
+    if (events & Event::MOUSE_RIGHT_UP)
+        _mouseRightUp->execute(target);
+    if (events & Event::MOUSE_LEFT_UP)
+        _mouseLeftUp->execute(target);
+    if (events & Event::TOUCH_DOWN)
+        _touchDown->execute(target);
+    if (events & Event::TOUCH_UP)
+        _touchUp->execute(target);
+    if (events & Event::TOUCH_MOVE)
+        _touchMove->execute(target);
+    if (events & Event::TAP)
+        _tap->execute(target);
+    if (events & Event::DOUBLE_TAP)
+        _doubleTap->execute(target);
+    if (events & Event::LONG_HOLD)
+        _longHold->execute(target);
+}
+
+void
+Picking::requestEvent(uint event)
+{
+    _pendingEvents |= event;
+
+    // the asynchronous mode picks the pointer along with the other requests of the frame
+    if (!_asynchronous)
+        _renderer->enabled(true);
 }
 
 void
 Picking::mouseMoveHandler(MousePtr mouse, int dx, int dy)
 {
     if (_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0)
-    {
-        _executeMoveHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_MOVE);
 }
 
 void
 Picking::mouseRightUpHandler(MousePtr mouse)
 {
     if (_mouseRightUp->numCallbacks() > 0)
-    {
-        _executeRightUpHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_RIGHT_UP);
 }
 
 void
 Picking::mouseLeftUpHandler(MousePtr mouse)
 {
     if (_mouseLeftUp->numCallbacks() > 0)
-    {
-        _executeLeftUpHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_LEFT_UP);
 }
 
 void
 Picking::mouseRightClickHandler(MousePtr mouse)
 {
     if (_mouseRightClick->numCallbacks() > 0)
-    {
-        _executeRightClickHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_RIGHT_CLICK);
 }
 
 void
 Picking::mouseLeftClickHandler(MousePtr mouse)
 {
     if (_mouseLeftClick->numCallbacks() > 0)
-    {
-        _executeLeftClickHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_LEFT_CLICK);
 }
 
 void
@@ -607,34 +793,24 @@ Picking::mouseRightDownHandler(MousePtr mouse)
 {
 
     if (_mouseRightDown->numCallbacks() > 0)
-    {
-        _executeRightDownHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_RIGHT_DOWN);
 }
 
 void
 Picking::mouseLeftDownHandler(MousePtr mouse)
 {
     if (_mouseLeftDown->numCallbacks() > 0)
-    {
-        _executeLeftDownHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::MOUSE_LEFT_DOWN);
 }
 
 void
 Picking::touchDownHandler(TouchPtr touch, int identifier, float x, float y)
 {
     if (_touchDown->numCallbacks() > 0)
-    {
-        _executeTouchDownHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::TOUCH_DOWN);
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseLeftDown->numCallbacks() > 0)
     {
-        _executeLeftDownHandler = true;
-        _renderer->enabled(true);
+        requestEvent(Event::MOUSE_LEFT_DOWN);
     }
 }
 
@@ -642,14 +818,10 @@ void
 Picking::touchUpHandler(TouchPtr touch, int identifier, float x, float y)
 {
     if (_touchUp->numCallbacks() > 0)
-    {
-        _executeTouchUpHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::TOUCH_UP);
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseLeftUp->numCallbacks() > 0)
     {
-        _executeLeftUpHandler = true;
-        _renderer->enabled(true);
+        requestEvent(Event::MOUSE_LEFT_UP);
     }
 }
 
@@ -657,14 +829,10 @@ void
 Picking::touchMoveHandler(TouchPtr touch, int identifier, float x, float y)
 {
     if (_touchMove->numCallbacks() > 0)
-    {
-        _executeTouchMoveHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::TOUCH_MOVE);
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseMove->numCallbacks() > 0)
     {
-        _executeMoveHandler = true;
-        _renderer->enabled(true);
+        requestEvent(Event::MOUSE_MOVE);
     }
 }
 
@@ -672,14 +840,10 @@ void
 Picking::touchTapHandler(TouchPtr touch, float x, float y)
 {
     if (_tap->numCallbacks() > 0)
-    {
-        _executeTapHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::TAP);
     if (_emulateMouseWithTouch && _mouseLeftClick->numCallbacks() > 0)
     {
-        _executeLeftClickHandler = true;
-        _renderer->enabled(true);
+        requestEvent(Event::MOUSE_LEFT_CLICK);
     }
 }
 
@@ -687,24 +851,17 @@ void
 Picking::touchDoubleTapHandler(TouchPtr touch, float x, float y)
 {
     if (_doubleTap->numCallbacks() > 0)
-    {
-        _executeDoubleTapHandler = true;
-        _renderer->enabled(true);
-    }
+        requestEvent(Event::DOUBLE_TAP);
 }
 
 void
 Picking::touchLongHoldHandler(TouchPtr touch, float x, float y)
 {
-    if (_doubleTap->numCallbacks() > 0)
-    {
-        _executeDoubleTapHandler = true;
-        _renderer->enabled(true);
-    }
+    if (_longHold->numCallbacks() > 0)
+        requestEvent(Event::LONG_HOLD);
     if (_emulateMouseWithTouch && _mouseRightClick->numCallbacks() > 0)
     {
-        _executeRightClickHandler = true;
-        _renderer->enabled(true);
+        requestEvent(Event::MOUSE_RIGHT_CLICK);
     }
 }
 
@@ -32,6 +32,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/DrawCallPool.hpp"
 #include "minko/data/AbstractFilter.hpp"
 #include "minko/data/LightMaskFilter.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector4.hpp"
+#include "minko/render/TextureStreamer.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -48,6 +53,11 @@ Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
     _viewportBox(),
     _scissorBox(),
     _enabled(true),
+    _instancing(false),
+    _textureStreamer(nullptr),
+    _screenSizes(),
+    _screenSizeProjection(),
+    _screenSizeProjectionId(0),
     _renderingBegin(Signal<Ptr>::create()),
     _renderingEnd(Signal<Ptr>::create()),
     _beforePresent(Signal<Ptr>::create()),
@@ -77,6 +87,11 @@ Renderer::Renderer(const Renderer& renderer, const CloneOption& option) :
 	_viewportBox(),
 	_scissorBox(),
 	_enabled(renderer._enabled),
+	_instancing(renderer._instancing),
+	_textureStreamer(renderer._textureStreamer),
+	_screenSizes(),
+	_screenSizeProjection(),
+	_screenSizeProjectionId(0),
 	_renderingBegin(Signal<Ptr>::create()),
 	_renderingEnd(Signal<Ptr>::create()),
 	_beforePresent(Signal<Ptr>::create()),
@@ -181,7 +196,7 @@ Renderer::addedHandler(std::shared_ptr<Node> node,
 {
     findSceneManager();
 
-    _rootDescendantAddedSlot = target->root()->added()->connect(std::bind(
+    _rootDescendantAddedSlot = target->root()->childrenAdded()->connect(std::bind(
         &Renderer::rootDescendantAddedHandler,
         std::static_pointer_cast<Renderer>(shared_from_this()),
         std::placeholders::_1,
@@ -189,7 +204,7 @@ Renderer::addedHandler(std::shared_ptr<Node> node,
         std::placeholders::_3
     ));
 
-    _rootDescendantRemovedSlot = target->root()->removed()->connect(std::bind(
+    _rootDescendantRemovedSlot = target->root()->childrenRemoved()->connect(std::bind(
         &Renderer::rootDescendantRemovedHandler,
         std::static_pointer_cast<Renderer>(shared_from_this()),
         std::placeholders::_1,
@@ -215,7 +230,7 @@ Renderer::addedHandler(std::shared_ptr<Node> node,
 
     _lightMaskFilter->root(target->root());
 
-    rootDescendantAddedHandler(nullptr, target->root(), nullptr);
+    rootDescendantAddedHandler(nullptr, std::vector<NodePtr>(1, target->root()), nullptr);
 }
 
 void
@@ -230,15 +245,15 @@ Renderer::removedHandler(std::shared_ptr<Node> node,
     _componentAddedSlot            = nullptr;
     _componentRemovedSlot        = nullptr;
 
-    rootDescendantRemovedHandler(nullptr, target->root(), nullptr);
+    rootDescendantRemovedHandler(nullptr, std::vector<NodePtr>(1, target->root()), nullptr);
 }
 
 void
-Renderer::rootDescendantAddedHandler(std::shared_ptr<Node> node,
-                                      std::shared_ptr<Node> target,
-                                      std::shared_ptr<Node> parent)
+Renderer::rootDescendantAddedHandler(std::shared_ptr<Node>                      node,
+                                     const std::vector<std::shared_ptr<Node>>&  targets,
+                                     std::shared_ptr<Node>                      parent)
 {
-    auto surfaceNodes = NodeSet::create(target)
+    auto surfaceNodes = NodeSet::create(targets)
         ->descendants(true)
         ->where([](scene::Node::Ptr node)
         {
@@ -251,11 +266,11 @@ Renderer::rootDescendantAddedHandler(std::shared_ptr<Node> node,
 }
 
 void
-Renderer::rootDescendantRemovedHandler(std::shared_ptr<Node> node,
-                                        std::shared_ptr<Node> target,
-                                        std::shared_ptr<Node> parent)
+Renderer::rootDescendantRemovedHandler(std::shared_ptr<Node>                    node,
+                                       const std::vector<std::shared_ptr<Node>>& targets,
+                                       std::shared_ptr<Node>                    parent)
 {
-    auto surfaceNodes = NodeSet::create(target)
+    auto surfaceNodes = NodeSet::create(targets)
         ->descendants(true)
         ->where([](scene::Node::Ptr node)
         {
@@ -305,6 +320,7 @@ void
 Renderer::removeSurface(Surface::Ptr surface)
 {
     _drawCallPool->removeSurface(surface);
+    _screenSizes.erase(surface);
 }
 
 void
@@ -314,6 +330,7 @@ Renderer::render(render::AbstractContext::Ptr    context,
     if (!_enabled)
         return;
 
+    _drawCallPool->instancing(_instancing && context->supportsInstancing());
     _drawCalls = _drawCallPool->drawCalls();
 
     _renderingBegin->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
@@ -341,9 +358,21 @@ Renderer::render(render::AbstractContext::Ptr    context,
            (_backgroundColor & 0xff) / 255.f
        );
 
+    DrawCallPtr previous = nullptr;
+    auto worldToScreen = _textureStreamer ? updateScreenSizeProjection(context) : nullptr;
+
     for (auto& drawCall : _drawCalls)
-        if ((drawCall->layouts() & layoutMask()) != 0)
-            drawCall->render(context, rt, _viewportBox);
+        if (!drawCall->culled() && (drawCall->layouts() & layoutMask()) != 0)
+        {
+            drawCall->render(context, rt, _viewportBox, previous);
+            previous = drawCall;
+
+            if (_textureStreamer)
+                requestTextures(drawCall, worldToScreen);
+        }
+
+    if (_textureStreamer)
+        _textureStreamer->update();
 
     _beforePresent->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
 
@@ -352,6 +381,141 @@ Renderer::render(render::AbstractContext::Ptr    context,
     _renderingEnd->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
 }
 
+math::Matrix4x4::Ptr
+Renderer::updateScreenSizeProjection(AbsContext context)
+{
+    auto cameraData = targets()[0]->data();
+
+    if (!cameraData->hasProperty("camera.worldToScreenMatrix"))
+        return nullptr;
+
+    auto worldToScreen = cameraData->get<math::Matrix4x4::Ptr>("camera.worldToScreenMatrix");
+    auto projection = std::array<float, 18>();
+
+    std::copy(worldToScreen->data().begin(), worldToScreen->data().end(), projection.begin());
+    projection[16] = float(_viewportBox.width >= 0 ? _viewportBox.width : context->viewportWidth());
+    projection[17] = float(_viewportBox.height >= 0 ? _viewportBox.height : context->viewportHeight());
+
+    if (projection != _screenSizeProjection)
+    {
+        _screenSizeProjection = projection;
+        ++_screenSizeProjectionId;
+    }
+
+    return worldToScreen;
+}
+
+void
+Renderer::requestTextures(DrawCallPtr drawCall, Matrix4x4Ptr worldToScreen)
+{
+    const auto& textures = drawCall->textures();
+
+    if (textures.empty())
+        return;
+
+    auto surface = _drawCallPool->surface(drawCall);
+
+    if (surface == nullptr)
+        return;
+
+    const auto& node = surface->targets()[0];
+
+    // surfaces without bounding box request the full resolution
+    auto screenSize = std::numeric_limits<float>::max();
+
+    if (worldToScreen != nullptr && node->hasComponent<BoundingBox>())
+    {
+        const auto& worldBox = node->component<BoundingBox>()->box();
+        const auto& bottomLeft = worldBox->bottomLeft();
+        const auto& topRight = worldBox->topRight();
+        const std::array<float, 6> box = {{
+            bottomLeft->x(), bottomLeft->y(), bottomLeft->z(),
+            topRight->x(), topRight->y(), topRight->z()
+        }};
+
+        auto screenSizeIt = _screenSizes.find(surface);
+
+        if (screenSizeIt == _screenSizes.end())
+            screenSizeIt = _screenSizes.insert(std::make_pair(surface, ScreenSize())).first;
+        else if (screenSizeIt->second.projectionId == _screenSizeProjectionId && screenSizeIt->second.box == box)
+            screenSize = screenSizeIt->second.size;
+
+        if (screenSize == std::numeric_limits<float>::max())
+        {
+            auto& cached = screenSizeIt->second;
+
+            cached.box = box;
+            cached.projectionId = _screenSizeProjectionId;
+            cached.size = computeScreenSize(
+                worldToScreen->data().data(), box, _screenSizeProjection[16], _screenSizeProjection[17]
+            );
+            screenSize = cached.size;
+        }
+    }
+
+    for (const auto& texture : textures)
+        if (texture)
+            _textureStreamer->requestSize(texture, screenSize);
+}
+
+/*static*/
+float
+Renderer::computeScreenSize(const float* m, const std::array<float, 6>& box, float width, float height)
+{
+    auto minX = std::numeric_limits<float>::max();
+    auto minY = std::numeric_limits<float>::max();
+    auto maxX = -std::numeric_limits<float>::max();
+    auto maxY = -std::numeric_limits<float>::max();
+
+    for (auto i = 0; i < 8; ++i)
+    {
+        const auto x = box[(i & 1) * 3];
+        const auto y = box[((i >> 1) & 1) * 3 + 1];
+        const auto z = box[((i >> 2) & 1) * 3 + 2];
+        const auto w = x * m[12] + y * m[13] + z * m[14] + m[15];
+
+        // surfaces crossing the near plane request the full resolution
+        if (w <= 0.f)
+            return std::numeric_limits<float>::max();
+
+        const auto screenX = (x * m[0] + y * m[1] + z * m[2] + m[3]) / w;
+        const auto screenY = (x * m[4] + y * m[5] + z * m[6] + m[7]) / w;
+
+        minX = std::min(minX, screenX);
+        minY = std::min(minY, screenY);
+        maxX = std::max(maxX, screenX);
+        maxY = std::max(maxY, screenY);
+    }
+
+    return std::max((maxX - minX) * .5f * width, (maxY - minY) * .5f * height);
+}
+
+render::DrawCallSortMode
+Renderer::sortMode() const
+{
+    return _drawCallPool->sortMode();
+}
+
+Renderer::Ptr
+Renderer::sortMode(render::DrawCallSortMode value)
+{
+    _drawCallPool->sortMode(value);
+
+    return std::static_pointer_cast<Renderer>(shared_from_this());
+}
+
+bool
+Renderer::culled(Surface::Ptr surface) const
+{
+    return _drawCallPool->culled(surface);
+}
+
+void
+Renderer::culled(Surface::Ptr surface, bool value)
+{
+    _drawCallPool->culled(surface, value);
+}
+
 void
 Renderer::findSceneManager()
 {
@@ -33,6 +33,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/component/MasterAnimation.hpp>
 #include <minko/component/Animation.hpp>
 #include <minko/component/Transform.hpp>
+#include <minko/async/ThreadPool.hpp>
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+# include <xmmintrin.h>
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+# include <arm_neon.h>
+#endif
 
 using namespace minko;
 using namespace minko::data;
@@ -51,6 +58,7 @@ using namespace minko::render;
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_IDS_B        = "boneIdsB";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_A    = "boneWeightsA";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_B    = "boneWeightsB";
+/*static*/ const uint           Skinning::SOFTWARE_SKINNING_GRAIN_SIZE  = 1024;
 
 Skinning::Skinning(const Skin::Ptr                        skin,
                    SkinningMethod                        method,
@@ -68,6 +76,10 @@ Skinning::Skinning(const Skin::Ptr                        skin,
     _targetGeometry(),
     _targetInputPositions(),
     _targetInputNormals(),
+    _targetSkinnedFrameId(),
+    _numPaddedVertexBones(0),
+    _paddedVertexBoneOffsets(),
+    _paddedVertexBoneWeights(),
     _targetAddedSlot(nullptr)
 {
 }
@@ -83,6 +95,10 @@ Skinning::Skinning(const Skinning& skinning, const CloneOption& option) :
 	_targetGeometry(),
 	_targetInputPositions(),
 	_targetInputNormals(),
+	_targetSkinnedFrameId(),
+	_numPaddedVertexBones(0),
+	_paddedVertexBoneOffsets(),
+	_paddedVertexBoneWeights(),
 	_targetAddedSlot(nullptr)
 {	
 	_skin = skinning._skin->clone();
@@ -129,6 +145,9 @@ Skinning::initialize()
         ? nullptr
         : createVertexBufferForBones();
 
+    if (_method == SkinningMethod::SOFTWARE)
+        initializeSoftwareSkinning();
+
     _maxTime = _skin->duration();
 
     setPlaybackWindow(0, _maxTime)->seek(0);
@@ -205,6 +224,8 @@ Skinning::removedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
         _targetInputPositions.erase(target);
     if (_targetInputNormals.count(target) > 0)
         _targetInputNormals.erase(target);
+    if (_targetSkinnedFrameId.count(target) > 0)
+        _targetSkinnedFrameId.erase(target);
 }
 
 VertexBuffer::Ptr
@@ -285,105 +306,271 @@ Skinning::updateFrame(unsigned int    frameId,
         uniformArray->second        = &(boneMatrices[0]);
     }
     else
-        performSoftwareSkinning(target, boneMatrices);
+        performSoftwareSkinning(target, frameId);
+}
+
+void
+Skinning::initializeSoftwareSkinning()
+{
+    const unsigned int numVertices = _skin->numVertices();
+
+    _numPaddedVertexBones = std::max(_skin->maxNumVertexBones(), 1u);
+    _paddedVertexBoneOffsets.assign(numVertices * _numPaddedVertexBones, 0);
+    _paddedVertexBoneWeights.assign(numVertices * _numPaddedVertexBones, 0.0f);
+
+    for (unsigned int vId = 0; vId < numVertices; ++vId)
+    {
+        const unsigned int numVertexBones   = _skin->numVertexBones(vId);
+        unsigned int index                  = vId * _numPaddedVertexBones;
+
+        for (unsigned int j = 0; j < numVertexBones; ++j)
+        {
+            unsigned int    boneId      = 0;
+            float           boneWeight  = 0.0f;
+
+            _skin->vertexBoneData(vId, j, boneId, boneWeight);
+
+            if (boneWeight == 0.0f)
+                continue;
+
+            _paddedVertexBoneOffsets[index] = boneId << 4;
+            _paddedVertexBoneWeights[index] = boneWeight;
+            ++index;
+        }
+    }
 }
 
 void
-Skinning::performSoftwareSkinning(Node::Ptr                    target,
-                                 const std::vector<float>&    boneMatrices)
+Skinning::performSoftwareSkinning(Node::Ptr    target,
+                                  uint         frameId)
 {
 #ifdef DEBUG_SKINNING
     assert(target && _targetGeometry.count(target) > 0 && _targetInputPositions.count(target) > 0);
 #endif //DEBUG_SKINNING
 
-    auto geometry    = _targetGeometry[target];
-
-    // transform positions
-    auto                        xyzBuffer    = geometry->vertexBuffer(ATTRNAME_POSITION);
-    VertexBuffer::AttributePtr    xyzAttr        = nullptr;
-    for (auto& attr : xyzBuffer->attributes())
-        if (std::get<0>(*attr) == ATTRNAME_POSITION)
-            xyzAttr = attr;
+    auto        geometry            = _targetGeometry[target];
+    auto        lastFrameIdIt       = _targetSkinnedFrameId.find(target);
+    const auto& boneMatrices        = _skin->matrices(frameId);
+    const uint  numVertices         = _skin->numVertices();
+    auto        changedBones        = std::vector<char>();
 
-    performSoftwareSkinning(xyzAttr, xyzBuffer, _targetInputPositions[target], boneMatrices, false);
+    if (numVertices == 0)
+        return;
 
-    // transform normals
-    if (geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0)
+    // only the vertices moved by the bones whose matrices changed since the last skinned frame are dirty
+    if (lastFrameIdIt != _targetSkinnedFrameId.end())
     {
-        auto                        normalBuffer    = geometry->vertexBuffer(ATTRNAME_NORMAL);
-        VertexBuffer::AttributePtr    normalAttr        = nullptr;
-        for (auto& attr : normalBuffer->attributes())
-            if (std::get<0>(*attr) == ATTRNAME_NORMAL)
-                normalAttr = attr;
+        if (lastFrameIdIt->second == (int)frameId)
+            return;
+
+        const auto& lastBoneMatrices = _skin->matrices(lastFrameIdIt->second);
+
+        changedBones.resize(_skin->numBones());
+        for (uint boneId = 0; boneId < _skin->numBones(); ++boneId)
+            changedBones[boneId] = std::memcmp(
+                &boneMatrices[boneId << 4], &lastBoneMatrices[boneId << 4], 16 * sizeof(float)
+            ) != 0;
+    }
+
+    _targetSkinnedFrameId[target] = frameId;
 
-        performSoftwareSkinning(normalAttr, normalBuffer, _targetInputNormals[target], boneMatrices, true);
+    auto xyzBuffer      = geometry->vertexBuffer(ATTRNAME_POSITION);
+    auto normalBuffer   = geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0
+        ? geometry->vertexBuffer(ATTRNAME_NORMAL)
+        : nullptr;
+
+    SoftwareSkinningData data;
+
+    data.boneMatrices       = &boneMatrices[0];
+    data.vertexBoneOffsets  = &_paddedVertexBoneOffsets[0];
+    data.vertexBoneWeights  = &_paddedVertexBoneWeights[0];
+    data.numVertexBones     = _numPaddedVertexBones;
+    data.changedBones       = changedBones.empty() ? nullptr : &changedBones[0];
+    data.positionStride     = xyzBuffer->vertexSize();
+    data.inputPositions     = &_targetInputPositions[target][0] + std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION));
+    data.outputPositions    = &xyzBuffer->data()[0] + std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION));
+    data.normalStride       = 0;
+    data.inputNormals       = nullptr;
+    data.outputNormals      = nullptr;
+
+    if (normalBuffer)
+    {
+        data.normalStride   = normalBuffer->vertexSize();
+        data.inputNormals   = &_targetInputNormals[target][0] + std::get<2>(*normalBuffer->attribute(ATTRNAME_NORMAL));
+        data.outputNormals  = &normalBuffer->data()[0] + std::get<2>(*normalBuffer->attribute(ATTRNAME_NORMAL));
     }
+
+    // each chunk of vertices reports its own dirty range
+    const uint          numChunks   = (numVertices + SOFTWARE_SKINNING_GRAIN_SIZE - 1) / SOFTWARE_SKINNING_GRAIN_SIZE;
+    std::vector<uint>   dirtyBegins (numChunks, numVertices);
+    std::vector<uint>   dirtyEnds   (numChunks, 0);
+
+    async::ThreadPool::instance()->parallelFor(
+        0,
+        numVertices,
+        SOFTWARE_SKINNING_GRAIN_SIZE,
+        [&](uint begin, uint end)
+        {
+            const uint chunk = begin / SOFTWARE_SKINNING_GRAIN_SIZE;
+
+            skinVertices(data, begin, end, dirtyBegins[chunk], dirtyEnds[chunk]);
+        }
+    );
+
+    const uint dirtyBegin   = *std::min_element(dirtyBegins.begin(), dirtyBegins.end());
+    const uint dirtyEnd     = *std::max_element(dirtyEnds.begin(), dirtyEnds.end());
+
+    if (dirtyBegin >= dirtyEnd)
+        return;
+
+    // the positions are edited in place: ray casts must not hit the previous pose
+    geometry->invalidateTriangleBvh();
+
+    xyzBuffer->upload(dirtyBegin, dirtyEnd - dirtyBegin);
+    if (normalBuffer && normalBuffer != xyzBuffer)
+        normalBuffer->upload(dirtyBegin, dirtyEnd - dirtyBegin);
 }
 
+/*static*/
 void
-Skinning::performSoftwareSkinning(VertexBuffer::AttributePtr        attr,
-                                 VertexBuffer::Ptr                    vertexBuffer,
-                                 const std::vector<float>&            inputData,
-                                 const std::vector<float>&            boneMatrices,
-                                 bool                                doDeltaTransform)
+Skinning::skinVertices(const SoftwareSkinningData&  data,
+                       uint                         begin,
+                       uint                         end,
+                       uint&                        dirtyBegin,
+                       uint&                        dirtyEnd)
 {
-#ifdef DEBUG_SKINNING
-    assert(vertexBuffer && vertexBuffer->data().size() == inputData.size());
-    assert(attr && std::get<1>(*attr) == 3);
-    assert(boneMatrices.size() == (_skin->numBones() << 4));
-#endif // DEBUG_SKINNING
+    for (uint vId = begin; vId < end; ++vId)
+    {
+        const uint*     boneOffsets = data.vertexBoneOffsets + vId * data.numVertexBones;
+        const float*    boneWeights = data.vertexBoneWeights + vId * data.numVertexBones;
 
-    const unsigned int    vertexSize        = vertexBuffer->vertexSize();
-    std::vector<float>&    outputData        = vertexBuffer->data();
-    const unsigned int    numVertices        = outputData.size() / vertexSize;
+        if (data.changedBones)
+        {
+            bool changed = false;
 
-#ifdef DEBUG_SKINNING
-    assert(numVertices == _skin->numVertices());
-#endif // DEBUG_SKINNING
+            for (uint j = 0; j < data.numVertexBones && boneWeights[j] != 0.0f && !changed; ++j)
+                changed = data.changedBones[boneOffsets[j] >> 4] != 0;
 
-    unsigned int index = std::get<2>(*attr);
-    for (unsigned int vId = 0; vId < numVertices; ++vId)
-    {
-        const float x1 = inputData[index];
-        const float y1 = inputData[index+1];
-        const float z1 = inputData[index+2];
+            if (!changed)
+                continue;
+        }
 
-        float x2 = 0.0f;
-        float y2 = 0.0f;
-        float z2 = 0.0f;
+        dirtyBegin  = std::min(dirtyBegin, vId);
+        dirtyEnd    = vId + 1;
 
-        const unsigned int numVertexBones = _skin->numVertexBones(vId);
-        for (unsigned int j = 0; j < numVertexBones; ++j)
+        const float*    position    = data.inputPositions + vId * data.positionStride;
+        float*          outPosition = data.outputPositions + vId * data.positionStride;
+
+        // bone matrices are column-major: blend their columns once, then transform both the position
+        // and the normal with the blended matrix
+#if MINKO_SIMD == MINKO_SIMD_SSE
+        __m128 c0 = _mm_setzero_ps();
+        __m128 c1 = _mm_setzero_ps();
+        __m128 c2 = _mm_setzero_ps();
+        __m128 c3 = _mm_setzero_ps();
+
+        for (uint j = 0; j < data.numVertexBones && boneWeights[j] != 0.0f; ++j)
         {
-            unsigned int    boneId        = 0;
-            float            boneWeight    = 0.0f;
+            const float*    m = data.boneMatrices + boneOffsets[j];
+            const __m128    w = _mm_set1_ps(boneWeights[j]);
 
-            _skin->vertexBoneData(vId, j, boneId, boneWeight);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+        }
 
-            const float*    boneMatrix    = &(boneMatrices[boneId << 4]);
+        float result[4];
 
-            if (!doDeltaTransform)
-            {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1 + boneMatrix[12]);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1 + boneMatrix[13]);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1 + boneMatrix[14]);
-            }
-            else
+        _mm_storeu_ps(result, _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(position[0])), _mm_mul_ps(c1, _mm_set1_ps(position[1]))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(position[2])), c3)
+        ));
+        outPosition[0] = result[0];
+        outPosition[1] = result[1];
+        outPosition[2] = result[2];
+
+        if (data.inputNormals)
+        {
+            const float*    normal      = data.inputNormals + vId * data.normalStride;
+            float*          outNormal   = data.outputNormals + vId * data.normalStride;
+
+            _mm_storeu_ps(result, _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(normal[0])), _mm_mul_ps(c1, _mm_set1_ps(normal[1]))),
+                _mm_mul_ps(c2, _mm_set1_ps(normal[2]))
+            ));
+            outNormal[0] = result[0];
+            outNormal[1] = result[1];
+            outNormal[2] = result[2];
+        }
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+        float32x4_t c0 = vdupq_n_f32(0.0f);
+        float32x4_t c1 = vdupq_n_f32(0.0f);
+        float32x4_t c2 = vdupq_n_f32(0.0f);
+        float32x4_t c3 = vdupq_n_f32(0.0f);
+
+        for (uint j = 0; j < data.numVertexBones && boneWeights[j] != 0.0f; ++j)
+        {
+            const float*    m = data.boneMatrices + boneOffsets[j];
+            const float     w = boneWeights[j];
+
+            c0 = vmlaq_n_f32(c0, vld1q_f32(m), w);
+            c1 = vmlaq_n_f32(c1, vld1q_f32(m + 4), w);
+            c2 = vmlaq_n_f32(c2, vld1q_f32(m + 8), w);
+            c3 = vmlaq_n_f32(c3, vld1q_f32(m + 12), w);
+        }
+
+        float result[4];
+
+        vst1q_f32(result, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, position[0]), c1, position[1]), c2, position[2]));
+        outPosition[0] = result[0];
+        outPosition[1] = result[1];
+        outPosition[2] = result[2];
+
+        if (data.inputNormals)
+        {
+            const float*    normal      = data.inputNormals + vId * data.normalStride;
+            float*          outNormal   = data.outputNormals + vId * data.normalStride;
+
+            vst1q_f32(result, vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, normal[0]), c1, normal[1]), c2, normal[2]));
+            outNormal[0] = result[0];
+            outNormal[1] = result[1];
+            outNormal[2] = result[2];
+        }
+#else
+        float c[12] = { 0.0f };
+
+        for (uint j = 0; j < data.numVertexBones && boneWeights[j] != 0.0f; ++j)
+        {
+            const float*    m = data.boneMatrices + boneOffsets[j];
+            const float     w = boneWeights[j];
+
+            for (uint i = 0; i < 3; ++i)
             {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1);
+                c[i]        += w * m[i];
+                c[3 + i]    += w * m[4 + i];
+                c[6 + i]    += w * m[8 + i];
+                c[9 + i]    += w * m[12 + i];
             }
         }
 
-        outputData[index]    = x2;
-        outputData[index+1]    = y2;
-        outputData[index+2]    = z2;
+        const float x = position[0];
+        const float y = position[1];
+        const float z = position[2];
 
-        index += vertexSize;
-    }
+        for (uint i = 0; i < 3; ++i)
+            outPosition[i] = c[i] * x + c[3 + i] * y + c[6 + i] * z + c[9 + i];
 
-    vertexBuffer->upload();
+        if (data.inputNormals)
+        {
+            const float*    normal      = data.inputNormals + vId * data.normalStride;
+            float*          outNormal   = data.outputNormals + vId * data.normalStride;
+
+            for (uint i = 0; i < 3; ++i)
+                outNormal[i] = c[i] * normal[0] + c[3 + i] * normal[1] + c[6 + i] * normal[2];
+        }
+#endif
+    }
 }
 
 void
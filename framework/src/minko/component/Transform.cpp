@@ -111,6 +111,13 @@ Transform::targetRemovedHandler(AbstractComponent::Ptr ctrl,
     _removedSlot = nullptr;
 }
 
+Transform::RootTransform::RootTransform() :
+    minko::component::AbstractComponent(),
+    _numHoles(0),
+    _invalidLists(true)
+{
+}
+
 AbstractComponent::Ptr
 Transform::RootTransform::clone(const CloneOption& option)
 {
@@ -154,6 +161,20 @@ Transform::RootTransform::targetAddedHandler(AbstractComponent::Ptr     ctrl,
         std::placeholders::_2,
         std::placeholders::_3
     )));
+    _targetSlots.push_back(target->childrenAdded()->connect(std::bind(
+        &Transform::RootTransform::childrenAddedHandler,
+        std::static_pointer_cast<RootTransform>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
+    _targetSlots.push_back(target->childrenRemoved()->connect(std::bind(
+        &Transform::RootTransform::childrenRemovedHandler,
+        std::static_pointer_cast<RootTransform>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    )));
     _targetSlots.push_back(target->componentAdded()->connect(std::bind(
         &Transform::RootTransform::componentAddedHandler,
         std::static_pointer_cast<RootTransform>(shared_from_this()),
@@ -207,7 +228,11 @@ Transform::RootTransform::componentAddedHandler(scene::Node::Ptr        node,
             std::placeholders::_3
         ), 1000.f);
     else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-        _invalidLists = true;
+    {
+        // the transformed descendants of target must now be parented to it and stored after it
+        removeSubtree(target);
+        insertSubtree(target);
+    }
 }
 
 void
@@ -220,7 +245,11 @@ Transform::RootTransform::componentRemovedHandler(scene::Node::Ptr            no
     if (sceneManager)
         _renderingBeginSlot = nullptr;
     else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-        _invalidLists = true;
+    {
+        // the transformed descendants of target must now be parented to its closest transformed ancestor
+        removeSubtree(target);
+        insertSubtree(target);
+    }
 }
 
 void
@@ -228,7 +257,15 @@ Transform::RootTransform::addedHandler(scene::Node::Ptr node,
                                        scene::Node::Ptr target,
                                        scene::Node::Ptr ancestor)
 {
-    auto descendants = scene::NodeSet::create(target->root())->descendants(false);
+    // added descendants are handled all at once by childrenAddedHandler()
+    if (node != nullptr && target->depth() > node->depth())
+        return;
+
+    // only the added subtree can hold other RootTransform components
+    auto descendants = node == nullptr
+        ? scene::NodeSet::create(target->root())->descendants(false)
+        : scene::NodeSet::create(target)->descendants(true);
+
     for (auto descendant : descendants->nodes())
     {
         auto rootTransformCtrl = descendant->component<RootTransform>();
@@ -237,7 +274,10 @@ Transform::RootTransform::addedHandler(scene::Node::Ptr node,
             descendant->removeComponent(rootTransformCtrl);
     }
 
-    _invalidLists = true;
+    if (node == nullptr || targets().empty() || target == targets()[0])
+        _invalidLists = true;
+    else
+        insertSubtree(target);
 }
 
 void
@@ -245,138 +285,247 @@ Transform::RootTransform::removedHandler(scene::Node::Ptr node,
                                          scene::Node::Ptr target,
                                          scene::Node::Ptr ancestor)
 {
-    _invalidLists = true;
+    // removed descendants are handled all at once by childrenRemovedHandler()
+    if (target->root() != node->root())
+        return;
+
+    removeSubtree(target);
 }
 
 void
-Transform::RootTransform::updateTransformsList()
+Transform::RootTransform::childrenAddedHandler(scene::Node::Ptr                    node,
+                                               const std::vector<scene::Node::Ptr>& children,
+                                               scene::Node::Ptr                    parent)
 {
-    _transforms        .clear();
-    _modelToWorld    .clear();
-    _nodeToId        .clear();
-    _idToNode        .clear();
-    _parentId        .clear();
-    _firstChildId    .clear();
-    _numChildren    .clear();
-
-    auto withTransforms            = scene::NodeSet::create(targets())
-        ->descendants(true, false)
-        ->where([](scene::Node::Ptr n){ return n->hasComponent<Transform>(); });
-
-    auto nodesWithTransform    = withTransforms->nodes();
-
-    juxtaposeSiblings(nodesWithTransform); // make sure siblings are at contiguous positions in the vector
-
-    _transforms        .resize(nodesWithTransform.size());
-    _modelToWorld    .resize(nodesWithTransform.size());
-    _idToNode        .resize(nodesWithTransform.size());
-    _parentId        .resize(nodesWithTransform.size(), -1);
-    _firstChildId    .resize(nodesWithTransform.size(), 0);
-    _numChildren    .resize(nodesWithTransform.size(), 0);
-
-    for (uint nodeId = 0; nodeId < nodesWithTransform.size(); ++nodeId)
+    auto descendants = scene::NodeSet::create(children)->descendants(true);
+
+    for (auto descendant : descendants->nodes())
     {
-        auto    node        = nodesWithTransform[nodeId];
-        auto    transform    = node->component<Transform>();
-        auto    ancestor    = node->parent();
+        auto rootTransformCtrl = descendant->component<RootTransform>();
 
-        while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
-            ancestor = ancestor->parent();
+        if (rootTransformCtrl)
+            descendant->removeComponent(rootTransformCtrl);
+    }
+
+    // a Transform added to a child before its batch was committed already inserted it
+    for (auto child : children)
+    {
+        removeSubtree(child);
+        insertSubtree(child);
+    }
+}
 
-        _nodeToId[node]            = nodeId;
+void
+Transform::RootTransform::childrenRemovedHandler(scene::Node::Ptr                    node,
+                                                 const std::vector<scene::Node::Ptr>& children,
+                                                 scene::Node::Ptr                    parent)
+{
+    for (auto child : children)
+        removeSubtree(child);
+}
 
-        _transforms[nodeId]        = transform->_matrix;
-        _modelToWorld[nodeId]    = transform->_modelToWorld;
-        _idToNode[nodeId]        = node;
+void
+Transform::RootTransform::updateTransformsList()
+{
+    _transforms     .clear();
+    _modelToWorld   .clear();
+    _nodeToId       .clear();
+    _idToNode       .clear();
+    _parentId       .clear();
+    _worldMatrices  .clear();
+    _worldChanged   .clear();
+    _numHoles = 0;
+
+    for (auto target : targets())
+        appendSubtree(target, -1);
 
-        if (ancestor)
-        {
-            assert(_nodeToId.count(ancestor) > 0);
-            auto ancestorId = _nodeToId[ancestor];
+    _invalidLists = false;
+}
+
+void
+Transform::RootTransform::insertSubtree(scene::Node::Ptr node)
+{
+    if (_invalidLists)
+        return;
+
+    auto ancestor = node->parent();
+
+    while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
+        ancestor = ancestor->parent();
+
+    appendSubtree(node, ancestor != nullptr ? _nodeToId[ancestor] : -1);
+}
+
+void
+Transform::RootTransform::removeSubtree(scene::Node::Ptr node)
+{
+    if (_invalidLists)
+        return;
+
+    std::vector<NodePtr> stack(1, node);
+
+    while (!stack.empty())
+    {
+        auto descendant = stack.back();
+        auto it         = _nodeToId.find(descendant);
 
-            _parentId[nodeId]    = ancestorId;
+        stack.pop_back();
 
-            if (_numChildren[ancestorId] == 0)
-                _firstChildId[ancestorId] = nodeId;
-            ++_numChildren[ancestorId];
+        if (it != _nodeToId.end())
+        {
+            auto nodeId = it->second;
+
+            // leave a hole: the ids of the other nodes are stable until compactLists()
+            _transforms[nodeId]     = nullptr;
+            _modelToWorld[nodeId]   = nullptr;
+            _idToNode[nodeId]       = nullptr;
+            _parentId[nodeId]       = -1;
+            _worldChanged[nodeId]   = 0;
+            _nodeToId.erase(it);
+            ++_numHoles;
         }
+
+        stack.insert(stack.end(), descendant->children().begin(), descendant->children().end());
     }
+}
 
-    _invalidLists = false;
+void
+Transform::RootTransform::appendSubtree(scene::Node::Ptr node, int parentId)
+{
+    // depth-first: every node is appended after its closest transformed ancestor
+    std::vector<std::pair<NodePtr, int>> stack(1, std::make_pair(node, parentId));
+
+    while (!stack.empty())
+    {
+        auto descendant         = stack.back().first;
+        auto descendantParentId = stack.back().second;
+
+        stack.pop_back();
+
+        if (descendant->hasComponent<Transform>())
+            descendantParentId = appendNode(descendant, descendantParentId);
+
+        for (auto child : descendant->children())
+            stack.push_back(std::make_pair(child, descendantParentId));
+    }
+}
+
+unsigned int
+Transform::RootTransform::appendNode(scene::Node::Ptr node, int parentId)
+{
+    auto transform  = node->component<Transform>();
+    auto nodeId     = _idToNode.size();
+
+    _nodeToId[node] = nodeId;
+    _idToNode       .push_back(node);
+    _transforms     .push_back(transform->_matrix);
+    _modelToWorld   .push_back(transform->_modelToWorld);
+    _parentId       .push_back(parentId);
+    _worldChanged   .push_back(0);
+    _worldMatrices  .resize(nodeId + 1);
+
+    std::copy(transform->_modelToWorld->_m.begin(), transform->_modelToWorld->_m.end(), worldMatrix(nodeId));
+
+    // the parent might have changed: the world matrix has to be computed again
+    transform->_matrix->_hasChanged = true;
+
+    return nodeId;
 }
 
-/*static*/
 void
-Transform::RootTransform::juxtaposeSiblings(std::vector<NodePtr>& nodes)
+Transform::RootTransform::compactLists()
 {
-    // assumes 'nodes' is the result of a breadth-first search from the nodes
-    std::unordered_map<scene::Node::Ptr, unsigned int>    firstChild;
+    std::vector<int>    newIds(_idToNode.size(), -1);
+    unsigned int        numNodes = 0;
 
-    for (unsigned int nodeId = 0; nodeId < nodes.size(); ++nodeId)
+    // holes are removed in place: the relative order of the nodes, and thus the fact that
+    // parents are always stored before their children, is preserved
+    for (unsigned int nodeId = 0; nodeId < _idToNode.size(); ++nodeId)
     {
-        auto it            = nodes.begin() + nodeId;
-        auto node        = *it;
-        auto ancestor    = node->parent();
-        while (ancestor != nullptr
-            && std::find(nodes.begin(), it, ancestor) == nodes.end())
-            ancestor = ancestor->parent();
-
-        if (firstChild.count(ancestor) == 0)
-            firstChild[ancestor] = nodeId;
-        else
-        {
-            assert(firstChild[ancestor] <= nodeId);
+        if (_idToNode[nodeId] == nullptr)
+            continue;
 
-            nodes.erase(it);
-            nodes.insert(nodes.begin() + firstChild[ancestor], node);
-        }
+        auto parentId = _parentId[nodeId];
+
+        newIds[nodeId] = numNodes;
+
+        _idToNode[numNodes]     = _idToNode[nodeId];
+        _transforms[numNodes]   = _transforms[nodeId];
+        _modelToWorld[numNodes] = _modelToWorld[nodeId];
+        _parentId[numNodes]     = parentId >= 0 ? newIds[parentId] : -1;
+        _worldChanged[numNodes] = _worldChanged[nodeId];
+        _worldMatrices[numNodes] = _worldMatrices[nodeId];
+        _nodeToId[_idToNode[numNodes]] = numNodes;
+
+        ++numNodes;
     }
+
+    _idToNode       .resize(numNodes);
+    _transforms     .resize(numNodes);
+    _modelToWorld   .resize(numNodes);
+    _parentId       .resize(numNodes);
+    _worldChanged   .resize(numNodes);
+    _worldMatrices  .resize(numNodes);
+    _numHoles = 0;
 }
 
 void
 Transform::RootTransform::updateTransforms()
 {
-    unsigned int numNodes     = _transforms.size();
-    unsigned int nodeId     = 0;
+    unsigned int numNodes = _transforms.size();
 
-    while (nodeId < numNodes)
+    _changedIds.clear();
+
+    // nodes are sorted breadth-first: a parent world matrix is always up to date before its children are visited
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
     {
-        auto parentModelToWorldMatrix     = _modelToWorld[nodeId];
-        auto numChildren                 = _numChildren[nodeId];
-        auto firstChildId                 = _firstChildId[nodeId];
-        auto lastChildId                 = firstChildId + numChildren;
-        auto parentId                     = _parentId[nodeId];
-        auto parentTransformChanged     = parentModelToWorldMatrix->_hasChanged;
+        auto transform  = _transforms[nodeId].get();
 
-        parentModelToWorldMatrix->_hasChanged = false;
+        if (transform == nullptr)
+            continue;
 
-        if (parentId == -1)
-        {
-            auto parentTransform = _transforms[nodeId];
-
-            if (_transforms[nodeId]->_hasChanged)
-            {
-                parentModelToWorldMatrix->copyFrom(parentTransform);
-                parentModelToWorldMatrix->_hasChanged = false;
-                parentTransform->_hasChanged = false;
-                parentTransformChanged = true;
-            }
-        }
+        auto parentId   = _parentId[nodeId];
+        auto changed    = transform->_hasChanged || (parentId >= 0 && _worldChanged[parentId]);
 
-        for (auto childId = firstChildId; childId < lastChildId; ++childId)
-        {
-            auto modelToWorld   = _modelToWorld[childId];
-            auto transform      = _transforms[childId];
-
-            if (transform->_hasChanged || parentTransformChanged)
-            {
-                modelToWorld->lock()->copyFrom(transform)->append(parentModelToWorldMatrix)->unlock();
-                transform->_hasChanged = false;
-            }
-        }
+        _worldChanged[nodeId] = changed;
 
-        ++nodeId;
+        if (!changed)
+            continue;
+
+        auto modelToWorld = worldMatrix(nodeId);
+
+        if (parentId < 0)
+            std::copy(transform->_m.begin(), transform->_m.end(), modelToWorld);
+        else
+            Matrix4x4::multiply(worldMatrix(parentId), &transform->_m[0], modelToWorld);
+
+        transform->_hasChanged = false;
+        _changedIds.push_back(nodeId);
     }
+
+    publishWorldMatrices();
+}
+
+void
+Transform::RootTransform::publishWorldMatrices()
+{
+    _changedMatrices.clear();
+
+    // copy everything before executing any signal: a callback might invalidate the lists
+    for (auto nodeId : _changedIds)
+    {
+        auto modelToWorld   = _modelToWorld[nodeId];
+        auto data           = worldMatrix(nodeId);
+
+        std::copy(data, data + 16, modelToWorld->_m.begin());
+        modelToWorld->_hasChanged = false;
+
+        _changedMatrices.push_back(modelToWorld);
+    }
+
+    for (auto& modelToWorld : _changedMatrices)
+        if (!modelToWorld->_lock)
+            modelToWorld->changed()->execute(modelToWorld);
 }
 
 void
@@ -385,33 +534,42 @@ Transform::RootTransform::forceUpdate(scene::Node::Ptr node, bool updateTransfor
     if (_invalidLists || updateTransformLists)
         updateTransformsList();
 
-    auto                targetNodeId    = _nodeToId[node];
-    int                    nodeId            = targetNodeId;
-    auto                dirtyRoot        = -1;
-    std::vector<uint>    path;
+    auto it = _nodeToId.find(node);
+
+    if (it == _nodeToId.end())
+        return;
+
+    int                 nodeId          = it->second;
+    auto                dirtyRoot       = -1;
+    std::vector<uint>   path;
 
     // find the "dirty" root and build the path to get back to the target node
     while (nodeId >= 0)
     {
-        if ((_transforms[nodeId]->_hasChanged)
-            || (nodeId != targetNodeId && _modelToWorld[nodeId]->_hasChanged))
-            dirtyRoot = nodeId;
+        if (_transforms[nodeId]->_hasChanged)
+            dirtyRoot = path.size();
 
         path.push_back(nodeId);
 
         nodeId = _parentId[nodeId];
     }
 
-    // update that path starting from the dirty root
-    for (int i = path.size() - 1; i >= 0; --i)
+    // update that path starting from the dirty root, transforms are left dirty so that the
+    // siblings of the updated nodes get updated by the next call to updateTransforms()
+    for (int i = dirtyRoot; i >= 0; --i)
     {
         auto dirtyNodeId    = path[i];
-        auto parentId        = _parentId[dirtyNodeId];
-        auto modelToWorld    = _modelToWorld[dirtyNodeId];
+        auto parentId       = _parentId[dirtyNodeId];
+        auto transform      = _transforms[dirtyNodeId];
+        auto modelToWorld   = _modelToWorld[dirtyNodeId];
+        auto data           = worldMatrix(dirtyNodeId);
+
+        if (parentId < 0)
+            std::copy(transform->_m.begin(), transform->_m.end(), data);
+        else
+            Matrix4x4::multiply(worldMatrix(parentId), &transform->_m[0], data);
 
-        modelToWorld->copyFrom(_transforms[dirtyNodeId]);
-        if (parentId != -1)
-            modelToWorld->append(_modelToWorld[parentId]);
+        modelToWorld->initialize(data);
         modelToWorld->_hasChanged = false;
     }
 }
@@ -423,6 +581,8 @@ Transform::RootTransform::renderingBeginHandler(std::shared_ptr<SceneManager>
 {
     if (_invalidLists)
         updateTransformsList();
+    else if (_numHoles > _idToNode.size() / 2)
+        compactLists();
 
     updateTransforms();
 }
@@ -32,6 +32,8 @@ Container::Container() :
     std::enable_shared_from_this<Container>(),
     _providers(),
     _propertyNameToProvider(),
+    _propertyIdToProvider(),
+    _arrayProviderToPrefix(),
     _arrayLengths(data::Provider::create()),
     _propertyAdded(Container::PropertyChangedSignal::create()),
     _propertyRemoved(Container::PropertyChangedSignal::create()),
@@ -111,6 +113,7 @@ Container::removeProvider(Provider::Ptr provider)
 
         _providers.erase(std::find(_providers.begin(), _providers.end(), provider));
         _providerToIndex.erase(provider);
+        _arrayProviderToPrefix.erase(provider);
         _providersToNumUse.erase(provider);
 
         _providerRemoved->execute(shared_from_this(), provider);
@@ -146,6 +149,10 @@ Container::addProvider(std::shared_ptr<ArrayProvider> provider)
         if (_providerToIndex.find(provider) == _providerToIndex.end())
             _providerToIndex[provider] = length;
 
+#ifndef MINKO_NO_GLSL_STRUCT
+        _arrayProviderToPrefix[provider] = provider->arrayName() + "[" + std::to_string(_providerToIndex[provider]) + "].";
+#endif // MINKO_NO_GLSL_STRUCT
+
         addProvider(std::dynamic_pointer_cast<Provider>(provider));
         provider->indexChanged()->execute(provider, length);
 
@@ -216,6 +223,31 @@ Container::hasProperty(const std::string& propertyName) const
     return _propertyNameToProvider.count(propertyName) != 0;
 }
 
+bool
+Container::hasProperty(const PropertyId& propertyId) const
+{
+    return findProviderAndPropertyId(propertyId) != nullptr;
+}
+
+const std::pair<Container::ProviderPtr, PropertyId>*
+Container::findProviderAndPropertyId(const PropertyId& propertyId) const
+{
+    auto foundIt = _propertyIdToProvider.find(propertyId);
+
+    return foundIt != _propertyIdToProvider.end() ? &foundIt->second : nullptr;
+}
+
+const std::pair<Container::ProviderPtr, PropertyId>&
+Container::getProviderAndPropertyId(const PropertyId& propertyId) const
+{
+    auto providerAndId = findProviderAndPropertyId(propertyId);
+
+    if (providerAndId == nullptr)
+        throw std::invalid_argument(propertyId.name());
+
+    return *providerAndId;
+}
+
 Container::PropertyChangedSignalPtr
 Container::propertyValueChanged(const std::string& propertyName)
 {
@@ -227,7 +259,7 @@ Container::propertyValueChanged(const std::string& propertyName)
 
         if (_propertyNameToProvider.count(propertyName) != 0)
         {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
+            Provider::Ptr provider = _propertyNameToProvider[propertyName].provider;
 
             if (_providerValueChangedSlot.count(provider) == 0)
                 _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
@@ -251,7 +283,7 @@ Container::propertyReferenceChanged(const std::string& propertyName)
 
         if (_propertyNameToProvider.count(propertyName) != 0)
         {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
+            Provider::Ptr provider = _propertyNameToProvider[propertyName].provider;
 
             if (_providerReferenceChangedSlot.count(provider) == 0)
             {
@@ -304,7 +336,13 @@ Container::providerPropertyAddedHandler(std::shared_ptr<Provider>     provider,
     if (_propertyNameToProvider.count(formatedPropertyName) != 0)
         throw std::logic_error("duplicate property name: " + formatedPropertyName);
 
-    _propertyNameToProvider[formatedPropertyName] = provider;
+    auto& entry = _propertyNameToProvider[formatedPropertyName];
+
+    entry.provider = provider;
+    if (formatedPropertyName != propertyName)
+        entry.providerPropertyName = propertyName;
+
+    _propertyIdToProvider[PropertyId(formatedPropertyName)] = std::make_pair(provider, PropertyId(propertyName));
 
     if (_propValueChanged.count(formatedPropertyName) != 0)
         _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
@@ -329,6 +367,7 @@ Container::providerPropertyRemovedHandler(std::shared_ptr<Provider> provider,
     if (_propertyNameToProvider.count(formatedPropertyName) != 0)
     {
         _propertyNameToProvider.erase(formatedPropertyName);
+        _propertyIdToProvider.erase(PropertyId(formatedPropertyName));
 
         if (_propValueChanged.count(formatedPropertyName) && _propValueChanged[formatedPropertyName]->numCallbacks() == 0)
             _propValueChanged.erase(formatedPropertyName);
@@ -357,17 +396,21 @@ Container::providerPropertyRemovedHandler(std::shared_ptr<Provider> provider,
 std::string
 Container::formatPropertyName(ProviderPtr provider, const std::string& propertyName) const
 {
+#ifndef MINKO_NO_GLSL_STRUCT
 
-    auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(provider);
+    // the "array[index]." prefix is built once when the array provider is added
+    const auto foundPrefixIt = _arrayProviderToPrefix.find(provider);
 
-    if (arrayProvider == nullptr)
-        return propertyName;
+    return foundPrefixIt == _arrayProviderToPrefix.end()
+        ? propertyName
+        : foundPrefixIt->second + propertyName;
 
-#ifndef MINKO_NO_GLSL_STRUCT
+#else
 
-    return arrayProvider->arrayName() + "[" + std::to_string(_providerToIndex.find(provider)->second) + "]." + propertyName;
+    auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(provider);
 
-#else
+    if (arrayProvider == nullptr)
+        return propertyName;
 
     return arrayProvider->arrayName() + NO_STRUCT_SEP + propertyName + "[" + std::to_string(_index) + "]";
 
@@ -458,5 +501,5 @@ Container::isLengthProperty(const std::string& propertyName) const
 
     return foundProviderIt == _propertyNameToProvider.end()
         ? false
-        : foundProviderIt->second.get() == _arrayLengths.get();
+        : foundProviderIt->second.provider.get() == _arrayLengths.get();
 }
\ No newline at end of file
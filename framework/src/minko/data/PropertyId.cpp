@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/data/PropertyId.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+using namespace minko;
+using namespace minko::data;
+
+// Names are looked up without locking: insertions are serialized by the mutex and publish each name
+// with release stores, both in an open addressing hash table (replaced by a larger copy when it gets
+// half full, the previous copies remaining valid for the readers still using them) and in fixed size
+// chunks indexed by id. Names are never removed.
+struct PropertyId::NameTable
+{
+    struct Entry
+    {
+        std::string     name;
+        size_t          hash;
+        uint            id;
+    };
+
+    struct Slots
+    {
+        size_t                                          mask;
+        std::unique_ptr<std::atomic<const Entry*>[]>    entries;
+    };
+
+    static const uint                                   CHUNK_SIZE      = 1024;
+    static const uint                                   MAX_NUM_CHUNKS  = 4096;
+
+    std::mutex                                          mutex;
+    std::deque<Entry>                                   entries; // references to the entries must remain valid
+    std::vector<std::unique_ptr<Slots>>                 allSlots;
+    std::atomic<const Slots*>                           slots;
+    std::atomic<const Entry**>                          chunks[MAX_NUM_CHUNKS];
+
+    NameTable()
+    {
+        for (auto& chunk : chunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+
+        slots.store(createSlots(1024), std::memory_order_relaxed);
+        insert("", std::hash<std::string>()(""));
+    }
+
+    ~NameTable()
+    {
+        for (auto& chunk : chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    const Entry*
+    find(const std::string& name, size_t hash) const
+    {
+        auto table = slots.load(std::memory_order_acquire);
+
+        for (auto i = hash & table->mask; ; i = (i + 1) & table->mask)
+        {
+            auto entry = table->entries[i].load(std::memory_order_acquire);
+
+            if (entry == nullptr)
+                return nullptr;
+            if (entry->hash == hash && entry->name == name)
+                return entry;
+        }
+    }
+
+    // must be called with the mutex locked
+    const Entry*
+    insert(const std::string& name, size_t hash)
+    {
+        const uint id = entries.size();
+
+        if (id == CHUNK_SIZE * MAX_NUM_CHUNKS)
+            throw std::overflow_error("too many property names");
+
+        entries.push_back({ name, hash, id });
+
+        const auto entry = &entries.back();
+
+        if (id % CHUNK_SIZE == 0)
+            chunks[id / CHUNK_SIZE].store(new const Entry*[CHUNK_SIZE], std::memory_order_release);
+        chunks[id / CHUNK_SIZE].load(std::memory_order_relaxed)[id % CHUNK_SIZE] = entry;
+
+        auto table = slots.load(std::memory_order_relaxed);
+
+        if (entries.size() * 2 > table->mask + 1)
+        {
+            auto largerTable = createSlots((table->mask + 1) * 2);
+
+            for (const auto& e : entries)
+                if (&e != entry)
+                    store(largerTable, &e);
+            slots.store(largerTable, std::memory_order_release);
+            table = largerTable;
+        }
+
+        store(table, entry);
+
+        return entry;
+    }
+
+    const Slots*
+    createSlots(size_t capacity)
+    {
+        auto table = new Slots();
+
+        table->mask = capacity - 1;
+        table->entries.reset(new std::atomic<const Entry*>[capacity]);
+        for (size_t i = 0; i < capacity; ++i)
+            table->entries[i].store(nullptr, std::memory_order_relaxed);
+
+        allSlots.emplace_back(table);
+
+        return table;
+    }
+
+    static
+    void
+    store(const Slots* table, const Entry* entry)
+    {
+        auto i = entry->hash & table->mask;
+
+        while (table->entries[i].load(std::memory_order_relaxed) != nullptr)
+            i = (i + 1) & table->mask;
+
+        table->entries[i].store(entry, std::memory_order_release);
+    }
+};
+
+/*static*/
+PropertyId::NameTable&
+PropertyId::nameTable()
+{
+    // function-local static: property ids can be built during static initialization
+    static NameTable table;
+
+    return table;
+}
+
+const std::string&
+PropertyId::name() const
+{
+    auto& table = nameTable();
+
+    return table.chunks[_id / NameTable::CHUNK_SIZE].load(std::memory_order_acquire)[_id % NameTable::CHUNK_SIZE]->name;
+}
+
+/*static*/
+uint
+PropertyId::intern(const std::string& name)
+{
+    auto&       table   = nameTable();
+    const auto  hash    = std::hash<std::string>()(name);
+
+    if (auto entry = table.find(name, hash))
+        return entry->id;
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    // another thread may have added the name since the lookup above
+    if (auto entry = table.find(name, hash))
+        return entry->id;
+
+    return table.insert(name, hash)->id;
+}
@@ -28,6 +28,7 @@ Provider::Provider() :
     enable_shared_from_this(),
     _names(),
     _values(),
+    _valuesById(),
     _valueChangedSlots(),
     _referenceChangedSlots(),
     _propertyAdded(Signal<Ptr, const std::string&>::create()),
@@ -46,6 +47,7 @@ Provider::unset(const std::string& propertyName)
     {
         _names.erase(std::find(_names.begin(), _names.end(), formattedPropertyName));
         _values.erase(formattedPropertyName);
+        _valuesById.erase(PropertyId(formattedPropertyName));
         _valueChangedSlots.erase(formattedPropertyName);
         _referenceChangedSlots.erase(formattedPropertyName);
 
@@ -76,6 +78,8 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 
         _values[destination] = _values[source];
         _values.erase(source);
+        _valuesById.erase(PropertyId(source));
+        _valuesById[PropertyId(destination)] = &_values[destination];
 
         _valueChangedSlots[destination] = _valueChangedSlots[source];
         _valueChangedSlots.erase(source);
@@ -135,5 +139,16 @@ Provider::copyFrom(Provider::Ptr source)
     _names    = source->_names;
     _values = source->_values;
 
+    indexValues();
+
     return shared_from_this();
 }
+
+void
+Provider::indexValues()
+{
+    _valuesById.clear();
+
+    for (auto& nameAndValue : _values)
+        _valuesById[PropertyId(nameAndValue.first)] = &nameAndValue.second;
+}
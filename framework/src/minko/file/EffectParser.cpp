@@ -35,6 +35,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/Pass.hpp"
+#include "minko/render/ProgramCache.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/file/FileProtocol.hpp"
 #include "minko/file/Options.hpp"
@@ -184,11 +185,30 @@ EffectParser::parse(const std::string&				    filename,
                     std::shared_ptr<Options>            options,
 				    const std::vector<unsigned char>&	data,
 				    std::shared_ptr<AssetLibrary>	    assetLibrary)
+{
+    parse(filename, resolvedFilename, options, data.data(), data.size(), assetLibrary);
+}
+
+void
+EffectParser::parseFile(std::shared_ptr<File>           file,
+                        std::shared_ptr<Options>        options,
+                        std::shared_ptr<AssetLibrary>   assetLibrary)
+{
+    parse(file->filename(), file->resolvedFilename(), options, file->bytes(), file->size(), assetLibrary);
+}
+
+void
+EffectParser::parse(const std::string&				    filename,
+				    const std::string&                  resolvedFilename,
+                    std::shared_ptr<Options>            options,
+				    const unsigned char*	            data,
+                    std::size_t                         size,
+				    std::shared_ptr<AssetLibrary>	    assetLibrary)
 {
 	Json::Value root;
 	Json::Reader reader;
 
-	if (!reader.parse((const char*)&data[0], (const char*)&data[data.size() - 1], root, false))
+	if (!reader.parse((const char*)data, (const char*)data + size - 1, root, false))
 		_error->execute(shared_from_this(), file::Error(resolvedFilename + ": " + reader.getFormattedErrorMessages()));
 
     int pos	= resolvedFilename.find_last_of("/\\");
@@ -623,7 +643,7 @@ EffectParser::glslIncludeCompleteHandler(LoaderPtr 			        loader,
         options->includePaths().push_back(resolvedFilename.substr(0, pos));
 	}
 
-    parseGLSL(std::string((const char*)&file->data()[0], file->data().size()), options, blocks, blockIt);
+    parseGLSL(std::string((const char*)file->bytes(), file->size()), options, blocks, blockIt);
 
 	if (_numDependencies == _numLoadedDependencies && _effect)
 		finalize();
@@ -1436,6 +1456,12 @@ EffectParser::finalize()
 				"#define FRAGMENT_SHADER\r\n"
 				+ concatenateGLSLBlocks(_glslBlocks[program->fragmentShader()])
 			);
+
+			if (_options->programCache())
+			{
+				pass->programCache(_options->programCache());
+				pass->prewarm();
+			}
 		}
 
 		if (_techniqueFallback.count(techniqueName))
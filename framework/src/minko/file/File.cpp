@@ -19,6 +19,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/file/File.hpp"
 
+#include "minko/file/MemoryMappedFile.hpp"
+
 #if defined(_MSC_VER) // Windows
 # include <windows.h>
 #elif defined(__APPLE__) // iOS
@@ -32,6 +34,30 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 using namespace minko::file;
 
+const std::vector<unsigned char>&
+File::data()
+{
+    if (_mappedFile != nullptr && _data.size() != _mappedFile->size())
+        _data.assign(_mappedFile->data(), _mappedFile->data() + _mappedFile->size());
+
+    return _data;
+}
+
+const unsigned char*
+File::bytes() const
+{
+    if (_mappedFile != nullptr)
+        return _mappedFile->data();
+
+    return _data.empty() ? nullptr : _data.data();
+}
+
+std::size_t
+File::size() const
+{
+    return _mappedFile != nullptr ? _mappedFile->size() : _data.size();
+}
+
 std::string
 File::getCurrentWorkingDirectory()
 {
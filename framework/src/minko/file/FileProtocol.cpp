@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/Options.hpp"
 #include "minko/Signal.hpp"
 #include "minko/AbstractCanvas.hpp"
+#include "minko/file/MemoryMappedFile.hpp"
 #include "minko/async/Worker.hpp"
 
 #include <fstream>
@@ -48,23 +49,51 @@ FileProtocol::load()
     auto options = _options;
     auto flags = std::ios::in | std::ios::ate | std::ios::binary;
 
-    std::string cleanFilename = "";
+    // strip the "protocol://" prefixes
+    auto protocolPos = resolvedFilename.rfind("://");
+    auto cleanFilename = protocolPos == std::string::npos
+        ? resolvedFilename
+        : resolvedFilename.substr(protocolPos + 3);
 
-    for (uint i = 0; i < resolvedFilename.length(); ++i)
+    auto offset = options->seekingOffset();
+    auto length = options->seekedLength();
+
+    if (options->memoryMapFiles() && MemoryMappedFile::supported())
     {
-        if (i < resolvedFilename.length() - 2 && resolvedFilename.at(i) == ':' && resolvedFilename.at(i + 1) == '/' && resolvedFilename.at(i + 2) == '/')
+        MemoryMappedFile::Ptr mappedFile;
+
+        try
         {
-            cleanFilename = "";
-            i += 2;
-            continue;
+            mappedFile = MemoryMappedFile::create(cleanFilename, offset, length);
+        }
+        catch (const std::exception&)
+        {
+            // the file is read, or reported as missing, below
         }
 
-        cleanFilename += resolvedFilename.at(i);
-    }
+        if (mappedFile != nullptr)
+        {
+            this->mappedFile(mappedFile);
+
+            // the pages are read from the disk in the background when loading asynchronously, and when the
+            // parsers access them otherwise
+            if (_options->loadAsynchronously() && AbstractCanvas::defaultCanvas() != nullptr
+                && AbstractCanvas::defaultCanvas()->isWorkerRegistered("file-protocol"))
+            {
+                loadWithWorker(cleanFilename, offset, length, true);
+
+                return;
+            }
+
+            _progress->execute(loader, 0.f);
+            _progress->execute(loader, 1.f);
 
-    _options = options;
+            _complete->execute(loader);
+            _runningLoaders.remove(loader);
 
-    auto realFilename = cleanFilename;
+            return;
+        }
+    }
 
     std::fstream file(cleanFilename, flags);
 
@@ -74,72 +103,36 @@ FileProtocol::load()
             && AbstractCanvas::defaultCanvas()->isWorkerRegistered("file-protocol"))
         {
             file.close();
-            auto worker = AbstractCanvas::defaultCanvas()->getWorker("file-protocol");
 
-            _workerSlots.push_back(worker->message()->connect([=](async::Worker::Ptr, async::Worker::Message message)
-            {
-                if (message.type == "complete")
-                {
-                    void* bytes = &*message.data.begin();
-                    data().assign(static_cast<unsigned char*>(bytes), static_cast<unsigned char*>(bytes) + message.data.size());
-                    _complete->execute(loader);
-                    _runningLoaders.remove(loader);
-                }
-                else if (message.type == "progress")
-                {
-                    float ratio = *reinterpret_cast<float*>(&*message.data.begin());
-
-                    _progress->execute(loader, ratio);
-                }
-                else if (message.type == "error")
-                {
-                    _error->execute(loader);
-                    _runningLoaders.remove(loader);
-                }
-            }));
-
-            auto offset = options->seekingOffset();
-            auto length = options->seekedLength();
-
-            std::vector<char> offsetByteArray(4);
-            offsetByteArray[0] = (offset & 0xff000000) >> 24;
-            offsetByteArray[1] = (offset & 0x00ff0000) >> 16;
-            offsetByteArray[2] = (offset & 0x0000ff00) >> 8;
-            offsetByteArray[3] = (offset & 0x000000ff);
-
-            std::vector<char> lengthByteArray(4);
-            lengthByteArray[0] = (length & 0xff000000) >> 24;
-            lengthByteArray[1] = (length & 0x00ff0000) >> 16;
-            lengthByteArray[2] = (length & 0x0000ff00) >> 8;
-            lengthByteArray[3] = (length & 0x000000ff);
-
-            std::vector<char> input;
-            
-            input.insert(input.end(), offsetByteArray.begin(), offsetByteArray.end());
-            input.insert(input.end(), lengthByteArray.begin(), lengthByteArray.end());
-            input.insert(input.end(), cleanFilename.begin(), cleanFilename.end());
-
-            worker->start(input);
+            loadWithWorker(cleanFilename, offset, length, false);
         }
         else
         {
-            auto offset = options->seekingOffset();
+            uint64_t fileSize = file.tellg();
+            uint64_t begin = std::min(offset, fileSize);
+            std::size_t size = std::size_t(length > 0 ? std::min(length, fileSize - begin) : fileSize - begin);
+            const auto chunkSize = progressChunkSize(size);
+
+            _progress->execute(loader, 0.f);
 
-			auto length = options->seekedLength() > 0 ? options->seekedLength() : (unsigned int)file.tellg();
+            data().resize(size);
 
-            // FIXME: use fixed size buffers and call _progress accordingly
+            file.seekg(std::streamoff(begin), std::ios::beg);
 
-            _progress->execute(shared_from_this(), 0.0);
+            for (std::size_t chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize)
+            {
+                auto readSize = std::min(chunkSize, size - chunkOffset);
+
+                file.read(reinterpret_cast<char*>(&data()[chunkOffset]), readSize);
 
-			data().resize(length);
+                _progress->execute(loader, float(chunkOffset + readSize) / float(size));
+            }
 
-			file.seekg(offset, std::ios::beg);
-			file.read((char*)&data()[0], length);
             file.close();
 
-            _progress->execute(loader, 1.0);
+            _progress->execute(loader, 1.f);
 
-            _complete->execute(shared_from_this());
+            _complete->execute(loader);
             _runningLoaders.remove(loader);
         }
     }
@@ -149,6 +142,62 @@ FileProtocol::load()
     }
 }
 
+void
+FileProtocol::loadWithWorker(const std::string& filename, uint64_t offset, uint64_t length, bool prefetchOnly)
+{
+    auto loader = std::static_pointer_cast<FileProtocol>(shared_from_this());
+    auto worker = AbstractCanvas::defaultCanvas()->getWorker("file-protocol");
+
+    // the worker runs in the same process: no need for a portable encoding
+    std::vector<char> input(2 * sizeof(uint64_t) + sizeof(int) + filename.size());
+    int prefetch = prefetchOnly ? 1 : 0;
+
+    std::memcpy(&input[0], &offset, sizeof(uint64_t));
+    std::memcpy(&input[sizeof(uint64_t)], &length, sizeof(uint64_t));
+    std::memcpy(&input[2 * sizeof(uint64_t)], &prefetch, sizeof(int));
+    std::copy(filename.begin(), filename.end(), input.begin() + 2 * sizeof(uint64_t) + sizeof(int));
+
+    worker->start(input, [=](const async::Worker::Message& message)
+    {
+        if (message.type == "complete")
+        {
+            // prefetched files are already mapped
+            if (!prefetchOnly)
+            {
+                auto bytes = message.data.data();
+                data().assign(bytes, bytes + message.data.size());
+            }
+            _complete->execute(loader);
+            _runningLoaders.remove(loader);
+        }
+        else if (message.type == "progress")
+        {
+            float ratio = *reinterpret_cast<const float*>(message.data.data());
+
+            _progress->execute(loader, ratio);
+        }
+        else if (message.type == "error")
+        {
+            // the mapped pages will be read when they are accessed
+            if (prefetchOnly)
+                _complete->execute(loader);
+            else
+                _error->execute(loader);
+            _runningLoaders.remove(loader);
+        }
+    });
+}
+
+/*static*/
+std::size_t
+FileProtocol::progressChunkSize(std::size_t size)
+{
+    // about 50 progress steps, by chunks of 8KB to 1MB
+    auto chunkSize = math::clp2(uint((size / 50) / 1024));
+
+    return std::max(8u, std::min(chunkSize, 1024u)) * 1024;
+}
+
 bool
 FileProtocol::fileExists(const std::string& filename)
 {
@@ -18,6 +18,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/file/FileProtocolWorker.hpp"
+#include "minko/file/FileProtocol.hpp"
+#include "minko/file/MemoryMappedFile.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -28,47 +30,68 @@ namespace minko
     {
         MINKO_DEFINE_WORKER(FileProtocolWorker,
         {
-            auto seekingOffset = (static_cast<int>(static_cast<unsigned char>((input[0]))) << 24) +
-                                 (static_cast<int>(static_cast<unsigned char>((input[1]))) << 16) +
-                                 (static_cast<int>(static_cast<unsigned char>((input[2]))) << 8) + 
-                                 static_cast<int>(static_cast<unsigned char>((input[3])));
+            uint64_t seekingOffset;
+            uint64_t seekedLength;
+            int prefetchOnly;
 
-            auto seekedLength = (static_cast<int>(static_cast<unsigned char>((input[4]))) << 24) +
-                                (static_cast<int>(static_cast<unsigned char>((input[5]))) << 16) +
-                                (static_cast<int>(static_cast<unsigned char>((input[6]))) << 8) +
-                                static_cast<int>(static_cast<unsigned char>((input[7])));
+            std::memcpy(&seekingOffset, &input[0], sizeof(uint64_t));
+            std::memcpy(&seekedLength, &input[sizeof(uint64_t)], sizeof(uint64_t));
+            std::memcpy(&prefetchOnly, &input[2 * sizeof(uint64_t)], sizeof(int));
 
-			std::string filename(input.begin() + 8, input.end());
+			std::string filename(input.begin() + 2 * sizeof(uint64_t) + sizeof(int), input.end());
 
             std::vector<char> output;
 
             post(Message { "progress" }.set(0.0f));
 
+            if (prefetchOnly)
+            {
+                // the application maps the file too: faulting the pages in here fills the page cache it reads from
+                try
+                {
+                    auto mappedFile = MemoryMappedFile::create(filename, seekingOffset, seekedLength);
+                    const auto size = mappedFile->size();
+                    const auto chunkSize = FileProtocol::progressChunkSize(size);
+
+                    for (std::size_t chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize)
+                    {
+                        mappedFile->prefetch(chunkOffset, chunkSize);
+
+                        post(Message { "progress" }.set(float(std::min(chunkOffset + chunkSize, size)) / float(size)));
+                    }
+
+                    post(Message { "complete" });
+                }
+                catch (const std::exception&)
+                {
+                    post(Message { "error" });
+                }
+
+                return;
+            }
+
             auto flags = std::ios::in | std::ios::ate | std::ios::binary;
 
             std::fstream file(filename, flags);
 
             if (file.is_open())
             {
-				uint length = seekedLength > 0 ? seekedLength : (uint(file.tellg()) - seekingOffset);
-
-				uint chunkSize = math::clp2((length / 50) / 1024);
+				uint64_t fileSize = file.tellg();
+				uint64_t begin = std::min(seekingOffset, fileSize);
+				std::size_t length = std::size_t(seekedLength > 0 ? std::min(seekedLength, fileSize - begin) : fileSize - begin);
 
-                if (chunkSize > 1024)
-                    chunkSize = 1024;
-                else if (chunkSize <= 0)
-                    chunkSize = 8;
+				std::size_t chunkSize = FileProtocol::progressChunkSize(length);
 
-                chunkSize *= 1024;
+				file.seekg(std::streamoff(begin), std::ios::beg);
 
-				file.seekg(seekingOffset, std::ios::beg);
+                std::size_t offset = 0;
 
-                uint offset = 0;
+                output.reserve(length);
 
 				while (offset < length)
                 {
-                    uint nextOffset = offset + chunkSize;
-                    uint readSize = chunkSize;
+                    std::size_t nextOffset = offset + chunkSize;
+                    std::size_t readSize = chunkSize;
 
 					if (nextOffset > length)
 						readSize = length % chunkSize;
@@ -79,8 +102,6 @@ namespace minko
 
                     auto progress = float(offset + readSize) / float(length);
 
-                    progress *= 100.0;
-
                     post(Message { "progress" }.set(progress));
 
                     offset = nextOffset;
@@ -88,7 +109,7 @@ namespace minko
 
                 file.close();
 
-                post(Message{ "complete" }.set(output));
+                post(Message{ "complete" }.set(std::move(output)));
             }
             else
             {
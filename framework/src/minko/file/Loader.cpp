@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AbstractProtocol.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/AssetLibrary.hpp"
+#include "minko/async/TaskScheduler.hpp"
 
 #include "minko/log/Logger.hpp"
 
@@ -181,12 +182,7 @@ Loader::protocolCompleteHandler(std::shared_ptr<AbstractProtocol> protocol)
         << _loading.size() << " file(s) still loading, "
         << _filesQueue.size() << " file(s) in the queue");
 
-    auto parsed = processData(
-        filename,
-        protocol->file()->resolvedFilename(),
-        protocol->options(),
-        protocol->file()->data()
-    );
+    auto parsed = processData(protocol->file(), protocol->options());
 
     if (!parsed)
     {
@@ -197,11 +193,9 @@ Loader::protocolCompleteHandler(std::shared_ptr<AbstractProtocol> protocol)
 }
 
 bool
-Loader::processData(const std::string&                      filename,
-                         const std::string&                 resolvedFilename,
-                         Options::Ptr                       options,
-                         const std::vector<unsigned char>&  data)
+Loader::processData(File::Ptr file, Options::Ptr options)
 {
+    const auto& filename = file->filename();
     auto extension = filename.substr(filename.find_last_of('.') + 1);
 
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
@@ -223,7 +217,10 @@ Loader::processData(const std::string&                      filename,
                                                                        std::placeholders::_2
                                                                        ));
 
-        parser->parse(filename, resolvedFilename, options, data, options->assetLibrary());
+        if (options->parseAsynchronously() && parser->threadSafe())
+            parseAsynchronously(parser, file, options);
+        else
+            parser->parseFile(file, options, options->assetLibrary());
     }
     else
     {
@@ -232,13 +229,48 @@ Loader::processData(const std::string&                      filename,
             if (extension != "glsl")
                 LOG_DEBUG("no parser found for extension '" << extension << "'");
 
-            options->assetLibrary()->blob(filename, data);
+            options->assetLibrary()->blob(filename, file->data());
         }
     }
 
     return parser != nullptr;
 }
 
+void
+Loader::parseAsynchronously(AbstractParser::Ptr parser, File::Ptr file, Options::Ptr options)
+{
+    auto loader = shared_from_this();
+    auto scheduler = async::TaskScheduler::instance();
+    auto decoding = scheduler->schedule([=]()
+    {
+        parser->decode(file, options);
+    });
+
+    scheduler->schedule(
+        [=]()
+        {
+            try
+            {
+                if (decoding->exception())
+                    std::rethrow_exception(decoding->exception());
+
+                parser->commit(file, options, options->assetLibrary());
+            }
+            catch (const std::exception& exception)
+            {
+                // nothing would catch an exception thrown from a main thread task
+                LOG_ERROR("unable to parse '" << file->filename() << "': " << exception.what());
+
+                if (loader->_error->numCallbacks() > 0)
+                    loader->_error->execute(loader, Error("ParserError", exception.what()));
+            }
+        },
+        { decoding },
+        true,
+        [=]() { return parser->stagedSize(); }
+    );
+}
+
 void
 Loader::parserCompleteHandler(AbstractParser::Ptr parser)
 {
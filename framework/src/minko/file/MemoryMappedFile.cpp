@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/MemoryMappedFile.hpp"
+
+#if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+# include <windows.h>
+#elif MINKO_PLATFORM != MINKO_PLATFORM_HTML5
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+using namespace minko;
+using namespace minko::file;
+
+MemoryMappedFile::MemoryMappedFile() :
+    _mapping(nullptr),
+    _mappingSize(0),
+    _data(nullptr),
+    _size(0)
+#if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+    ,
+    _fileHandle(INVALID_HANDLE_VALUE),
+    _mappingHandle(nullptr)
+#endif
+{
+}
+
+/*static*/
+MemoryMappedFile::Ptr
+MemoryMappedFile::create(const std::string& filename, uint64_t offset, std::size_t length)
+{
+    auto file = std::shared_ptr<MemoryMappedFile>(new MemoryMappedFile());
+
+    file->initialize(filename, offset, length);
+
+    return file;
+}
+
+/*static*/
+bool
+MemoryMappedFile::supported()
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    return false;
+#else
+    return true;
+#endif
+}
+
+void
+MemoryMappedFile::initialize(const std::string& filename, uint64_t offset, std::size_t length)
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    throw std::runtime_error("memory-mapped files are not supported on this platform");
+#else
+    // mappings must start on a page boundary
+    auto mappingOffset = offset - offset % pageSize();
+    uint64_t fileSize = 0;
+
+# if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+    _fileHandle = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+
+    LARGE_INTEGER largeFileSize;
+
+    if (_fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(_fileHandle, &largeFileSize))
+        throw std::runtime_error("cannot open file '" + filename + "'");
+
+    fileSize = uint64_t(largeFileSize.QuadPart);
+# else
+    auto fileDescriptor = open(filename.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStat) != 0)
+    {
+        if (fileDescriptor >= 0)
+            close(fileDescriptor);
+
+        throw std::runtime_error("cannot open file '" + filename + "'");
+    }
+
+    fileSize = uint64_t(fileStat.st_size);
+# endif
+
+    if (offset > fileSize)
+        offset = fileSize;
+
+    _size = length == 0 || offset + length > fileSize ? std::size_t(fileSize - offset) : length;
+    _mappingSize = _size + std::size_t(offset - mappingOffset);
+
+    // nothing to map
+    if (_size == 0)
+    {
+# if MINKO_PLATFORM != MINKO_PLATFORM_WINDOWS
+        close(fileDescriptor);
+# endif
+
+        return;
+    }
+
+# if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+    _mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (_mappingHandle != nullptr)
+        _mapping = MapViewOfFile(
+            _mappingHandle,
+            FILE_MAP_READ,
+            DWORD(mappingOffset >> 32),
+            DWORD(mappingOffset & 0xffffffff),
+            _mappingSize
+        );
+# else
+    _mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fileDescriptor, off_t(mappingOffset));
+
+    // the mapping keeps its own reference to the file
+    close(fileDescriptor);
+
+    if (_mapping == MAP_FAILED)
+        _mapping = nullptr;
+# endif
+
+    if (_mapping == nullptr)
+        throw std::runtime_error("cannot map file '" + filename + "'");
+
+    _data = static_cast<const unsigned char*>(_mapping) + std::size_t(offset - mappingOffset);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+    if (_mapping != nullptr)
+        UnmapViewOfFile(_mapping);
+    if (_mappingHandle != nullptr)
+        CloseHandle(_mappingHandle);
+    if (_fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(_fileHandle);
+#elif MINKO_PLATFORM != MINKO_PLATFORM_HTML5
+    if (_mapping != nullptr)
+        munmap(_mapping, _mappingSize);
+#endif
+}
+
+void
+MemoryMappedFile::prefetch(std::size_t offset, std::size_t size) const
+{
+    if (offset >= _size)
+        return;
+
+    size = std::min(size, _size - offset);
+
+    const auto step = pageSize();
+    auto begin = _data + offset;
+
+#if MINKO_PLATFORM != MINKO_PLATFORM_WINDOWS && MINKO_PLATFORM != MINKO_PLATFORM_HTML5
+    auto pageBegin = reinterpret_cast<std::uintptr_t>(begin);
+
+    pageBegin -= pageBegin % step;
+    madvise(reinterpret_cast<void*>(pageBegin), reinterpret_cast<std::uintptr_t>(begin + size) - pageBegin, MADV_WILLNEED);
+#endif
+
+    // reading one byte per page is enough to fault all of them in
+    volatile unsigned char sum = 0;
+
+    for (std::size_t i = 0; i < size; i += step)
+        sum += begin[i];
+    sum += begin[size - 1];
+}
+
+/*static*/
+std::size_t
+MemoryMappedFile::pageSize()
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS
+    SYSTEM_INFO systemInfo;
+
+    GetSystemInfo(&systemInfo);
+
+    // views must start at a multiple of the allocation granularity, not only of the page size
+    return systemInfo.dwAllocationGranularity;
+#elif MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    return 4096;
+#else
+    return std::size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
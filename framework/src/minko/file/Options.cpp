@@ -43,14 +43,19 @@ Options::Options() :
     _isCubeTexture(false),
     _startAnimation(true),
     _loadAsynchronously(false),
+    _memoryMapFiles(false),
+    _parseAsynchronously(false),
     _disposeIndexBufferAfterLoading(false),
     _disposeVertexBufferAfterLoading(false),
     _disposeTextureAfterLoading(false),
     _storeDataIfNotParsed(true),
     _skinningFramerate(30),
     _skinningMethod(component::SkinningMethod::HARDWARE),
+    _skinningCompressionTolerance(0.0f),
     _material(nullptr),
     _effect(nullptr),
+    _programCache(nullptr),
+    _textureStreamer(nullptr),
     _seekingOffset(0),
     _seekedLength(0)
 {
@@ -84,7 +89,10 @@ Options::Options(const Options& copy) :
     _storeDataIfNotParsed(copy._storeDataIfNotParsed),
     _skinningFramerate(copy._skinningFramerate),
     _skinningMethod(copy._skinningMethod),
+    _skinningCompressionTolerance(copy._skinningCompressionTolerance),
     _effect(copy._effect),
+    _programCache(copy._programCache),
+    _textureStreamer(copy._textureStreamer),
     _textureFormats(copy._textureFormats),
     _material(copy._material),
     _materialFunction(copy._materialFunction),
@@ -96,6 +104,8 @@ Options::Options(const Options& copy) :
     _effectFunction(copy._effectFunction),
     _textureFormatFunction(copy._textureFormatFunction),
     _loadAsynchronously(copy._loadAsynchronously),
+    _memoryMapFiles(copy._memoryMapFiles),
+    _parseAsynchronously(copy._parseAsynchronously),
     _seekingOffset(copy._seekingOffset),
     _seekedLength(copy._seekedLength)
 {
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Ray.hpp"
 #include "minko/render/IndexBuffer.hpp"
 #include "minko/render/VertexBuffer.hpp"
+#include "minko/geometry/TriangleBvh.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -34,7 +35,8 @@ Geometry::Geometry() :
     _data(data::ArrayProvider::create("geometry")),
     _vertexSize(0),
     _numVertices(0),
-    _indexBuffer(nullptr)
+    _indexBuffer(nullptr),
+    _triangleBvh(nullptr)
 {
 }
 
@@ -43,7 +45,8 @@ Geometry::Geometry(const Geometry& geometry) :
 	_vertexSize(geometry._vertexSize),
 	_numVertices(geometry._numVertices),
 	_vertexBuffers(geometry._vertexBuffers),
-	_indexBuffer(geometry._indexBuffer)
+	_indexBuffer(geometry._indexBuffer),
+	_triangleBvh(geometry._triangleBvh)
 {
 }
 
@@ -75,6 +78,7 @@ Geometry::addVertexBuffer(render::VertexBuffer::Ptr vertexBuffer)
         _numVertices = bufNumVertices;
 
     _vertexBuffers.push_back(vertexBuffer);
+    _triangleBvh = nullptr;
 
     _vbToVertexSizeChangedSlot[vertexBuffer] = vertexBuffer->vertexSizeChanged()->connect(std::bind(
         &Geometry::vertexSizeChanged,
@@ -97,6 +101,7 @@ Geometry::removeVertexBuffer(std::list<render::VertexBuffer::Ptr>::iterator vert
     _data->set("vertex.size", _vertexSize);
 
     _vertexBuffers.erase(vertexBufferIt);
+    _triangleBvh = nullptr;
 
     if (_vertexBuffers.size() == 0)
         _numVertices = 0;
@@ -355,6 +360,24 @@ Geometry::removeDuplicatedVertices(std::vector<unsigned short>&        indices,
         index = oldVertexIdToNewVertexId[index];
 }
 
+std::shared_ptr<TriangleBvh>
+Geometry::triangleBvh()
+{
+    if (_triangleBvh == nullptr)
+    {
+        auto xyzBuffer = vertexBuffer("position");
+        auto xyzOffset = std::get<2>(*xyzBuffer->attribute("position"));
+
+        _triangleBvh = TriangleBvh::create(
+            &xyzBuffer->data()[0] + xyzOffset,
+            xyzBuffer->vertexSize(),
+            _indexBuffer->data()
+        );
+    }
+
+    return _triangleBvh;
+}
+
 bool
 Geometry::cast(std::shared_ptr<math::Ray>    ray,
                float&                        distance,
@@ -363,103 +386,68 @@ Geometry::cast(std::shared_ptr<math::Ray>    ray,
                std::shared_ptr<Vector2>        hitUv,
                std::shared_ptr<Vector3>        hitNormal)
 {
-    static const auto EPSILON = 0.00001f;
-
-    auto hit = false;
-    auto& indicesData = _indexBuffer->data();
-    auto numIndices = indicesData.size();
-
-    auto xyzBuffer = vertexBuffer("position");
-    auto& xyzData = xyzBuffer->data();
-    auto xyzPtr = &xyzData[0];
-    auto xyzVertexSize = xyzBuffer->vertexSize();
-    auto xyzOffset = std::get<2>(*xyzBuffer->attribute("position"));
-
-    auto minDistance = std::numeric_limits<float>::infinity();
-    auto lambda = hitUv ? Vector2::create() : nullptr;
-    auto triangleIndice = -3;
-
-    auto v0 = Vector3::create();
-    auto v1 = Vector3::create();
-    auto v2 = Vector3::create();
-    auto edge1 = Vector3::create();
-    auto edge2 = Vector3::create();
-    auto pvec = Vector3::create();
-    auto tvec = Vector3::create();
-    auto qvec = Vector3::create();
-    auto dot = 0.f;
-    auto invDot = 0.f;
-    auto u = 0.f;
-    auto v = 0.f;
-    auto t = 0.f;
-
-    for (uint i = 0; i < numIndices; i += 3)
-    {
-        v0->copyFrom(xyzPtr + indicesData[i] * xyzVertexSize);
-        v1->copyFrom(xyzPtr + indicesData[i + 1] * xyzVertexSize);
-        v2->copyFrom(xyzPtr + indicesData[i + 2] * xyzVertexSize);
-
-        edge1->copyFrom(v1)->subtract(v0);
-        edge2->copyFrom(v2)->subtract(v0);
-
-        pvec->copyFrom(ray->direction())->cross(edge2);
-        dot = edge1->dot(pvec);
+    const float origin[3]       = { ray->origin()->x(), ray->origin()->y(), ray->origin()->z() };
+    const float direction[3]    = { ray->direction()->x(), ray->direction()->y(), ray->direction()->z() };
+    auto        u               = 0.f;
+    auto        v               = 0.f;
 
-        if (dot > -EPSILON && dot < EPSILON)
-            continue;
+    if (!triangleBvh()->cast(origin, direction, distance, triangle, u, v))
+        return false;
 
-        invDot = 1.f / dot;
+    if (hitXyz)
+    {
+        hitXyz->setTo(
+            origin[0] + distance * direction[0],
+            origin[1] + distance * direction[1],
+            origin[2] + distance * direction[2]
+        );
+    }
 
-        tvec->copyFrom(ray->origin())->subtract(v0);
-        u = tvec->dot(pvec) * invDot;
-        if (u < 0.f || u > 1.f)
-            continue;
+    if (hitUv)
+        getHitUv(triangle, u, v, hitUv);
 
-        qvec->copyFrom(tvec)->cross(edge1);
-        v = ray->direction()->dot(qvec) * invDot;
-        if (v < 0.f || u + v > 1.f)
-            continue;
+    if (hitNormal)
+        getHitNormal(triangle, u, v, hitNormal);
 
-        t = edge2->dot(qvec) * invDot;
-        if (t < minDistance)
-        {
-            minDistance = t;
-            distance = t;
-            triangle = i;
-            hit = true;
+    return true;
+}
 
-            if (hitUv)
-            {
-                lambda->x(u);
-                lambda->y(v);
-            }
+uint
+Geometry::cast(const std::vector<std::shared_ptr<math::Ray>>&  rays,
+               std::vector<float>&                             distances,
+               std::vector<uint>&                              triangles)
+{
+    const uint          numRays = rays.size();
+    std::vector<float>  origins(numRays * 3);
+    std::vector<float>  directions(numRays * 3);
 
-            if (hitXyz)
-            {
-                hitXyz->setTo(
-                    ray->origin()->x() + minDistance * ray->direction()->x(),
-                    ray->origin()->y() + minDistance * ray->direction()->y(),
-                    ray->origin()->z() + minDistance * ray->direction()->z()
-                    );
-            }
-        }
+    distances.resize(numRays);
+    triangles.resize(numRays);
 
-        if (hitUv)
-            getHitUv(triangle, lambda, hitUv);
+    if (numRays == 0)
+        return 0;
 
-        if (hitNormal)
-            getHitNormal(triangle, hitNormal);
+    for (uint i = 0; i < numRays; ++i)
+    {
+        auto origin     = rays[i]->origin();
+        auto direction  = rays[i]->direction();
+
+        origins[i * 3] = origin->x();
+        origins[i * 3 + 1] = origin->y();
+        origins[i * 3 + 2] = origin->z();
+        directions[i * 3] = direction->x();
+        directions[i * 3 + 1] = direction->y();
+        directions[i * 3 + 2] = direction->z();
     }
 
-    return hit;
+    return triangleBvh()->cast(&origins[0], &directions[0], numRays, &distances[0], &triangles[0]);
 }
 
 void
-Geometry::getHitUv(uint triangle, Vector2::Ptr lambda, Vector2::Ptr hitUv)
+Geometry::getHitUv(uint triangle, float u, float v, Vector2::Ptr hitUv)
 {
     auto uvBuffer = vertexBuffer("uv");
     auto& uvData = uvBuffer->data();
-    auto uvPtr = &uvData[0];
     auto uvVertexSize = uvBuffer->vertexSize();
     auto uvOffset = std::get<2>(*uvBuffer->attribute("uv"));
     auto& indicesData = _indexBuffer->data();
@@ -473,32 +461,50 @@ Geometry::getHitUv(uint triangle, Vector2::Ptr lambda, Vector2::Ptr hitUv)
     auto u2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset];
     auto v2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset + 1];
 
-    auto z = 1.f - lambda->x() - lambda->y();
+    auto z = 1.f - u - v;
 
     hitUv->setTo(
-        z * u0 + lambda->x() * u1 + lambda->y() * u2,
-        z * v0 + lambda->x() * v1 + lambda->y() * v2
+        z * u0 + u * u1 + v * u2,
+        z * v0 + u * v1 + v * v2
     );
 }
 
 void
-Geometry::getHitNormal(uint triangle, Vector3::Ptr hitNormal)
+Geometry::getHitNormal(uint triangle, float u, float v, Vector3::Ptr hitNormal)
 {
-    auto normalBuffer = vertexBuffer("normal");
-    auto& normalData = normalBuffer->data();
-    auto normalPtr = &normalData[0];
-    auto normalVertexSize = normalBuffer->vertexSize();
-    auto normalOffset = std::get<2>(*normalBuffer->attribute("normal"));
     auto& indicesData = _indexBuffer->data();
+    auto z = 1.f - u - v;
 
-    auto v0 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-    auto v1 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-    auto v2 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-
-    auto edge1 = Vector3::create(v1)->subtract(v0)->normalize();
-    auto edge2 = Vector3::create(v2)->subtract(v0)->normalize();
+    if (hasVertexAttribute("normal"))
+    {
+        // interpolated vertex normal
+        auto normalBuffer = vertexBuffer("normal");
+        auto normalPtr = &normalBuffer->data()[0] + std::get<2>(*normalBuffer->attribute("normal"));
+        auto normalVertexSize = normalBuffer->vertexSize();
+        auto n0 = normalPtr + indicesData[triangle] * normalVertexSize;
+        auto n1 = normalPtr + indicesData[triangle + 1] * normalVertexSize;
+        auto n2 = normalPtr + indicesData[triangle + 2] * normalVertexSize;
+
+        hitNormal->setTo(
+            z * n0[0] + u * n1[0] + v * n2[0],
+            z * n0[1] + u * n1[1] + v * n2[1],
+            z * n0[2] + u * n1[2] + v * n2[2]
+        );
+    }
+    else
+    {
+        // face normal
+        auto xyzBuffer = vertexBuffer("position");
+        auto xyzPtr = &xyzBuffer->data()[0] + std::get<2>(*xyzBuffer->attribute("position"));
+        auto xyzVertexSize = xyzBuffer->vertexSize();
+        auto v0 = Vector3::create(xyzPtr + indicesData[triangle] * xyzVertexSize);
+        auto edge1 = Vector3::create(xyzPtr + indicesData[triangle + 1] * xyzVertexSize)->subtract(v0);
+        auto edge2 = Vector3::create(xyzPtr + indicesData[triangle + 2] * xyzVertexSize)->subtract(v0);
+
+        hitNormal->copyFrom(edge1)->cross(edge2);
+    }
 
-    hitNormal->copyFrom(edge2)->cross(edge1);
+    hitNormal->normalize();
 }
 
 void
@@ -28,12 +28,20 @@ using namespace minko::scene;
 using namespace minko::math;
 using namespace minko::geometry;
 
+/*static*/ const uint Skin::POSE_CACHE_SIZE = 4;
+/*static*/ const float Skin::MIN_TRACK_TOLERANCE = 1e-6f;
+
 Skin::Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames):
     _bones(numBones, nullptr),
     _numBones(numBones),
     _duration(duration),
     _timeFactor(duration > 0 ? numFrames / float(duration) : 0.0f),
+    _numFrames(numFrames),
     _boneMatricesPerFrame(numFrames, std::vector<float>(numBones << 4, 0.0f)),
+    _transposedMatrices(false),
+    _boneTracks(),
+    _poseCache(),
+    _poseCacheClock(0),
     _maxNumVertexBones(0),
     _numVertexBones(),
     _vertexBones(),
@@ -47,7 +55,12 @@ Skin::Skin(const Skin& skin) :
 	_numBones(skin._numBones),
 	_duration(skin._duration),
 	_timeFactor(skin._timeFactor),
+	_numFrames(skin._numFrames),
 	_boneMatricesPerFrame(skin._boneMatricesPerFrame),
+	_transposedMatrices(skin._transposedMatrices),
+	_boneTracks(skin._boneTracks),
+	_poseCache(),
+	_poseCacheClock(0),
 	_maxNumVertexBones(skin._maxNumVertexBones),
 	_numVertexBones(skin._numVertexBones),
 	_vertexBones(skin._vertexBones),
@@ -73,6 +86,9 @@ Skin::matrix(unsigned int    frameId,
     assert(frameId < numFrames() && boneId < numBones());
 #endif // DEBUG_SKINNING
 
+    if (compressed())
+        throw std::logic_error("the matrices of a compressed skin cannot be changed");
+
     memcpy(
         &(_boneMatricesPerFrame[frameId][boneId << 4]),
         &(value->data()[0]),
@@ -190,6 +206,9 @@ Skin::disposeBones()
 Skin::Ptr
 Skin::transposeMatrices()
 {
+    _transposedMatrices = !_transposedMatrices;
+    _poseCache.clear();
+
     for (auto& frameMatrices : _boneMatricesPerFrame)
     {
         assert(frameMatrices.size() % 16 == 0);
@@ -208,4 +227,486 @@ Skin::transposeMatrices()
         }
     }
     return shared_from_this();
-}
\ No newline at end of file
+}
+
+void
+Skin::setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame)
+{
+    _boneMatricesPerFrame = boneMatricesPerFrame;
+    _numFrames = boneMatricesPerFrame.size();
+    _boneTracks.clear();
+    _poseCache.clear();
+}
+
+std::vector<std::vector<float>>
+Skin::getBoneMatricesPerFrame()
+{
+    if (!compressed())
+        return _boneMatricesPerFrame;
+
+    std::vector<std::vector<float>> boneMatricesPerFrame(_numFrames, std::vector<float>(_numBones << 4));
+
+    for (unsigned int frameId = 0; frameId < _numFrames; ++frameId)
+        evaluatePose(frameId, &boneMatricesPerFrame[frameId][0]);
+
+    return boneMatricesPerFrame;
+}
+
+Skin::Ptr
+Skin::compress(float tolerance)
+{
+    if (compressed() || _numFrames == 0 || _numBones == 0)
+        return shared_from_this();
+
+    if (_numFrames > std::numeric_limits<unsigned short>::max())
+        throw std::logic_error("too many frames to compress the skin");
+
+    std::vector<float> translations(_numFrames * 3);
+    std::vector<float> rotations(_numFrames * 4);
+    std::vector<float> scales(_numFrames * 3);
+    float matrix[16];
+
+    _boneTracks.resize(_numBones);
+
+    for (unsigned int boneId = 0; boneId < _numBones; ++boneId)
+    {
+        for (unsigned int frameId = 0; frameId < _numFrames; ++frameId)
+        {
+            const float* frameMatrix = &_boneMatricesPerFrame[frameId][boneId << 4];
+
+            for (unsigned int i = 0; i < 16; ++i)
+                matrix[i] = _transposedMatrices ? frameMatrix[((i & 3) << 2) + (i >> 2)] : frameMatrix[i];
+
+            decompose(matrix, &translations[frameId * 3], &rotations[frameId * 4], &scales[frameId * 3]);
+
+            // q and -q are the same rotation: keep consecutive quaternions in the same hemisphere to interpolate them
+            if (frameId > 0)
+            {
+                float* q        = &rotations[frameId * 4];
+                float* previous = q - 4;
+
+                if (q[0] * previous[0] + q[1] * previous[1] + q[2] * previous[2] + q[3] * previous[3] < 0.0f)
+                    for (unsigned int i = 0; i < 4; ++i)
+                        q[i] = -q[i];
+            }
+        }
+
+        // the errors of the components add up once composed: tighten the tracks until the matrices fit
+        for (float trackTolerance = tolerance; ; trackTolerance *= 0.5f)
+        {
+            fitTrack(translations, _boneTracks[boneId].translation, trackTolerance);
+            fitTrack(rotations, _boneTracks[boneId].rotation, trackTolerance);
+            fitTrack(scales, _boneTracks[boneId].scale, trackTolerance);
+
+            if (trackTolerance < MIN_TRACK_TOLERANCE || boneTrackFits(boneId, tolerance))
+                break;
+        }
+    }
+
+    _boneMatricesPerFrame.clear();
+    _boneMatricesPerFrame.shrink_to_fit();
+    _poseCache.clear();
+
+    return shared_from_this();
+}
+
+unsigned int
+Skin::numKeyframes() const
+{
+    unsigned int numKeyframes = 0;
+
+    for (auto& boneTrack : _boneTracks)
+        numKeyframes += boneTrack.translation.frames.size()
+            + boneTrack.rotation.frames.size()
+            + boneTrack.scale.frames.size();
+
+    return numKeyframes;
+}
+
+const std::vector<float>&
+Skin::cachedPose(unsigned int frameId) const
+{
+    ++_poseCacheClock;
+
+    CachedPose* pose = nullptr;
+
+    for (auto& cachedPose : _poseCache)
+    {
+        if (cachedPose.frameId == (int)frameId)
+        {
+            cachedPose.lastUse = _poseCacheClock;
+
+            return cachedPose.matrices;
+        }
+
+        if (pose == nullptr || cachedPose.lastUse < pose->lastUse)
+            pose = &cachedPose;
+    }
+
+    // poses are never moved once created: references to the matrices of the other ones remain valid
+    if (_poseCache.size() < POSE_CACHE_SIZE)
+    {
+        _poseCache.reserve(POSE_CACHE_SIZE);
+        _poseCache.resize(_poseCache.size() + 1);
+        pose = &_poseCache.back();
+        pose->matrices.resize(_numBones << 4);
+    }
+
+    pose->frameId = frameId;
+    pose->lastUse = _poseCacheClock;
+    evaluatePose(frameId, &pose->matrices[0]);
+
+    return pose->matrices;
+}
+
+void
+Skin::evaluatePose(unsigned int frameId, float* matrices) const
+{
+    for (unsigned int boneId = 0; boneId < _numBones; ++boneId)
+        evaluateBone(frameId, boneId, matrices + (boneId << 4));
+}
+
+void
+Skin::evaluateBone(unsigned int frameId, unsigned int boneId, float* boneMatrix) const
+{
+    const auto& boneTrack = _boneTracks[boneId];
+    float       translation[3];
+    float       rotation[4];
+    float       scale[3];
+    float       matrix[16];
+
+    sampleTrack(boneTrack.translation, frameId, translation);
+    sampleTrack(boneTrack.rotation, frameId, rotation);
+    sampleTrack(boneTrack.scale, frameId, scale);
+
+    compose(translation, rotation, scale, matrix);
+
+    for (unsigned int i = 0; i < 16; ++i)
+        boneMatrix[i] = _transposedMatrices ? matrix[((i & 3) << 2) + (i >> 2)] : matrix[i];
+}
+
+bool
+Skin::boneTrackFits(unsigned int boneId, float tolerance) const
+{
+    float matrix[16];
+
+    for (unsigned int frameId = 0; frameId < _numFrames; ++frameId)
+    {
+        const float* frameMatrix = &_boneMatricesPerFrame[frameId][boneId << 4];
+
+        evaluateBone(frameId, boneId, matrix);
+
+        for (unsigned int i = 0; i < 16; ++i)
+            if (fabsf(matrix[i] - frameMatrix[i]) > tolerance)
+                return false;
+    }
+
+    return true;
+}
+
+/*static*/
+void
+Skin::decompose(const float* m, float* translation, float* rotation, float* scale)
+{
+    // m is row-major and transforms column vectors: its columns are the scaled axes
+    translation[0] = m[3];
+    translation[1] = m[7];
+    translation[2] = m[11];
+
+    for (unsigned int j = 0; j < 3; ++j)
+        scale[j] = sqrtf(m[j] * m[j] + m[4 + j] * m[4 + j] + m[8 + j] * m[8 + j]);
+
+    const float determinant = m[0] * (m[5] * m[10] - m[9] * m[6])
+        - m[1] * (m[4] * m[10] - m[8] * m[6])
+        + m[2] * (m[4] * m[9] - m[8] * m[5]);
+
+    if (determinant < 0.0f)
+        scale[0] = -scale[0];
+
+    float r[3][3];
+
+    for (unsigned int i = 0; i < 3; ++i)
+        for (unsigned int j = 0; j < 3; ++j)
+            r[i][j] = scale[j] != 0.0f ? m[(i << 2) + j] / scale[j] : (i == j ? 1.0f : 0.0f);
+
+    const float trace = r[0][0] + r[1][1] + r[2][2];
+    float       x, y, z, w;
+
+    if (trace > 0.0f)
+    {
+        const float s = sqrtf(trace + 1.0f) * 2.0f;
+
+        w = 0.25f * s;
+        x = (r[2][1] - r[1][2]) / s;
+        y = (r[0][2] - r[2][0]) / s;
+        z = (r[1][0] - r[0][1]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        const float s = sqrtf(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;
+
+        w = (r[2][1] - r[1][2]) / s;
+        x = 0.25f * s;
+        y = (r[0][1] + r[1][0]) / s;
+        z = (r[0][2] + r[2][0]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+        const float s = sqrtf(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;
+
+        w = (r[0][2] - r[2][0]) / s;
+        x = (r[0][1] + r[1][0]) / s;
+        y = 0.25f * s;
+        z = (r[1][2] + r[2][1]) / s;
+    }
+    else
+    {
+        const float s = sqrtf(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;
+
+        w = (r[1][0] - r[0][1]) / s;
+        x = (r[0][2] + r[2][0]) / s;
+        y = (r[1][2] + r[2][1]) / s;
+        z = 0.25f * s;
+    }
+
+    const float length = sqrtf(x * x + y * y + z * z + w * w);
+
+    rotation[0] = x / length;
+    rotation[1] = y / length;
+    rotation[2] = z / length;
+    rotation[3] = w / length;
+}
+
+/*static*/
+void
+Skin::compose(const float* translation, const float* rotation, const float* scale, float* m)
+{
+    const float x = rotation[0];
+    const float y = rotation[1];
+    const float z = rotation[2];
+    const float w = rotation[3];
+
+    m[0]    = (1.0f - 2.0f * (y * y + z * z)) * scale[0];
+    m[1]    = 2.0f * (x * y - w * z) * scale[1];
+    m[2]    = 2.0f * (x * z + w * y) * scale[2];
+    m[3]    = translation[0];
+    m[4]    = 2.0f * (x * y + w * z) * scale[0];
+    m[5]    = (1.0f - 2.0f * (x * x + z * z)) * scale[1];
+    m[6]    = 2.0f * (y * z - w * x) * scale[2];
+    m[7]    = translation[1];
+    m[8]    = 2.0f * (x * z - w * y) * scale[0];
+    m[9]    = 2.0f * (y * z + w * x) * scale[1];
+    m[10]   = (1.0f - 2.0f * (x * x + y * y)) * scale[2];
+    m[11]   = translation[2];
+    m[12]   = 0.0f;
+    m[13]   = 0.0f;
+    m[14]   = 0.0f;
+    m[15]   = 1.0f;
+}
+
+/*static*/
+std::vector<unsigned short>
+Skin::selectKeyframes(unsigned int numFrames, const std::function<bool(unsigned int, unsigned int, unsigned int)>& interpolates)
+{
+    std::vector<unsigned short> keyframes(1, 0);
+
+    // greedily extend each segment as long as linear interpolation stays close to every frame it spans
+    for (unsigned int end = 2; end < numFrames; ++end)
+    {
+        const unsigned int  start   = keyframes.back();
+        bool                fits    = true;
+
+        for (unsigned int frameId = start + 1; frameId < end && fits; ++frameId)
+            fits = interpolates(start, end, frameId);
+
+        if (!fits)
+            keyframes.push_back(end - 1);
+    }
+
+    if (numFrames > 1)
+        keyframes.push_back(numFrames - 1);
+
+    return keyframes;
+}
+
+/*static*/
+void
+Skin::fitTrack(const std::vector<float>& values, Vector3Track& track, float tolerance)
+{
+    const unsigned int numFrames = values.size() / 3;
+
+    track.frames = selectKeyframes(numFrames, [&](unsigned int start, unsigned int end, unsigned int frameId)
+    {
+        const float t = (frameId - start) / float(end - start);
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            const float a = values[start * 3 + i];
+            const float b = values[end * 3 + i];
+
+            if (fabsf(a + (b - a) * t - values[frameId * 3 + i]) > tolerance)
+                return false;
+        }
+
+        return true;
+    });
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        float min = values[i];
+        float max = values[i];
+
+        for (auto frameId : track.frames)
+        {
+            min = std::min(min, values[frameId * 3 + i]);
+            max = std::max(max, values[frameId * 3 + i]);
+        }
+
+        track.min[i] = min;
+        track.extent[i] = max - min;
+    }
+
+    track.values.resize(track.frames.size() * 3);
+    for (unsigned int k = 0; k < track.frames.size(); ++k)
+        for (unsigned int i = 0; i < 3; ++i)
+            track.values[k * 3 + i] = track.extent[i] > 0.0f
+                ? (unsigned short)floorf((values[track.frames[k] * 3 + i] - track.min[i]) / track.extent[i] * 65535.0f + 0.5f)
+                : 0;
+}
+
+/*static*/
+void
+Skin::fitTrack(const std::vector<float>& values, RotationTrack& track, float tolerance)
+{
+    const unsigned int numFrames = values.size() / 4;
+
+    track.frames = selectKeyframes(numFrames, [&](unsigned int start, unsigned int end, unsigned int frameId)
+    {
+        const float t = (frameId - start) / float(end - start);
+        float       q[4];
+        float       length = 0.0f;
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            q[i] = values[start * 4 + i] + (values[end * 4 + i] - values[start * 4 + i]) * t;
+            length += q[i] * q[i];
+        }
+
+        length = sqrtf(length);
+
+        for (unsigned int i = 0; i < 4; ++i)
+            if (fabsf(q[i] / length - values[frameId * 4 + i]) > tolerance)
+                return false;
+
+        return true;
+    });
+
+    track.values.resize(track.frames.size());
+    for (unsigned int k = 0; k < track.frames.size(); ++k)
+        track.values[k] = encodeRotation(&values[track.frames[k] * 4]);
+}
+
+/*static*/
+void
+Skin::sampleTrack(const Vector3Track& track, unsigned int frameId, float* value)
+{
+    const auto          next    = std::upper_bound(track.frames.begin(), track.frames.end(), frameId);
+    const unsigned int  k1      = std::min<unsigned int>(next - track.frames.begin(), track.frames.size() - 1);
+    const unsigned int  k0      = next == track.frames.begin() ? 0 : (next - track.frames.begin()) - 1;
+    const float         t       = k1 != k0 ? (frameId - track.frames[k0]) / float(track.frames[k1] - track.frames[k0]) : 0.0f;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const float a = track.min[i] + track.values[k0 * 3 + i] * track.extent[i] / 65535.0f;
+        const float b = track.min[i] + track.values[k1 * 3 + i] * track.extent[i] / 65535.0f;
+
+        value[i] = a + (b - a) * t;
+    }
+}
+
+/*static*/
+void
+Skin::sampleTrack(const RotationTrack& track, unsigned int frameId, float* value)
+{
+    const auto          next    = std::upper_bound(track.frames.begin(), track.frames.end(), frameId);
+    const unsigned int  k1      = std::min<unsigned int>(next - track.frames.begin(), track.frames.size() - 1);
+    const unsigned int  k0      = next == track.frames.begin() ? 0 : (next - track.frames.begin()) - 1;
+    const float         t       = k1 != k0 ? (frameId - track.frames[k0]) / float(track.frames[k1] - track.frames[k0]) : 0.0f;
+    float               a[4];
+    float               b[4];
+
+    decodeRotation(track.values[k0], a);
+    decodeRotation(track.values[k1], b);
+
+    // the encoding does not preserve the sign of the quaternions
+    const float sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f ? -1.0f : 1.0f;
+    float       length = 0.0f;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        value[i] = a[i] + (sign * b[i] - a[i]) * t;
+        length += value[i] * value[i];
+    }
+
+    length = sqrtf(length);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        value[i] /= length;
+}
+
+/*static*/
+uint64_t
+Skin::encodeRotation(const float* rotation)
+{
+    // drop the largest component, rebuilt from the unit length, and keep the sign making it positive:
+    // the three others then lie in [-1/sqrt(2), 1/sqrt(2)] and are quantized to 20 bits each
+    static const float      range   = 0.70710678f;
+    static const uint64_t   mask    = (1 << 20) - 1;
+
+    unsigned int largest = 0;
+
+    for (unsigned int i = 1; i < 4; ++i)
+        if (fabsf(rotation[i]) > fabsf(rotation[largest]))
+            largest = i;
+
+    const float sign    = rotation[largest] < 0.0f ? -1.0f : 1.0f;
+    uint64_t    encoded = largest;
+    unsigned int shift  = 2;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+
+        const float normalized = std::min(std::max((sign * rotation[i] / range + 1.0f) * 0.5f, 0.0f), 1.0f);
+
+        encoded |= (uint64_t)floorf(normalized * mask + 0.5f) << shift;
+        shift += 20;
+    }
+
+    return encoded;
+}
+
+/*static*/
+void
+Skin::decodeRotation(uint64_t encoded, float* rotation)
+{
+    static const float      range   = 0.70710678f;
+    static const uint64_t   mask    = (1 << 20) - 1;
+
+    const unsigned int  largest         = encoded & 3;
+    unsigned int        shift           = 2;
+    float               squaredLength   = 0.0f;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+
+        rotation[i] = (((encoded >> shift) & mask) / float(mask) * 2.0f - 1.0f) * range;
+        squaredLength += rotation[i] * rotation[i];
+        shift += 20;
+    }
+
+    rotation[largest] = sqrtf(std::max(0.0f, 1.0f - squaredLength));
+}
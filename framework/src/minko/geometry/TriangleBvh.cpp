@@ -0,0 +1,481 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/TriangleBvh.hpp"
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+# include <xmmintrin.h>
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+# include <arm_neon.h>
+#endif
+
+using namespace minko;
+using namespace minko::geometry;
+
+void
+TriangleBvh::build(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices)
+{
+    struct TriangleRef
+    {
+        float   min[3];
+        float   max[3];
+        float   center[3];
+        uint    triangle;
+    };
+
+    struct BuildTask
+    {
+        uint    parent;
+        uint    begin;
+        uint    end;
+    };
+
+    static const uint NO_PARENT = std::numeric_limits<uint>::max();
+
+    _numTriangles = indices.size() / 3;
+    _nodes.clear();
+    _packets.clear();
+
+    if (_numTriangles == 0)
+        return;
+
+    std::vector<TriangleRef> refs(_numTriangles);
+
+    for (uint i = 0; i < _numTriangles; ++i)
+    {
+        auto& ref = refs[i];
+
+        ref.triangle = i * 3;
+        for (uint axis = 0; axis < 3; ++axis)
+        {
+            const float a = xyz[indices[i * 3] * vertexSize + axis];
+            const float b = xyz[indices[i * 3 + 1] * vertexSize + axis];
+            const float c = xyz[indices[i * 3 + 2] * vertexSize + axis];
+
+            ref.min[axis] = std::min(a, std::min(b, c));
+            ref.max[axis] = std::max(a, std::max(b, c));
+            ref.center[axis] = (ref.min[axis] + ref.max[axis]) * .5f;
+        }
+    }
+
+    _nodes.reserve(2 * _numTriangles / MAX_LEAF_SIZE + 1);
+    _packets.reserve((_numTriangles + 3) / 4 + _numTriangles / MAX_LEAF_SIZE + 1);
+
+    std::vector<BuildTask> tasks;
+    BuildTask task = { NO_PARENT, 0, _numTriangles };
+
+    tasks.push_back(task);
+    while (!tasks.empty())
+    {
+        task = tasks.back();
+        tasks.pop_back();
+
+        // the first child of an inner node is processed right after it and thus stored next to it
+        while (true)
+        {
+            const uint nodeId = _nodes.size();
+
+            _nodes.push_back(Node());
+            if (task.parent != NO_PARENT)
+                _nodes[task.parent].offset = nodeId;
+
+            auto&   node            = _nodes.back();
+            float   centerMin[3]    = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+            float   centerMax[3]    = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+            for (uint axis = 0; axis < 3; ++axis)
+            {
+                node.min[axis] = std::numeric_limits<float>::max();
+                node.max[axis] = -std::numeric_limits<float>::max();
+            }
+
+            for (uint i = task.begin; i < task.end; ++i)
+                for (uint axis = 0; axis < 3; ++axis)
+                {
+                    node.min[axis] = std::min(node.min[axis], refs[i].min[axis]);
+                    node.max[axis] = std::max(node.max[axis], refs[i].max[axis]);
+                    centerMin[axis] = std::min(centerMin[axis], refs[i].center[axis]);
+                    centerMax[axis] = std::max(centerMax[axis], refs[i].center[axis]);
+                }
+
+            uint splitAxis = 0;
+
+            for (uint axis = 1; axis < 3; ++axis)
+                if (centerMax[axis] - centerMin[axis] > centerMax[splitAxis] - centerMin[splitAxis])
+                    splitAxis = axis;
+
+            const uint numTriangles = task.end - task.begin;
+
+            if (numTriangles <= MAX_LEAF_SIZE || !(centerMax[splitAxis] > centerMin[splitAxis]))
+            {
+                node.offset = _packets.size();
+                node.numPackets = (numTriangles + 3) / 4;
+
+                for (uint i = 0; i < numTriangles; i += 4)
+                {
+                    // unused lanes keep null edges and are rejected as degenerated triangles
+                    TrianglePacket packet;
+
+                    std::memset(&packet, 0, sizeof(TrianglePacket));
+                    for (uint lane = 0; lane < 4 && i + lane < numTriangles; ++lane)
+                    {
+                        const uint      triangle    = refs[task.begin + i + lane].triangle;
+                        const float*    v0          = xyz + indices[triangle] * vertexSize;
+                        const float*    v1          = xyz + indices[triangle + 1] * vertexSize;
+                        const float*    v2          = xyz + indices[triangle + 2] * vertexSize;
+
+                        for (uint axis = 0; axis < 3; ++axis)
+                        {
+                            packet.v0[axis][lane] = v0[axis];
+                            packet.edge1[axis][lane] = v1[axis] - v0[axis];
+                            packet.edge2[axis][lane] = v2[axis] - v0[axis];
+                        }
+                        packet.triangle[lane] = triangle;
+                    }
+                    _packets.push_back(packet);
+                }
+                break;
+            }
+
+            const uint middle = task.begin + numTriangles / 2;
+
+            std::nth_element(
+                refs.begin() + task.begin,
+                refs.begin() + middle,
+                refs.begin() + task.end,
+                [=](const TriangleRef& a, const TriangleRef& b) { return a.center[splitAxis] < b.center[splitAxis]; }
+            );
+
+            node.numPackets = 0;
+
+            BuildTask secondChild = { nodeId, middle, task.end };
+
+            tasks.push_back(secondChild);
+            task.parent = NO_PARENT;
+            task.end = middle;
+        }
+    }
+}
+
+/*static*/
+bool
+TriangleBvh::intersectBox(const Node&   node,
+                          const float*  origin,
+                          const float*  invDirection,
+                          float         maxDistance,
+                          float&        distance)
+{
+    float tmin = 0.f;
+    float tmax = maxDistance;
+
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+        float t0 = (node.min[axis] - origin[axis]) * invDirection[axis];
+        float t1 = (node.max[axis] - origin[axis]) * invDirection[axis];
+
+        if (t0 > t1)
+            std::swap(t0, t1);
+
+        // NaN (origin on a slab of a parallel ray) leaves the interval unchanged
+        tmin = t0 > tmin ? t0 : tmin;
+        tmax = t1 < tmax ? t1 : tmax;
+
+        if (tmin > tmax)
+            return false;
+    }
+
+    distance = tmin;
+
+    return true;
+}
+
+bool
+TriangleBvh::intersectPacket(const TrianglePacket&  packet,
+                             const float*           origin,
+                             const float*           direction,
+                             float&                 distance,
+                             uint&                  triangle,
+                             float&                 u,
+                             float&                 v) const
+{
+    static const float EPSILON = 0.00001f;
+
+    float laneT[4];
+    float laneU[4];
+    float laneV[4];
+    uint  laneHit[4];
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+    const __m128 ox     = _mm_set1_ps(origin[0]);
+    const __m128 oy     = _mm_set1_ps(origin[1]);
+    const __m128 oz     = _mm_set1_ps(origin[2]);
+    const __m128 dx     = _mm_set1_ps(direction[0]);
+    const __m128 dy     = _mm_set1_ps(direction[1]);
+    const __m128 dz     = _mm_set1_ps(direction[2]);
+    const __m128 e1x    = _mm_loadu_ps(packet.edge1[0]);
+    const __m128 e1y    = _mm_loadu_ps(packet.edge1[1]);
+    const __m128 e1z    = _mm_loadu_ps(packet.edge1[2]);
+    const __m128 e2x    = _mm_loadu_ps(packet.edge2[0]);
+    const __m128 e2y    = _mm_loadu_ps(packet.edge2[1]);
+    const __m128 e2z    = _mm_loadu_ps(packet.edge2[2]);
+    const __m128 zero   = _mm_setzero_ps();
+
+    // pvec = direction x edge2
+    const __m128 px     = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    const __m128 py     = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    const __m128 pz     = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+    const __m128 det    = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+    const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.f), det);
+    const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+    // tvec = origin - v0, qvec = tvec x edge1
+    const __m128 tx     = _mm_sub_ps(ox, _mm_loadu_ps(packet.v0[0]));
+    const __m128 ty     = _mm_sub_ps(oy, _mm_loadu_ps(packet.v0[1]));
+    const __m128 tz     = _mm_sub_ps(oz, _mm_loadu_ps(packet.v0[2]));
+    const __m128 qx     = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+    const __m128 qy     = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+    const __m128 qz     = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+    const __m128 uu     = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+    const __m128 vv     = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+    const __m128 tt     = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+    __m128 mask = _mm_cmpgt_ps(absDet, _mm_set1_ps(EPSILON));
+
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(uu, zero));
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(vv, zero));
+    mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(uu, vv), _mm_set1_ps(1.f)));
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(tt, zero));
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(tt, _mm_set1_ps(distance)));
+
+    const int hitMask = _mm_movemask_ps(mask);
+
+    if (hitMask == 0)
+        return false;
+
+    _mm_storeu_ps(laneT, tt);
+    _mm_storeu_ps(laneU, uu);
+    _mm_storeu_ps(laneV, vv);
+    for (uint lane = 0; lane < 4; ++lane)
+        laneHit[lane] = (hitMask >> lane) & 1;
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+    const float32x4_t ox        = vdupq_n_f32(origin[0]);
+    const float32x4_t oy        = vdupq_n_f32(origin[1]);
+    const float32x4_t oz        = vdupq_n_f32(origin[2]);
+    const float32x4_t dx        = vdupq_n_f32(direction[0]);
+    const float32x4_t dy        = vdupq_n_f32(direction[1]);
+    const float32x4_t dz        = vdupq_n_f32(direction[2]);
+    const float32x4_t e1x       = vld1q_f32(packet.edge1[0]);
+    const float32x4_t e1y       = vld1q_f32(packet.edge1[1]);
+    const float32x4_t e1z       = vld1q_f32(packet.edge1[2]);
+    const float32x4_t e2x       = vld1q_f32(packet.edge2[0]);
+    const float32x4_t e2y       = vld1q_f32(packet.edge2[1]);
+    const float32x4_t e2z       = vld1q_f32(packet.edge2[2]);
+    const float32x4_t zero      = vdupq_n_f32(0.f);
+
+    const float32x4_t px        = vsubq_f32(vmulq_f32(dy, e2z), vmulq_f32(dz, e2y));
+    const float32x4_t py        = vsubq_f32(vmulq_f32(dz, e2x), vmulq_f32(dx, e2z));
+    const float32x4_t pz        = vsubq_f32(vmulq_f32(dx, e2y), vmulq_f32(dy, e2x));
+    const float32x4_t det       = vaddq_f32(vaddq_f32(vmulq_f32(e1x, px), vmulq_f32(e1y, py)), vmulq_f32(e1z, pz));
+
+    // reciprocal estimate refined by two Newton-Raphson steps
+    float32x4_t invDet = vrecpeq_f32(det);
+
+    invDet = vmulq_f32(vrecpsq_f32(det, invDet), invDet);
+    invDet = vmulq_f32(vrecpsq_f32(det, invDet), invDet);
+
+    const float32x4_t tx        = vsubq_f32(ox, vld1q_f32(packet.v0[0]));
+    const float32x4_t ty        = vsubq_f32(oy, vld1q_f32(packet.v0[1]));
+    const float32x4_t tz        = vsubq_f32(oz, vld1q_f32(packet.v0[2]));
+    const float32x4_t qx        = vsubq_f32(vmulq_f32(ty, e1z), vmulq_f32(tz, e1y));
+    const float32x4_t qy        = vsubq_f32(vmulq_f32(tz, e1x), vmulq_f32(tx, e1z));
+    const float32x4_t qz        = vsubq_f32(vmulq_f32(tx, e1y), vmulq_f32(ty, e1x));
+
+    const float32x4_t uu        = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(tx, px), vmulq_f32(ty, py)), vmulq_f32(tz, pz)), invDet);
+    const float32x4_t vv        = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(dx, qx), vmulq_f32(dy, qy)), vmulq_f32(dz, qz)), invDet);
+    const float32x4_t tt        = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(e2x, qx), vmulq_f32(e2y, qy)), vmulq_f32(e2z, qz)), invDet);
+
+    uint32x4_t mask = vcgtq_f32(vabsq_f32(det), vdupq_n_f32(EPSILON));
+
+    mask = vandq_u32(mask, vcgeq_f32(uu, zero));
+    mask = vandq_u32(mask, vcgeq_f32(vv, zero));
+    mask = vandq_u32(mask, vcleq_f32(vaddq_f32(uu, vv), vdupq_n_f32(1.f)));
+    mask = vandq_u32(mask, vcgeq_f32(tt, zero));
+    mask = vandq_u32(mask, vcltq_f32(tt, vdupq_n_f32(distance)));
+
+    vst1q_u32(laneHit, mask);
+    if ((laneHit[0] | laneHit[1] | laneHit[2] | laneHit[3]) == 0)
+        return false;
+
+    vst1q_f32(laneT, tt);
+    vst1q_f32(laneU, uu);
+    vst1q_f32(laneV, vv);
+#else
+    for (uint lane = 0; lane < 4; ++lane)
+    {
+        const float e1[3]   = { packet.edge1[0][lane], packet.edge1[1][lane], packet.edge1[2][lane] };
+        const float e2[3]   = { packet.edge2[0][lane], packet.edge2[1][lane], packet.edge2[2][lane] };
+        const float p[3]    = {
+            direction[1] * e2[2] - direction[2] * e2[1],
+            direction[2] * e2[0] - direction[0] * e2[2],
+            direction[0] * e2[1] - direction[1] * e2[0]
+        };
+        const float det     = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+        laneHit[lane] = 0;
+        if (det > -EPSILON && det < EPSILON)
+            continue;
+
+        const float invDet  = 1.f / det;
+        const float t[3]    = {
+            origin[0] - packet.v0[0][lane],
+            origin[1] - packet.v0[1][lane],
+            origin[2] - packet.v0[2][lane]
+        };
+        const float q[3]    = {
+            t[1] * e1[2] - t[2] * e1[1],
+            t[2] * e1[0] - t[0] * e1[2],
+            t[0] * e1[1] - t[1] * e1[0]
+        };
+
+        laneU[lane] = (t[0] * p[0] + t[1] * p[1] + t[2] * p[2]) * invDet;
+        laneV[lane] = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * invDet;
+        laneT[lane] = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+        laneHit[lane] = laneU[lane] >= 0.f && laneV[lane] >= 0.f && laneU[lane] + laneV[lane] <= 1.f
+            && laneT[lane] >= 0.f && laneT[lane] < distance;
+    }
+#endif
+
+    bool hit = false;
+
+    for (uint lane = 0; lane < 4; ++lane)
+        if (laneHit[lane] && laneT[lane] < distance)
+        {
+            distance = laneT[lane];
+            triangle = packet.triangle[lane];
+            u = laneU[lane];
+            v = laneV[lane];
+            hit = true;
+        }
+
+    return hit;
+}
+
+bool
+TriangleBvh::cast(const float*  origin,
+                  const float*  direction,
+                  float&        distance,
+                  uint&         triangle,
+                  float&        u,
+                  float&        v) const
+{
+    if (_nodes.empty())
+        return false;
+
+    const float invDirection[3] = { 1.f / direction[0], 1.f / direction[1], 1.f / direction[2] };
+
+    float   closest     = std::numeric_limits<float>::infinity();
+    uint    hitTriangle = 0;
+    float   hitU        = 0.f;
+    float   hitV        = 0.f;
+    float   entry       = 0.f;
+
+    // median splits keep the depth under 32 levels for any 32 bits number of triangles
+    std::pair<uint, float>  stack[64];
+    uint                    stackSize   = 0;
+
+    if (!intersectBox(_nodes[0], origin, invDirection, closest, entry))
+        return false;
+
+    stack[stackSize++] = std::make_pair(0u, entry);
+    while (stackSize != 0)
+    {
+        const auto  current = stack[--stackSize];
+        const auto& node    = _nodes[current.first];
+
+        if (current.second > closest)
+            continue;
+
+        if (node.numPackets != 0)
+        {
+            for (uint i = node.offset; i < node.offset + node.numPackets; ++i)
+                intersectPacket(_packets[i], origin, direction, closest, hitTriangle, hitU, hitV);
+
+            continue;
+        }
+
+        // visit the closest child first to shrink the search interval as soon as possible
+        float       firstEntry  = 0.f;
+        float       secondEntry = 0.f;
+        const uint  first       = current.first + 1;
+        const uint  second      = node.offset;
+        const bool  hitFirst    = intersectBox(_nodes[first], origin, invDirection, closest, firstEntry);
+        const bool  hitSecond   = intersectBox(_nodes[second], origin, invDirection, closest, secondEntry);
+
+        if (hitFirst && hitSecond)
+        {
+            if (firstEntry < secondEntry)
+            {
+                stack[stackSize++] = std::make_pair(second, secondEntry);
+                stack[stackSize++] = std::make_pair(first, firstEntry);
+            }
+            else
+            {
+                stack[stackSize++] = std::make_pair(first, firstEntry);
+                stack[stackSize++] = std::make_pair(second, secondEntry);
+            }
+        }
+        else if (hitFirst)
+            stack[stackSize++] = std::make_pair(first, firstEntry);
+        else if (hitSecond)
+            stack[stackSize++] = std::make_pair(second, secondEntry);
+    }
+
+    if (closest == std::numeric_limits<float>::infinity())
+        return false;
+
+    distance = closest;
+    triangle = hitTriangle;
+    u = hitU;
+    v = hitV;
+
+    return true;
+}
+
+uint
+TriangleBvh::cast(const float*  origins,
+                  const float*  directions,
+                  uint          numRays,
+                  float*        distances,
+                  uint*         triangles) const
+{
+    uint numHits = 0;
+
+    for (uint i = 0; i < numRays; ++i)
+    {
+        float u = 0.f;
+        float v = 0.f;
+
+        distances[i] = std::numeric_limits<float>::infinity();
+        if (cast(origins + i * 3, directions + i * 3, distances[i], triangles[i], u, v))
+            ++numHits;
+    }
+
+    return numHits;
+}
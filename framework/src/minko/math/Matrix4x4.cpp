@@ -21,6 +21,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Signal.hpp"
 
+#if MINKO_SIMD == MINKO_SIMD_SSE
+# include <xmmintrin.h>
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+# include <arm_neon.h>
+#endif
+
 using namespace minko;
 using namespace minko::math;
 
@@ -305,6 +311,60 @@ Matrix4x4::prepend(Matrix4x4::Ptr matrix)
     );
 }
 
+/*static*/
+void
+Matrix4x4::multiply(const float* a, const float* b, float* out)
+{
+#if MINKO_SIMD == MINKO_SIMD_SSE
+    const __m128 b0 = _mm_loadu_ps(b);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+    __m128 rows[4];
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        const float* ai = a + i * 4;
+
+        rows[i] = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ai[0]), b0), _mm_mul_ps(_mm_set1_ps(ai[1]), b1)),
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ai[2]), b2), _mm_mul_ps(_mm_set1_ps(ai[3]), b3))
+        );
+    }
+
+    for (auto i = 0; i < 4; ++i)
+        _mm_storeu_ps(out + i * 4, rows[i]);
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+    const float32x4_t b0 = vld1q_f32(b);
+    const float32x4_t b1 = vld1q_f32(b + 4);
+    const float32x4_t b2 = vld1q_f32(b + 8);
+    const float32x4_t b3 = vld1q_f32(b + 12);
+    float32x4_t rows[4];
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        const float* ai = a + i * 4;
+        float32x4_t row = vmulq_n_f32(b0, ai[0]);
+
+        row = vmlaq_n_f32(row, b1, ai[1]);
+        row = vmlaq_n_f32(row, b2, ai[2]);
+        rows[i] = vmlaq_n_f32(row, b3, ai[3]);
+    }
+
+    for (auto i = 0; i < 4; ++i)
+        vst1q_f32(out + i * 4, rows[i]);
+#else
+    float result[16];
+
+    for (auto i = 0; i < 4; ++i)
+        for (auto j = 0; j < 4; ++j)
+            result[i * 4 + j] = a[i * 4] * b[j] + a[i * 4 + 1] * b[4 + j]
+                + a[i * 4 + 2] * b[8 + j] + a[i * 4 + 3] * b[12 + j];
+
+    std::copy(result, result + 16, out);
+#endif
+}
+
 Matrix4x4::Ptr
 Matrix4x4::appendTranslation(float x, float y, float z)
 {
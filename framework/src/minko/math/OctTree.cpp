@@ -31,30 +31,29 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/math/Frustum.hpp"
+#include "minko/math/Ray.hpp"
 
 using namespace minko;
 using namespace minko::math;
 
-OctTree::OctTree(float                            worldSize,
-                  uint                            maxDepth,
-                 std::shared_ptr<math::Vector3>    center,
-                 uint                            depth)
+OctTree::OctTree(float                          worldSize,
+                 uint                           maxDepth,
+                 std::shared_ptr<math::Vector3> center,
+                 uint                           depth) :
+    _maxDepth(maxDepth),
+    _depth(depth),
+    _splitted(false),
+    _parent(nullptr),
+    _numNodes(0),
+    _halfSize(worldSize / powf(2.f, (float)depth)),
+    _center(math::Vector3::create(center)), // grow() moves the center of the root
+    _octantBox(math::Box::create())
 {
-    _worldSize  = worldSize;
-    _depth        = depth;
-    _center        = center;
-    _splitted    = false;
-    _maxDepth    = maxDepth;
-
-    float edgel = edgeLength();
-
-    _octantBox = math::Box::create(
-        math::Vector3::create(_center->x() + edgel, _center->y() + edgel, _center->z() + edgel),
-        math::Vector3::create(_center->x() - edgel, _center->y() - edgel, _center->z() - edgel));
+    updateOctantBox();
 }
 
 std::shared_ptr<scene::Node>
-OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>        assetLibrary,
+OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>     assetLibrary,
                         std::shared_ptr<scene::Node>            rootNode)
 {
     if (!rootNode)
@@ -76,7 +75,6 @@ OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>        assetLibrary,
                         assetLibrary->effect("effect/Basic.effect")
                     ));
         rootNode->addChild(node);
-        debugNode = node;
     }
 
     if (_splitted)
@@ -89,9 +87,9 @@ OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>        assetLibrary,
 void
 OctTree::split()
 {
-    this->_children.resize(8);
+    _children.resize(8);
 
-    float size = (float)_k * _worldSize / (powf(2.f, (float)_depth));
+    const float childHalfSize = _halfSize * .5f;
 
     for (uint x = 0; x < 2; ++x)
     {
@@ -102,14 +100,15 @@ OctTree::split()
                 uint index = x + (y << 1) + (z << 2);
 
                 _children[index] = OctTree::create(
-                    _worldSize,
+                    childHalfSize,
                     _maxDepth,
                     math::Vector3::create(
-                        _center->x() + (x == 0 ? -size / 2 : size / 2),
-                        _center->y() + (y == 0 ? -size / 2 : size / 2),
-                        _center->z() + (z == 0 ? -size / 2 : size / 2)),
-                    _depth + 1);
-                _children[index]->_parent = shared_from_this();
+                        _center->x() + (x == 0 ? -childHalfSize : childHalfSize),
+                        _center->y() + (y == 0 ? -childHalfSize : childHalfSize),
+                        _center->z() + (z == 0 ? -childHalfSize : childHalfSize))
+                );
+                _children[index]->_depth = _depth + 1;
+                _children[index]->_parent = this;
             }
         }
     }
@@ -119,93 +118,207 @@ OctTree::split()
 OctTree::Ptr
 OctTree::insert(std::shared_ptr<scene::Node> node)
 {
-    // already reference by the octTree
-    if (_nodeToOctant.find(node) != _nodeToOctant.end())
+    // already referenced by the octTree
+    if (hasNode(node))
         return shared_from_this();
 
     if (!node->hasComponent<component::BoundingBox>())
         node->addComponent(component::BoundingBox::create());
 
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Matrix4x4>        modelToWorld    = node->component<component::Transform>()->modelToWorldMatrix(true);
+    std::weak_ptr<scene::Node> weakNode = node;
+
+    // world matrices are not up to date yet: the node will be placed by the next call to update()
+    _nodeToTransformChangedSlot[node] = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(
+        [=](data::Container::Ptr data, const std::string& propertyName)
+        {
+            auto changedNode = weakNode.lock();
+
+            if (changedNode)
+                _invalidNodes.insert(changedNode);
+        }
+    );
+    _invalidNodes.insert(node);
+
+    return shared_from_this();
+}
+
+OctTree::Ptr
+OctTree::remove(std::shared_ptr<scene::Node> node)
+{
+    // not referenced by the octTree
+    if (!hasNode(node))
+        return shared_from_this();
+
+    _nodeToTransformChangedSlot.erase(node);
+    _invalidNodes.erase(node);
+
+    auto octantIt = _nodeToOctant.find(node);
+
+    if (octantIt != _nodeToOctant.end())
+    {
+        detach(node, octantIt->second);
+        _nodeToOctant.erase(octantIt);
+    }
+
+    return shared_from_this();
+}
+
+void
+OctTree::update()
+{
+    if (_invalidNodes.empty())
+        return;
 
-    // insert
-    uint                                optimalDepth    = std::min(computeDepth(node), _maxDepth);
-    uint                                currentDepth    = 0;
-    OctTree::Ptr                        octant            = shared_from_this();
+    std::vector<NodePtr> invalidNodes(_invalidNodes.begin(), _invalidNodes.end());
 
-    std::shared_ptr<math::Vector3>        newNodeCenter    = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
+    _invalidNodes.clear();
 
-    for (currentDepth = 0; currentDepth != optimalDepth; ++currentDepth)
+    for (auto& node : invalidNodes)
     {
-        if (!octant->_splitted)
-            octant->split();
+        auto octantIt = _nodeToOctant.find(node);
 
-        uint xIndex = 0;
-        uint yIndex = 0;
-        uint zIndex = 0;
+        if (octantIt != _nodeToOctant.end())
+        {
+            auto box = node->component<component::BoundingBox>()->box();
+
+            // loose bounds: small moves do not require to move the node to another octant
+            if (octantIt->second->fits(box, computeRadius(box)))
+                continue;
 
-        if (newNodeCenter->x() > octant->_center->x())
-            xIndex = 1;
+            detach(node, octantIt->second);
+            _nodeToOctant.erase(octantIt);
+        }
 
-        if (newNodeCenter->y() > octant->_center->y())
-            yIndex = 1;
+        place(node);
+    }
+}
 
-        if (newNodeCenter->z() > octant->_center->z())
-            zIndex = 1;
+void
+OctTree::place(NodePtr node)
+{
+    auto        boundingBox = node->component<component::BoundingBox>();
+    auto        box         = boundingBox->box();
+    const float radius      = computeRadius(box);
+    OctTree*    octant      = this;
+
+    // nodes with an invalid bounding box stay in the root octant
+    if (std::isfinite(radius)
+        && std::isfinite(box->bottomLeft()->x() + box->bottomLeft()->y() + box->bottomLeft()->z()))
+    {
+        while (!fits(box, radius))
+            grow(box);
 
-        octant = octant->_children[xIndex + (yIndex << 1) + (zIndex << 2)];
+        while (octant->_depth < _maxDepth && radius <= octant->_halfSize * .5f)
+        {
+            if (!octant->_splitted)
+                octant->split();
+
+            uint xIndex = (box->bottomLeft()->x() + box->topRight()->x()) * .5f > octant->_center->x() ? 1 : 0;
+            uint yIndex = (box->bottomLeft()->y() + box->topRight()->y()) * .5f > octant->_center->y() ? 1 : 0;
+            uint zIndex = (box->bottomLeft()->z() + box->topRight()->z()) * .5f > octant->_center->z() ? 1 : 0;
+
+            octant = octant->_children[xIndex + (yIndex << 1) + (zIndex << 2)].get();
+        }
     }
 
     octant->_content.push_back(node);
-    octant->addChildContent(node);
+    octant->_contentBoxes.push_back(boundingBox);
+    for (auto ancestor = octant; ancestor != nullptr; ancestor = ancestor->_parent)
+        ++ancestor->_numNodes;
+
     _nodeToOctant[node] = octant;
-    _matrixToNode[node->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix")] = node;
+}
+
+void
+OctTree::detach(NodePtr node, OctTree* octant)
+{
+    auto index = std::find(octant->_content.begin(), octant->_content.end(), node) - octant->_content.begin();
+
+    octant->_content[index] = octant->_content.back();
+    octant->_content.pop_back();
+    octant->_contentBoxes[index] = octant->_contentBoxes.back();
+    octant->_contentBoxes.pop_back();
+
+    // merge the largest octant left empty
+    OctTree* emptyOctant = nullptr;
+
+    for (auto ancestor = octant; ancestor != nullptr; ancestor = ancestor->_parent)
+        if (--ancestor->_numNodes == 0)
+            emptyOctant = ancestor;
 
-    if (_nodeToTransformChangedSlot.find(node) == _nodeToTransformChangedSlot.end())
+    if (emptyOctant != nullptr && emptyOctant->_splitted)
     {
-        _nodeToTransformChangedSlot[node] = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(std::bind(
-            &OctTree::nodeModelToWorldChanged,
-            shared_from_this(),
-            std::placeholders::_1,
-            std::placeholders::_2));
+        emptyOctant->_children.clear();
+        emptyOctant->_splitted = false;
     }
-
-    return shared_from_this();
 }
 
 bool
-OctTree::nodeChangedOctant(std::shared_ptr<scene::Node> node)
+OctTree::fits(const std::shared_ptr<math::Box>& box, float radius) const
 {
-    Ptr                                        octant            = _nodeToOctant[node];
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Vector3>            nodeCenter        = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
-
-    if (sqrt(pow(nodeCenter->x() - octant->_center->x(), 2) + pow(nodeCenter->y() - octant->_center->y(), 2) + pow(nodeCenter->z() - octant->_center->z(), 2)) < octant->edgeLength())
-        return false;
-    return true;
+    const float x = (box->bottomLeft()->x() + box->topRight()->x()) * .5f;
+    const float y = (box->bottomLeft()->y() + box->topRight()->y()) * .5f;
+    const float z = (box->bottomLeft()->z() + box->topRight()->z()) * .5f;
+
+    return radius <= _halfSize
+        && fabsf(x - _center->x()) <= _halfSize
+        && fabsf(y - _center->y()) <= _halfSize
+        && fabsf(z - _center->z()) <= _halfSize;
 }
 
 void
-OctTree::nodeModelToWorldChanged(data::Container::Ptr    data,
-                                 const std::string&        propertyName)
+OctTree::grow(const std::shared_ptr<math::Box>& box)
 {
-    /*auto node        = _matrixToNode[data->get<std::shared_ptr<math::Matrix4x4>>(propertyName)];
-    auto octant        = _nodeToOctant[node];
+    // the current root becomes one of the 8 children of a root twice as large, extended towards box
+    auto previousRoot = OctTree::create(_halfSize, _maxDepth, _center);
+
+    previousRoot->_splitted = _splitted;
+    previousRoot->_numNodes = _numNodes;
+    previousRoot->_children.swap(_children);
+    previousRoot->_content.swap(_content);
+    previousRoot->_contentBoxes.swap(_contentBoxes);
+
+    for (auto& child : previousRoot->_children)
+        child->_parent = previousRoot.get();
+    for (auto& node : previousRoot->_content)
+        _nodeToOctant[node] = previousRoot.get();
+
+    previousRoot->shiftDepth();
+    ++_maxDepth;
+
+    uint xIndex = (box->bottomLeft()->x() + box->topRight()->x()) * .5f < _center->x() ? 1 : 0;
+    uint yIndex = (box->bottomLeft()->y() + box->topRight()->y()) * .5f < _center->y() ? 1 : 0;
+    uint zIndex = (box->bottomLeft()->z() + box->topRight()->z()) * .5f < _center->z() ? 1 : 0;
+
+    _center->setTo(
+        _center->x() + (xIndex == 1 ? -_halfSize : _halfSize),
+        _center->y() + (yIndex == 1 ? -_halfSize : _halfSize),
+        _center->z() + (zIndex == 1 ? -_halfSize : _halfSize)
+    );
+    _halfSize *= 2.f;
+    _splitted = false;
+    updateOctantBox();
+    split();
+
+    previousRoot->_parent = this;
+    _children[xIndex + (yIndex << 1) + (zIndex << 2)] = previousRoot;
+}
 
-    if (node && nodeChangedOctant(node)) // node is no more in the octant
-    {
-        _matrixToNode.erase(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
-        _nodeToOctant.erase(node);
-        octant->_content.remove(node);
-        insert(node);
-    }*/
+void
+OctTree::shiftDepth()
+{
+    ++_depth;
+
+    for (auto& child : _children)
+        child->shiftDepth();
+}
+
+void
+OctTree::testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
+                     std::function<void(std::shared_ptr<scene::Node>)>    insideFrustumCallback)
+{
+    update();
+    visit(frustum, insideFrustumCallback, nullptr);
 }
 
 void
@@ -213,84 +326,98 @@ OctTree::testFrustum(std::shared_ptr<math::AbstractShape>                frustum
                      std::function<void(std::shared_ptr<scene::Node>)>    insideFrustumCallback,
                      std::function<void(std::shared_ptr<scene::Node>)>    outsideFustumCallback)
 {
-    ShapePosition result                    = frustum->testBoundingBox(_octantBox);
+    update();
+    visit(frustum, insideFrustumCallback, outsideFustumCallback);
+}
+
+void
+OctTree::visit(std::shared_ptr<math::AbstractShape> frustum,
+               const NodeCallback&                  insideFrustumCallback,
+               const NodeCallback&                  outsideFustumCallback)
+{
+    if (_numNodes == 0)
+        return;
+
+    auto result = frustum->testBoundingBox(_octantBox);
 
-    if (result == ShapePosition::AROUND || result == ShapePosition::INSIDE)
+    if (result != ShapePosition::AROUND && result != ShapePosition::INSIDE)
     {
-        if (_splitted)
-        {
-            for (auto octantChild : _children)
-                octantChild->testFrustum(frustum, insideFrustumCallback, outsideFustumCallback);
-        }
+        if (outsideFustumCallback)
+            forEachNode(outsideFustumCallback);
 
-        for (auto node : _content)
-            insideFrustumCallback(node);
+        return;
     }
-    else
+
+    for (uint i = 0; i < _content.size(); ++i)
     {
-        for (auto node : _childrenContent)
-            outsideFustumCallback(node);
-        for (auto node : _content)
-            insideFrustumCallback(node);
+        result = frustum->testBoundingBox(_contentBoxes[i]->box());
+
+        if (result == ShapePosition::AROUND || result == ShapePosition::INSIDE)
+            insideFrustumCallback(_content[i]);
+        else if (outsideFustumCallback)
+            outsideFustumCallback(_content[i]);
     }
+
+    if (_splitted)
+        for (auto& octantChild : _children)
+            octantChild->visit(frustum, insideFrustumCallback, outsideFustumCallback);
 }
 
-OctTree::Ptr
-OctTree::remove(std::shared_ptr<scene::Node> node)
+void
+OctTree::testRay(std::shared_ptr<math::Ray>             ray,
+                 std::function<void(NodePtr, float)>    hitCallback)
 {
-    // not reference by the octTree
-    if (_nodeToOctant.find(node) == _nodeToOctant.end())
-        return shared_from_this();
-
-    Ptr octant = _nodeToOctant[node];
+    update();
+    visit(ray, hitCallback);
+}
 
-    octant->_content.remove(node);
+void
+OctTree::visit(std::shared_ptr<math::Ray>   ray,
+               const RayCallback&           hitCallback)
+{
+    auto distance = 0.f;
 
-    _nodeToOctant.erase(node);
-    _matrixToNode.erase(node->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix"));
+    if (_numNodes == 0 || !_octantBox->cast(ray, distance))
+        return;
 
+    for (uint i = 0; i < _content.size(); ++i)
+        if (_contentBoxes[i]->box()->cast(ray, distance))
+            hitCallback(_content[i], distance);
 
-    return shared_from_this();
+    if (_splitted)
+        for (auto& octantChild : _children)
+            octantChild->visit(ray, hitCallback);
 }
 
-uint
-OctTree::computeDepth(std::shared_ptr<scene::Node> node)
+void
+OctTree::forEachNode(const NodeCallback& callback)
 {
-    component::Surface::Ptr surface = node->component<component::Surface>();
-    float                    radius    = computeRadius(node->component<component::BoundingBox>());
+    for (auto& node : _content)
+        callback(node);
 
-    return (uint)std::floor(std::log(_worldSize / radius) / std::log(2));
+    if (_splitted)
+        for (auto& octantChild : _children)
+            if (octantChild->_numNodes != 0)
+                octantChild->forEachNode(callback);
 }
 
 float
-OctTree::computeRadius(std::shared_ptr<component::BoundingBox> boundingBox)
+OctTree::computeRadius(std::shared_ptr<math::Box> box)
 {
-    return std::max(boundingBox->box()->width() / 2.f,  std::max(boundingBox->box()->height() / 2.f, boundingBox->box()->depth() / 2.f));
+    return std::max(box->width() / 2.f,  std::max(box->height() / 2.f, box->depth() / 2.f));
 }
 
 float
 OctTree::edgeLength()
 {
-    return (float)_k * (_worldSize / powf(2.f, (float)_depth));
+    return 2.f * _halfSize;
 }
 
-
 void
-OctTree::addChildContent(NodePtr node)
+OctTree::updateOctantBox()
 {
-    if (_parent)
-    {
-        _parent->_childrenContent.push_back(node);
-        _parent->addChildContent(node);
-    }
-}
+    float edgel = edgeLength();
 
-void
-OctTree::removeChildContent(NodePtr node)
-{
-    if (_parent)
-    {
-        _parent->_childrenContent.remove(node);
-        _parent->removeChildContent(node);
-    }
-}
\ No newline at end of file
+    _octantBox->topRight()->setTo(_center->x() + edgel, _center->y() + edgel, _center->z() + edgel);
+    _octantBox->bottomLeft()->setTo(_center->x() - edgel, _center->y() - edgel, _center->z() - edgel);
+}
@@ -50,19 +50,22 @@ using namespace minko::render;
 SamplerState DrawCall::_defaultSamplerState = SamplerState(WrapMode::CLAMP, TextureFilter::NEAREST, MipFilter::NONE);
 /*static*/ const unsigned int    DrawCall::MAX_NUM_TEXTURES        = 8;
 /*static*/ const unsigned int    DrawCall::MAX_NUM_VERTEXBUFFERS    = 8;
+/*static*/ uint                  DrawCall::_lastUniformsStamp        = 0;
 
 
 DrawCall::DrawCall(Pass::Ptr pass) :
     _pass(pass),
-    _program(nullptr),
     _targetData(nullptr),
     _rendererData(nullptr),
     _rootData(nullptr),
-    _fullRootData(nullptr),
-    _fullRendererData(nullptr),
     _fullTargetData(nullptr),
+    _fullRendererData(nullptr),
+    _fullRootData(nullptr),
+    _program(nullptr),
+    _inputBindings(nullptr),
     _formatFunction(nullptr),
     _textureIds(MAX_NUM_TEXTURES, 0),
+    _textures(MAX_NUM_TEXTURES, nullptr),
     _textureLocations(MAX_NUM_TEXTURES, -1),
     _textureWrapMode(MAX_NUM_TEXTURES, WrapMode::CLAMP),
     _textureFilters(MAX_NUM_TEXTURES, TextureFilter::NEAREST),
@@ -72,12 +75,21 @@ DrawCall::DrawCall(Pass::Ptr pass) :
     _vertexSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeOffsets(MAX_NUM_VERTEXBUFFERS, -1),
+    _vertexAttributeDivisors(MAX_NUM_VERTEXBUFFERS, 0),
+    _numInstances(0),
+    _culled(false),
     _target(nullptr),
+    _uniformCommands(),
+    _locationToUniformCommand(),
+    _uniformFloatValues(),
+    _uniformIntValues(),
+    _uniformsStamp(++_lastUniformsStamp),
     _referenceChangedSlots(),
     _macroChangedSlots(),
     _macroAddedOrRemovedSlots(),
     _indicesChangedSlot(nullptr),
     _layoutsPropertyChangedSlot(nullptr),
+    _numInstancesChangedSlot(nullptr),
     _zsortNeeded(Signal<Ptr>::create()),
     _macroChanged(Signal<Ptr, ContainerPtr, const std::string&>::create()),
     _containerMacroPNames(),
@@ -103,9 +115,11 @@ DrawCall::configure(Program::Ptr                program,
                     Container::Ptr                fullRootData,
                     Container::Ptr                targetData,
                     Container::Ptr                rendererData,
-                    Container::Ptr                rootData)
+                    Container::Ptr                rootData,
+                    InputBindingsPtr              inputBindings)
 {
     _program            = program;
+    _inputBindings      = inputBindings ? inputBindings : resolveInputBindings(_pass, program);
 
     _formatFunction        = formatNameFunc;
 
@@ -159,6 +173,7 @@ DrawCall::bind()
     bindProgramDefaultUniforms();
     bindTargetLayouts();
     bindIndexBuffer();
+    bindInstancing();
     bindProgramInputs();
     bindStates();
 }
@@ -170,13 +185,58 @@ DrawCall::bindProgramDefaultUniforms()
         return;
 
     for (auto& uniform : _program->uniformFloat())
-        _uniformFloat[uniform.first] = uniform.second;
+        _uniformFloatValues[getUniformCommand(uniform.first, ProgramInputs::Type::float1, UniformSource::VALUE).offset] = uniform.second;
     for (auto& uniform : _program->uniformFloat2())
-        _uniformFloat2[uniform.first] = uniform.second;
+        getUniformCommand(uniform.first, ProgramInputs::Type::float2, UniformSource::VECTOR).vector = uniform.second;
     for (auto& uniform : _program->uniformFloat3())
-        _uniformFloat3[uniform.first] = uniform.second;
+        getUniformCommand(uniform.first, ProgramInputs::Type::float3, UniformSource::VECTOR).vector = uniform.second;
     for (auto& uniform : _program->uniformFloat4())
-        _uniformFloat4[uniform.first] = uniform.second;
+        getUniformCommand(uniform.first, ProgramInputs::Type::float4, UniformSource::VECTOR).vector = uniform.second;
+}
+
+DrawCall::UniformCommand&
+DrawCall::getUniformCommand(int                 location,
+                           ProgramInputs::Type  type,
+                           UniformSource        source)
+{
+    auto commandIt = _locationToUniformCommand.find(location);
+
+    if (commandIt == _locationToUniformCommand.end())
+    {
+        const bool isInteger = type == ProgramInputs::Type::int1 || type == ProgramInputs::Type::int2
+            || type == ProgramInputs::Type::int3 || type == ProgramInputs::Type::int4;
+        const uint numComponents = type == ProgramInputs::Type::float16 ? 16
+            : type == ProgramInputs::Type::float4 || type == ProgramInputs::Type::int4 ? 4
+            : type == ProgramInputs::Type::float3 || type == ProgramInputs::Type::int3 ? 3
+            : type == ProgramInputs::Type::float2 || type == ProgramInputs::Type::int2 ? 2
+            : 1;
+
+        UniformCommand command;
+
+        command.type        = type;
+        command.location    = location;
+        command.offset      = isInteger ? _uniformIntValues.size() : _uniformFloatValues.size();
+
+        if (isInteger)
+            _uniformIntValues.resize(_uniformIntValues.size() + numComponents, 0);
+        else
+            _uniformFloatValues.resize(_uniformFloatValues.size() + numComponents, 0.f);
+
+        commandIt = _locationToUniformCommand.insert(std::make_pair(location, _uniformCommands.size())).first;
+        _uniformCommands.push_back(command);
+    }
+
+    // a uniform can be bound again with another source when a property reference changes
+    auto& command = _uniformCommands[commandIt->second];
+
+    command.source      = source;
+    command.dirty       = true;
+    command.vector      = nullptr;
+    command.matrix      = nullptr;
+    command.floatArray  = nullptr;
+    command.intArray    = nullptr;
+
+    return command;
 }
 
 void
@@ -228,6 +288,24 @@ DrawCall::bindIndexBuffer()
     }
 }
 
+void
+DrawCall::bindInstancing()
+{
+    const std::string propertyName = "instancing.numInstances";
+
+    _numInstances = 0;
+
+    // Note: instancing data is only set by the DrawCallPool on the filtered target container.
+    if (_targetData->hasProperty(propertyName))
+        _numInstances = std::max(0, _targetData->get<int>(propertyName));
+
+    if (_numInstancesChangedSlot == nullptr)
+        _numInstancesChangedSlot = _targetData->propertyReferenceChanged(propertyName)->connect(std::bind(
+            &DrawCall::bindInstancing,
+            shared_from_this()
+        ));
+}
+
 void
 DrawCall::bindTargetLayouts()
 {
@@ -250,64 +328,134 @@ DrawCall::bindTargetLayouts()
     }
 }
 
-void
-DrawCall::bindProgramInputs()
+/*static*/
+DrawCall::InputBindingsPtr
+DrawCall::resolveInputBindings(Pass::Ptr pass, Program::Ptr program, FormatNameFunction formatNameFunc)
 {
-    if (_program == nullptr || _program->inputs() == nullptr)
-        return;
+    auto inputBindings = std::make_shared<InputBindings>();
 
-    auto                            programInputs        = _program->inputs();
-    const std::vector<std::string>&    inputNames            = programInputs->names();
-    unsigned int                    numTextures            = 0;
-    unsigned int                    numVertexBuffers    = 0;
+    if (program == nullptr || program->inputs() == nullptr)
+        return inputBindings;
 
-    unsigned int                    vertexBufferIndex    = 0;
+    auto                            programInputs       = program->inputs();
+    const std::vector<std::string>& inputNames          = programInputs->names();
+    const auto&                     attributeBindings   = pass->attributeBindings();
+    const auto&                     uniformBindings     = pass->uniformBindings();
+    const auto&                     samplerStates       = pass->states()->samplers();
+
+    unsigned int                    vertexBufferIndex   = 0;
     unsigned int                    textureIndex        = 0;
 
     for (unsigned int inputId = 0; inputId < inputNames.size(); ++inputId)
     {
-        const std::string&    inputName    = inputNames[inputId];
-        const auto            type        = programInputs->type(inputName);
-        const int            location    = programInputs->location(inputName);
+        InputBinding binding;
+
+        binding.inputName   = inputNames[inputId];
+        binding.type        = programInputs->type(binding.inputName);
+        binding.location    = programInputs->location(binding.inputName);
+        binding.index       = 0;
 
-        switch (type)
+        switch (binding.type)
         {
         case ProgramInputs::Type::attribute:
             {
-                bindVertexAttribute(inputName, location, vertexBufferIndex);
-                ++vertexBufferIndex;
+                binding.index = vertexBufferIndex++;
+
+                const auto bindingIt = attributeBindings.find(binding.inputName);
+
+                if (bindingIt == attributeBindings.end())
+                    continue;
+
+                binding.propertyName    = std::get<0>(bindingIt->second);
+                binding.source          = std::get<1>(bindingIt->second);
                 break;
             }
 
         case ProgramInputs::Type::sampler2d:
         case ProgramInputs::Type::samplerCube:
             {
-                auto& samplerState = _pass->states()->samplers().count(inputName)
-                    ? _pass->states()->samplers().at(inputName)
-                    : _defaultSamplerState;
+                binding.index = textureIndex++;
+
+                const auto bindingIt = uniformBindings.find(binding.inputName);
 
-                bindTextureSampler(inputName, location, textureIndex, samplerState);
-                ++textureIndex;
+                if (bindingIt == uniformBindings.end())
+                    continue;
+
+                binding.propertyName    = std::get<0>(bindingIt->second);
+                binding.source          = std::get<1>(bindingIt->second);
+                binding.samplerState    = samplerStates.count(binding.inputName)
+                    ? samplerStates.at(binding.inputName)
+                    : _defaultSamplerState;
                 break;
             }
 
         default:
             {
-                bindUniform(inputName, type, location);
+                auto        pos         = binding.inputName.find_first_of('[');
+                const auto  bindingIt   = uniformBindings.find(binding.inputName.substr(0, pos));
+
+                if (bindingIt == uniformBindings.end())
+                    continue;
+
+                if (pos != std::string::npos)
+                    binding.arraySuffix = binding.inputName.substr(pos);
+
+                binding.propertyName    = std::get<0>(bindingIt->second);
+                binding.source          = std::get<1>(bindingIt->second);
                 break;
             }
 
         case ProgramInputs::Type::unknown:
+            continue;
+        }
+
+        binding.formatted = binding.propertyName.find("${") != std::string::npos;
+        if (binding.formatted && formatNameFunc)
+        {
+            binding.propertyName    = formatNameFunc(binding.propertyName);
+            binding.formatted       = false;
+        }
+        if (!binding.formatted)
+            binding.propertyId = PropertyId(binding.propertyName + binding.arraySuffix);
+
+        inputBindings->push_back(binding);
+    }
+
+    return inputBindings;
+}
+
+void
+DrawCall::bindProgramInputs()
+{
+    if (_inputBindings == nullptr)
+        return;
+
+    for (const auto& binding : *_inputBindings)
+    {
+        switch (binding.type)
+        {
+        case ProgramInputs::Type::attribute:
+            bindVertexAttribute(binding);
+            break;
+
+        case ProgramInputs::Type::sampler2d:
+        case ProgramInputs::Type::samplerCube:
+            bindTextureSampler(binding);
+            break;
+
+        default:
+            bindUniform(binding);
             break;
         }
     }
 }
 
 void
-DrawCall::bindVertexAttribute(const std::string&    inputName,
-                              int                    location,
-                              uint                    vertexBufferIndex)
+DrawCall::bindVertexAttribute(const InputBinding& binding)
 {
+    const auto location             = binding.location;
+    const auto vertexBufferIndex    = binding.index;
+
 #ifdef DEBUG
     if (location < 0)
         throw std::invalid_argument("location");
@@ -315,55 +463,52 @@ DrawCall::bindVertexAttribute(const std::string&    inputName,
         throw std::invalid_argument("vertexBufferIndex");
 #endif // DEBUG
 
-    const auto& attributeBindings    = _pass->attributeBindings();
-    auto        index                = vertexBufferIndex;
+    const auto  propertyId      = binding.formatted ? PropertyId(_formatFunction(binding.propertyName)) : binding.propertyId;
+    const auto& propertyName    = propertyId.name();
+    const auto& container       = getContainer(ContainerId::FILTERED, binding.source);
 
-    if (attributeBindings.count(inputName))
+    if (container && container->hasProperty(propertyId))
     {
-        auto propertyName        = _formatFunction(std::get<0>(attributeBindings.at(inputName)));
-        auto source                = std::get<1>(attributeBindings.at(inputName));
-        const auto& container    = getContainer(ContainerId::FILTERED, source);
-
-        if (container && container->hasProperty(propertyName))
-        {
-            auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyName);
-            auto attributeName = propertyName.substr(propertyName.find_last_of('.') + 1);
+        auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyId);
+        auto attributeName = propertyName.substr(propertyName.find_last_of('.') + 1);
 
 #ifdef DEBUG
-            if (!vertexBuffer->hasAttribute(attributeName))
-                throw std::logic_error("missing required vertex attribute: " + attributeName);
+        if (!vertexBuffer->hasAttribute(attributeName))
+            throw std::logic_error("missing required vertex attribute: " + attributeName);
 #endif
 
-            auto attribute = vertexBuffer->attribute(attributeName);
+        auto attribute = vertexBuffer->attribute(attributeName);
 
-            _vertexBufferIds[vertexBufferIndex] = vertexBuffer->id();
-            _vertexBufferLocations[vertexBufferIndex] = location;
-            _vertexAttributeSizes[vertexBufferIndex] = std::get<1>(*attribute);
-            _vertexSizes[vertexBufferIndex] = vertexBuffer->vertexSize();
-            _vertexAttributeOffsets[vertexBufferIndex] = std::get<2>(*attribute);
-        }
+        _vertexBufferIds[vertexBufferIndex] = vertexBuffer->id();
+        _vertexBufferLocations[vertexBufferIndex] = location;
+        _vertexAttributeSizes[vertexBufferIndex] = std::get<1>(*attribute);
+        _vertexSizes[vertexBufferIndex] = vertexBuffer->vertexSize();
+        _vertexAttributeOffsets[vertexBufferIndex] = std::get<2>(*attribute);
+        // properties of the instancing provider advance once per instance instead of once per vertex
+        _vertexAttributeDivisors[vertexBufferIndex] = propertyName.compare(0, 11, "instancing.") == 0 ? 1 : 0;
+    }
 
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
-        {
-            auto that = shared_from_this();
-            auto slot = container->propertyReferenceChanged(propertyName)->connect(
-                    [=](Container::Ptr, const std::string&)
-                    {
-                        that->bindVertexAttribute(inputName, location, vertexBufferIndex);
-                    }
-                );
-            _referenceChangedSlots[propertyName].push_back(slot);
-        }
+    if (_referenceChangedSlots.count(propertyName) == 0)
+    {
+        auto that = shared_from_this();
+        auto slot = container->propertyReferenceChanged(propertyName)->connect(
+                [=](Container::Ptr, const std::string&)
+                {
+                    that->bindVertexAttribute(binding);
+                }
+            );
+        _referenceChangedSlots[propertyName].push_back(slot);
     }
 }
 
 void
-DrawCall::bindTextureSampler(const std::string&        inputName,
-                             int                    location,
-                             uint                    textureIndex,
-                                const SamplerState&    samplerState)
+DrawCall::bindTextureSampler(const InputBinding& binding)
 {
+    const auto  location        = binding.location;
+    const auto  textureIndex    = binding.index;
+    const auto& samplerState    = binding.samplerState;
+
 #ifdef DEBUG
     if (location < 0)
         throw std::invalid_argument("location");
@@ -371,45 +516,74 @@ DrawCall::bindTextureSampler(const std::string&        inputName,
         throw std::invalid_argument("textureIndex");
 #endif // DEBUG
 
-    const auto& uniformBindings = _pass->uniformBindings();
-    auto        index            = textureIndex;
+    const auto  propertyId      = binding.formatted ? PropertyId(_formatFunction(binding.propertyName)) : binding.propertyId;
+    const auto& propertyName    = propertyId.name();
+    const auto& container       = getContainer(ContainerId::FILTERED, binding.source);
 
-    if (uniformBindings.count(inputName))
+    if (container && container->hasProperty(propertyId))
     {
-        auto propertyName        = _formatFunction(std::get<0>(uniformBindings.at(inputName)));
-        auto source                = std::get<1>(uniformBindings.at(inputName));
-        const auto& container    = getContainer(ContainerId::FILTERED, source);
+        auto texture    = container->get<AbstractTexture::Ptr>(propertyId);
+
+        _textureIds            [textureIndex] = texture->id();
+        _textures            [textureIndex] = texture;
+        _textureLocations    [textureIndex] = location;
+        _textureWrapMode    [textureIndex] = std::get<0>(samplerState);
+        _textureFilters        [textureIndex] = std::get<1>(samplerState);
+        _textureMipFilters    [textureIndex] = std::get<2>(samplerState);
+    }
 
-        if (container && container->hasProperty(propertyName))
-        {
-            auto texture    = container->get<AbstractTexture::Ptr>(propertyName);
+    if (_referenceChangedSlots.count(propertyName) == 0)
+    {
+        auto that = shared_from_this();
+        auto slot = container->propertyReferenceChanged(propertyName)->connect(
+            [=](Container::Ptr, const std::string&)
+            {
+                that->bindTextureSampler(binding);
+            }
+        );
+        _referenceChangedSlots[propertyName].push_back(slot);
+    }
+}
 
-            _textureIds            [textureIndex] = texture->id();
-            _textureLocations    [textureIndex] = location;
-            _textureWrapMode    [textureIndex] = std::get<0>(samplerState);
-            _textureFilters        [textureIndex] = std::get<1>(samplerState);
-            _textureMipFilters    [textureIndex] = std::get<2>(samplerState);
-        }
+void
+DrawCall::bindUniform(const InputBinding& binding)
+{
+    const auto& container   = getContainer(ContainerId::FILTERED, binding.source);
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
-        {
-            auto that = shared_from_this();
-            auto slot = container->propertyReferenceChanged(propertyName)->connect(
-                [=](Container::Ptr, const std::string&)
-                {
-                    that->bindTextureSampler(inputName, location, textureIndex, samplerState);
-                }
-            );
-            _referenceChangedSlots[propertyName].push_back(slot);
-        }
+    if (!container)
+        return;
+
+    // the property id is interned once per binding, or once per draw call when the property name has to be formatted
+    const auto  propertyId  = binding.formatted
+        ? PropertyId(_formatFunction(binding.propertyName) + binding.arraySuffix)
+        : binding.propertyId;
+
+    bindUniformValue(binding, propertyId);
+
+    // continuous base type arrays are tracked by their name without the array suffix
+    const auto  propertyName = binding.arraySuffix.empty() || container->hasProperty(propertyId)
+        ? propertyId.name()
+        : (binding.formatted ? _formatFunction(binding.propertyName) : binding.propertyName);
+
+    if (_referenceChangedSlots.count(propertyName) == 0)
+    {
+        auto that = shared_from_this();
+
+        _referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(
+            [=](Container::Ptr, const std::string&)
+            {
+                that->bindUniformValue(binding, propertyId);
+            }
+        ));
     }
 }
 
 void
-DrawCall::bindUniform(const std::string&    inputName,
-                      ProgramInputs::Type    type,
-                      int                    location)
+DrawCall::bindUniformValue(const InputBinding& binding, const PropertyId& propertyId)
 {
+    const auto type        = binding.type;
+    const auto location    = binding.location;
+
 #ifdef DEBUG
     if (type == ProgramInputs::Type::sampler2d || type == ProgramInputs::Type::attribute)
         throw std::invalid_argument("type");
@@ -417,68 +591,63 @@ DrawCall::bindUniform(const std::string&    inputName,
         throw std::invalid_argument("location");
 #endif // DEBUG
 
-    const auto& uniformBindings = _pass->uniformBindings();
-    bool        isArray            = false;
-    auto        pos                = inputName.find_first_of('[');
-    std::string    bindingName        = inputName;
+    const auto& container = getContainer(ContainerId::FILTERED, binding.source);
 
-    if (pos != std::string::npos)
+    if (container->hasProperty(propertyId))
     {
-        bindingName = inputName.substr(0, pos);
-        isArray = true;
-    }
-
-    if (uniformBindings.count(bindingName))
-    {
-        std::string    propertyName    = _formatFunction(std::get<0>(uniformBindings.at(bindingName)));
-        auto        source            = std::get<1>(uniformBindings.at(bindingName));
-        const auto& container        = getContainer(ContainerId::FILTERED, source);
-
-        if (container)
+        // This case corresponds to base types uniforms or individual members of an GLSL struct array.
+
+        if (type == ProgramInputs::Type::float1)
+            _uniformFloatValues[getUniformCommand(location, type, UniformSource::VALUE).offset] = container->get<float>(propertyId);
+        else if (type == ProgramInputs::Type::float2)
+            getUniformCommand(location, type, UniformSource::VECTOR).vector = container->get<Vector2::Ptr>(propertyId);
+        else if (type == ProgramInputs::Type::float3)
+            getUniformCommand(location, type, UniformSource::VECTOR).vector = container->get<Vector3::Ptr>(propertyId);
+        else if (type == ProgramInputs::Type::float4)
+            getUniformCommand(location, type, UniformSource::VECTOR).vector = container->get<Vector4::Ptr>(propertyId);
+        else if (type == ProgramInputs::Type::float16)
+            getUniformCommand(location, type, UniformSource::MATRIX).matrix = &(container->get<Matrix4x4::Ptr>(propertyId)->data()[0]);
+        else if (type == ProgramInputs::Type::int1)
+            _uniformIntValues[getUniformCommand(location, type, UniformSource::VALUE).offset] = container->get<int>(propertyId);
+        else if (type == ProgramInputs::Type::int2)
         {
-            if (isArray)
-                propertyName += inputName.substr(pos); // way to handle array of GLSL structs
-
-            if (container->hasProperty(propertyName))
-            {
-                // This case corresponds to base types uniforms or individual members of an GLSL struct array.
-
-                if (type == ProgramInputs::Type::float1)
-                    _uniformFloat[location]        = container->get<float>(propertyName);
-                else if (type == ProgramInputs::Type::float2)
-                    _uniformFloat2[location]    = container->get<Vector2::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float3)
-                    _uniformFloat3[location]    = container->get<Vector3::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float4)
-                    _uniformFloat4[location]    = container->get<Vector4::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float16)
-                    _uniformFloat16[location]    = &(container->get<Matrix4x4::Ptr>(propertyName)->data()[0]);
-                else if (type == ProgramInputs::Type::int1)
-                    _uniformInt[location]        = container->get<int>(propertyName);
-                else if (type == ProgramInputs::Type::int2)
-                    _uniformInt2[location]        = container->get<Int2>(propertyName);
-                else if (type == ProgramInputs::Type::int3)
-                    _uniformInt3[location]        = container->get<Int3>(propertyName);
-                else if (type == ProgramInputs::Type::int4)
-                    _uniformInt4[location]        = container->get<Int4>(propertyName);
-                else
-                    throw std::logic_error("unsupported uniform type.");
-            }
-            else if (isArray)
-            {
-                // This case corresponds to continuous base type arrays that are stored in data providers as std::vector<float>.
-                propertyName = _formatFunction(std::get<0>(uniformBindings.at(bindingName)));
+            const auto  value   = container->get<Int2>(propertyId);
+            auto*       values  = &_uniformIntValues[getUniformCommand(location, type, UniformSource::VALUE).offset];
 
-                bindUniformArray(propertyName, container, type, location);
-            }
+            values[0] = std::get<0>(value);
+            values[1] = std::get<1>(value);
         }
+        else if (type == ProgramInputs::Type::int3)
+        {
+            const auto  value   = container->get<Int3>(propertyId);
+            auto*       values  = &_uniformIntValues[getUniformCommand(location, type, UniformSource::VALUE).offset];
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
+            values[0] = std::get<0>(value);
+            values[1] = std::get<1>(value);
+            values[2] = std::get<2>(value);
+        }
+        else if (type == ProgramInputs::Type::int4)
         {
-            _referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
-                &DrawCall::bindUniform, shared_from_this(), inputName, type, location
-            )));
+            const auto  value   = container->get<Int4>(propertyId);
+            auto*       values  = &_uniformIntValues[getUniformCommand(location, type, UniformSource::VALUE).offset];
+
+            values[0] = std::get<0>(value);
+            values[1] = std::get<1>(value);
+            values[2] = std::get<2>(value);
+            values[3] = std::get<3>(value);
         }
+        else
+            throw std::logic_error("unsupported uniform type.");
+    }
+    else if (!binding.arraySuffix.empty())
+    {
+        // This case corresponds to continuous base type arrays that are stored in data providers as std::vector<float>.
+        bindUniformArray(
+            binding.formatted ? _formatFunction(binding.propertyName) : binding.propertyName,
+            container,
+            type,
+            location
+        );
     }
 }
 
@@ -513,18 +682,14 @@ DrawCall::bindFloatUniformArray(const std::string&    propertyName,
     if (uniformArray->first == 0 || uniformArray->second == nullptr)
         return;
 
-    if (type == ProgramInputs::Type::float1)
-        _uniformFloats[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float2)
-        _uniformFloats2[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float3)
-        _uniformFloats3[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float4)
-        _uniformFloats4[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float16)
-        _uniformFloats16[location] = uniformArray;
-    else
+    if (type != ProgramInputs::Type::float1 &&
+        type != ProgramInputs::Type::float2 &&
+        type != ProgramInputs::Type::float3 &&
+        type != ProgramInputs::Type::float4 &&
+        type != ProgramInputs::Type::float16)
         throw std::logic_error("unsupported uniform type.");
+
+    getUniformCommand(location, type, UniformSource::FLOAT_ARRAY).floatArray = uniformArray;
 }
 
 void
@@ -540,16 +705,13 @@ DrawCall::bindIntegerUniformArray(const std::string&    propertyName,
     if (uniformArray->first == 0 || uniformArray->second == nullptr)
         return;
 
-    if (type == ProgramInputs::Type::int1)
-        _uniformInts[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int2)
-        _uniformInts2[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int3)
-        _uniformInts3[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int4)
-        _uniformInts4[location] = uniformArray;
-    else
+    if (type != ProgramInputs::Type::int1 &&
+        type != ProgramInputs::Type::int2 &&
+        type != ProgramInputs::Type::int3 &&
+        type != ProgramInputs::Type::int4)
         throw std::logic_error("unsupported uniform type.");
+
+    getUniformCommand(location, type, UniformSource::INT_ARRAY).intArray = uniformArray;
 }
 
 void
@@ -560,6 +722,7 @@ DrawCall::unbind()
     _macroChangedSlots.clear();
     _indicesChangedSlot            = nullptr;
     _layoutsPropertyChangedSlot    = nullptr;
+    _numInstancesChangedSlot    = nullptr;
 }
 
 void
@@ -567,35 +730,22 @@ DrawCall::reset()
 {
     _target = nullptr;
 
-    _uniformFloat.clear();
-    _uniformFloat2.clear();
-    _uniformFloat3.clear();
-    _uniformFloat4.clear();
-    _uniformFloat16.clear();
-
-    _uniformInt.clear();
-    _uniformInt2.clear();
-    _uniformInt3.clear();
-    _uniformInt4.clear();
-
-    _uniformFloats.clear();
-    _uniformFloats2.clear();
-    _uniformFloats3.clear();
-    _uniformFloats4.clear();
-    _uniformFloats16.clear();
-
-    _uniformInts.clear();
-    _uniformInts2.clear();
-    _uniformInts3.clear();
-    _uniformInts4.clear();
+    _uniformCommands.clear();
+    _locationToUniformCommand.clear();
+    _uniformFloatValues.clear();
+    _uniformIntValues.clear();
+    // the values held by the program cannot be trusted anymore
+    _uniformsStamp = ++_lastUniformsStamp;
 
     _textureIds            .clear();
+    _textures            .clear();
     _textureLocations    .clear();
     _textureWrapMode    .clear();
     _textureFilters        .clear();
     _textureMipFilters    .clear();
 
     _textureIds            .resize(MAX_NUM_TEXTURES, 0);
+    _textures            .resize(MAX_NUM_TEXTURES, nullptr);
     _textureLocations    .resize(MAX_NUM_TEXTURES, -1);
     _textureWrapMode    .resize(MAX_NUM_TEXTURES, WrapMode::CLAMP);
     _textureFilters        .resize(MAX_NUM_TEXTURES, TextureFilter::NEAREST);
@@ -606,15 +756,20 @@ DrawCall::reset()
     _vertexSizes            .clear();
     _vertexAttributeSizes    .clear();
     _vertexAttributeOffsets    .clear();
+    _vertexAttributeDivisors    .clear();
 
     _vertexBufferIds            .resize(MAX_NUM_VERTEXBUFFERS, 0);
     _vertexBufferLocations    .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexSizes            .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexAttributeSizes    .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexAttributeOffsets    .resize(MAX_NUM_VERTEXBUFFERS, -1);
+    _vertexAttributeDivisors    .resize(MAX_NUM_VERTEXBUFFERS, 0);
+
+    _numInstances                = 0;
 
     _indicesChangedSlot            = nullptr;
     _layoutsPropertyChangedSlot    = nullptr;
+    _numInstancesChangedSlot    = nullptr;
     _referenceChangedSlots.clear();
 
     _macroAddedOrRemovedSlots.clear();
@@ -657,7 +812,8 @@ DrawCall::bindStates()
 void
 DrawCall::render(const AbstractContext::Ptr&    context,
                  AbstractTexture::Ptr           renderTarget,
-                 const render::ScissorBox&      viewport)
+                 const render::ScissorBox&      viewport,
+                 const Ptr&                     previous)
 {
     if (_target)
     {
@@ -678,147 +834,289 @@ DrawCall::render(const AbstractContext::Ptr&    context,
             context->configureViewport(viewport.x, viewport.y, viewport.width, viewport.height);
     }
 
-    context->setProgram(_program->id());
+    const bool sameProgram = previous && previous->_program == _program;
+
+    if (!sameProgram)
+        context->setProgram(_program->id());
 
-    // float uniforms
-    for (auto& uniformFloat : _uniformFloat)
-        context->setUniform(uniformFloat.first, uniformFloat.second);
-    for (auto& uniformFloat2 : _uniformFloat2)
+    uploadUniforms(context);
+
+    // sampler uniforms belong to the program: they only have to be set again when the program
+    // or the texture bindings differ from the previous draw call
+    if (!sameProgram || !hasSameTextures(*previous))
     {
-        auto& float2 = uniformFloat2.second;
+        auto textureOffset = 0;
+        for (auto textureLocationAndPtr : _program->textures())
+            context->setTextureAt(
+                textureOffset++,
+                textureLocationAndPtr.second->id(),
+                textureLocationAndPtr.first
+            );
+
+        for (uint i = 0; i < _textureIds.size() - textureOffset; ++i)
+        {
+            auto textureId = _textureIds[i];
 
-        context->setUniform(uniformFloat2.first, float2->x(), float2->y());
+            context->setTextureAt(
+                textureOffset + i,
+                textureId,
+                _textureLocations[i]
+            );
+            if (textureId > 0)
+                context->setSamplerStateAt(
+                    textureOffset + i,
+                    _textureWrapMode[i],
+                    _textureFilters[i],
+                    _textureMipFilters[i]
+                );
+        }
     }
-    for (auto& uniformFloat3 : _uniformFloat3)
+
+    if (!sameProgram || !hasSameVertexAttributes(*previous))
     {
-        auto& float3 = uniformFloat3.second;
+        // first, hand over to the context bound vertex attributes
+        for (uint i = 0; i < _vertexBufferIds.size(); ++i)
+        {
+            auto vertexBufferId = _vertexBufferIds[i];
+
+            if (vertexBufferId > 0 &&
+                !_program->hasVertexBufferLocation(_vertexBufferLocations[i]))
+            {
+                // matrix attributes (ex: per-instance transforms) span one location per 4-component column
+                const int numColumns = std::max(1, _vertexAttributeSizes[i] / 4);
+
+                for (int column = 0; column < numColumns; ++column)
+                    context->setVertexBufferAt(
+                         _vertexBufferLocations[i] + column,
+                         vertexBufferId,
+                         numColumns > 1 ? 4 : _vertexAttributeSizes[i],
+                         _vertexSizes[i],
+                         _vertexAttributeOffsets[i] + column * 4
+                    );
+            }
+        }
+        // second, hand over explicitly user defined vertex attributes (possible replacement of )
+        for (auto vertexBufferLocationAndPtr : _program->vertexBuffers())
+        {
+            const int    location        = vertexBufferLocationAndPtr.first;
+            auto&        vertexBuffer    = vertexBufferLocationAndPtr.second;
+
+            if (vertexBuffer->isReady())
+            {
+                assert(vertexBuffer->attributes().size() == 1);
 
-        context->setUniform(uniformFloat3.first, float3->x(), float3->y(), float3->z());
+                const auto& vertexAttribute = vertexBuffer->attributes().front();
+
+                context->setVertexBufferAt(
+                    location,
+                    vertexBuffer->id(),
+                    std::get<1>(*vertexAttribute),
+                    vertexBuffer->vertexSize(),
+                    std::get<2>(*vertexAttribute)
+                );
+            }
+        }
     }
-    for (auto& uniformFloat4 : _uniformFloat4)
+
+    if (!previous || previous->_colorMask != _colorMask)
+        context->setColorMask(_colorMask);
+    if (!previous || previous->_blendMode != _blendMode)
+        context->setBlendMode(_blendMode);
+    if (!previous || previous->_depthMask != _depthMask || previous->_depthFunc != _depthFunc)
+        context->setDepthTest(_depthMask, _depthFunc);
+    if (!previous
+        || previous->_stencilFunc != _stencilFunc
+        || previous->_stencilRef != _stencilRef
+        || previous->_stencilMask != _stencilMask
+        || previous->_stencilFailOp != _stencilFailOp
+        || previous->_stencilZFailOp != _stencilZFailOp
+        || previous->_stencilZPassOp != _stencilZPassOp)
+        context->setStencilTest(_stencilFunc, _stencilRef, _stencilMask, _stencilFailOp, _stencilZFailOp, _stencilZPassOp);
+    if (!previous
+        || previous->_scissorTest != _scissorTest
+        || previous->_scissorBox.x != _scissorBox.x
+        || previous->_scissorBox.y != _scissorBox.y
+        || previous->_scissorBox.width != _scissorBox.width
+        || previous->_scissorBox.height != _scissorBox.height)
+        context->setScissorTest(_scissorTest, _scissorBox);
+    if (!previous || previous->_triangleCulling != _triangleCulling)
+        context->setTriangleCulling(_triangleCulling);
+
+    if (_program->indexBuffer() && _program->indexBuffer()->isReady())
+        context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->data().size() / 3);
+    else if (_indexBuffer != -1)
+    {
+        if (_numInstances > 0 && context->supportsInstancing())
+            drawInstances(context);
+        else
+            context->drawTriangles(_indexBuffer, _numIndices / 3);
+    }
+}
+
+void
+DrawCall::uploadUniforms(const AbstractContext::Ptr& context)
+{
+    // the program still holds the values uploaded the last time this draw call was rendered
+    // unless another draw call (or Program::setUniform) used it since then: only upload what changed
+    const bool uploadAll = _program->uniformsStamp() != _uniformsStamp;
+
+    for (auto& command : _uniformCommands)
     {
-        auto& float4 = uniformFloat4.second;
+        bool changed = uploadAll || command.dirty;
+
+        if (command.source == UniformSource::VECTOR)
+        {
+            auto*       values          = &_uniformFloatValues[command.offset];
+            float       vector[4]       = { command.vector->x(), command.vector->y(), 0.f, 0.f };
+            const uint  numComponents   = command.type == ProgramInputs::Type::float2 ? 2
+                : command.type == ProgramInputs::Type::float3 ? 3
+                : 4;
+
+            if (numComponents > 2)
+                vector[2] = std::static_pointer_cast<Vector3>(command.vector)->z();
+            if (numComponents > 3)
+                vector[3] = std::static_pointer_cast<Vector4>(command.vector)->w();
+
+            for (uint i = 0; i < numComponents; ++i)
+                if (values[i] != vector[i])
+                {
+                    values[i] = vector[i];
+                    changed = true;
+                }
+        }
+        else if (command.source == UniformSource::MATRIX)
+        {
+            auto* values = &_uniformFloatValues[command.offset];
+
+            if (std::memcmp(values, command.matrix, 16 * sizeof(float)) != 0)
+            {
+                std::memcpy(values, command.matrix, 16 * sizeof(float));
+                changed = true;
+            }
+        }
+        else if (command.source != UniformSource::VALUE)
+            changed = true; // arrays can be updated in place and are not compared
 
-        context->setUniform(uniformFloat4.first, float4->x(), float4->y(), float4->z(), float4->w());
+        if (changed)
+            uploadUniform(context, command);
+
+        command.dirty = false;
     }
-    for (auto& uniformFloat16 : _uniformFloat16)
-        context->setUniform(uniformFloat16.first, 1, true, uniformFloat16.second);
 
-    // integer uniforms
-    for (auto& uniformInt : _uniformInt)
-        context->setUniform(uniformInt.first, uniformInt.second);
-    for (auto& uniformInt2 : _uniformInt2)
+    _program->uniformsStamp(_uniformsStamp);
+}
+
+void
+DrawCall::uploadUniform(const AbstractContext::Ptr& context, const UniformCommand& command)
+{
+    const auto location = command.location;
+
+    if (command.source == UniformSource::FLOAT_ARRAY)
     {
-        const auto& int2 = uniformInt2.second;
-        context->setUniform(uniformInt2.first, std::get<0>(int2), std::get<1>(int2));
+        const auto& uniformArray = command.floatArray;
+
+        if (command.type == ProgramInputs::Type::float1)
+            context->setUniforms(location, uniformArray->first, uniformArray->second);
+        else if (command.type == ProgramInputs::Type::float2)
+            context->setUniforms2(location, uniformArray->first, uniformArray->second);
+        else if (command.type == ProgramInputs::Type::float3)
+            context->setUniforms3(location, uniformArray->first, uniformArray->second);
+        else if (command.type == ProgramInputs::Type::float4)
+            context->setUniforms4(location, uniformArray->first, uniformArray->second);
+        else
+            context->setUniform(location, uniformArray->first, false, uniformArray->second);
     }
-    for (auto& uniformInt3 : _uniformInt3)
+    else if (command.source == UniformSource::INT_ARRAY)
     {
-        const auto& int3 = uniformInt3.second;
-        context->setUniform(uniformInt3.first, std::get<0>(int3), std::get<1>(int3), std::get<2>(int3));
+        const auto& uniformArray = command.intArray;
+
+        if (command.type == ProgramInputs::Type::int1)
+            context->setUniforms(location, uniformArray->first, uniformArray->second);
+        else if (command.type == ProgramInputs::Type::int2)
+            context->setUniforms2(location, uniformArray->first, uniformArray->second);
+        else if (command.type == ProgramInputs::Type::int3)
+            context->setUniforms3(location, uniformArray->first, uniformArray->second);
+        else
+            context->setUniforms4(location, uniformArray->first, uniformArray->second);
     }
-    for (auto& uniformInt4 : _uniformInt4)
+    else if (command.type == ProgramInputs::Type::int1
+        || command.type == ProgramInputs::Type::int2
+        || command.type == ProgramInputs::Type::int3
+        || command.type == ProgramInputs::Type::int4)
     {
-        const auto& int4 = uniformInt4.second;
-        context->setUniform(uniformInt4.first, std::get<0>(int4), std::get<1>(int4), std::get<2>(int4), std::get<3>(int4));
+        const auto* values = &_uniformIntValues[command.offset];
+
+        if (command.type == ProgramInputs::Type::int1)
+            context->setUniform(location, values[0]);
+        else if (command.type == ProgramInputs::Type::int2)
+            context->setUniform(location, values[0], values[1]);
+        else if (command.type == ProgramInputs::Type::int3)
+            context->setUniform(location, values[0], values[1], values[2]);
+        else
+            context->setUniform(location, values[0], values[1], values[2], values[3]);
     }
-
-    // arrays of float uniforms
-    for (auto& uniformFloats : _uniformFloats)
-        context->setUniforms    (uniformFloats.first,    uniformFloats.second->first,            uniformFloats.second->second);
-    for (auto& uniformFloats2 : _uniformFloats2)
-        context->setUniforms2    (uniformFloats2.first,    uniformFloats2.second->first,            uniformFloats2.second->second);
-    for (auto& uniformFloats3 : _uniformFloats3)
-        context->setUniforms3    (uniformFloats3.first,    uniformFloats3.second->first,            uniformFloats3.second->second);
-    for (auto& uniformFloats4 : _uniformFloats4)
-        context->setUniforms4    (uniformFloats4.first,    uniformFloats4.second->first,            uniformFloats4.second->second);
-    for (auto& uniformFloats16 : _uniformFloats16)
-        context->setUniform        (uniformFloats16.first,    uniformFloats16.second->first, false,    uniformFloats16.second->second);
-
-    // arrays of integer uniforms
-    for (auto& uniformInts: _uniformInts)
-        context->setUniforms    (uniformInts.first,        uniformInts.second->first,            uniformInts.second->second);
-    for (auto& uniformInts2 : _uniformInts2)
-        context->setUniforms2    (uniformInts2.first,    uniformInts2.second->first,            uniformInts2.second->second);
-    for (auto& uniformInts3 : _uniformInts3)
-        context->setUniforms3    (uniformInts3.first,    uniformInts3.second->first,            uniformInts3.second->second);
-    for (auto& uniformInts4 : _uniformInts4)
-        context->setUniforms4    (uniformInts4.first,    uniformInts4.second->first,            uniformInts4.second->second);
-
-    auto textureOffset = 0;
-    for (auto textureLocationAndPtr : _program->textures())
-        context->setTextureAt(
-            textureOffset++,
-            textureLocationAndPtr.second->id(),
-            textureLocationAndPtr.first
-        );
-
-    for (uint i = 0; i < _textureIds.size() - textureOffset; ++i)
+    else
     {
-        auto textureId = _textureIds[i];
-
-        context->setTextureAt(
-            textureOffset + i,
-            textureId,
-            _textureLocations[i]
-        );
-        if (textureId > 0)
-            context->setSamplerStateAt(
-                textureOffset + i,
-                _textureWrapMode[i],
-                _textureFilters[i],
-                _textureMipFilters[i]
-            );
+        const auto* values = &_uniformFloatValues[command.offset];
+
+        if (command.type == ProgramInputs::Type::float1)
+            context->setUniform(location, values[0]);
+        else if (command.type == ProgramInputs::Type::float2)
+            context->setUniform(location, values[0], values[1]);
+        else if (command.type == ProgramInputs::Type::float3)
+            context->setUniform(location, values[0], values[1], values[2]);
+        else if (command.type == ProgramInputs::Type::float4)
+            context->setUniform(location, values[0], values[1], values[2], values[3]);
+        else
+            context->setUniform(location, 1, true, values);
     }
+}
+
+void
+DrawCall::drawInstances(const AbstractContext::Ptr& context)
+{
+    setVertexAttributeDivisors(context, true);
+    context->drawTrianglesInstanced(_indexBuffer, _numIndices / 3, _numInstances);
+    // restore per-vertex stepping so that the following non-instanced draw calls are not affected
+    setVertexAttributeDivisors(context, false);
+}
 
-    // first, hand over to the context bound vertex attributes
+void
+DrawCall::setVertexAttributeDivisors(const AbstractContext::Ptr& context, bool enabled)
+{
     for (uint i = 0; i < _vertexBufferIds.size(); ++i)
     {
-        auto vertexBufferId = _vertexBufferIds[i];
-
-        if (vertexBufferId > 0 &&
-            !_program->hasVertexBufferLocation(_vertexBufferLocations[i]))
-            context->setVertexBufferAt(
-                 _vertexBufferLocations[i],
-                 vertexBufferId,
-                 _vertexAttributeSizes[i],
-                 _vertexSizes[i],
-                 _vertexAttributeOffsets[i]
-            );
-    }
-    // second, hand over explicitly user defined vertex attributes (possible replacement of )
-    for (auto vertexBufferLocationAndPtr : _program->vertexBuffers())
-    {
-        const int    location        = vertexBufferLocationAndPtr.first;
-        auto&        vertexBuffer    = vertexBufferLocationAndPtr.second;
-
-        if (vertexBuffer->isReady())
-        {
-            assert(vertexBuffer->attributes().size() == 1);
+        if (_vertexBufferIds[i] <= 0 || _vertexAttributeDivisors[i] == 0)
+            continue;
 
-            const auto& vertexAttribute = vertexBuffer->attributes().front();
+        const int numColumns = std::max(1, _vertexAttributeSizes[i] / 4);
 
-            context->setVertexBufferAt(
-                location,
-                vertexBuffer->id(),
-                std::get<1>(*vertexAttribute),
-                vertexBuffer->vertexSize(),
-                std::get<2>(*vertexAttribute)
+        for (int column = 0; column < numColumns; ++column)
+            context->setVertexAttributeDivisor(
+                _vertexBufferLocations[i] + column,
+                enabled ? _vertexAttributeDivisors[i] : 0
             );
-        }
     }
+}
 
-    context->setColorMask(_colorMask);
-    context->setBlendMode(_blendMode);
-    context->setDepthTest(_depthMask, _depthFunc);
-    context->setStencilTest(_stencilFunc, _stencilRef, _stencilMask, _stencilFailOp, _stencilZFailOp, _stencilZPassOp);
-    context->setScissorTest(_scissorTest, _scissorBox);
-    context->setTriangleCulling(_triangleCulling);
+bool
+DrawCall::hasSameTextures(const DrawCall& drawCall) const
+{
+    return _textureIds == drawCall._textureIds
+        && _textureLocations == drawCall._textureLocations
+        && _textureWrapMode == drawCall._textureWrapMode
+        && _textureFilters == drawCall._textureFilters
+        && _textureMipFilters == drawCall._textureMipFilters;
+}
 
-    if (_program->indexBuffer() && _program->indexBuffer()->isReady())
-        context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->data().size() / 3);
-    else if (_indexBuffer != -1)
-        context->drawTriangles(_indexBuffer, _numIndices / 3);
+bool
+DrawCall::hasSameVertexAttributes(const DrawCall& drawCall) const
+{
+    return _vertexBufferIds == drawCall._vertexBufferIds
+        && _vertexBufferLocations == drawCall._vertexBufferLocations
+        && _vertexSizes == drawCall._vertexSizes
+        && _vertexAttributeSizes == drawCall._vertexAttributeSizes
+        && _vertexAttributeOffsets == drawCall._vertexAttributeOffsets;
 }
 
 Container::Ptr
@@ -19,6 +19,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/render/DrawCallPool.hpp"
 #include "minko/render/DrawCall.hpp"
+#include "minko/render/DrawCallSortMode.hpp"
+#include "minko/render/AbstractTexture.hpp"
 #include "minko/component/Renderer.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/render/Effect.hpp"
@@ -29,6 +31,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/geometry/Geometry.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/material/Material.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/math/Matrix4x4.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -47,13 +54,30 @@ DrawCallPool::DrawCallPool(Renderer::Ptr renderer):
     _toCollect(),
     _toRemove(),
     _invisibleSurfaces(),
+    _culledSurfaces(),
     _surfaceToDrawCalls(),
     _drawcallToSurface(),
     _drawcallToMacroChangedSlot(),
     _drawcallToZSortNeededSlot(),
+    _drawcallToIterator(),
     _drawCalls(),
     _dirtyDrawCalls(),
     _mustZSort(true),
+    _sortMode(DrawCallSortMode::PRIORITY),
+    _sortedDrawCalls(),
+    _sortPriorities(),
+    _sortKeys(),
+    _sortKeysBuffer(),
+    _sortIndices(),
+    _sortIndicesBuffer(),
+    _instancing(false),
+    _instanceBatches(),
+    _surfaceToInstanceBatch(),
+    _surfaceToInstanceSlots(),
+    _dirtyInstanceBatches(),
+    _drawCallTemplates(),
+    _macroValues(),
+    _mustPurgeTemplates(false),
     _surfaceToTechniqueChangedSlot(),
     _surfaceToVisibilityChangedSlots(),
     _surfaceToIndexChangedSlots(),
@@ -82,30 +106,517 @@ DrawCallPool::drawCalls()
         cleanSurface(surface);
     _toRemove.clear();
 
+    if (_mustPurgeTemplates)
+        purgeDrawCallTemplates();
+
     auto dirtyDrawCalls = _dirtyDrawCalls;
     _dirtyDrawCalls.clear();
 
     for (auto& d : dirtyDrawCalls)
         refreshDrawCall(d);
 
-    for (auto& surface : _toCollect)
+    // collecting a batch leader can dissolve its batch and push the other instances back in _toCollect
+    while (!_toCollect.empty())
     {
-        auto& newDrawCalls = generateDrawCall(surface, NUM_FALLBACK_ATTEMPTS);
+        auto surface = *_toCollect.begin();
+
+        _toCollect.erase(_toCollect.begin());
+
+        if (collectInstance(surface))
+            continue;
 
-        _drawCalls.insert(_drawCalls.end(), newDrawCalls.begin(), newDrawCalls.end());
+        for (auto& drawCall : generateDrawCall(surface, NUM_FALLBACK_ATTEMPTS))
+            insertDrawCall(drawCall);
     }
-    _toCollect.clear();
+
+    for (auto& batch : _dirtyInstanceBatches)
+        updateInstanceBatch(batch);
+    _dirtyInstanceBatches.clear();
 
     if (doZSort)
     {
         _cachedDrawcallPositions.clear();
-        _drawCalls.sort(&DrawCallPool::compareDrawCalls);
+
+        if (_sortMode == DrawCallSortMode::STATE)
+            sortDrawCallsByState();
+        else
+            _drawCalls.sort(&DrawCallPool::compareDrawCalls);
     }
     _mustZSort = false;
 
     return _drawCalls;
 }
 
+void
+DrawCallPool::sortMode(DrawCallSortMode value)
+{
+    if (value == _sortMode)
+        return;
+
+    _sortMode   = value;
+    _mustZSort  = true;
+}
+
+void
+DrawCallPool::instancing(bool value)
+{
+    if (value == _instancing)
+        return;
+
+    _instancing = value;
+
+    // every surface has to be collected again to be batched (or unbatched)
+    for (auto& batch : _instanceBatches)
+        _toCollect.insert(batch.second->surfaces.begin(), batch.second->surfaces.end());
+
+    _instanceBatches.clear();
+    _surfaceToInstanceBatch.clear();
+    _surfaceToInstanceSlots.clear();
+    _dirtyInstanceBatches.clear();
+
+    if (_instancing)
+        for (auto& surfaceAndDrawCalls : _surfaceToDrawCalls)
+        {
+            if (surfaceAndDrawCalls.second.empty())
+                continue;
+
+            // parked draw calls are generated again when their surface becomes visible
+            if (_invisibleSurfaces.count(surfaceAndDrawCalls.first) != 0)
+                deleteDrawCalls(surfaceAndDrawCalls.first);
+            else
+                _toCollect.insert(surfaceAndDrawCalls.first);
+        }
+}
+
+bool
+DrawCallPool::collectInstance(Surface::Ptr surface)
+{
+    removeInstance(surface);
+
+    if (!_instancing || !canBeInstanced(surface))
+        return false;
+
+    const auto  key     = getInstanceBatchKey(surface);
+    auto        batchIt = _instanceBatches.find(key);
+
+    if (batchIt != _instanceBatches.end())
+    {
+        // the surface will be rendered by the draw calls of the batch leader
+        if (_surfaceToDrawCalls.count(surface))
+            deleteDrawCalls(surface);
+
+        batchIt->second->surfaces.push_back(surface);
+        _surfaceToInstanceBatch[surface] = batchIt->second;
+        _dirtyInstanceBatches.insert(batchIt->second);
+        watchInstance(surface);
+
+        return true;
+    }
+
+    auto batch = std::make_shared<InstanceBatch>();
+
+    batch->key      = key;
+    batch->leader   = surface;
+    batch->provider = data::StructureProvider::create("instancing");
+    batch->surfaces.push_back(surface);
+
+    _instanceBatches[key]               = batch;
+    _surfaceToInstanceBatch[surface]    = batch;
+    watchInstance(surface);
+
+    // the instancing properties must exist before the leader draw calls select their program
+    updateInstanceBatch(batch);
+
+    return false;
+}
+
+void
+DrawCallPool::removeInstance(Surface::Ptr surface)
+{
+    auto batchIt = _surfaceToInstanceBatch.find(surface);
+
+    if (batchIt == _surfaceToInstanceBatch.end())
+        return;
+
+    auto batch = batchIt->second;
+
+    _surfaceToInstanceBatch.erase(batchIt);
+    _surfaceToInstanceSlots.erase(surface);
+
+    if (batch->leader == surface)
+    {
+        // the batch draw calls belong to the leader: the remaining instances must be collected again
+        _instanceBatches.erase(batch->key);
+        _dirtyInstanceBatches.erase(batch);
+
+        for (auto& instance : batch->surfaces)
+        {
+            if (instance == surface)
+                continue;
+
+            _surfaceToInstanceBatch.erase(instance);
+            _surfaceToInstanceSlots.erase(instance);
+            if (_toRemove.count(instance) == 0)
+                _toCollect.insert(instance);
+        }
+    }
+    else
+    {
+        batch->surfaces.erase(std::find(batch->surfaces.begin(), batch->surfaces.end(), surface));
+        _dirtyInstanceBatches.insert(batch);
+    }
+}
+
+DrawCallPool::InstanceBatchKey
+DrawCallPool::getInstanceBatchKey(Surface::Ptr surface)
+{
+    const auto target       = surface->targets()[0];
+    const auto effect       = _renderer->effect() ? _renderer->effect() : surface->effect();
+    const auto technique    = _renderer->effect() ? effect->techniques().begin()->first : surface->technique();
+
+    // the batch draw calls read the properties of the leader: the instances must share every provider
+    // but their transform, which is instanced, their node provider, whose layouts are part of the key,
+    // and the array lengths of their container, which only depend on the other providers
+    std::vector<ProviderPtr> providers;
+
+    for (const auto& provider : target->data()->providers())
+    {
+        const auto structure = std::dynamic_pointer_cast<data::StructureProvider>(provider);
+
+        if (provider == target->data()->arrayLengths())
+            continue;
+        if (structure == nullptr
+            || (structure->structureName() != "transform" && structure->structureName() != "node"))
+            providers.push_back(provider);
+    }
+    std::sort(providers.begin(), providers.end());
+
+    return InstanceBatchKey(
+        surface->geometry(),
+        surface->material(),
+        effect,
+        technique,
+        target->layouts(),
+        providers
+    );
+}
+
+void
+DrawCallPool::watchInstance(Surface::Ptr surface)
+{
+    const auto  target  = surface->targets()[0];
+    auto&       slots   = _surfaceToInstanceSlots[surface];
+
+    slots.layoutsChanged = target->layoutsChanged()->connect([=](NodePtr n, NodePtr t)
+    {
+        instanceKeyChangedHandler(surface);
+    });
+    slots.providerAdded = target->data()->providerAdded()->connect([=](ContainerPtr c, ProviderPtr p)
+    {
+        instanceKeyChangedHandler(surface);
+    });
+    slots.providerRemoved = target->data()->providerRemoved()->connect([=](ContainerPtr c, ProviderPtr p)
+    {
+        instanceKeyChangedHandler(surface);
+    });
+    // only the batches whose transforms changed are packed again
+    slots.transformChanged = target->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(
+        [=](ContainerPtr c, const std::string& propertyName)
+        {
+            auto batchIt = _surfaceToInstanceBatch.find(surface);
+
+            if (batchIt != _surfaceToInstanceBatch.end())
+                _dirtyInstanceBatches.insert(batchIt->second);
+        }
+    );
+}
+
+void
+DrawCallPool::instanceKeyChangedHandler(Surface::Ptr surface)
+{
+    auto batchIt = _surfaceToInstanceBatch.find(surface);
+
+    if (batchIt == _surfaceToInstanceBatch.end())
+        return;
+
+    // layouts changes are also bubbled from the ancestors and descendants of the surface node,
+    // and adding or removing a transform only changes the instanced matrices
+    if (batchIt->second->key == getInstanceBatchKey(surface))
+    {
+        _dirtyInstanceBatches.insert(batchIt->second);
+
+        return;
+    }
+
+    deleteDrawCalls(surface);
+    removeInstance(surface);
+    if (_invisibleSurfaces.count(surface) == 0 && _toRemove.count(surface) == 0)
+        _toCollect.insert(surface);
+}
+
+bool
+DrawCallPool::canBeInstanced(Surface::Ptr surface)
+{
+    const auto geometry = surface->geometry();
+    const auto material = surface->material();
+
+    // skinned geometries are animated per surface
+    if (geometry->indices() == nullptr || geometry->data()->hasProperty("numBones"))
+        return false;
+
+    // instances are rendered at once and cannot be sorted back to front
+    if (material->hasProperty("zSort") && material->get<bool>("zSort"))
+        return false;
+
+    const auto effect       = _renderer->effect() ? _renderer->effect() : surface->effect();
+    const auto technique    = _renderer->effect() ? effect->techniques().begin()->first : surface->technique();
+
+    for (const auto& pass : effect->technique(technique))
+    {
+        if (pass->states()->zSorted())
+            return false;
+
+        // only effects reading the per-instance transforms from a vertex attribute support instancing
+        bool hasInstanceAttribute = false;
+
+        for (const auto& binding : pass->attributeBindings())
+            if (binding.second.first == "instancing.modelToWorldMatrix")
+            {
+                hasInstanceAttribute = true;
+                break;
+            }
+
+        if (!hasInstanceAttribute)
+            return false;
+    }
+
+    return true;
+}
+
+void
+DrawCallPool::updateInstanceBatch(InstanceBatchPtr batch)
+{
+    static const uint   MATRIX_SIZE = 16;
+    static const auto   identity    = Matrix4x4::create();
+
+    const uint  numSurfaces     = batch->surfaces.size();
+    uint        numInstances    = 0;
+    bool        changed         = false;
+    bool        reallocated     = false;
+
+    if (batch->matrices == nullptr || batch->matrices->numVertices() < numSurfaces)
+    {
+        // vertex buffers cannot be resized once uploaded: grow the capacity geometrically
+        const uint capacity = std::max(numSurfaces, batch->matrices ? batch->matrices->numVertices() * 2 : 1u);
+        const auto context  = batch->leader->geometry()->indices()->context();
+
+        batch->matrices = VertexBuffer::create(context, std::vector<float>(capacity * MATRIX_SIZE, 0.f));
+        batch->matrices->addAttribute("modelToWorldMatrix", MATRIX_SIZE, 0);
+
+        changed     = true;
+        reallocated = true;
+    }
+
+    auto& instanceData = batch->matrices->data();
+
+    for (auto& surface : batch->surfaces)
+    {
+        // culled instances are packed out of the per-instance buffer
+        if (_culledSurfaces.count(surface) != 0)
+            continue;
+
+        const auto  targetData  = surface->targets()[0]->data();
+        const auto& matrix      = targetData->hasProperty("transform.modelToWorldMatrix")
+            ? targetData->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix")->data()
+            : identity->data();
+        auto*       output      = &instanceData[numInstances++ * MATRIX_SIZE];
+
+        // matrices are stored row-major but mat4 attributes are read one column per location
+        for (uint column = 0; column < 4; ++column)
+            for (uint row = 0; row < 4; ++row)
+            {
+                const float value = matrix[row * 4 + column];
+
+                if (output[column * 4 + row] != value)
+                {
+                    output[column * 4 + row] = value;
+                    changed = true;
+                }
+            }
+    }
+
+    if (changed && numInstances != 0)
+        batch->matrices->upload(0, numInstances);
+
+    for (auto& drawCall : _surfaceToDrawCalls[batch->leader])
+        drawCall->culled(numInstances == 0);
+
+    if (reallocated)
+        batch->provider->set("modelToWorldMatrix", batch->matrices);
+
+    if (!batch->provider->hasProperty("numInstances")
+        || batch->provider->get<int>("numInstances") != int(numInstances))
+        batch->provider->set("numInstances", int(numInstances));
+}
+
+void
+DrawCallPool::sortDrawCallsByState()
+{
+    const auto numDrawCalls = _drawCalls.size();
+
+    _sortedDrawCalls.clear();
+    for (auto drawCallIt = _drawCalls.begin(); drawCallIt != _drawCalls.end(); ++drawCallIt)
+        _sortedDrawCalls.push_back(drawCallIt);
+
+    // priorities are floats compared with a tolerance: rank the distinct values, highest first
+    _sortPriorities.clear();
+    for (auto& drawCallIt : _sortedDrawCalls)
+        _sortPriorities.push_back((*drawCallIt)->priority());
+    std::sort(_sortPriorities.begin(), _sortPriorities.end(), std::greater<float>());
+    _sortPriorities.erase(
+        std::unique(_sortPriorities.begin(), _sortPriorities.end(), [](float a, float b)
+        {
+            return fabsf(a - b) < 1e-3f;
+        }),
+        _sortPriorities.end()
+    );
+
+    _sortKeys.resize(numDrawCalls);
+    _sortIndices.resize(numDrawCalls);
+
+    for (uint i = 0; i < numDrawCalls; ++i)
+    {
+        const auto& drawCall        = *_sortedDrawCalls[i];
+        const auto  priorityIt      = std::lower_bound(
+            _sortPriorities.begin(),
+            _sortPriorities.end(),
+            drawCall->priority() + 1e-3f,
+            std::greater<float>()
+        );
+
+        _sortKeys[i]    = getDrawCallStateKey(drawCall, priorityIt - _sortPriorities.begin());
+        _sortIndices[i] = i;
+    }
+
+    radixSort(_sortKeys, _sortIndices, _sortKeysBuffer, _sortIndicesBuffer);
+
+    // moving the nodes keeps the iterators of _drawcallToIterator valid
+    for (auto index : _sortIndices)
+        _drawCalls.splice(_drawCalls.end(), _drawCalls, _sortedDrawCalls[index]);
+
+    _sortedDrawCalls.clear();
+}
+
+/*static*/
+uint64_t
+DrawCallPool::getDrawCallStateKey(DrawCall::Ptr drawCall, uint priorityRank)
+{
+    // key layout, the lowest key being rendered first:
+    // [63..52] priority rank (highest priority first)
+    // [51..36] render target (textures by decreasing id, then back buffer)
+    // [35..0]  z-sorted draw calls: eye-space depth (farthest first)
+    //          others: program [35..22], texture set [21..8], blending and depth states [7..0]
+    static const uint64_t MAX_TARGET = 0xffff;
+
+    static auto eyePosition = Vector3::create();
+
+    uint64_t key = uint64_t(std::min(priorityRank, 0xfffu)) << 52;
+
+    const auto target = drawCall->target();
+    if (target)
+        key |= (MAX_TARGET - 1 - std::min<uint64_t>(target->id(), MAX_TARGET - 1)) << 36;
+    else
+        key |= MAX_TARGET << 36;
+
+    if (drawCall->zSorted())
+    {
+        getDrawcallEyePosition(drawCall, eyePosition);
+
+        // map the float bits to an unsigned integer with the same ordering, then reverse it
+        const float z    = eyePosition->z();
+        uint        bits = 0;
+
+        std::memcpy(&bits, &z, sizeof(float));
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+        key |= uint64_t(~bits) << 4;
+    }
+    else
+    {
+        const auto& program = drawCall->program();
+        size_t      textureSet = 0;
+
+        for (auto textureId : drawCall->textureIds())
+            std::hash_combine(textureSet, textureId);
+        textureSet ^= textureSet >> 14;
+
+        const uint states = uint(drawCall->blendMode()) * 31
+            + uint(drawCall->depthFunc()) * 2
+            + (drawCall->depthMask() ? 1 : 0);
+
+        key |= uint64_t(program && program->isReady() ? program->id() & 0x3fff : 0) << 22;
+        key |= uint64_t(textureSet & 0x3fff) << 8;
+        key |= uint64_t(states & 0xff);
+    }
+
+    return key;
+}
+
+/*static*/
+void
+DrawCallPool::radixSort(std::vector<uint64_t>&  keys,
+                        std::vector<uint>&      indices,
+                        std::vector<uint64_t>&  keysBuffer,
+                        std::vector<uint>&      indicesBuffer)
+{
+    // stable LSD radix sort, one byte per pass
+    static const uint NUM_PASSES    = sizeof(uint64_t);
+    static const uint NUM_BUCKETS   = 256;
+
+    const auto numKeys = keys.size();
+
+    if (numKeys < 2)
+        return;
+
+    keysBuffer.resize(numKeys);
+    indicesBuffer.resize(numKeys);
+
+    std::array<uint, NUM_BUCKETS> offsets;
+
+    for (uint pass = 0; pass < NUM_PASSES; ++pass)
+    {
+        const uint shift = pass * 8;
+
+        offsets.fill(0);
+        for (auto key : keys)
+            ++offsets[(key >> shift) & 0xff];
+
+        // every key shares the same byte: this pass would not change the order
+        if (offsets[(keys[0] >> shift) & 0xff] == numKeys)
+            continue;
+
+        uint sum = 0;
+        for (auto& offset : offsets)
+        {
+            const auto count = offset;
+
+            offset = sum;
+            sum += count;
+        }
+
+        for (uint i = 0; i < numKeys; ++i)
+        {
+            const auto position = offsets[(keys[i] >> shift) & 0xff]++;
+
+            keysBuffer[position]    = keys[i];
+            indicesBuffer[position] = indices[i];
+        }
+
+        keys.swap(keysBuffer);
+        indices.swap(indicesBuffer);
+    }
+}
+
 /*static*/
 bool
 DrawCallPool::compareDrawCalls(DrawCall::Ptr a,
@@ -219,6 +730,8 @@ DrawCallPool::addSurface(Surface::Ptr surface)
 void
 DrawCallPool::removeSurface(Surface::Ptr surface)
 {
+    _culledSurfaces.erase(surface);
+
     auto foundSurfaceIt = _toCollect.find(surface);
 
     if (foundSurfaceIt == _toCollect.end())
@@ -227,13 +740,44 @@ DrawCallPool::removeSurface(Surface::Ptr surface)
         _toCollect.erase(foundSurfaceIt);
 }
 
+void
+DrawCallPool::culled(Surface::Ptr surface, bool value)
+{
+    if (value == culled(surface))
+        return;
+
+    if (value)
+        _culledSurfaces.insert(surface);
+    else
+        _culledSurfaces.erase(surface);
+
+    // the draw calls of an instance batch are culled when all its surfaces are (see updateInstanceBatch())
+    auto batchIt = _surfaceToInstanceBatch.find(surface);
+
+    if (batchIt != _surfaceToInstanceBatch.end())
+    {
+        _dirtyInstanceBatches.insert(batchIt->second);
+
+        return;
+    }
+
+    auto drawCallsIt = _surfaceToDrawCalls.find(surface);
+
+    if (drawCallsIt != _surfaceToDrawCalls.end())
+        for (auto& drawCall : drawCallsIt->second)
+            drawCall->culled(value);
+}
+
 void
 DrawCallPool::cleanSurface(Surface::Ptr    surface)
 {
     deleteDrawCalls(surface);
+    removeInstance(surface);
 
     _surfaceToDrawCalls[surface].clear();
     _surfaceToTechniqueChangedSlot.erase(surface);
+    // the effect of the surface might be released with its passes and programs
+    _mustPurgeTemplates = true;
     //_surfaceToVisibilityChangedSlots.erase(surface);
     _surfaceToIndexChangedSlots.erase(surface);
 
@@ -249,7 +793,9 @@ DrawCallPool::techniqueChangedHandler(Surface::Ptr            surface,
                                       bool                    updateDrawCall)
 {
     deleteDrawCalls(surface);
-    if (updateDrawCall && std::find(_toCollect.begin(), _toCollect.end(), surface) == _toCollect.end())
+    removeInstance(surface);
+    _mustPurgeTemplates = true;
+    if (updateDrawCall && _invisibleSurfaces.count(surface) == 0)
         _toCollect.insert(surface);
 }
 
@@ -265,15 +811,71 @@ DrawCallPool::visibilityChangedHandler(Surface::Ptr        surface,
 
     if (visible && _invisibleSurfaces.find(surface) != _invisibleSurfaces.end()) // visible and already wasn't visible before
     {
-        _toCollect.insert(surface);
         _invisibleSurfaces.erase(surface);
+        unparkDrawCalls(surface);
     }
     else if (!visible && _invisibleSurfaces.find(surface) == _invisibleSurfaces.end()) // not visible but was visible before
     {
-        _toRemove.insert(surface);
         _invisibleSurfaces.insert(surface);
+        parkDrawCalls(surface);
     }
+}
 
+void
+DrawCallPool::insertDrawCall(DrawCall::Ptr drawCall)
+{
+    if (_drawcallToIterator.count(drawCall) == 0)
+        _drawcallToIterator[drawCall] = _drawCalls.insert(_drawCalls.end(), drawCall);
+}
+
+void
+DrawCallPool::eraseDrawCall(DrawCall::Ptr drawCall)
+{
+    auto iteratorIt = _drawcallToIterator.find(drawCall);
+
+    if (iteratorIt == _drawcallToIterator.end())
+        return;
+
+    _drawCalls.erase(iteratorIt->second);
+    _drawcallToIterator.erase(iteratorIt);
+}
+
+void
+DrawCallPool::parkDrawCalls(Surface::Ptr surface)
+{
+    // instances are rendered by the draw calls of their batch leader: they will be batched again when visible
+    if (_surfaceToInstanceBatch.count(surface) != 0)
+    {
+        deleteDrawCalls(surface);
+        removeInstance(surface);
+
+        return;
+    }
+
+    auto drawCallsIt = _surfaceToDrawCalls.find(surface);
+
+    if (drawCallsIt != _surfaceToDrawCalls.end())
+        for (auto& drawCall : drawCallsIt->second)
+            eraseDrawCall(drawCall);
+}
+
+void
+DrawCallPool::unparkDrawCalls(Surface::Ptr surface)
+{
+    auto drawCallsIt = _surfaceToDrawCalls.find(surface);
+
+    if (drawCallsIt == _surfaceToDrawCalls.end() || drawCallsIt->second.empty()
+        || (_instancing && canBeInstanced(surface)))
+    {
+        _toCollect.insert(surface);
+
+        return;
+    }
+
+    // parked draw calls kept their bindings up to date: no need to select a program or bind them again
+    for (auto& drawCall : drawCallsIt->second)
+        insertDrawCall(drawCall);
+    _mustZSort = true;
 }
 
 void
@@ -283,7 +885,11 @@ DrawCallPool::drawCallVariablesChangedHandler(data::ArrayProvider::Ptr    provid
 {
     if (surface->getTarget(0)->data()->getProviderIndex(provider) != _surfaceToMaterialProviderIndex[surface] && _toRemove.find(surface) == _toRemove.end())
     {
-        _toCollect.insert(surface);
+        // parked draw calls are generated again when their surface becomes visible
+        if (_invisibleSurfaces.count(surface) != 0)
+            deleteDrawCalls(surface);
+        else
+            _toCollect.insert(surface);
         _surfaceToMaterialProviderIndex[surface] = surface->getTarget(0)->data()->getProviderIndex(provider);
     }
 }
@@ -313,6 +919,8 @@ DrawCallPool::generateDrawCall(Surface::Ptr    surface,
 
         if (drawCall)
         {
+            drawCall->culled(_culledSurfaces.count(surface) != 0);
+
             _surfaceToDrawCalls[surface].push_back(drawCall);
 
             _drawcallToSurface[drawCall] = surface;
@@ -385,6 +993,12 @@ DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
     rendererData    = fullRendererData->filter(rendererFilters);
     rootData        = fullRootData->filter(rootFilters);
 
+    // instanced draw calls read the batch transforms from the filtered target data only
+    const auto batchIt = _surfaceToInstanceBatch.find(surface);
+
+    if (batchIt != _surfaceToInstanceBatch.end() && batchIt->second->leader == surface)
+        targetData->addProvider(batchIt->second->provider);
+
     // get drawcall's property name formatting function (dependent on filters!)
     auto geometryId    = targetData->getProviderIndex(surface->geometry()->data());
     auto materialId    = targetData->getProviderIndex(surface->material());
@@ -401,9 +1015,11 @@ DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
         drawCallVariables
     );
 
-    auto program = getWorkingProgram(
+    auto&       drawCallTemplate    = getDrawCallTemplate(pass, geometryId, materialId, formatNameFunc);
+    const auto& variant             = getWorkingProgram(
         surface,
         pass,
+        drawCallTemplate,
         formatNameFunc,
         fullTargetData,
         fullRendererData,
@@ -412,6 +1028,7 @@ DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
         rendererData,
         rootData
     );
+    auto        program             = variant.program.lock();
 
     if (!program)
         return nullptr;
@@ -427,15 +1044,137 @@ DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
         fullRootData,
         targetData,
         rendererData,
-        rootData
+        rootData,
+        variant.inputBindings
     );
     return drawCall;
 }
 
+DrawCallPool::DrawCallTemplate&
+DrawCallPool::getDrawCallTemplate(Pass::Ptr             pass,
+                                  int                   geometryId,
+                                  int                   materialId,
+                                  FormatNameFunction    formatNameFunc)
+{
+    auto& drawCallTemplate = _drawCallTemplates[DrawCallTemplateKey(pass.get(), geometryId, materialId)];
+
+    // the address of a destroyed pass can be reused
+    if (drawCallTemplate.pass.lock() != pass)
+    {
+        const auto& macroPropertyIds = pass->macroPropertyIds();
+        unsigned int macroIndex = 0;
+
+        drawCallTemplate.pass = pass;
+        drawCallTemplate.variants.clear();
+        drawCallTemplate.macroPropertyIds.clear();
+
+        for (const auto& macroBinding : pass->macroBindings())
+        {
+            const auto& macroPropertyId = macroPropertyIds[macroIndex++];
+
+            drawCallTemplate.macroPropertyIds.push_back(macroPropertyId != PropertyId()
+                ? macroPropertyId
+                : PropertyId(formatNameFunc(std::get<0>(macroBinding.second)))
+            );
+        }
+    }
+
+    return drawCallTemplate;
+}
+
+const DrawCallPool::DrawCallVariant&
+DrawCallPool::getDrawCallVariant(Pass::Ptr              pass,
+                                 DrawCallTemplate&      drawCallTemplate,
+                                 FormatNameFunction     formatNameFunc,
+                                 ContainerPtr           targetData,
+                                 ContainerPtr           rendererData,
+                                 ContainerPtr           rootData)
+{
+    // the program signature only depends on the existence and the integer value of the macro properties
+    unsigned int macroIndex = 0;
+
+    _macroValues.clear();
+    for (const auto& macroBinding : pass->macroBindings())
+    {
+        const auto& propertyId  = drawCallTemplate.macroPropertyIds[macroIndex++];
+        const auto  source      = std::get<1>(macroBinding.second);
+        const auto& container   = source == data::BindingSource::TARGET
+            ? targetData
+            : (source == data::BindingSource::RENDERER ? rendererData : rootData);
+
+        if (!container->hasProperty(propertyId))
+            _macroValues.push_back(0);
+        else if (!container->propertyHasType<int>(propertyId))
+            _macroValues.push_back(1);
+        else
+        {
+            _macroValues.push_back(2);
+            _macroValues.push_back(container->get<int>(propertyId));
+        }
+    }
 
-std::shared_ptr<Program>
+    auto variantIt = drawCallTemplate.variants.find(_macroValues);
+
+    if (variantIt != drawCallTemplate.variants.end())
+    {
+        auto program = variantIt->second.program.lock();
+
+        // macro values out of their bounds always fail, programs failing to compile are tried again
+        if ((program && program->isReady()) || !variantIt->second.incorrectIntegerMacros.empty())
+            return variantIt->second;
+    }
+
+    auto&                   variant = drawCallTemplate.variants[_macroValues];
+    std::list<std::string>  booleanMacros;
+
+    auto program = pass->selectProgram(
+        formatNameFunc,
+        targetData,
+        rendererData,
+        rootData,
+        booleanMacros,
+        variant.integerMacros,
+        variant.incorrectIntegerMacros
+    );
+
+    variant.program         = program;
+    variant.inputBindings   = program ? DrawCall::resolveInputBindings(pass, program, formatNameFunc) : nullptr;
+
+    return variant;
+}
+
+void
+DrawCallPool::purgeDrawCallTemplates()
+{
+    _mustPurgeTemplates = false;
+
+    for (auto templateIt = _drawCallTemplates.begin(); templateIt != _drawCallTemplates.end();)
+    {
+        if (templateIt->second.pass.expired())
+        {
+            templateIt = _drawCallTemplates.erase(templateIt);
+
+            continue;
+        }
+
+        auto& variants = templateIt->second.variants;
+
+        for (auto variantIt = variants.begin(); variantIt != variants.end();)
+        {
+            if (variantIt->second.program.expired() && variantIt->second.incorrectIntegerMacros.empty())
+                variantIt = variants.erase(variantIt);
+            else
+                ++variantIt;
+        }
+
+        ++templateIt;
+    }
+}
+
+const DrawCallPool::DrawCallVariant&
 DrawCallPool::getWorkingProgram(Surface::Ptr            surface,
                                 Pass::Ptr                pass,
+                                DrawCallTemplate&        drawCallTemplate,
                                 FormatNameFunction        formatNameFunc,
                                 ContainerPtr            fullTargetData,
                                 ContainerPtr            fullRendererData,
@@ -444,20 +1183,12 @@ DrawCallPool::getWorkingProgram(Surface::Ptr            surface,
                                 ContainerPtr            rendererData,
                                 ContainerPtr            rootData)
 {
-    // get program signature from filtered data containers
-    std::list<std::string>    booleanMacros;
-    std::list<std::string>    integerMacros;
-    std::list<std::string>    incorrectIntegerMacros;
+    const auto& variant                 = getDrawCallVariant(pass, drawCallTemplate, formatNameFunc, targetData, rendererData, rootData);
+    const auto& integerMacros           = variant.integerMacros;
+    const auto& incorrectIntegerMacros  = variant.incorrectIntegerMacros;
 
-    Program::Ptr program = pass->selectProgram(
-        formatNameFunc,
-        targetData,
-        rendererData,
-        rootData,
-        booleanMacros,
-        integerMacros,
-        incorrectIntegerMacros
-    );
+    if (incorrectIntegerMacros.empty() && _surfaceBadMacroToTechniques.count(surface) == 0)
+        return variant;
 
     // forgive good macros
     for (auto& macroName : integerMacros)
@@ -531,7 +1262,7 @@ DrawCallPool::getWorkingProgram(Surface::Ptr            surface,
         }
     }
 
-    return program;
+    return variant;
 }
 
 void
@@ -548,7 +1279,7 @@ DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
         _drawcallToMacroChangedSlot.erase(drawCall);
         _drawcallToZSortNeededSlot.erase(drawCall);
 
-        _drawCalls.remove(drawCall);
+        eraseDrawCall(drawCall);
         _dirtyDrawCalls.erase(drawCall);
     }
 }
@@ -0,0 +1,458 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ImageResampler.hpp"
+
+#include "minko/async/ThreadPool.hpp"
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+# include <xmmintrin.h>
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+# include <arm_neon.h>
+#endif
+
+using namespace minko;
+using namespace minko::render;
+
+// number of pixels processed by each chunk of the parallel loops
+const uint  ImageResampler::GRAIN_SIZE      = 16384;
+const float ImageResampler::KAISER_RADIUS   = 3.f;
+const float ImageResampler::KAISER_ALPHA    = 4.f;
+
+void
+ImageResampler::resize(uint                         width,
+                       uint                         height,
+                       const unsigned char*         data,
+                       uint                         newWidth,
+                       uint                         newHeight,
+                       Filter                       filter,
+                       bool                         sRGB,
+                       std::vector<unsigned char>&  newData)
+{
+    newData.resize(newWidth * newHeight * 4);
+
+    if (newData.empty())
+        return;
+
+    if (newWidth == width && newHeight == height)
+    {
+        std::copy(data, data + newData.size(), newData.begin());
+
+        return;
+    }
+
+    if (filter == Filter::NEAREST)
+    {
+        resizeNearest(width, height, data, newWidth, newHeight, newData.data());
+
+        return;
+    }
+
+    std::vector<float> pixels;
+    std::vector<float> newPixels;
+
+    decode(width, height, data, sRGB, false, pixels);
+    resample(width, height, pixels, newWidth, newHeight, filter, newPixels);
+    encode(newWidth, newHeight, newPixels, sRGB, false, newData.data());
+}
+
+uint
+ImageResampler::generateMipChain(uint                           width,
+                                 uint                           height,
+                                 const unsigned char*           data,
+                                 Filter                         filter,
+                                 bool                           sRGB,
+                                 std::vector<unsigned char>&    mipChain,
+                                 bool                           premultiplyAlpha)
+{
+    const auto numLevels = numMipLevels(width, height);
+
+    mipChain.insert(mipChain.end(), data, data + width * height * 4);
+
+    std::vector<float> pixels;
+    std::vector<float> newPixels;
+
+    decode(width, height, data, sRGB, premultiplyAlpha, pixels);
+
+    for (uint level = 1; level < numLevels; ++level)
+    {
+        const auto newWidth = std::max(width >> 1, 1u);
+        const auto newHeight = std::max(height >> 1, 1u);
+
+        resample(width, height, pixels, newWidth, newHeight, filter, newPixels);
+
+        const auto offset = mipChain.size();
+
+        mipChain.resize(offset + newWidth * newHeight * 4);
+        encode(newWidth, newHeight, newPixels, sRGB, premultiplyAlpha, mipChain.data() + offset);
+
+        pixels.swap(newPixels);
+        width = newWidth;
+        height = newHeight;
+    }
+
+    return numLevels;
+}
+
+uint
+ImageResampler::numMipLevels(uint width, uint height)
+{
+    uint numLevels = 1;
+
+    for (auto size = std::max(width, height); size > 1; size >>= 1)
+        ++numLevels;
+
+    return numLevels;
+}
+
+void
+ImageResampler::resizeNearest(uint                  width,
+                              uint                  height,
+                              const unsigned char*  data,
+                              uint                  newWidth,
+                              uint                  newHeight,
+                              unsigned char*        newData)
+{
+    Kernel horizontal;
+    Kernel vertical;
+
+    computeKernel(width, newWidth, Filter::NEAREST, horizontal);
+    computeKernel(height, newHeight, Filter::NEAREST, vertical);
+
+    // texels are copied as they are: their alpha might not be a coverage
+    async::ThreadPool::instance()->parallelFor(0, newHeight, grainSize(newWidth), [&](uint begin, uint end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            const unsigned char*    src = data + vertical.firsts[y] * width * 4;
+            unsigned char*          dst = newData + y * newWidth * 4;
+
+            for (uint x = 0; x < newWidth; ++x)
+                std::copy(src + horizontal.firsts[x] * 4, src + horizontal.firsts[x] * 4 + 4, dst + x * 4);
+        }
+    });
+}
+
+void
+ImageResampler::decode(uint                     width,
+                       uint                     height,
+                       const unsigned char*     data,
+                       bool                     sRGB,
+                       bool                     premultiplyAlpha,
+                       std::vector<float>&      pixels)
+{
+    static const auto toLinear = []()
+    {
+        std::vector<float> table(256);
+
+        for (uint i = 0; i < 256; ++i)
+        {
+            const auto c = i / 255.f;
+
+            table[i] = c <= .04045f ? c / 12.92f : std::pow((c + .055f) / 1.055f, 2.4f);
+        }
+
+        return table;
+    }();
+
+    pixels.resize(width * height * 4);
+
+    async::ThreadPool::instance()->parallelFor(0, height, grainSize(width), [&](uint begin, uint end)
+    {
+        for (auto i = begin * width * 4; i < end * width * 4; i += 4)
+        {
+            const auto alpha    = data[i + 3] / 255.f;
+            // premultiplied: transparent pixels do not bleed their color into their neighbours
+            const auto scale    = premultiplyAlpha ? alpha : 1.f;
+
+            for (uint k = 0; k < 3; ++k)
+                pixels[i + k] = (sRGB ? toLinear[data[i + k]] : data[i + k] / 255.f) * scale;
+            pixels[i + 3] = alpha;
+        }
+    });
+}
+
+void
+ImageResampler::encode(uint                         width,
+                       uint                         height,
+                       const std::vector<float>&    pixels,
+                       bool                         sRGB,
+                       bool                         premultiplyAlpha,
+                       unsigned char*               data)
+{
+    static const uint TO_SRGB_SIZE = 4096;
+    static const auto toSRGB = []()
+    {
+        std::vector<unsigned char> table(TO_SRGB_SIZE);
+
+        for (uint i = 0; i < TO_SRGB_SIZE; ++i)
+        {
+            const auto c = i / float(TO_SRGB_SIZE - 1);
+            const auto s = c <= .0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - .055f;
+
+            table[i] = (unsigned char)(s * 255.f + .5f);
+        }
+
+        return table;
+    }();
+
+    async::ThreadPool::instance()->parallelFor(0, height, grainSize(width), [&](uint begin, uint end)
+    {
+        for (auto i = begin * width * 4; i < end * width * 4; i += 4)
+        {
+            // negative lobes of the Kaiser filter overshoot
+            const auto alpha = std::min(std::max(pixels[i + 3], 0.f), 1.f);
+            const auto invAlpha = !premultiplyAlpha ? 1.f : (alpha > 0.f ? 1.f / alpha : 0.f);
+
+            for (uint k = 0; k < 3; ++k)
+            {
+                const auto c = std::min(std::max(pixels[i + k] * invAlpha, 0.f), 1.f);
+
+                data[i + k] = sRGB
+                    ? toSRGB[uint(c * (TO_SRGB_SIZE - 1) + .5f)]
+                    : (unsigned char)(c * 255.f + .5f);
+            }
+            data[i + 3] = (unsigned char)(alpha * 255.f + .5f);
+        }
+    });
+}
+
+void
+ImageResampler::resample(uint                       width,
+                         uint                       height,
+                         const std::vector<float>&  pixels,
+                         uint                       newWidth,
+                         uint                       newHeight,
+                         Filter                     filter,
+                         std::vector<float>&        newPixels)
+{
+    Kernel horizontal;
+    Kernel vertical;
+
+    computeKernel(width, newWidth, filter, horizontal);
+    computeKernel(height, newHeight, filter, vertical);
+
+    // horizontal pass: width x height -> newWidth x height
+    std::vector<float> rows(newWidth * height * 4);
+
+    async::ThreadPool::instance()->parallelFor(0, height, grainSize(width), [&](uint begin, uint end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            const float*    src = pixels.data() + y * width * 4;
+            float*          dst = rows.data() + y * newWidth * 4;
+
+            for (uint x = 0; x < newWidth; ++x)
+            {
+                const float*    in      = src + horizontal.firsts[x] * 4;
+                const float*    weights = horizontal.weights.data() + horizontal.offsets[x];
+                const auto      size    = horizontal.sizes[x];
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+                __m128 color = _mm_setzero_ps();
+
+                for (uint k = 0; k < size; ++k)
+                    color = _mm_add_ps(color, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(in + k * 4)));
+
+                _mm_storeu_ps(dst + x * 4, color);
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+                float32x4_t color = vdupq_n_f32(0.0f);
+
+                for (uint k = 0; k < size; ++k)
+                    color = vmlaq_n_f32(color, vld1q_f32(in + k * 4), weights[k]);
+
+                vst1q_f32(dst + x * 4, color);
+#else
+                float color[4] = { 0.0f };
+
+                for (uint k = 0; k < size; ++k)
+                    for (uint c = 0; c < 4; ++c)
+                        color[c] += weights[k] * in[k * 4 + c];
+
+                std::copy(color, color + 4, dst + x * 4);
+#endif
+            }
+        }
+    });
+
+    // vertical pass: newWidth x height -> newWidth x newHeight, 4 floats at a time
+    const auto rowSize = newWidth * 4;
+
+    newPixels.resize(rowSize * newHeight);
+
+    async::ThreadPool::instance()->parallelFor(0, newHeight, grainSize(newWidth), [&](uint begin, uint end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            const float*    in      = rows.data() + vertical.firsts[y] * rowSize;
+            const float*    weights = vertical.weights.data() + vertical.offsets[y];
+            const auto      size    = vertical.sizes[y];
+            float*          dst     = newPixels.data() + y * rowSize;
+
+            for (uint i = 0; i < rowSize; i += 4)
+            {
+#if MINKO_SIMD == MINKO_SIMD_SSE
+                __m128 color = _mm_setzero_ps();
+
+                for (uint k = 0; k < size; ++k)
+                    color = _mm_add_ps(color, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(in + k * rowSize + i)));
+
+                _mm_storeu_ps(dst + i, color);
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+                float32x4_t color = vdupq_n_f32(0.0f);
+
+                for (uint k = 0; k < size; ++k)
+                    color = vmlaq_n_f32(color, vld1q_f32(in + k * rowSize + i), weights[k]);
+
+                vst1q_f32(dst + i, color);
+#else
+                float color[4] = { 0.0f };
+
+                for (uint k = 0; k < size; ++k)
+                    for (uint c = 0; c < 4; ++c)
+                        color[c] += weights[k] * in[k * rowSize + i + c];
+
+                std::copy(color, color + 4, dst + i);
+#endif
+            }
+        }
+    });
+}
+
+void
+ImageResampler::computeKernel(uint size, uint newSize, Filter filter, Kernel& kernel)
+{
+    const auto scale = float(newSize) / float(size);
+    // the filter is stretched over the source pixels covered by each destination pixel when minifying
+    const auto stretch = scale < 1.f ? 1.f / scale : 1.f;
+    const auto radius = filter == Filter::BOX
+        ? .5f
+        : filter == Filter::LINEAR ? 1.f : KAISER_RADIUS;
+    std::vector<float> taps;
+
+    kernel.firsts.resize(newSize);
+    kernel.sizes.resize(newSize);
+    kernel.offsets.resize(newSize);
+    kernel.weights.clear();
+
+    for (uint i = 0; i < newSize; ++i)
+    {
+        const auto center = (i + .5f) / scale - .5f;
+
+        kernel.offsets[i] = kernel.weights.size();
+
+        if (filter == Filter::NEAREST)
+        {
+            kernel.firsts[i] = std::min(uint((i + .5f) / scale), size - 1);
+            kernel.sizes[i] = 1;
+            kernel.weights.push_back(1.f);
+
+            continue;
+        }
+
+        const auto begin = int(std::floor(center - radius * stretch));
+        const auto end = int(std::ceil(center + radius * stretch));
+        const auto first = std::max(begin, 0);
+        const auto last = std::min(end, int(size) - 1);
+        auto sum = 0.f;
+
+        taps.assign(last - first + 1, 0.f);
+
+        // pixels outside of the image are clamped to its edges
+        for (auto j = begin; j <= end; ++j)
+        {
+            const auto weight = filterWeight(filter, (j - center) / stretch, radius);
+
+            taps[std::min(std::max(j, first), last) - first] += weight;
+            sum += weight;
+        }
+
+        if (sum == 0.f)
+        {
+            kernel.firsts[i] = std::min(std::max(int(center + .5f), 0), int(size) - 1);
+            kernel.sizes[i] = 1;
+            kernel.weights.push_back(1.f);
+
+            continue;
+        }
+
+        uint tapsBegin = 0;
+        uint tapsEnd = taps.size();
+
+        while (taps[tapsBegin] == 0.f)
+            ++tapsBegin;
+        while (taps[tapsEnd - 1] == 0.f)
+            --tapsEnd;
+
+        kernel.firsts[i] = first + tapsBegin;
+        kernel.sizes[i] = tapsEnd - tapsBegin;
+        for (auto k = tapsBegin; k < tapsEnd; ++k)
+            kernel.weights.push_back(taps[k] / sum);
+    }
+}
+
+float
+ImageResampler::filterWeight(Filter filter, float x, float radius)
+{
+    x = std::abs(x);
+
+    switch (filter)
+    {
+    case Filter::BOX:
+        return x < radius ? 1.f : (x == radius ? .5f : 0.f);
+
+    case Filter::LINEAR:
+        return std::max(1.f - x, 0.f);
+
+    case Filter::KAISER:
+    {
+        if (x >= radius)
+            return 0.f;
+
+        // zeroth order modified Bessel function of the first kind
+        auto besselI0 = [](float v)
+        {
+            auto sum = 1.f;
+            auto term = 1.f;
+
+            for (auto k = 1; k < 16; ++k)
+            {
+                term *= (v * .5f / k) * (v * .5f / k);
+                sum += term;
+            }
+
+            return sum;
+        };
+
+        const auto ratio = x / radius;
+        const auto sinc = x < 1e-6f ? 1.f : std::sin(float(M_PI) * x) / (float(M_PI) * x);
+
+        return sinc * besselI0(KAISER_ALPHA * std::sqrt(1.f - ratio * ratio)) / besselI0(KAISER_ALPHA);
+    }
+
+    default:
+        return x < .5f ? 1.f : 0.f;
+    }
+}
+
+uint
+ImageResampler::grainSize(uint width)
+{
+    return std::max(GRAIN_SIZE / std::max(width, 1u), 1u);
+}
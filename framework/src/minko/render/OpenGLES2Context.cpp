@@ -30,6 +30,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/log/Logger.hpp" 
 
 #include <iomanip>
+#include <cstring>
 
 #ifndef GL_GLEXT_PROTOTYPES
 # define GL_GLEXT_PROTOTYPES
@@ -69,6 +70,43 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 # include <EGL/egl.h>
 #endif
 
+// instanced arrays entry points, depending on the extension exposed by the platform
+#if defined(MINKO_PLUGIN_ANGLE) || MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+# define MINKO_INSTANCED_ARRAYS_EXTENSION   "ANGLE_instanced_arrays"
+# define glVertexAttribDivisorInstancing    glVertexAttribDivisorANGLE
+# define glDrawElementsInstancing           glDrawElementsInstancedANGLE
+#elif MINKO_PLATFORM == MINKO_PLATFORM_IOS
+# define MINKO_INSTANCED_ARRAYS_EXTENSION   "EXT_instanced_arrays"
+# define glVertexAttribDivisorInstancing    glVertexAttribDivisorEXT
+# define glDrawElementsInstancing           glDrawElementsInstancedEXT
+#elif (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS && !defined(MINKO_PLUGIN_OFFSCREEN)) \
+    || MINKO_PLATFORM == MINKO_PLATFORM_LINUX || MINKO_PLATFORM == MINKO_PLATFORM_OSX
+# define MINKO_INSTANCED_ARRAYS_EXTENSION   "ARB_instanced_arrays"
+# define glVertexAttribDivisorInstancing    glVertexAttribDivisorARB
+# define glDrawElementsInstancing           glDrawElementsInstancedARB
+#endif
+
+#if (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS && !defined(MINKO_PLUGIN_ANGLE) && !defined(MINKO_PLUGIN_OFFSCREEN)) \
+    || MINKO_PLATFORM == MINKO_PLATFORM_LINUX
+# define MINKO_PIXEL_PACK_BUFFER
+#endif
+
+// program binaries entry points, depending on the extension exposed by the platform
+#if defined(MINKO_PLUGIN_ANGLE) || MINKO_PLATFORM == MINKO_PLATFORM_ANDROID
+# define MINKO_PROGRAM_BINARY_EXTENSION     "OES_get_program_binary"
+# define MINKO_PROGRAM_BINARY_LENGTH        GL_PROGRAM_BINARY_LENGTH_OES
+# define MINKO_NUM_PROGRAM_BINARY_FORMATS   GL_NUM_PROGRAM_BINARY_FORMATS_OES
+# define glGetProgramBinaryExtension        glGetProgramBinaryOES
+# define glProgramBinaryExtension           glProgramBinaryOES
+#elif (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS && !defined(MINKO_PLUGIN_OFFSCREEN)) \
+    || MINKO_PLATFORM == MINKO_PLATFORM_LINUX
+# define MINKO_PROGRAM_BINARY_EXTENSION     "ARB_get_program_binary"
+# define MINKO_PROGRAM_BINARY_LENGTH        GL_PROGRAM_BINARY_LENGTH
+# define MINKO_NUM_PROGRAM_BINARY_FORMATS   GL_NUM_PROGRAM_BINARY_FORMATS
+# define glGetProgramBinaryExtension        glGetProgramBinary
+# define glProgramBinaryExtension           glProgramBinary
+#endif
+
 using namespace minko;
 using namespace minko::render;
 
@@ -148,10 +186,16 @@ OpenGLES2Context::OpenGLES2Context() :
     _viewportHeight(0),
     _currentTarget(0),
     _currentIndexBuffer(0),
-    _currentVertexBuffer(8, 0),
-    _currentVertexSize(8, -1),
-    _currentVertexStride(8, -1),
-    _currentVertexOffset(8, -1),
+    _currentVertexBuffer(16, 0),
+    _currentVertexSize(16, -1),
+    _currentVertexStride(16, -1),
+    _currentVertexOffset(16, -1),
+    _currentVertexDivisor(16, 0),
+    _instancingSupported(false),
+    _pixelPackBufferSupported(false),
+    _programBinarySupported(false),
+    _nextPixelRead(0),
+    _pixelReads(),
     _currentBoundTexture(0),
     _currentTexture(8, 0),
     _currentProgram(0),
@@ -200,6 +244,25 @@ OpenGLES2Context::OpenGLES2Context() :
     _viewportWidth = viewportSettings[2];
     _viewportHeight = viewportSettings[3];
 
+#ifdef MINKO_INSTANCED_ARRAYS_EXTENSION
+    _instancingSupported = supportsExtension(MINKO_INSTANCED_ARRAYS_EXTENSION);
+#endif
+
+#ifdef MINKO_PIXEL_PACK_BUFFER
+    _pixelPackBufferSupported = supportsExtension("ARB_pixel_buffer_object") && supportsExtension("ARB_sync");
+#endif
+
+#ifdef MINKO_PROGRAM_BINARY_EXTENSION
+    if (supportsExtension(MINKO_PROGRAM_BINARY_EXTENSION))
+    {
+        // some drivers expose the extension without supporting any binary format
+        GLint numFormats = 0;
+
+        glGetIntegerv(MINKO_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        _programBinarySupported = numFormats > 0;
+    }
+#endif
+
     setColorMask(true);
     setDepthTest(true, CompareMode::LESS);
     setStencilTest(CompareMode::ALWAYS, 0, 0x1, StencilOperation::KEEP, StencilOperation::KEEP, StencilOperation::KEEP);
@@ -224,6 +287,16 @@ OpenGLES2Context::~OpenGLES2Context()
 
     for (auto& fragmentShader : _fragmentShaders)
         glDeleteShader(fragmentShader);
+
+#ifdef MINKO_PIXEL_PACK_BUFFER
+    for (auto& idAndRead : _pixelReads)
+    {
+        if (idAndRead.second.buffer != 0)
+            glDeleteBuffers(1, &idAndRead.second.buffer);
+        if (idAndRead.second.fence != nullptr)
+            glDeleteSync(static_cast<GLsync>(idAndRead.second.fence));
+    }
+#endif
 }
 
 void
@@ -333,6 +406,48 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
     checkForErrors();
 }
 
+void
+OpenGLES2Context::drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+    if (!_instancingSupported)
+        throw std::logic_error("Instanced rendering is not supported by this context.");
+
+    if (_currentIndexBuffer != indexBuffer)
+    {
+        _currentIndexBuffer = indexBuffer;
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    }
+
+#ifdef MINKO_INSTANCED_ARRAYS_EXTENSION
+    // https://www.khronos.org/registry/gles/extensions/ANGLE/ANGLE_instanced_arrays.txt
+    //
+    // behaves as if glDrawElements was called numInstances times, each vertex attribute
+    // with a non-zero divisor advancing once every divisor instances
+    glDrawElementsInstancing(GL_TRIANGLES, numTriangles * 3, GL_UNSIGNED_SHORT, (void*)0, numInstances);
+#endif
+
+    checkForErrors();
+}
+
+void
+OpenGLES2Context::setVertexAttributeDivisor(const uint position, const uint divisor)
+{
+    if (position >= _currentVertexDivisor.size() || _currentVertexDivisor[position] == divisor)
+        return;
+
+    if (!_instancingSupported)
+        throw std::logic_error("Instanced rendering is not supported by this context.");
+
+    _currentVertexDivisor[position] = divisor;
+
+#ifdef MINKO_INSTANCED_ARRAYS_EXTENSION
+    glVertexAttribDivisorInstancing(position, divisor);
+#endif
+
+    checkForErrors();
+}
+
 const uint
 OpenGLES2Context::createVertexBuffer(const uint size)
 {
@@ -980,6 +1095,11 @@ OpenGLES2Context::attachShader(const uint program, const uint shader)
 void
 OpenGLES2Context::linkProgram(const uint program)
 {
+#if defined(MINKO_PROGRAM_BINARY_EXTENSION) && defined(GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+    if (_programBinarySupported)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(program);
 
 #ifdef DEBUG
@@ -1004,6 +1124,58 @@ OpenGLES2Context::deleteProgram(const uint program)
     checkForErrors();
 }
 
+bool
+OpenGLES2Context::getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary)
+{
+#ifdef MINKO_PROGRAM_BINARY_EXTENSION
+    if (!_programBinarySupported)
+        return false;
+
+    GLint length = 0;
+
+    glGetProgramiv(program, MINKO_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return false;
+
+    GLenum binaryFormat = 0;
+    GLsizei numBytes = 0;
+
+    binary.resize(length);
+    glGetProgramBinaryExtension(program, length, &numBytes, &binaryFormat, &binary[0]);
+    binary.resize(numBytes);
+
+    format = binaryFormat;
+
+    checkForErrors();
+
+    return numBytes > 0;
+#else
+    return false;
+#endif
+}
+
+bool
+OpenGLES2Context::setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary)
+{
+#ifdef MINKO_PROGRAM_BINARY_EXTENSION
+    if (!_programBinarySupported || binary.empty())
+        return false;
+
+    GLint linkStatus = GL_FALSE;
+
+    glProgramBinaryExtension(program, format, &binary[0], binary.size());
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+
+    // a rejected binary is not an error: silently discard the one it may have raised
+    glGetError();
+
+    return linkStatus == GL_TRUE;
+#else
+    return false;
+#endif
+}
+
 void
 OpenGLES2Context::compileShader(const uint shader)
 {
@@ -1608,6 +1780,117 @@ OpenGLES2Context::readPixels(unsigned char* pixels)
     checkForErrors();
 }
 
+uint
+OpenGLES2Context::readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+    auto id = ++_nextPixelRead;
+    auto& read = _pixelReads[id];
+
+    read.x = x;
+    read.y = y;
+    read.width = width;
+    read.height = height;
+    read.target = _currentTarget;
+    read.buffer = 0;
+    read.fence = nullptr;
+
+#ifdef MINKO_PIXEL_PACK_BUFFER
+    if (_pixelPackBufferSupported)
+    {
+        // with a pixel pack buffer bound, glReadPixels() only queues the copy and returns right away
+        glGenBuffers(1, &read.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, width * height * 4, nullptr, GL_STREAM_READ);
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // make sure the fence reaches the GPU and eventually gets signaled
+        glFlush();
+
+        checkForErrors();
+
+        return id;
+    }
+#endif
+
+    // Without pixel pack buffers, reading a render texture is delayed until readPixelsAsyncResult() is
+    // called: the GPU is then very likely done with it and glReadPixels() does not stall the pipeline.
+    // The back buffer will not survive the next presentation and has to be read right away.
+    if (_currentTarget == 0)
+    {
+        read.pixels.resize(width * height * 4);
+        readPixels(x, y, width, height, &read.pixels[0]);
+    }
+
+    return id;
+}
+
+bool
+OpenGLES2Context::readPixelsAsyncResult(uint id, unsigned char* pixels)
+{
+    auto readIt = _pixelReads.find(id);
+
+    if (readIt == _pixelReads.end())
+        throw std::invalid_argument("read");
+
+    auto& read = readIt->second;
+    auto size = read.width * read.height * 4;
+
+#ifdef MINKO_PIXEL_PACK_BUFFER
+    if (read.buffer != 0)
+    {
+        auto fence = static_cast<GLsync>(read.fence);
+
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            return false;
+
+        glDeleteSync(fence);
+        read.fence = nullptr;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+
+        auto data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+
+        if (data != nullptr)
+        {
+            std::memcpy(pixels, data, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glDeleteBuffers(1, &read.buffer);
+        read.buffer = 0;
+
+        if (data == nullptr)
+        {
+            // the buffer could not be mapped: the next call reads the render target synchronously
+            checkForErrors();
+
+            return false;
+        }
+    }
+    else
+#endif
+    if (!read.pixels.empty())
+        std::memcpy(pixels, &read.pixels[0], size);
+    else if (_frameBuffers.count(read.target) != 0)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffers[read.target]);
+        glReadPixels(read.x, read.y, read.width, read.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glBindFramebuffer(GL_FRAMEBUFFER, _currentTarget != 0 ? _frameBuffers[_currentTarget] : 0);
+    }
+    else
+        // the render target was deleted in the meantime, or the back buffer could not be mapped
+        std::memset(pixels, 0, size);
+
+    _pixelReads.erase(readIt);
+
+    checkForErrors();
+
+    return true;
+}
+
 void
 OpenGLES2Context::setTriangleCulling(TriangleCulling triangleCulling)
 {
@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/DrawCall.hpp"
 #include "minko/render/States.hpp"
 #include "minko/render/ProgramSignature.hpp"
+#include "minko/render/ProgramCache.hpp"
 
 using namespace minko;
 using namespace minko::render;
@@ -44,6 +45,7 @@ Pass::Pass(const std::string&        name,
     _uniformBindings(uniformBindings),
     _stateBindings(stateBindings),
     _macroBindings(macroBindings),
+    _macroPropertyIds(),
     _states(states),
     _fallback(fallback),
     _signatureToProgram(),
@@ -52,8 +54,55 @@ Pass::Pass(const std::string&        name,
     _indexFunction(nullptr),
     _undefinedMacros(),
     _definedBoolMacros(),
-    _definedIntMacros()
+    _definedIntMacros(),
+    _programCache(nullptr),
+    _programSourceHash(0)
 {
+    _macroPropertyIds.reserve(_macroBindings.size());
+    for (const auto& macroBinding : _macroBindings)
+    {
+        const auto& propertyName = std::get<0>(macroBinding.second);
+
+        _macroPropertyIds.push_back(
+            propertyName.find("${") == std::string::npos ? PropertyId(propertyName) : PropertyId()
+        );
+    }
+}
+
+void
+Pass::programCache(std::shared_ptr<ProgramCache> cache)
+{
+    _programCache = cache;
+    _programSourceHash = cache ? ProgramCache::sourceHash(_programTemplate, _macroBindings) : 0;
+}
+
+void
+Pass::prewarm()
+{
+    if (!_programCache)
+        return;
+
+    if (_macroBindings.size() == 0)
+    {
+        finalizeProgram(_programTemplate, ProgramSignature(), "");
+
+        return;
+    }
+
+    std::list<ProgramCache::Variant> variants;
+
+    _programCache->variants(_programSourceHash, variants);
+
+    for (auto& variant : variants)
+    {
+        if (_signatureToProgram.count(variant.first) != 0)
+            continue;
+
+        auto program = createProgram(variant.second);
+
+        _signatureToProgram[variant.first] = program;
+        finalizeProgram(program, variant.first, variant.second);
+    }
 }
 
 std::shared_ptr<Program>
@@ -69,15 +118,14 @@ Pass::selectProgram(FormatNameFunction        formatNameFunc,
     integerMacros.clear();
     incorrectIntegerMacros.clear();
 
-    Program::Ptr program;
+    Program::Ptr        program;
+    std::string         defines = "";
+    ProgramSignature    signature;
 
     if (_macroBindings.size() == 0)
         program = _programTemplate;
     else
     {
-        std::string            defines = "";
-        ProgramSignature    signature;
-
         signature.build(
             shared_from_this(),
             formatNameFunc,
@@ -99,45 +147,60 @@ Pass::selectProgram(FormatNameFunction        formatNameFunc,
             program = foundProgramIt->second;
         else
         {
-            // compile a new shader program from template with macros
-
-#ifdef MINKO_NO_GLSL_STRUCT
-            defines += "#define MINKO_NO_GLSL_STRUCT\n";
-#endif // MINKO_NO_GLSL_STRUCT
-
-            auto vs = Shader::create(
-                _programTemplate->context(),
-                Shader::Type::VERTEX_SHADER,
-                defines + _programTemplate->vertexShader()->source()
-            );
-            auto fs = Shader::create(
-                _programTemplate->context(),
-                Shader::Type::FRAGMENT_SHADER,
-                defines + _programTemplate->fragmentShader()->source()
-            );
-
-            program                            = Program::create(_programTemplate->context(), vs, fs);
+            program                            = createProgram(defines);
             _signatureToProgram[signature]    = program;
         }
     }
 
-    return finalizeProgram(program);
+    return finalizeProgram(program, signature, defines);
+}
+
+Program::Ptr
+Pass::createProgram(const std::string& defines)
+{
+    // compile a new shader program from template with macros
+    auto programDefines = defines;
+
+#ifdef MINKO_NO_GLSL_STRUCT
+    programDefines += "#define MINKO_NO_GLSL_STRUCT\n";
+#endif // MINKO_NO_GLSL_STRUCT
+
+    auto vs = Shader::create(
+        _programTemplate->context(),
+        Shader::Type::VERTEX_SHADER,
+        programDefines + _programTemplate->vertexShader()->source()
+    );
+    auto fs = Shader::create(
+        _programTemplate->context(),
+        Shader::Type::FRAGMENT_SHADER,
+        programDefines + _programTemplate->fragmentShader()->source()
+    );
+
+    return Program::create(_programTemplate->context(), vs, fs);
 }
 
 Program::Ptr
-Pass::finalizeProgram(Program::Ptr program)
+Pass::finalizeProgram(Program::Ptr program, const ProgramSignature& signature, const std::string& defines)
 {
     if (program)
     {
         try
         {
-            if (!program->vertexShader()->isReady())
-                program->vertexShader()->upload();
-            if (!program->fragmentShader()->isReady())
-                program->fragmentShader()->upload();
             if (!program->isReady())
             {
-                program->upload();
+                // a program loaded from its binary does not need its shaders to be compiled
+                if (!_programCache || !_programCache->upload(program, _programSourceHash, defines))
+                {
+                    if (!program->vertexShader()->isReady())
+                        program->vertexShader()->upload();
+                    if (!program->fragmentShader()->isReady())
+                        program->fragmentShader()->upload();
+
+                    program->upload();
+
+                    if (_programCache)
+                        _programCache->store(program, _programSourceHash, signature, defines);
+                }
 
                 for (auto& func : _uniformFunctions)
                     func(program);
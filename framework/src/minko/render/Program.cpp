@@ -39,7 +39,8 @@ Program::Program(Program::AbstractContextPtr context) :
     _uniformFloat2(),
     _textures(),
     _vertexBuffers(),
-    _indexBuffer(nullptr)
+    _indexBuffer(nullptr),
+    _uniformsStamp(0)
 {
 }
 
@@ -52,6 +53,26 @@ Program::upload()
     _context->linkProgram(_id);
 
     _inputs = _context->getProgramInputs(_id);
+    _uniformsStamp = 0;
+}
+
+bool
+Program::upload(uint binaryFormat, const std::vector<unsigned char>& binary)
+{
+    _id = context()->createProgram();
+
+    if (!_context->setProgramBinary(_id, binaryFormat, binary))
+    {
+        _context->deleteProgram(_id);
+        _id = -1;
+
+        return false;
+    }
+
+    _inputs = _context->getProgramInputs(_id);
+    _uniformsStamp = 0;
+
+    return true;
 }
 
 void
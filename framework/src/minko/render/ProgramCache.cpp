@@ -0,0 +1,278 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ProgramCache.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Program.hpp"
+#include "minko/render/Shader.hpp"
+
+#include <fstream>
+
+using namespace minko;
+using namespace minko::render;
+
+/*static*/ const uint ProgramCache::MAGIC_NUMBER   = 0x4D4B5043; // MKPC
+/*static*/ const uint ProgramCache::VERSION        = 1;
+
+ProgramCache::ProgramCache(ContextPtr context, const std::string& filename) :
+    _context(context),
+    _filename(filename),
+    _entries(),
+    _changed(false)
+{
+    if (context == nullptr)
+        throw std::invalid_argument("context");
+}
+
+bool
+ProgramCache::upload(ProgramPtr program, uint64_t sourceHash, const std::string& defines)
+{
+    auto entryIt = _entries.find(key(sourceHash, defines));
+
+    if (entryIt == _entries.end() || entryIt->second.binary.empty())
+        return false;
+
+    auto& entry = entryIt->second;
+
+    if (program->upload(entry.binaryFormat, entry.binary))
+        return true;
+
+    // the driver changed without changing its info: the program will be stored again once built
+    entry.binary.clear();
+    _changed = true;
+
+    return false;
+}
+
+void
+ProgramCache::store(ProgramPtr                program,
+                    uint64_t                  sourceHash,
+                    const ProgramSignature&   signature,
+                    const std::string&        defines)
+{
+    auto entryKey = key(sourceHash, defines);
+    auto entryIt = _entries.find(entryKey);
+
+    if (entryIt != _entries.end() && !entryIt->second.binary.empty())
+        return;
+
+    auto& entry = _entries[entryKey];
+
+    entry.sourceHash = sourceHash;
+    entry.signature = signature;
+    entry.defines = defines;
+    entry.binaryFormat = 0;
+
+    // the variant is recorded even without a binary, to be built while loading the next time
+    auto hasBinary = _context->getProgramBinary(program->id(), entry.binaryFormat, entry.binary);
+
+    if (!hasBinary)
+        entry.binary.clear();
+
+    _changed = _changed || hasBinary || entryIt == _entries.end();
+}
+
+void
+ProgramCache::variants(uint64_t sourceHash, std::list<Variant>& variants) const
+{
+    variants.clear();
+
+    for (const auto& keyAndEntry : _entries)
+        if (keyAndEntry.second.sourceHash == sourceHash)
+            variants.push_back(Variant(keyAndEntry.second.signature, keyAndEntry.second.defines));
+}
+
+void
+ProgramCache::save()
+{
+    if (!_changed)
+        return;
+
+    std::ofstream file(_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file)
+        throw std::runtime_error("unable to write program cache '" + _filename + "'");
+
+    auto writeUInt = [&](uint value) { file.write(reinterpret_cast<const char*>(&value), sizeof(uint)); };
+    auto writeBytes = [&](const void* data, uint size)
+    {
+        writeUInt(size);
+        file.write(reinterpret_cast<const char*>(data), size);
+    };
+
+    const auto& driverInfo = _context->driverInfo();
+
+    writeUInt(MAGIC_NUMBER);
+    writeUInt(VERSION);
+    writeBytes(driverInfo.data(), driverInfo.size());
+    writeUInt(_entries.size());
+
+    for (const auto& keyAndEntry : _entries)
+    {
+        const auto& entry = keyAndEntry.second;
+        const auto& values = entry.signature.values();
+
+        file.write(reinterpret_cast<const char*>(&entry.sourceHash), sizeof(uint64_t));
+        writeUInt(entry.signature.mask());
+        writeBytes(values.data(), values.size() * sizeof(int));
+        writeBytes(entry.defines.data(), entry.defines.size());
+        writeUInt(entry.binaryFormat);
+        writeBytes(entry.binary.data(), entry.binary.size());
+    }
+
+    _changed = false;
+}
+
+void
+ProgramCache::load()
+{
+    std::ifstream file(_filename, std::ios::in | std::ios::binary);
+
+    if (!file)
+        return;
+
+    auto readUInt = [&]() -> uint
+    {
+        uint value = 0;
+
+        file.read(reinterpret_cast<char*>(&value), sizeof(uint));
+
+        return value;
+    };
+    auto readBytes = [&](std::vector<char>& bytes) -> bool
+    {
+        auto size = readUInt();
+
+        // a truncated file must not make us allocate an arbitrary amount of memory
+        if (!file || size > (1u << 28))
+            return false;
+
+        bytes.resize(size);
+        if (size != 0)
+            file.read(&bytes[0], size);
+
+        return !file.fail();
+    };
+
+    std::vector<char> bytes;
+
+    if (readUInt() != MAGIC_NUMBER || readUInt() != VERSION || !readBytes(bytes))
+        return;
+
+    auto sameDriver = std::string(bytes.begin(), bytes.end()) == _context->driverInfo();
+    auto numEntries = readUInt();
+
+    for (uint i = 0; i < numEntries && file; ++i)
+    {
+        Entry entry;
+        uint mask;
+        std::vector<int> values;
+
+        file.read(reinterpret_cast<char*>(&entry.sourceHash), sizeof(uint64_t));
+        mask = readUInt();
+
+        if (!readBytes(bytes))
+            break;
+        values.resize(bytes.size() / sizeof(int));
+        if (!values.empty())
+            std::memcpy(&values[0], &bytes[0], values.size() * sizeof(int));
+        entry.signature = ProgramSignature(mask, values);
+
+        if (!readBytes(bytes))
+            break;
+        entry.defines.assign(bytes.begin(), bytes.end());
+
+        entry.binaryFormat = readUInt();
+        if (!readBytes(bytes))
+            break;
+        if (sameDriver)
+            entry.binary.assign(bytes.begin(), bytes.end());
+
+        _entries[key(entry.sourceHash, entry.defines)] = entry;
+    }
+
+    // binaries of another driver are dropped, the file has to be written again
+    _changed = !sameDriver && !_entries.empty();
+}
+
+/*static*/
+uint64_t
+ProgramCache::sourceHash(ProgramPtr program, const data::MacroBindingMap& macroBindings)
+{
+    auto sourceHash = hash(
+        program->fragmentShader()->source(),
+        hash(program->vertexShader()->source(), 14695981039346656037ULL)
+    );
+
+    // the iteration order of the bindings depends on the standard library: hash them by name
+    std::vector<std::string> macroNames;
+
+    macroNames.reserve(macroBindings.size());
+    for (const auto& macroBinding : macroBindings)
+        macroNames.push_back(macroBinding.first);
+    std::sort(macroNames.begin(), macroNames.end());
+
+    for (const auto& macroName : macroNames)
+    {
+        const auto& macroBinding = macroBindings.at(macroName);
+        const auto& macroDefault = std::get<2>(macroBinding);
+        const auto defaultValue = macroDefault.semantic == data::MacroBindingDefaultValueSemantic::VALUE
+            ? macroDefault.value.value
+            : (macroDefault.semantic == data::MacroBindingDefaultValueSemantic::PROPERTY_EXISTS
+                ? int(macroDefault.value.propertyExists)
+                : 0);
+
+        sourceHash = hash(macroName, sourceHash);
+        sourceHash = hash(std::get<0>(macroBinding), sourceHash);
+        sourceHash = hash(
+            std::to_string(int(std::get<1>(macroBinding))) + ","
+            + std::to_string(int(macroDefault.semantic)) + ","
+            + std::to_string(defaultValue) + ","
+            + std::to_string(std::get<3>(macroBinding)) + ","
+            + std::to_string(std::get<4>(macroBinding)),
+            sourceHash
+        );
+    }
+
+    return sourceHash;
+}
+
+/*static*/
+uint64_t
+ProgramCache::hash(const std::string& value, uint64_t seed)
+{
+    // FNV-1a: unlike std::hash, it does not change with the standard library the application is built with
+    auto hash = seed;
+
+    for (auto c : value)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/*static*/
+uint64_t
+ProgramCache::key(uint64_t sourceHash, const std::string& defines)
+{
+    return hash(defines, sourceHash);
+}
@@ -56,13 +56,19 @@ ProgramSignature::build(Pass::Ptr                pass,
 
     pass->getExplicitDefinitions(explicitDefinitions);
 
-    unsigned int macroId    = 0;
+    const auto&  macroPropertyIds   = pass->macroPropertyIds();
+    unsigned int macroIndex         = 0;
+    unsigned int macroId            = 0;
     for (auto& macroBinding : pass->macroBindings())
     {
         const auto&    macroName        = macroBinding.first;
-        auto        macroDefault    = macroBinding.second;
+        const auto&    macroDefault    = macroBinding.second;
+        const auto&    macroPropertyId = macroPropertyIds[macroIndex++];
 
-        const auto& propertyName    = formatNameFunc(std::get<0>(macroDefault));
+        // only the property names with variables are formatted and interned for each signature
+        const auto  propertyName    = macroPropertyId != PropertyId()
+            ? macroPropertyId
+            : PropertyId(formatNameFunc(std::get<0>(macroDefault)));
         auto        source            = std::get<1>(macroDefault);
         auto        container        = source == BindingSource::TARGET
             ? targetData
@@ -77,7 +83,7 @@ ProgramSignature::build(Pass::Ptr                pass,
         {
             // no explicit definition
             macroExists        = container->hasProperty(propertyName);
-            isMacroInteger    = macroExists && container->propertyHasType<int>(propertyName, true);
+            isMacroInteger    = macroExists && container->propertyHasType<int>(propertyName);
             defaultMacro    = std::get<2>(macroBinding.second);
         }
         else
@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ReadbackQueue.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+ReadbackQueue::ReadbackQueue(ContextPtr context) :
+    _context(context),
+    _reads(),
+    _pixels()
+{
+    if (context == nullptr)
+        throw std::invalid_argument("context");
+}
+
+void
+ReadbackQueue::read(uint x, uint y, uint width, uint height, const Callback& callback)
+{
+    Read read;
+
+    read.id = _context->readPixelsAsync(x, y, width, height);
+    read.size = width * height * 4;
+    read.callback = callback;
+
+    _reads.push_back(read);
+}
+
+uint
+ReadbackQueue::update()
+{
+    // reads complete in order on the GPU, so the first pending one holds back the following ones
+    while (!_reads.empty())
+    {
+        auto read = _reads.front();
+
+        _pixels.resize(read.size);
+        if (!_context->readPixelsAsyncResult(read.id, read.size != 0 ? &_pixels[0] : nullptr))
+            break;
+
+        _reads.pop_front();
+
+        if (read.callback)
+            read.callback(_pixels);
+    }
+
+    return _reads.size();
+}
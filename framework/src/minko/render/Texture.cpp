@@ -44,7 +44,8 @@ Texture::Texture(AbstractContext::Ptr    context,
         resizeSmoothly,
         filename
     ),
-    _data()
+    _data(),
+    _firstMipLevel(0)
 {
 }
 
@@ -220,6 +221,50 @@ Texture::uploadMipLevel(uint            level,
     }
 }
 
+void
+Texture::uploadMipChain(uint                                            firstLevel,
+                        const std::vector<std::vector<unsigned char>>&  levels)
+{
+    if (levels.empty())
+        throw std::invalid_argument("levels");
+
+    const auto isCompressed = TextureFormatInfo::isCompressed(_format);
+
+    if (_id == -1)
+    {
+        const auto width    = std::max(_widthGPU >> firstLevel, 1u);
+        const auto height   = std::max(_heightGPU >> firstLevel, 1u);
+
+        _id = isCompressed
+            ? _context->createCompressedTexture(_type, _format, width, height, _mipMapping)
+            : _context->createTexture(_type, width, height, _mipMapping, _optimizeForRenderToTexture);
+    }
+
+    _firstMipLevel = firstLevel;
+
+    for (uint i = 0; i < levels.size(); ++i)
+    {
+        const auto level    = firstLevel + i;
+        const auto width    = std::max(_widthGPU >> level, TextureFormatInfo::minimumWidth(_format));
+        const auto height   = std::max(_heightGPU >> level, TextureFormatInfo::minimumHeight(_format));
+        auto data           = const_cast<unsigned char*>(levels[i].data());
+
+        if (isCompressed)
+            _context->uploadCompressedTexture2dData(_id, _format, width, height, levels[i].size(), i, data);
+        else
+            _context->uploadTexture2dData(_id, width, height, i, data);
+    }
+}
+
+uint
+Texture::mipLevelSize(uint level) const
+{
+    const auto width    = std::max(_widthGPU >> level, TextureFormatInfo::minimumWidth(_format));
+    const auto height   = std::max(_heightGPU >> level, TextureFormatInfo::minimumHeight(_format));
+
+    return TextureFormatInfo::textureSize(_format, width, height);
+}
+
 void
 Texture::dispose()
 {
@@ -0,0 +1,326 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/TextureStreamer.hpp"
+
+#include "minko/render/Texture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TextureStreamer::TextureStreamer(uint budget) :
+    _budget(budget),
+    _minResidentSize(64),
+    _maxUploadSize(4 * 1024 * 1024),
+    _entries(),
+    _frame(0),
+    _residentSize(0),
+    _numUploads(0),
+    _numEvictions(0)
+{
+}
+
+bool
+TextureStreamer::contains(AbsTexturePtr texture) const
+{
+    return find(texture) != nullptr;
+}
+
+void
+TextureStreamer::add(TexturePtr texture, uint numLevels, const MipLevelFunction& mipLevelFunction)
+{
+    if (texture == nullptr || texture->isReady())
+        throw std::invalid_argument("texture");
+    if (numLevels == 0)
+        throw std::invalid_argument("numLevels");
+    if (!mipLevelFunction)
+        throw std::invalid_argument("mipLevelFunction");
+
+    // a texture destroyed since the last update might have had the same address
+    remove(texture);
+
+    auto& entry = _entries[texture.get()];
+
+    entry.texture = texture;
+    entry.levelSizes.resize(numLevels);
+    for (uint i = 0; i < numLevels; ++i)
+        entry.levelSizes[i] = texture->mipLevelSize(i);
+    entry.mipMapping = texture->mipMapping();
+    entry.numLevels = numLevels;
+    entry.mipLevelFunction = mipLevelFunction;
+    entry.minLevel = 0;
+    while (entry.minLevel < numLevels - 1
+           && std::max(texture->width() >> entry.minLevel, texture->height() >> entry.minLevel) > _minResidentSize)
+        ++entry.minLevel;
+    entry.residentLevel = numLevels;
+    entry.residentSize = 0;
+    entry.targetLevel = entry.minLevel;
+    entry.requestedLevel = numLevels;
+    entry.lastUsed = _frame;
+
+    if (!upload(entry, entry.minLevel))
+    {
+        _entries.erase(texture.get());
+
+        throw std::logic_error("Unable to read the smallest mip levels of the texture.");
+    }
+}
+
+void
+TextureStreamer::remove(AbsTexturePtr texture)
+{
+    auto entryIt = _entries.find(texture.get());
+
+    if (entryIt == _entries.end())
+        return;
+
+    _residentSize -= entryIt->second.residentSize;
+    _entries.erase(entryIt);
+}
+
+void
+TextureStreamer::requestSize(AbsTexturePtr texture, float screenSize)
+{
+    auto entry = find(texture);
+
+    if (entry == nullptr)
+        return;
+
+    auto level = entry->numLevels - 1;
+
+    if (screenSize > 0.f)
+    {
+        const auto maxSize = float(std::max(texture->width(), texture->height()));
+        const auto ratio = maxSize / screenSize;
+
+        level = ratio <= 1.f ? 0 : std::min<uint>(uint(std::floor(std::log2(ratio))), level);
+    }
+
+    entry->requestedLevel = std::min(entry->requestedLevel, level);
+}
+
+uint
+TextureStreamer::residentLevel(AbsTexturePtr texture) const
+{
+    auto entry = find(texture);
+
+    if (entry == nullptr)
+        throw std::invalid_argument("texture");
+
+    return entry->residentLevel;
+}
+
+void
+TextureStreamer::update()
+{
+    removeDisposedTextures();
+
+    std::vector<Entry*> raised;
+
+    for (auto& textureAndEntry : _entries)
+    {
+        auto& entry = textureAndEntry.second;
+
+        if (entry.requestedLevel < entry.numLevels)
+        {
+            entry.targetLevel = entry.requestedLevel;
+            entry.requestedLevel = entry.numLevels;
+            entry.lastUsed = _frame;
+
+            if (entry.targetLevel < entry.residentLevel)
+                raised.push_back(&entry);
+        }
+    }
+
+    // the textures the farthest from their requested resolution are raised first
+    std::sort(raised.begin(), raised.end(), [](Entry* a, Entry* b)
+    {
+        return a->residentLevel - a->targetLevel > b->residentLevel - b->targetLevel;
+    });
+
+    uint uploadSize = 0;
+    uint raisedSize = 0;
+    uint numRaised = 0;
+
+    for (auto entry : raised)
+    {
+        const auto size = chainSize(*entry, entry->residentLevel - 1);
+
+        if (numRaised != 0 && uploadSize + size > _maxUploadSize)
+            break;
+
+        uploadSize += size;
+        raisedSize += size - chainSize(*entry, entry->residentLevel);
+        ++numRaised;
+    }
+    raised.resize(numRaised);
+
+    evict(raisedSize < _budget ? _budget - raisedSize : 0);
+
+    for (auto entry : raised)
+    {
+        const auto level = entry->residentLevel - 1;
+
+        if (_residentSize + chainSize(*entry, level) - chainSize(*entry, entry->residentLevel) <= _budget)
+            upload(*entry, level);
+    }
+
+    ++_frame;
+}
+
+TextureStreamer::Entry*
+TextureStreamer::find(AbsTexturePtr texture)
+{
+    auto entryIt = _entries.find(texture.get());
+
+    // the entry of a destroyed texture is only removed by the next update
+    return entryIt != _entries.end() && !entryIt->second.texture.expired() ? &entryIt->second : nullptr;
+}
+
+const TextureStreamer::Entry*
+TextureStreamer::find(AbsTexturePtr texture) const
+{
+    return const_cast<TextureStreamer*>(this)->find(texture);
+}
+
+void
+TextureStreamer::removeDisposedTextures()
+{
+    for (auto entryIt = _entries.begin(); entryIt != _entries.end();)
+    {
+        auto texture = entryIt->second.texture.lock();
+
+        if (texture != nullptr && texture->isReady())
+        {
+            ++entryIt;
+            continue;
+        }
+
+        _residentSize -= entryIt->second.residentSize;
+        entryIt = _entries.erase(entryIt);
+    }
+}
+
+TextureStreamer::Statistics
+TextureStreamer::statistics() const
+{
+    Statistics statistics;
+
+    statistics.numTextures = _entries.size();
+    statistics.numFullyResident = 0;
+    statistics.residentSize = _residentSize;
+    statistics.requestedSize = 0;
+    statistics.numUploads = _numUploads;
+    statistics.numEvictions = _numEvictions;
+
+    for (const auto& textureAndEntry : _entries)
+    {
+        const auto& entry = textureAndEntry.second;
+
+        if (entry.residentLevel == 0)
+            ++statistics.numFullyResident;
+        statistics.requestedSize += chainSize(entry, entry.targetLevel);
+    }
+
+    return statistics;
+}
+
+uint
+TextureStreamer::chainSize(const Entry& entry, uint level) const
+{
+    if (level >= entry.numLevels)
+        return 0;
+
+    const auto lastLevel = entry.mipMapping ? entry.numLevels : level + 1;
+    uint size = 0;
+
+    for (auto i = level; i < lastLevel; ++i)
+        size += entry.levelSizes[i];
+
+    return size;
+}
+
+bool
+TextureStreamer::upload(Entry& entry, uint level)
+{
+    auto texture = entry.texture.lock();
+
+    // disposed textures are not uploaded again, only the first upload creates the GPU texture
+    if (texture == nullptr || (!texture->isReady() && entry.residentLevel != entry.numLevels))
+        return false;
+
+    const auto numLevels = entry.mipMapping ? entry.numLevels - level : 1;
+    std::vector<std::vector<unsigned char>> levels(numLevels);
+
+    for (uint i = 0; i < numLevels; ++i)
+        if (!entry.mipLevelFunction(level + i, levels[i]))
+            return false;
+
+    texture->uploadMipChain(level, levels);
+
+    _residentSize -= entry.residentSize;
+    entry.residentSize = chainSize(entry, level);
+    _residentSize += entry.residentSize;
+    entry.residentLevel = level;
+    ++_numUploads;
+
+    return true;
+}
+
+void
+TextureStreamer::evict(uint budget)
+{
+    if (_residentSize <= budget)
+        return;
+
+    std::vector<Entry*> candidates;
+
+    for (auto& textureAndEntry : _entries)
+        candidates.push_back(&textureAndEntry.second);
+
+    // least recently used first, then largest first
+    std::sort(candidates.begin(), candidates.end(), [&](Entry* a, Entry* b)
+    {
+        return a->lastUsed != b->lastUsed
+            ? a->lastUsed < b->lastUsed
+            : chainSize(*a, a->residentLevel) > chainSize(*b, b->residentLevel);
+    });
+
+    for (auto entry : candidates)
+    {
+        if (_residentSize <= budget)
+            break;
+
+        // textures used during this frame are only lowered to their requested resolution
+        const auto maxLevel = entry->lastUsed == _frame
+            ? std::min(entry->targetLevel, entry->minLevel)
+            : entry->minLevel;
+        auto level = entry->residentLevel;
+        auto size = _residentSize;
+
+        while (level < maxLevel && size > budget)
+        {
+            size -= chainSize(*entry, level) - chainSize(*entry, level + 1);
+            ++level;
+        }
+
+        if (level != entry->residentLevel && upload(*entry, level))
+            ++_numEvictions;
+    }
+}
@@ -61,7 +61,7 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>        context,
     upload();
 }
 
-VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, float* begin, float* end) :
+VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, const float* begin, const float* end) :
     AbstractResource(context),
     _data(begin, end),
     _vertexSize(0),
@@ -83,7 +83,7 @@ VertexBuffer::upload(uint offset, uint numVertices)
         _id,
         offset * _vertexSize,
         numVertices == 0 ? _data.size() : numVertices * _vertexSize,
-        &_data[0]
+        &_data[offset * _vertexSize]
     );
 
     //updatePositionBounds();
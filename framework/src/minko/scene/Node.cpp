@@ -33,6 +33,8 @@ using namespace minko::scene;
 using namespace minko::component;
 
 unsigned int Node::_lastId = 0;
+unsigned int Node::_numBatches = 0;
+unsigned int Node::_numComponentTypes = 0;
 
 Node::Node() :
     _id(_lastId++),
@@ -41,8 +43,14 @@ Node::Node() :
     _parent(nullptr),
     _container(data::Container::create()),
     _data(data::StructureProvider::create("node")),
+    _batchDepth(0),
+    _batchAdded(),
+    _batchRemoved(),
+    _batchRemovedFrom(nullptr),
     _added(Signal<Ptr, Ptr, Ptr>::create()),
     _removed(Signal<Ptr, Ptr, Ptr>::create()),
+    _childrenAdded(ChildrenChangedSignal::create()),
+    _childrenRemoved(ChildrenChangedSignal::create()),
 	_componentAdded(Signal<Ptr, Ptr, Node::AbsCmpPtr>::create()),
 	_componentRemoved(Signal<Ptr, Ptr, Node::AbsCmpPtr>::create()),
     _layoutsChanged(Signal<Ptr, Ptr>::create()),
@@ -163,9 +171,16 @@ Node::layouts(Layouts value)
 Node::Ptr
 Node::addChild(Node::Ptr child)
 {
+    // pending notifications must reach the current ancestors of child before it moves
+    child->flushBatches();
+
     if (child->_parent)
         child->_parent->removeChild(child);
 
+    // a batch removing child from another node would notify its ancestors after they were told it was added here
+    if (child->_batchRemovedFrom != nullptr && child->_batchRemovedFrom.get() != this)
+        child->_batchRemovedFrom->flushBatch();
+
     _children.push_back(child);
 
     child->_parent = shared_from_this();
@@ -176,10 +191,21 @@ Node::addChild(Node::Ptr child)
     for (auto descendant : descendants->nodes())
         descendant->_added->execute(descendant, child, shared_from_this());
 
-    // bubble up
-    auto ancestors = NodeSet::create(shared_from_this())->ancestors(true);
-    for (auto ancestor : ancestors->nodes())
-        ancestor->_added->execute(ancestor, child, shared_from_this());
+    if (_batchDepth != 0)
+    {
+        auto removedIt = std::find(_batchRemoved.begin(), _batchRemoved.end(), child);
+
+        // removed then added back during the same batch: the ancestors don't have to know
+        if (removedIt != _batchRemoved.end())
+        {
+            _batchRemoved.erase(removedIt);
+            child->_batchRemovedFrom = nullptr;
+        }
+        else
+            _batchAdded.push_back(child);
+    }
+    else
+        notifyChildrenAdded(std::vector<Ptr>(1, child));
 
     return shared_from_this();
 }
@@ -192,6 +218,8 @@ Node::removeChild(Node::Ptr child)
     if (it == _children.end())
         throw std::invalid_argument("child");
 
+    child->flushBatches();
+
     _children.erase(it);
 
     child->_parent = nullptr;
@@ -202,10 +230,21 @@ Node::removeChild(Node::Ptr child)
     for (auto descendant : descendants->nodes())
         descendant->_removed->execute(descendant, child, shared_from_this());
 
-    // bubble up
-    auto ancestors = NodeSet::create(shared_from_this())->ancestors(true);
-    for (auto ancestor : ancestors->nodes())
-        ancestor->_removed->execute(ancestor, child, shared_from_this());
+    if (_batchDepth != 0)
+    {
+        auto addedIt = std::find(_batchAdded.begin(), _batchAdded.end(), child);
+
+        // added then removed during the same batch: the ancestors were never told it was added
+        if (addedIt != _batchAdded.end())
+            _batchAdded.erase(addedIt);
+        else
+        {
+            _batchRemoved.push_back(child);
+            child->_batchRemovedFrom = shared_from_this();
+        }
+    }
+    else
+        notifyChildrenRemoved(std::vector<Ptr>(1, child));
 
     return shared_from_this();
 }
@@ -215,12 +254,109 @@ Node::removeChildren()
 {
     int numChildren = _children.size();
 
+    beginBatch();
     for (int i = numChildren - 1; i >= 0; --i)
         removeChild(_children[i]);
+    commitBatch();
+
+    return shared_from_this();
+}
+
+Node::Ptr
+Node::addChildren(const std::vector<Ptr>& children)
+{
+    beginBatch();
+    for (auto child : children)
+        addChild(child);
+    commitBatch();
+
+    return shared_from_this();
+}
+
+Node::Ptr
+Node::beginBatch()
+{
+    if (_batchDepth++ == 0)
+        ++_numBatches;
 
     return shared_from_this();
 }
 
+Node::Ptr
+Node::commitBatch()
+{
+    if (_batchDepth == 0)
+        throw std::logic_error("commitBatch() must follow a call to beginBatch().");
+
+    if (--_batchDepth == 0)
+    {
+        --_numBatches;
+        flushBatch();
+    }
+
+    return shared_from_this();
+}
+
+void
+Node::flushBatches()
+{
+    if (_numBatches == 0)
+        return;
+
+    auto descendants = NodeSet::create(shared_from_this())->descendants(true);
+    for (auto descendant : descendants->nodes())
+        if (descendant->_batchDepth != 0)
+            descendant->flushBatch();
+}
+
+void
+Node::flushBatch()
+{
+    std::vector<Ptr> added;
+    std::vector<Ptr> removed;
+
+    added.swap(_batchAdded);
+    removed.swap(_batchRemoved);
+
+    for (auto child : removed)
+        child->_batchRemovedFrom = nullptr;
+
+    if (!removed.empty())
+        notifyChildrenRemoved(removed);
+    if (!added.empty())
+        notifyChildrenAdded(added);
+}
+
+void
+Node::notifyChildrenAdded(const std::vector<Ptr>& children)
+{
+    auto ancestors = NodeSet::create(shared_from_this())->ancestors(true);
+
+    // bubble up
+    for (auto ancestor : ancestors->nodes())
+    {
+        for (auto child : children)
+            ancestor->_added->execute(ancestor, child, shared_from_this());
+
+        ancestor->_childrenAdded->execute(ancestor, children, shared_from_this());
+    }
+}
+
+void
+Node::notifyChildrenRemoved(const std::vector<Ptr>& children)
+{
+    auto ancestors = NodeSet::create(shared_from_this())->ancestors(true);
+
+    // bubble up
+    for (auto ancestor : ancestors->nodes())
+    {
+        for (auto child : children)
+            ancestor->_removed->execute(ancestor, child, shared_from_this());
+
+        ancestor->_childrenRemoved->execute(ancestor, children, shared_from_this());
+    }
+}
+
 bool
 Node::contains(Node::Ptr node)
 {
@@ -237,6 +373,7 @@ Node::addComponent(std::shared_ptr<AbstractComponent> component)
         throw std::logic_error("The same component cannot be added twice.");
 
     _components.push_back(component);
+    addTypedComponent(component);
     component->_targets.push_back(shared_from_this());
 
     component->targetAdded()->execute(component, shared_from_this());
@@ -266,6 +403,7 @@ Node::removeComponent(std::shared_ptr<AbstractComponent> component)
         throw std::invalid_argument("component");
 
     _components.erase(it);
+    removeTypedComponent(component);
     component->_targets.erase(
         std::find(component->_targets.begin(), component->_targets.end(), shared_from_this())
     );
@@ -291,6 +429,35 @@ Node::hasComponent(std::shared_ptr<AbstractComponent> component)
     return std::find(_components.begin(), _components.end(), component) != _components.end();
 }
 
+void
+Node::addTypedComponent(AbsCmpPtr component)
+{
+    // only the types component matches are touched
+    for (auto& typedComponents : _typedComponents)
+    {
+        auto typedComponent = typedComponents.cast(component);
+
+        if (typedComponent != nullptr)
+            typedComponents.components.push_back(typedComponent);
+    }
+}
+
+void
+Node::removeTypedComponent(AbsCmpPtr component)
+{
+    for (auto& typedComponents : _typedComponents)
+    {
+        auto typedComponent = typedComponents.cast(component);
+
+        if (typedComponent != nullptr)
+            typedComponents.components.erase(std::find(
+                typedComponents.components.begin(),
+                typedComponents.components.end(),
+                typedComponent
+            ));
+    }
+}
+
 void
 Node::updateRoot()
 {
@@ -106,6 +106,10 @@ namespace minko
 
             Assimp::Importer*                                       _importer;
 
+            std::string                                             _resolvedFilename;
+            const aiScene*                                          _scene;
+            std::vector<Error>                                      _decodingErrors;
+
         public:
 
             virtual ~AbstractASSIMPParser();
@@ -117,6 +121,26 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary);
 
+            // decode() reads the sub-files of the scene through the asset library and a synchronous Loader:
+            // it must run on the main thread
+            inline
+            bool
+            threadSafe() const
+            {
+                return false;
+            }
+
+            void
+            decode(std::shared_ptr<File> file, std::shared_ptr<Options> options);
+
+            void
+            commit(std::shared_ptr<File>            file,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary);
+
+            uint
+            stagedSize() const;
+
         protected:
 
             AbstractASSIMPParser();
@@ -129,6 +153,16 @@ namespace minko
             TextureTypeToName
             initializeTextureTypeToName();
 
+            void
+            decode(const std::string&           filename,
+                   const std::string&           resolvedFilename,
+                   std::shared_ptr<Options>     options,
+                   const unsigned char*         data,
+                   std::size_t                  size);
+
+            void
+            commit(std::shared_ptr<AssetLibrary> assetLibrary);
+
             void
             initImporter();
 
@@ -112,7 +112,10 @@ AbstractASSIMPParser::AbstractASSIMPParser() :
     _meshNames(),
     _loaderCompleteSlots(),
     _loaderErrorSlots(),
-    _importer(nullptr)
+    _importer(nullptr),
+    _resolvedFilename(),
+    _scene(nullptr),
+    _decodingErrors()
 {
 }
 
@@ -131,6 +134,47 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
     std::cout << "AbstractASSIMPParser::parse()" << std::endl;
 #endif // DEBUG
 
+    decode(filename, resolvedFilename, options, data.data(), data.size());
+    commit(assetLibrary);
+}
+
+void
+AbstractASSIMPParser::decode(std::shared_ptr<File> file, std::shared_ptr<Options> options)
+{
+    decode(file->filename(), file->resolvedFilename(), options, file->bytes(), file->size());
+}
+
+void
+AbstractASSIMPParser::commit(std::shared_ptr<File>            file,
+                             std::shared_ptr<Options>         options,
+                             std::shared_ptr<AssetLibrary>    assetLibrary)
+{
+    commit(assetLibrary);
+}
+
+uint
+AbstractASSIMPParser::stagedSize() const
+{
+    if (_scene == nullptr)
+        return 0;
+
+    uint size = 0;
+
+    // estimate the vertex buffers with positions, normals and uvs and the 16 bits index buffers
+    for (uint i = 0; i < _scene->mNumMeshes; ++i)
+        size += _scene->mMeshes[i]->mNumVertices * 8 * sizeof(float)
+            + _scene->mMeshes[i]->mNumFaces * 3 * sizeof(unsigned short);
+
+    return size;
+}
+
+void
+AbstractASSIMPParser::decode(const std::string&           filename,
+                             const std::string&           resolvedFilename,
+                             std::shared_ptr<Options>     options,
+                             const unsigned char*         data,
+                             std::size_t                  size)
+{
     resetParser();
     initImporter();
 
@@ -143,19 +187,20 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
         options->includePaths().push_front(resolvedFilename.substr(0, pos));
     }
 
-    _filename        = filename;
-    _assetLibrary    = assetLibrary;
-    _options        = options;
+    _filename           = filename;
+    _resolvedFilename   = resolvedFilename;
+    _options            = options;
 
     //fixme : find a way to handle loading dependencies asynchronously
     auto ioHandlerOptions = options->clone();
     ioHandlerOptions->loadAsynchronously(false);
 
-    auto ioHandler = new IOHandler(ioHandlerOptions, _assetLibrary);
+    auto ioHandler = new IOHandler(ioHandlerOptions, options->assetLibrary());
 
+    // errors are collected and reported by commit()
     ioHandler->errorFunction([this](IOHandler& self, const Error& error) -> void
     {
-        this->error()->execute(shared_from_this(), error);
+        _decodingErrors.push_back(error);
     });
 
     _importer->SetIOHandler(ioHandler);
@@ -164,9 +209,9 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
     std::cout << "AbstractASSIMPParser: preparing to parse" << std::endl;
 #endif // DEBUG
 
-    const aiScene* scene = _importer->ReadFileFromMemory(
-        &data[0],
-        data.size(),
+    _scene = _importer->ReadFileFromMemory(
+        data,
+        size,
         //| aiProcess_GenSmoothNormals // assertion is raised by assimp
         aiProcess_JoinIdenticalVertices
         | aiProcess_GenSmoothNormals
@@ -181,21 +226,33 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
         resolvedFilename.c_str()
     );
 
-    if (!scene)
-        _error->execute(shared_from_this(), Error(_importer->GetErrorString()));
+    if (!_scene)
+        _decodingErrors.push_back(Error(_importer->GetErrorString()));
 
 #ifdef DEBUG
     std::cout << "AbstractASSIMPParser: scene parsed" << std::endl;
 #endif // DEBUG
+}
+
+void
+AbstractASSIMPParser::commit(std::shared_ptr<AssetLibrary> assetLibrary)
+{
+    _assetLibrary = assetLibrary;
+
+    for (const auto& error : _decodingErrors)
+        _error->execute(shared_from_this(), error);
 
-    parseDependencies(resolvedFilename, scene);
+    if (!_scene)
+        return;
+
+    parseDependencies(_resolvedFilename, _scene);
 
 #ifdef DEBUG
     std::cout << "AbstractASSIMPParser: " << _numDependencies << " dependencies to load..." << std::endl;
 #endif // DEBUG
 
     if (_numDependencies == 0)
-        allDependenciesLoaded(scene);
+        allDependenciesLoaded(_scene);
 }
 
 void
@@ -282,6 +339,10 @@ AbstractASSIMPParser::createSceneTree(scene::Node::Ptr                 minkoNode
         createMeshSurface(minkoNode, scene, aimesh);
     }
 
+    std::vector<Node::Ptr> children;
+
+    children.reserve(ainode->mNumChildren);
+
     // traverse the node's children
     for (uint i = 0; i < ainode->mNumChildren; i++)
     {
@@ -299,8 +360,10 @@ AbstractASSIMPParser::createSceneTree(scene::Node::Ptr                 minkoNode
         //Recursive call
         createSceneTree(childNode, scene, aichild, assets);
 
-        minkoNode->addChild(childNode);
+        children.push_back(childNode);
     }
+
+    minkoNode->addChildren(children);
 }
 
 void
@@ -719,7 +782,10 @@ AbstractASSIMPParser::resetParser()
     _numDependencies        = 0;
     _numLoadedDependencies    = 0;
     _filename.clear();
+    _resolvedFilename.clear();
     _symbol    = nullptr;
+    _scene    = nullptr;
+    _decodingErrors.clear();
 
     disposeNodeMaps();
 }
@@ -884,16 +950,23 @@ AbstractASSIMPParser::createSkin(const aiMesh* aimesh)
         _alreadyAnimatedNodes.insert(n);
     }
 
+    skeletonRoot->beginBatch();
     for (auto& n : slaves) // FIXME
     {
         if (n->parent())
             n->parent()->removeChild(n);
         skeletonRoot->addChild(n);
     }
+    skeletonRoot->commitBatch();
+
+    skin->reorganizeByVertices()->transposeMatrices();
+
+    if (_options->skinningCompressionTolerance() > 0.0f)
+        skin->compress(_options->skinningCompressionTolerance());
 
     // add skinning component to mesh
     meshNode->addComponent(Skinning::create(
-		skin->reorganizeByVertices()->transposeMatrices(),
+		skin,
         _options->skinningMethod(),
         _assetLibrary->context(),
         skeletonRoot
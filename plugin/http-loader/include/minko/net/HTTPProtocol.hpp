@@ -73,9 +73,6 @@ namespace minko
             progressHandler(void*, int, int);
 
         protected:
-            std::list<Any>
-            _workerSlots;
-
             static
             std::list<std::shared_ptr<HTTPProtocol>>
             _runningLoaders;
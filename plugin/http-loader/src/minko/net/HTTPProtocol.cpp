@@ -142,7 +142,7 @@ HTTPProtocol::load()
         auto seekingOffset = _options->seekingOffset();
         auto seekedLength = _options->seekedLength();
 
-        if (seekingOffset >= 0 && seekedLength > 0)
+        if (seekedLength > 0)
         {
             auto rangeMin = std::to_string(seekingOffset);
             auto rangeMax = std::to_string(seekingOffset + seekedLength - 1);
@@ -176,7 +176,7 @@ HTTPProtocol::load()
         auto seekingOffset = _options->seekingOffset();
         auto seekedLength = _options->seekedLength();
 
-        if (seekingOffset >= 0 && seekedLength > 0)
+        if (seekedLength > 0)
         {
             auto rangeMin = std::to_string(seekingOffset);
             auto rangeMax = std::to_string(seekingOffset + seekedLength - 1);
@@ -223,24 +223,23 @@ HTTPProtocol::load()
     {
         auto worker = AbstractCanvas::defaultCanvas()->getWorker("http");
 
-        _workerSlots.push_back(worker->message()->connect([=](Worker::Ptr, Worker::Message message) {
+        std::vector<char> input(resolvedFilename().begin(), resolvedFilename().end());
+
+        worker->start(input, [=](const Worker::Message& message) {
             if (message.type == "complete")
             {
-                completeHandler(loader.get(), &*message.data.begin(), message.data.size());
+                completeHandler(loader.get(), const_cast<char*>(message.data.data()), message.data.size());
             }
             else if (message.type == "progress")
             {
-                float ratio = *reinterpret_cast<float*>(&*message.data.begin());
+                float ratio = *reinterpret_cast<const float*>(message.data.data());
                 progressHandler(loader.get(), int(ratio * 100.f), 100);
             }
             else if (message.type == "error")
             {
                 errorHandler(loader.get());
             }
-        }));
-
-        std::vector<char> input(resolvedFilename().begin(), resolvedFilename().end());
-        worker->start(input);
+        });
     }
     else
     {
@@ -35,7 +35,7 @@ namespace minko
             auto _0 = request.progress()->connect([&](float p) {
                 Message message { "progress" };
                 message.set(p);
-                post(message);
+                post(std::move(message));
             });
 
             auto _1 = request.error()->connect([&](int e) {
@@ -45,7 +45,7 @@ namespace minko
             auto _2 = request.complete()->connect([&](const std::vector<char>& output) {
                 Message message { "complete" };
                 message.set(output);
-                post(message);
+                post(std::move(message));
             });
 
             request.run();
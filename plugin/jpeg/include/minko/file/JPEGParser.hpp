@@ -34,6 +34,12 @@ namespace minko
         public:
             typedef std::shared_ptr<JPEGParser> Ptr;
 
+        private:
+            unsigned char*              _pixels;
+            int                         _width;
+            int                         _height;
+            int                         _numComponents;
+
         public:
             inline static
             Ptr
@@ -49,10 +55,45 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>    AssetLibrary);
 
-        private:
-            JPEGParser()
+            void
+            parseFile(std::shared_ptr<File>             file,
+                      std::shared_ptr<Options>          options,
+                      std::shared_ptr<AssetLibrary>     assetLibrary);
+
+            inline
+            bool
+            threadSafe() const
             {
+                return true;
             }
+
+            void
+            decode(std::shared_ptr<File> file, std::shared_ptr<Options> options);
+
+            void
+            commit(std::shared_ptr<File>            file,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary);
+
+            inline
+            uint
+            stagedSize() const
+            {
+                return _pixels != nullptr ? _width * _height * _numComponents : 0;
+            }
+
+            ~JPEGParser();
+
+        private:
+            JPEGParser();
+
+            void
+            decode(const std::string& filename, const unsigned char* data, std::size_t size);
+
+            void
+            commit(const std::string&               filename,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary);
         };
     }
 }
@@ -17,7 +17,7 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-#include "JPEGParser.hpp"
+#include "minko/file/JPEGParser.hpp"
 
 #include "minko/file/Options.hpp"
 #include "minko/file/AssetLibrary.hpp"
@@ -29,6 +29,20 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::file;
 
+JPEGParser::JPEGParser() :
+    _pixels(nullptr),
+    _width(0),
+    _height(0),
+    _numComponents(0)
+{
+}
+
+JPEGParser::~JPEGParser()
+{
+    if (_pixels != nullptr)
+        free(_pixels);
+}
+
 void
 JPEGParser::parse(const std::string&                filename,
                   const std::string&                resolvedFilename,
@@ -36,20 +50,60 @@ JPEGParser::parse(const std::string&                filename,
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary)
 {
-    int width;
-    int height;
-    int comps;
+    decode(filename, data.data(), data.size());
+    commit(filename, options, assetLibrary);
+}
+
+void
+JPEGParser::parseFile(std::shared_ptr<File>             file,
+                      std::shared_ptr<Options>          options,
+                      std::shared_ptr<AssetLibrary>     assetLibrary)
+{
+    decode(file->filename(), file->bytes(), file->size());
+    commit(file->filename(), options, assetLibrary);
+}
+
+void
+JPEGParser::decode(std::shared_ptr<File> file, std::shared_ptr<Options> options)
+{
+    decode(file->filename(), file->bytes(), file->size());
+}
 
+void
+JPEGParser::commit(std::shared_ptr<File>            file,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary)
+{
+    commit(file->filename(), options, assetLibrary);
+}
+
+void
+JPEGParser::decode(const std::string& filename, const unsigned char* data, std::size_t size)
+{
     // Loads a JPEG image from a memory buffer.
     // req_comps can be 1 (grayscale), 3 (RGB), or 4 (RGBA).
     // On return, width/height will be set to the image's dimensions, and actual_comps will be set
     // to either 1 (grayscale) or 3 (RGB).
-    auto bmpData = jpgd::decompress_jpeg_image_from_memory(
-        (const unsigned char*)&data[0], data.size(), &width, &height, &comps, 3
+    _pixels = jpgd::decompress_jpeg_image_from_memory(
+        data, int(size), &_width, &_height, &_numComponents, 3
     );
+}
+
+void
+JPEGParser::commit(const std::string&               filename,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary)
+{
+    if (_pixels == nullptr)
+    {
+        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error"));
+        _complete->execute(shared_from_this());
+
+        return;
+    }
 
     auto format = render::TextureFormat::RGBA;
-    if (comps == 3 || comps == 1)
+    if (_numComponents == 3 || _numComponents == 1)
         format    = render::TextureFormat::RGB;
 
     render::AbstractTexture::Ptr texture = nullptr;
@@ -58,8 +112,8 @@ JPEGParser::parse(const std::string&                filename,
     {
         auto texture2d = render::Texture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -74,8 +128,8 @@ JPEGParser::parse(const std::string&                filename,
     {
         auto cubeTexture = render::CubeTexture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -87,12 +141,13 @@ JPEGParser::parse(const std::string&                filename,
         assetLibrary->cubeTexture(filename, cubeTexture);
     }
 
-    texture->data(bmpData);
+    texture->data(_pixels);
     texture->upload();
     if (options->disposeTextureAfterLoading())
         texture->disposeData();
 
-    free(bmpData);
+    free(_pixels);
+    _pixels = nullptr;
 
     complete()->execute(shared_from_this());
 }
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/component/ParticleSystem.hpp"
 #include "minko/data/ParticlesProvider.hpp"
+#include "minko/particle/ParticlePool.hpp"
 #include "minko/particle/StartDirection.hpp"
 #include "minko/particle/modifier/IParticleModifier.hpp"
 #include "minko/particle/modifier/Modifier1.hpp"
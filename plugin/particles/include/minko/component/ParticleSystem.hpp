@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/geometry/ParticlesGeometry.hpp"
 #include "minko/particle/ParticleData.hpp"
+#include "minko/particle/ParticlePool.hpp"
 
 namespace minko
 {
@@ -57,6 +58,7 @@ namespace minko
             typedef std::shared_ptr<particle::modifier::IParticleInitializer>    IInitializerPtr;
             typedef std::shared_ptr<particle::modifier::IParticleUpdater>        IUpdaterPtr;
             typedef std::shared_ptr<particle::modifier::IParticleModifier>        ModifierPtr;
+            typedef std::shared_ptr<particle::ParticlePool>                        ParticlePoolPtr;
 
         private:
             class ParticleDistanceToCameraComparison
@@ -75,6 +77,8 @@ namespace minko
 
         private:
             static const unsigned int                                     COUNT_LIMIT;
+            static const unsigned int                                     PARALLEL_UPDATE_GRAIN_SIZE;
+            static const unsigned int                                     MAX_SORT_MOVES_PER_PARTICLE;
 
             GeometryPtr                                                    _geometry;
             ParticlesProviderPtr                                        _material;
@@ -86,16 +90,17 @@ namespace minko
             unsigned int                                                _countLimit;
             unsigned int                                                _maxCount;
             //unsigned int                                                _liveCount;
-            unsigned int                                                _previousLiveCount;
             std::vector<IInitializerPtr>                                 _initializers;
             std::vector<IUpdaterPtr>                                     _updaters;
-            std::vector<particle::ParticleData>                            _particles;
+            ParticlePoolPtr                                                _particles;
+            unsigned int                                                _parallelUpdateThreshold;
             std::vector<unsigned int>                                    _particleOrder;
             std::vector<float>                                            _particleDistanceToCamera;
 
             bool                                                        _isInWorldSpace;
             float                                                         _localToWorld[16];
             bool                                                        _isZSorted;
+            unsigned int                                                _numSortedParticles;
             float                                                         _cameraCoords[3];
             ParticleDistanceToCameraComparison                            _comparisonObject;
             bool                                                        _useOldPosition;
@@ -384,14 +389,45 @@ namespace minko
             };
 
             inline
-            std::vector<particle::ParticleData>&
-            getParticles()
+            ParticlePoolPtr
+            particles() const
             {
                 return _particles;
             };
 
+            /**
+             * @deprecated Use particles(): particles are now stored in a particle::ParticlePool.
+             */
+            inline
+            ParticlePoolPtr
+            getParticles() const
+            {
+                return particles();
+            };
+
+            /**
+             * Number of live particles from which updates are split across the threads of
+             * async::ThreadPool::instance(). 0, the default, always updates on the calling thread.
+             * Samplers used by the updaters must then be safe to call concurrently.
+             */
+            inline
+            Ptr
+            parallelUpdateThreshold(unsigned int value)
+            {
+                _parallelUpdateThreshold = value;
+
+                return std::static_pointer_cast<ParticleSystem>(shared_from_this());
+            }
+
+            inline
+            unsigned int
+            parallelUpdateThreshold() const
+            {
+                return _parallelUpdateThreshold;
+            }
+
             void
-            createParticle(unsigned int                         particleIndex,
+            createParticle(particle::ParticleData&                particle,
                            const particle::shape::EmitterShape&    emitter,
                            float                                timeLived);
 
@@ -416,21 +452,18 @@ namespace minko
             void
             addComponents(unsigned int components, bool blockVSInit = false);
 
-            inline
             void
-            setInVertexBuffer(float* ptr, unsigned int offset, float value)
-            {
-                unsigned int idx = offset;
-                for (unsigned int i = 0; i < 4; ++i)
-                {
-                    ptr[idx] = value;
-                    idx += _geometry->vertexSize();
-                }
-            };
+            parallelFor(unsigned int begin, unsigned int end, const std::function<void(unsigned int, unsigned int)>& function);
+
+            void
+            setInVertexBuffer(float* ptr, unsigned int offset, float value);
 
             void
             updateVertexBuffer();
 
+            void
+            sortParticles();
+
         protected:
             ParticleSystem(AssetLibraryPtr,
                            float                    rate,
@@ -26,6 +26,13 @@ namespace minko
 {
     namespace geometry
     {
+        /**
+         * Quads of the particles. The geometry itself only stores the offsets of the corners of the quads,
+         * each particle attribute is written once per particle in particleVertices() and bound to the
+         * effect through the "instancing" provider of particlesData(). When the context supports
+         * instancing, a single quad is drawn once per particle. Otherwise, the attributes of each particle
+         * are repeated for the 4 corners of its own quad.
+         */
         class ParticlesGeometry :
             public Geometry
         {
@@ -34,10 +41,17 @@ namespace minko
 
             typedef std::shared_ptr<render::ParticleVertexBuffer>    VertexBufferPtr;
             typedef std::shared_ptr<render::ParticleIndexBuffer>    IndexBufferPtr;
+            typedef std::shared_ptr<data::StructureProvider>        ProviderPtr;
 
         private:
-            VertexBufferPtr    _particleVertices;
-            IndexBufferPtr    _particleIndices;
+            bool                        _instanced;
+            VertexBufferPtr             _quadVertices;
+            VertexBufferPtr             _particleVertices;
+            IndexBufferPtr              _particleIndices;
+            ProviderPtr                 _particlesData;
+            std::vector<std::string>    _particleAttributes;
+            unsigned int                _maxParticles;
+            unsigned int                _numParticles;
 
         public:
             inline static
@@ -54,6 +68,20 @@ namespace minko
             void
             initStreams(unsigned int maxParticles);
 
+            inline
+            bool
+            instanced() const
+            {
+                return _instanced;
+            }
+
+            inline
+            unsigned int
+            verticesPerParticle() const
+            {
+                return _instanced ? 1 : 4;
+            }
+
             inline
             VertexBufferPtr
             particleVertices() const
@@ -61,9 +89,31 @@ namespace minko
                 return _particleVertices;
             }
 
+            inline
+            ProviderPtr
+            particlesData() const
+            {
+                return _particlesData;
+            }
+
+            /**
+             * Updates the bindings of particlesData() after attributes were added to or removed from
+             * particleVertices().
+             */
+            void
+            bindParticleVertices();
+
+            /**
+             * Draws the particles stored in the first numParticles slots of particleVertices().
+             */
+            void
+            numParticles(unsigned int numParticles);
+
         protected:
+            ParticlesGeometry();
+
             void
             initialize(std::shared_ptr<render::AbstractContext> context);
         };
     }
-}
\ No newline at end of file
+}
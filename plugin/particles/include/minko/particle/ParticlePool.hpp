@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/ParticlesCommon.hpp"
+
+namespace minko
+{
+    namespace particle
+    {
+        /**
+         * Particles stored as structure of arrays: one contiguous column of floats per attribute. Live
+         * particles are kept packed at the beginning of every column, in the [0, numAlive()) range, so
+         * that updaters can run vectorized loops over column spans without ever visiting dead particles.
+         */
+        class ParticlePool
+        {
+        public:
+            typedef std::shared_ptr<ParticlePool>   Ptr;
+
+            enum Attribute
+            {
+                X = 0,
+                Y,
+                Z,
+                OLD_X,
+                OLD_Y,
+                OLD_Z,
+                VELOCITY_X,
+                VELOCITY_Y,
+                VELOCITY_Z,
+                FORCE_X,
+                FORCE_Y,
+                FORCE_Z,
+                R,
+                G,
+                B,
+                SIZE,
+                ROTATION,
+                ANGULAR_VELOCITY,
+                LIFETIME,
+                TIME_LIVED,
+                SPRITE_INDEX,
+                NUM_ATTRIBUTES
+            };
+
+        private:
+            unsigned int                            _capacity;
+            unsigned int                            _stride;        // column size, rounded to 4 floats
+            unsigned int                            _numAlive;
+            std::vector<float>                      _data;          // NUM_ATTRIBUTES columns of _stride floats
+
+        public:
+            inline static
+            Ptr
+            create(unsigned int capacity = 0)
+            {
+                return std::shared_ptr<ParticlePool>(new ParticlePool(capacity));
+            }
+
+            inline
+            unsigned int
+            capacity() const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Resizes every column. Live particles beyond the new capacity are discarded.
+             */
+            void
+            capacity(unsigned int value);
+
+            inline
+            unsigned int
+            numAlive() const
+            {
+                return _numAlive;
+            }
+
+            inline
+            float*
+            column(Attribute attribute)
+            {
+                return _data.data() + attribute * _stride;
+            }
+
+            inline
+            const float*
+            column(Attribute attribute) const
+            {
+                return _data.data() + attribute * _stride;
+            }
+
+            /**
+             * Appends a live particle and returns its index, or throws when the pool is full.
+             */
+            unsigned int
+            spawn(const ParticleData& particle);
+
+            void
+            get(unsigned int particleIndex, ParticleData& particle) const;
+
+            void
+            set(unsigned int particleIndex, const ParticleData& particle);
+
+            /**
+             * Moves the last live particle in the slot of the killed one.
+             */
+            void
+            kill(unsigned int particleIndex);
+
+            /**
+             * Kills every particle that lived longer than its lifetime and returns how many were.
+             */
+            unsigned int
+            killExpired();
+
+            inline
+            void
+            clear()
+            {
+                _numAlive = 0;
+            }
+
+            /**
+             * Adds timeStep to the age of the particles in [begin, end) and saves their current position.
+             */
+            void
+            age(unsigned int begin, unsigned int end, float timeStep);
+
+            /**
+             * Integrates forces, velocities and angular velocities of the particles in [begin, end).
+             */
+            void
+            integrate(unsigned int begin, unsigned int end, float timeStep);
+
+            /**
+             * values[i] += factors[i] * k for every i in [begin, end).
+             */
+            static
+            void
+            multiplyAdd(float* values, const float* factors, float k, unsigned int begin, unsigned int end);
+
+            /**
+             * values[i] += k for every i in [begin, end).
+             */
+            static
+            void
+            add(float* values, float k, unsigned int begin, unsigned int end);
+
+        private:
+            ParticlePool(unsigned int capacity);
+        };
+    }
+}
@@ -57,7 +57,7 @@ namespace minko
 
 
                 void
-                update(std::vector<ParticleData>&, float) const;
+                update(ParticlePool&, unsigned int begin, unsigned int end, float timeStep) const;
 
                 unsigned int
                 getNeededComponents() const;
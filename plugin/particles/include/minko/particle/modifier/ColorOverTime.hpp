@@ -55,7 +55,7 @@ namespace minko
                 };
 
                 void
-                update(std::vector<ParticleData>&, float timeStep) const;
+                update(ParticlePool&, unsigned int begin, unsigned int end, float timeStep) const;
 
                 unsigned int
                 getNeededComponents() const;
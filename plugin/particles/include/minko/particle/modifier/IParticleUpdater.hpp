@@ -34,9 +34,13 @@ namespace minko
                 typedef std::shared_ptr<IParticleUpdater> Ptr;
 
             public:
+                /**
+                 * Updates the live particles in [begin, end). Spans of a same pool can be updated
+                 * concurrently, updaters must only write the attributes of the particles they are given.
+                 */
                 virtual
                 void
-                update(std::vector<ParticleData>&, float timeStep) const = 0;
+                update(ParticlePool&, unsigned int begin, unsigned int end, float timeStep) const = 0;
             };
         }
     }
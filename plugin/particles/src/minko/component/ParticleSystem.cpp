@@ -26,12 +26,16 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/ParticlesProvider.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/data/StructureProvider.hpp"
 #include "minko/render/Blending.hpp"
 #include "minko/render/CompareMode.hpp"
 #include "minko/render/ParticleVertexBuffer.hpp"
 #include "minko/render/ParticleIndexBuffer.hpp"
 #include "minko/math/Matrix4x4.hpp"
+#include "minko/async/ThreadPool.hpp"
 #include "minko/particle/ParticleData.hpp"
+#include "minko/particle/ParticlePool.hpp"
 #include "minko/particle/StartDirection.hpp"
 #include "minko/particle/modifier/IParticleModifier.hpp"
 #include "minko/particle/modifier/IParticleInitializer.hpp"
@@ -46,6 +50,8 @@ using namespace minko::component;
 using namespace minko::particle;
 
 /*static*/ const unsigned int ParticleSystem::COUNT_LIMIT = 16384;
+/*static*/ const unsigned int ParticleSystem::PARALLEL_UPDATE_GRAIN_SIZE = 2048;
+/*static*/ const unsigned int ParticleSystem::MAX_SORT_MOVES_PER_PARTICLE = 8;
 
 ParticleSystem::ParticleSystem(AssetLibraryPtr        assets,
                                float                rate,
@@ -60,10 +66,11 @@ ParticleSystem::ParticleSystem(AssetLibraryPtr        assets,
     _toWorld            (nullptr),
     _countLimit            (COUNT_LIMIT),
     _maxCount            (0),
-    _previousLiveCount    (0),
-    _particles            (),
+    _particles            (ParticlePool::create()),
+    _parallelUpdateThreshold(0),
     _isInWorldSpace        (false),
     _isZSorted            (false),
+    _numSortedParticles    (0),
     _useOldPosition        (false),
     _rate                (1.0f / rate),
     _lifetime            (lifetime            ? lifetime            : sampler::Constant<float>::create(1.0f)),
@@ -116,6 +123,8 @@ ParticleSystem::targetAddedHandler(AbsCompPtr    ctrl,
 {
     findSceneManager();
 
+    // the draw calls of the surface only read the providers of the target when they are created
+    target->data()->addProvider(_geometry->particlesData());
     target->addComponent(_surface);
 
     auto nodeCallback       = [&](NodePtr, NodePtr, NodePtr) { findSceneManager(); };
@@ -136,6 +145,7 @@ ParticleSystem::targetRemovedHandler(AbsCompPtr ctrl,
     findSceneManager();
 
     target->removeComponent(_surface);
+    target->data()->removeProvider(_geometry->particlesData());
 
     _addedSlot                = nullptr;
     _removedSlot            = nullptr;
@@ -327,58 +337,59 @@ ParticleSystem::updateSystem(float timeStep, bool emit)
     if (emit && _createTimer < _rate)
         _createTimer += timeStep;
 
-    for (unsigned particleIndex = 0; particleIndex < _particles.size(); ++particleIndex)
-    {
-        ParticleData& particle = _particles[particleIndex];
-
-        if (particle.alive())
-        {
-            particle.timeLived  += timeStep;
+    auto& particles = *_particles;
 
-            particle.oldx       = particle.x;
-            particle.oldy       = particle.y;
-            particle.oldz       = particle.z;
+    parallelFor(0, particles.numAlive(), [&](unsigned int begin, unsigned int end)
+    {
+        particles.age(begin, end, timeStep);
+    });
 
-            //if (part)
-            //if (!(particle.timeLived < particle.lifetime))
-            //    killParticle(particleIndex);
-        }
-    }
+    particles.killExpired();
 
-    for (auto& updater : _updaters)
-        updater->update(_particles, timeStep);
+    const unsigned int numUpdatedParticles = particles.numAlive();
 
-    for (unsigned particleIndex = 0; particleIndex < _particles.size(); ++particleIndex)
+    parallelFor(0, numUpdatedParticles, [&](unsigned int begin, unsigned int end)
     {
-        ParticleData& particle = _particles[particleIndex];
+        for (auto& updater : _updaters)
+            updater->update(particles, begin, end, timeStep);
 
-        if (!particle.alive() && emit && !(_createTimer < _rate))
-        {
-            _createTimer -= _rate;
+        particles.integrate(begin, end, timeStep);
+    });
 
-            createParticle(particleIndex, *_shape, _createTimer);
+    ParticleData particle;
 
-            particle.lifetime = _lifetime->value();
-        }
+    while (emit && !(_createTimer < _rate) && particles.numAlive() < _maxCount)
+    {
+        _createTimer -= _rate;
 
-        particle.rotation   += particle.startAngularVelocity * timeStep;
+        createParticle(particle, *_shape, _createTimer);
 
-        particle.startvx    += particle.startfx * timeStep;
-        particle.startvy    += particle.startfy * timeStep;
-        particle.startvz    += particle.startfz * timeStep;
+        particle.lifetime = _lifetime->value();
 
-        particle.x          += particle.startvx * timeStep;
-        particle.y          += particle.startvy * timeStep;
-        particle.z          += particle.startvz * timeStep;
+        particles.spawn(particle);
     }
+
+    // new particles skip the updaters but are integrated like the others
+    particles.integrate(numUpdatedParticles, particles.numAlive(), timeStep);
+}
+
+void
+ParticleSystem::parallelFor(unsigned int                                        begin,
+                            unsigned int                                        end,
+                            const std::function<void(unsigned int, unsigned int)>& function)
+{
+    if (_parallelUpdateThreshold == 0 || end - begin < _parallelUpdateThreshold)
+        function(begin, end);
+    else
+        async::ThreadPool::instance()->parallelFor(begin, end, PARALLEL_UPDATE_GRAIN_SIZE, function);
 }
 
 void
-ParticleSystem::createParticle(unsigned int                 particleIndex,
+ParticleSystem::createParticle(ParticleData&                particle,
                                const shape::EmitterShape&    shape,
                                float                        timeLived)
 {
-    ParticleData& particle = _particles[particleIndex];
+    particle = ParticleData();
 
     if (_emissionDirection == StartDirection::NONE)
     {
@@ -486,48 +497,23 @@ ParticleSystem::updateMaxParticlesCount()
 
     _maxCount = value;
 
-    uint liveCount = 0;
-    for (auto& particle : _particles)
-        if (particle.alive())
-        {
-            if (liveCount == _maxCount || !( particle.timeLived < _lifetime->max()) )
-                particle.kill();
-            else
-            {
-                if (particle.lifetime < _lifetime->min() || particle.lifetime > _lifetime->max())
-                    particle.lifetime = _lifetime->value();
+    auto&   particles   = *_particles;
+    float*  lifetime    = particles.column(ParticlePool::LIFETIME);
+    float*  timeLived   = particles.column(ParticlePool::TIME_LIVED);
 
-                if (particle.alive())
-                    ++liveCount;
-            }
-        }
+    for (unsigned int particleIndex = 0; particleIndex < particles.numAlive(); )
+    {
+        if (timeLived[particleIndex] < _lifetime->max()
+            && (lifetime[particleIndex] < _lifetime->min() || lifetime[particleIndex] > _lifetime->max()))
+            lifetime[particleIndex] = _lifetime->value();
 
+        if (timeLived[particleIndex] < _lifetime->max() && timeLived[particleIndex] < lifetime[particleIndex])
+            ++particleIndex;
+        else
+            particles.kill(particleIndex);
+    }
 
- //   //std::cout << "lifetime in [" << _lifetime->min() << " " << _lifetime->max() << "]" << std::endl;
-
-    //for (unsigned int i = 0; i < _particles.size(); ++i)
-    //{
-    //    if (_particles[i].alive())
-    //    {
-    //        if (liveCount == _maxCount ||
-    //            !(_particles[i].timeLived < _lifetime->max()))
-    //            _particles[i].kill();
-    //            //!(_particles[i].timeLived < _lifetime->max()))
-    //            //;//                _particles[i].alive = false;
-    //        else
-    //        {
-    //            //++_liveCount;
-    //            if (_particles[i].lifetime > _lifetime->max() || _particles[i].lifetime < _lifetime->min())
-    //                _particles[i].lifetime = _lifetime->value();
-
-    //            liveCount += _particles[i].alive() ? 1 : 0;
-    //            //if (!(_particles[i].timeLived < _particles[i].lifetime))
-    //                //;// _particles[i].alive = false;
- //               //else
- //                   //++_liveCount;
-    //        }
-    //    }
-    //}
+    // the live particles beyond the new maximum count are discarded
     resizeParticlesVector();
     _geometry->initStreams(_maxCount);
 }
@@ -535,13 +521,13 @@ ParticleSystem::updateMaxParticlesCount()
 void
 ParticleSystem::resizeParticlesVector()
 {
-    _particles.resize(_maxCount);
+    _particles->capacity(_maxCount);
+    _numSortedParticles = 0;
+
     if (_isZSorted)
     {
         _particleDistanceToCamera.resize(_maxCount);
         _particleOrder.resize(_maxCount);
-        for (unsigned int i = 0; i < _particleOrder.size(); ++i)
-            _particleOrder[i] = i;
     }
     else
     {
@@ -553,19 +539,25 @@ ParticleSystem::resizeParticlesVector()
 void
 ParticleSystem::updateParticleDistancesToCamera()
 {
-    for (unsigned int i = 0; i < _particleDistanceToCamera.size(); ++i)
-    {
-        const ParticleData& particle = _particles[i];
+    const float*    px  = _particles->column(ParticlePool::X);
+    const float*    py  = _particles->column(ParticlePool::Y);
+    const float*    pz  = _particles->column(ParticlePool::Z);
 
-        float x = particle.x;
-        float y = particle.y;
-        float z = particle.z;
+    for (unsigned int i = 0; i < _particles->numAlive(); ++i)
+    {
+        float x = px[i];
+        float y = py[i];
+        float z = pz[i];
 
         if (!_isInWorldSpace)
         {
-            x = _localToWorld[0] * x + _localToWorld[4] * y + _localToWorld[8] * z + _localToWorld[12];
-            y = _localToWorld[1] * x + _localToWorld[5] * y + _localToWorld[9] * z + _localToWorld[13];
-            z = _localToWorld[2] * x + _localToWorld[6] * y + _localToWorld[10] * z + _localToWorld[14];
+            const float localX = x;
+            const float localY = y;
+            const float localZ = z;
+
+            x = _localToWorld[0] * localX + _localToWorld[4] * localY + _localToWorld[8] * localZ + _localToWorld[12];
+            y = _localToWorld[1] * localX + _localToWorld[5] * localY + _localToWorld[9] * localZ + _localToWorld[13];
+            z = _localToWorld[2] * localX + _localToWorld[6] * localY + _localToWorld[10] * localZ + _localToWorld[14];
         }
 
         float deltaX = _cameraCoords[0] - x;
@@ -579,19 +571,9 @@ ParticleSystem::updateParticleDistancesToCamera()
 void
 ParticleSystem::reset()
 {
-    for (auto& particle : _particles)
-        particle.kill();
-
-    //if (_liveCount == 0)
-    //    return;
-
-    //_liveCount = 0;
-
-//    for (auto& particle : _particles)
-//        particle.alive = false;
+    _particles->clear();
 }
 
-
 void
 ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
 {
@@ -614,7 +596,6 @@ ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
     // FIXME: should be made fully dynamic
     auto vertexBuffer = _geometry->particleVertices();
 
-    _geometry->removeVertexBuffer(vertexBuffer);
     for (auto& component : OPTIONAL_COMPONENTS)
     {
         const auto& attrName = std::get<0>(component);
@@ -623,9 +604,9 @@ ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
             vertexBuffer->removeAttribute(attrName); // attribute offset must be updated
     }
 
-    // mandatory vertex attributes: offset and position
-    assert(vertexBuffer->hasAttribute("offset") && vertexBuffer->hasAttribute("position"));
-    unsigned int attrOffset = 5;
+    // mandatory vertex attribute: position (the offsets of the quad corners are in the geometry)
+    assert(vertexBuffer->hasAttribute("position"));
+    unsigned int attrOffset = 3;
 
     for (auto& component : OPTIONAL_COMPONENTS)
     {
@@ -640,7 +621,7 @@ ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
         }
     }
 
-    _geometry->addVertexBuffer(vertexBuffer);
+    _geometry->bindParticleVertices();
 
     if (!blockVSInit)
         _geometry->initStreams(_maxCount);
@@ -684,77 +665,130 @@ ParticleSystem::updateVertexFormat()
 void
 ParticleSystem::updateVertexBuffer()
 {
-    //if (_liveCount == 0)
-    //    return;
+    const auto&         particles   = *_particles;
+    const unsigned int  liveCount   = particles.numAlive();
 
     if (_isZSorted)
     {
         updateParticleDistancesToCamera();
-        std::sort(_particleOrder.begin(), _particleOrder.end(), _comparisonObject);
+        sortParticles();
     }
 
-    std::vector<float>&    vsData            = _geometry->particleVertices()->data();
-    float*                vertexIterator    = &(*vsData.begin());
+    auto                vertexBuffer    = _geometry->particleVertices();
+    float*              vertexIterator  = vertexBuffer->data().data();
+    const unsigned int  particleSize    = _geometry->verticesPerParticle() * vertexBuffer->vertexSize();
+
+    const float* x              = particles.column(ParticlePool::X);
+    const float* y              = particles.column(ParticlePool::Y);
+    const float* z              = particles.column(ParticlePool::Z);
+    const float* oldx           = particles.column(ParticlePool::OLD_X);
+    const float* oldy           = particles.column(ParticlePool::OLD_Y);
+    const float* oldz           = particles.column(ParticlePool::OLD_Z);
+    const float* r              = particles.column(ParticlePool::R);
+    const float* g              = particles.column(ParticlePool::G);
+    const float* b              = particles.column(ParticlePool::B);
+    const float* size           = particles.column(ParticlePool::SIZE);
+    const float* rotation       = particles.column(ParticlePool::ROTATION);
+    const float* lifetime       = particles.column(ParticlePool::LIFETIME);
+    const float* timeLived      = particles.column(ParticlePool::TIME_LIVED);
+    const float* spriteIndex    = particles.column(ParticlePool::SPRITE_INDEX);
+
+    for (unsigned int i = 0; i < liveCount; ++i)
+    {
+        const unsigned int particleIndex = _isZSorted ? _particleOrder[i] : i;
 
-    unsigned int liveCount = 0;
+        unsigned int offset = 3;
 
-    for (unsigned int particleIndex = 0; particleIndex < _maxCount; ++particleIndex)
-    {
-        ParticleData* particle;
+        setInVertexBuffer(vertexIterator, 0, x[particleIndex]);
+        setInVertexBuffer(vertexIterator, 1, y[particleIndex]);
+        setInVertexBuffer(vertexIterator, 2, z[particleIndex]);
 
-        if (_isZSorted)
-            particle = &_particles[_particleOrder[particleIndex]];
-        else
-            particle = &_particles[particleIndex];
+        if (_format & VertexComponentFlags::SIZE)
+            setInVertexBuffer(vertexIterator, offset++, size[particleIndex]);
 
-        unsigned int i = 5;
+        if (_format & VertexComponentFlags::COLOR)
+        {
+            setInVertexBuffer(vertexIterator, offset++, r[particleIndex]);
+            setInVertexBuffer(vertexIterator, offset++, g[particleIndex]);
+            setInVertexBuffer(vertexIterator, offset++, b[particleIndex]);
+        }
 
-        if (particle->alive())
+        if (_format & VertexComponentFlags::TIME)
+            setInVertexBuffer(vertexIterator, offset++, timeLived[particleIndex] / lifetime[particleIndex]);
+
+        if (_format & VertexComponentFlags::OLD_POSITION)
         {
-            setInVertexBuffer(vertexIterator, 2, particle->x);
-            setInVertexBuffer(vertexIterator, 3, particle->y);
-            setInVertexBuffer(vertexIterator, 4, particle->z);
+            setInVertexBuffer(vertexIterator, offset++, oldx[particleIndex]);
+            setInVertexBuffer(vertexIterator, offset++, oldy[particleIndex]);
+            setInVertexBuffer(vertexIterator, offset++, oldz[particleIndex]);
+        }
 
-            if (_format & VertexComponentFlags::SIZE)
-                setInVertexBuffer(vertexIterator, i++, particle->size);
+        if (_format & VertexComponentFlags::ROTATION)
+            setInVertexBuffer(vertexIterator, offset++, rotation[particleIndex]);
 
-            if (_format & VertexComponentFlags::COLOR)
-            {
-                setInVertexBuffer(vertexIterator, i++, particle->r);
-                setInVertexBuffer(vertexIterator, i++, particle->g);
-                setInVertexBuffer(vertexIterator, i++, particle->b);
-            }
+        if (_format & VertexComponentFlags::SPRITE_INDEX)
+            setInVertexBuffer(vertexIterator, offset++, spriteIndex[particleIndex]);
 
-            if (_format & VertexComponentFlags::TIME)
-                setInVertexBuffer(vertexIterator, i++, particle->timeLived / particle->lifetime);
+        vertexIterator += particleSize;
+    }
 
-            if (_format & VertexComponentFlags::OLD_POSITION)
-            {
-                setInVertexBuffer(vertexIterator, i++, particle->oldx);
-                setInVertexBuffer(vertexIterator, i++, particle->oldy);
-                setInVertexBuffer(vertexIterator, i++, particle->oldz);
-            }
+    if (liveCount != 0)
+        vertexBuffer->upload(0, liveCount * _geometry->verticesPerParticle());
 
-            if (_format & VertexComponentFlags::ROTATION)
-                setInVertexBuffer(vertexIterator, i++, particle->rotation);
+    _geometry->numParticles(liveCount);
+}
 
-            if (_format & VertexComponentFlags::SPRITE_INDEX)
-                setInVertexBuffer(vertexIterator, i++, particle->spriteIndex);
+void
+ParticleSystem::setInVertexBuffer(float* ptr, unsigned int offset, float value)
+{
+    const unsigned int vertexSize = _geometry->particleVertices()->vertexSize();
 
-            vertexIterator += 4 * _geometry->vertexSize();
-            ++liveCount;
-        }
+    unsigned int idx = offset;
+    for (unsigned int i = 0; i < _geometry->verticesPerParticle(); ++i)
+    {
+        ptr[idx] = value;
+        idx += vertexSize;
     }
+}
+
+void
+ParticleSystem::sortParticles()
+{
+    const unsigned int numAlive = _particles->numAlive();
 
-//    std::cout << "liveCount = " << _liveCount << " " << liveCount << std::endl;
-    _geometry->particleVertices()->upload(0, liveCount << 2);
+    // start from the order of the previous frame: indices of dead particles are dropped, the slots they
+    // left are filled by particles that were already live or by new ones, appended at the end
+    unsigned int numSorted = 0;
 
-    if (liveCount != _previousLiveCount)
+    for (unsigned int i = 0; i < _numSortedParticles; ++i)
+        if (_particleOrder[i] < numAlive)
+            _particleOrder[numSorted++] = _particleOrder[i];
+
+    for (unsigned int particleIndex = numSorted; particleIndex < numAlive; ++particleIndex)
+        _particleOrder[particleIndex] = particleIndex;
+
+    _numSortedParticles = numAlive;
+
+    // distances barely change from one frame to the next: an insertion sort is close to linear on an
+    // almost sorted order, but falls back to a full sort when the camera moved too much
+    const unsigned int  maxNumMoves = MAX_SORT_MOVES_PER_PARTICLE * numAlive;
+    unsigned int        numMoves    = 0;
+
+    for (unsigned int i = 1; i < numAlive && numMoves <= maxNumMoves; ++i)
     {
-        auto particleIndices    = std::static_pointer_cast<render::ParticleIndexBuffer>(_geometry->indices());
-        particleIndices->upload(0, liveCount * 6);
-        _previousLiveCount = liveCount;
+        const unsigned int  particleIndex   = _particleOrder[i];
+        const float         distance        = _particleDistanceToCamera[particleIndex];
+        unsigned int        j               = i;
+
+        for (; j > 0 && _particleDistanceToCamera[_particleOrder[j - 1]] < distance; --j)
+            _particleOrder[j] = _particleOrder[j - 1];
+
+        _particleOrder[j] = particleIndex;
+        numMoves += i - j;
     }
+
+    if (numMoves > maxNumMoves)
+        std::sort(_particleOrder.begin(), _particleOrder.begin() + numAlive, _comparisonObject);
 }
 
 ParticleSystem::Ptr
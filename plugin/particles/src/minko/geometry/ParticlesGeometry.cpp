@@ -22,18 +22,39 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/AbstractContext.hpp"
 #include "minko/render/ParticleVertexBuffer.hpp"
 #include "minko/render/ParticleIndexBuffer.hpp"
+#include "minko/data/StructureProvider.hpp"
 
 using namespace minko;
 using namespace minko::geometry;
 
+ParticlesGeometry::ParticlesGeometry() :
+    Geometry(),
+    _instanced(false),
+    _quadVertices(nullptr),
+    _particleVertices(nullptr),
+    _particleIndices(nullptr),
+    _particlesData(data::StructureProvider::create("instancing")),
+    _particleAttributes(),
+    _maxParticles(0),
+    _numParticles(0)
+{
+}
+
 void
 ParticlesGeometry::initialize(render::AbstractContext::Ptr context)
 {
+    _instanced          = context->supportsInstancing();
+    _quadVertices       = render::ParticleVertexBuffer::create(context);
     _particleVertices   = render::ParticleVertexBuffer::create(context);
     _particleIndices    = render::ParticleIndexBuffer::create(context);
 
-    addVertexBuffer(_particleVertices);
+    _quadVertices->addAttribute("offset", 2, 0);
+    _particleVertices->addAttribute("position", 3, 0);
+
+    addVertexBuffer(_quadVertices);
     indices(_particleIndices);
+
+    bindParticleVertices();
 }
 
 void
@@ -42,6 +63,64 @@ ParticlesGeometry::initStreams(unsigned int maxParticles)
     if (maxParticles == 0)
         return;
 
-    _particleVertices->resize(maxParticles, vertexSize());
-    _particleIndices->resize(maxParticles);
+    const unsigned int numQuads = _instanced ? 1 : maxParticles;
+
+    if (_quadVertices->numVertices() != numQuads << 2)
+    {
+        removeVertexBuffer(_quadVertices);
+        _quadVertices->resizeQuads(numQuads);
+        addVertexBuffer(_quadVertices);
+        _particleIndices->resize(numQuads);
+    }
+
+    const unsigned int numParticleVertices = maxParticles * verticesPerParticle();
+
+    if (_particleVertices->numVertices() != numParticleVertices)
+    {
+        _particleVertices->resize(numParticleVertices);
+        // the vertex buffer was recreated: the draw calls must bind the new one
+        bindParticleVertices();
+    }
+
+    _maxParticles = maxParticles;
+    _numParticles = std::min(_numParticles, maxParticles);
+
+    // the index buffer was just uploaded whole
+    numParticles(_numParticles);
+}
+
+void
+ParticlesGeometry::bindParticleVertices()
+{
+    for (auto& attributeName : _particleAttributes)
+        _particlesData->unset(attributeName);
+
+    _particleAttributes.clear();
+
+    // the draw calls read vertex buffers back as render::VertexBuffer::Ptr
+    auto vertexBuffer = std::static_pointer_cast<render::VertexBuffer>(_particleVertices);
+
+    for (auto& attribute : _particleVertices->attributes())
+    {
+        _particleAttributes.push_back(std::get<0>(*attribute));
+        _particlesData->set(std::get<0>(*attribute), vertexBuffer);
+    }
+}
+
+void
+ParticlesGeometry::numParticles(unsigned int numParticles)
+{
+    _numParticles = numParticles;
+
+    if (_instanced)
+    {
+        // without instances the quad would be drawn once, reading the first particle as a regular vertex
+        if ((numParticles == 0) != (_particleIndices->numIndices() == 0))
+            _particleIndices->upload(0, numParticles == 0 ? 0 : 6);
+
+        if (!_particlesData->hasProperty("numInstances") || _particlesData->get<int>("numInstances") != int(numParticles))
+            _particlesData->set("numInstances", int(numParticles));
+    }
+    else if (_particleIndices->numIndices() != numParticles * 6)
+        _particleIndices->upload(0, numParticles * 6);
 }
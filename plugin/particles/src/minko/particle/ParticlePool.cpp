@@ -0,0 +1,223 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/particle/ParticlePool.hpp"
+
+#include "minko/particle/ParticleData.hpp"
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+# include <xmmintrin.h>
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+# include <arm_neon.h>
+#endif
+
+using namespace minko;
+using namespace minko::particle;
+
+ParticlePool::ParticlePool(unsigned int capacity) :
+    _capacity(0),
+    _stride(0),
+    _numAlive(0),
+    _data()
+{
+    this->capacity(capacity);
+}
+
+void
+ParticlePool::capacity(unsigned int value)
+{
+    if (value == _capacity)
+        return;
+
+    const unsigned int  stride      = (value + 3) & ~3u;
+    const unsigned int  numAlive    = std::min(_numAlive, value);
+    std::vector<float>  data(NUM_ATTRIBUTES * stride, 0.0f);
+
+    for (unsigned int attribute = 0; attribute < NUM_ATTRIBUTES && numAlive > 0; ++attribute)
+        std::copy(
+            _data.begin() + attribute * _stride,
+            _data.begin() + attribute * _stride + numAlive,
+            data.begin() + attribute * stride
+        );
+
+    _data.swap(data);
+    _capacity = value;
+    _stride = stride;
+    _numAlive = numAlive;
+}
+
+unsigned int
+ParticlePool::spawn(const ParticleData& particle)
+{
+    if (_numAlive == _capacity)
+        throw std::length_error("The particle pool is full.");
+
+    set(_numAlive, particle);
+
+    return _numAlive++;
+}
+
+void
+ParticlePool::get(unsigned int particleIndex, ParticleData& particle) const
+{
+    particle.x                      = column(X)[particleIndex];
+    particle.y                      = column(Y)[particleIndex];
+    particle.z                      = column(Z)[particleIndex];
+    particle.oldx                   = column(OLD_X)[particleIndex];
+    particle.oldy                   = column(OLD_Y)[particleIndex];
+    particle.oldz                   = column(OLD_Z)[particleIndex];
+    particle.startvx                = column(VELOCITY_X)[particleIndex];
+    particle.startvy                = column(VELOCITY_Y)[particleIndex];
+    particle.startvz                = column(VELOCITY_Z)[particleIndex];
+    particle.startfx                = column(FORCE_X)[particleIndex];
+    particle.startfy                = column(FORCE_Y)[particleIndex];
+    particle.startfz                = column(FORCE_Z)[particleIndex];
+    particle.r                      = column(R)[particleIndex];
+    particle.g                      = column(G)[particleIndex];
+    particle.b                      = column(B)[particleIndex];
+    particle.size                   = column(SIZE)[particleIndex];
+    particle.rotation               = column(ROTATION)[particleIndex];
+    particle.startAngularVelocity   = column(ANGULAR_VELOCITY)[particleIndex];
+    particle.lifetime               = column(LIFETIME)[particleIndex];
+    particle.timeLived              = column(TIME_LIVED)[particleIndex];
+    particle.spriteIndex            = column(SPRITE_INDEX)[particleIndex];
+}
+
+void
+ParticlePool::set(unsigned int particleIndex, const ParticleData& particle)
+{
+    column(X)[particleIndex]                = particle.x;
+    column(Y)[particleIndex]                = particle.y;
+    column(Z)[particleIndex]                = particle.z;
+    column(OLD_X)[particleIndex]            = particle.oldx;
+    column(OLD_Y)[particleIndex]            = particle.oldy;
+    column(OLD_Z)[particleIndex]            = particle.oldz;
+    column(VELOCITY_X)[particleIndex]       = particle.startvx;
+    column(VELOCITY_Y)[particleIndex]       = particle.startvy;
+    column(VELOCITY_Z)[particleIndex]       = particle.startvz;
+    column(FORCE_X)[particleIndex]          = particle.startfx;
+    column(FORCE_Y)[particleIndex]          = particle.startfy;
+    column(FORCE_Z)[particleIndex]          = particle.startfz;
+    column(R)[particleIndex]                = particle.r;
+    column(G)[particleIndex]                = particle.g;
+    column(B)[particleIndex]                = particle.b;
+    column(SIZE)[particleIndex]             = particle.size;
+    column(ROTATION)[particleIndex]         = particle.rotation;
+    column(ANGULAR_VELOCITY)[particleIndex] = particle.startAngularVelocity;
+    column(LIFETIME)[particleIndex]         = particle.lifetime;
+    column(TIME_LIVED)[particleIndex]       = particle.timeLived;
+    column(SPRITE_INDEX)[particleIndex]     = particle.spriteIndex;
+}
+
+void
+ParticlePool::kill(unsigned int particleIndex)
+{
+    const unsigned int last = --_numAlive;
+
+    if (particleIndex != last)
+        for (unsigned int attribute = 0; attribute < NUM_ATTRIBUTES; ++attribute)
+        {
+            float* values = column(Attribute(attribute));
+
+            values[particleIndex] = values[last];
+        }
+}
+
+unsigned int
+ParticlePool::killExpired()
+{
+    const float*        lifetime    = column(LIFETIME);
+    const float*        timeLived   = column(TIME_LIVED);
+    const unsigned int  numAlive    = _numAlive;
+
+    // kill() moves the last particle in the freed slot, which must then be checked again
+    for (unsigned int particleIndex = 0; particleIndex < _numAlive; )
+        if (!(timeLived[particleIndex] < lifetime[particleIndex]))
+            kill(particleIndex);
+        else
+            ++particleIndex;
+
+    return numAlive - _numAlive;
+}
+
+void
+ParticlePool::age(unsigned int begin, unsigned int end, float timeStep)
+{
+    add(column(TIME_LIVED), timeStep, begin, end);
+
+    std::copy(column(X) + begin, column(X) + end, column(OLD_X) + begin);
+    std::copy(column(Y) + begin, column(Y) + end, column(OLD_Y) + begin);
+    std::copy(column(Z) + begin, column(Z) + end, column(OLD_Z) + begin);
+}
+
+void
+ParticlePool::integrate(unsigned int begin, unsigned int end, float timeStep)
+{
+    multiplyAdd(column(ROTATION), column(ANGULAR_VELOCITY), timeStep, begin, end);
+
+    multiplyAdd(column(VELOCITY_X), column(FORCE_X), timeStep, begin, end);
+    multiplyAdd(column(VELOCITY_Y), column(FORCE_Y), timeStep, begin, end);
+    multiplyAdd(column(VELOCITY_Z), column(FORCE_Z), timeStep, begin, end);
+
+    multiplyAdd(column(X), column(VELOCITY_X), timeStep, begin, end);
+    multiplyAdd(column(Y), column(VELOCITY_Y), timeStep, begin, end);
+    multiplyAdd(column(Z), column(VELOCITY_Z), timeStep, begin, end);
+}
+
+/*static*/
+void
+ParticlePool::multiplyAdd(float* values, const float* factors, float k, unsigned int begin, unsigned int end)
+{
+    unsigned int i = begin;
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+    const __m128 k4 = _mm_set1_ps(k);
+
+    for (; i + 4 <= end; i += 4)
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(factors + i), k4)));
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+    for (; i + 4 <= end; i += 4)
+        vst1q_f32(values + i, vmlaq_n_f32(vld1q_f32(values + i), vld1q_f32(factors + i), k));
+#endif
+
+    for (; i < end; ++i)
+        values[i] += factors[i] * k;
+}
+
+/*static*/
+void
+ParticlePool::add(float* values, float k, unsigned int begin, unsigned int end)
+{
+    unsigned int i = begin;
+
+#if MINKO_SIMD == MINKO_SIMD_SSE
+    const __m128 k4 = _mm_set1_ps(k);
+
+    for (; i + 4 <= end; i += 4)
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), k4));
+#elif MINKO_SIMD == MINKO_SIMD_NEON
+    const float32x4_t k4 = vdupq_n_f32(k);
+
+    for (; i + 4 <= end; i += 4)
+        vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), k4));
+#endif
+
+    for (; i < end; ++i)
+        values[i] += k;
+}
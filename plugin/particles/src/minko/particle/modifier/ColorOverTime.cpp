@@ -44,7 +44,7 @@ ColorOverTime::ColorOverTime(LinearlyInterpolatedValue<math::Vector3>::Ptr color
 }
 
 void
-ColorOverTime::update(std::vector<ParticleData>&, float timeStep) const
+ColorOverTime::update(ParticlePool&, unsigned int, unsigned int, float) const
 {
 
 }
@@ -18,7 +18,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/particle/modifier/ForceOverTime.hpp"
-#include "minko/particle/ParticleData.hpp"
+#include "minko/particle/ParticlePool.hpp"
 #include "minko/particle/sampler/Sampler.hpp"
 #include "minko/particle/tools/VertexComponentFlags.hpp"
 
@@ -36,24 +36,29 @@ ForceOverTime::ForceOverTime(SamplerPtr fx,
 }
 
 void
-ForceOverTime::update(std::vector<ParticleData>&     particles,
-                          float                            timeStep) const
+ForceOverTime::update(ParticlePool&    particles,
+                      unsigned int     begin,
+                      unsigned int     end,
+                      float            timeStep) const
 {
-    float sqTime = timeStep * timeStep;
-
-    for (auto& particle : particles)
-        if (particle.alive())
-            {
-                const float t = particle.lifetime > 0.0f
-                    ? particle.timeLived / particle.lifetime
-                    : 0.0f;
-
-                particle.x += _x->value(t) * sqTime;
-                particle.y += _y->value(t) * sqTime;
-                particle.z += _z->value(t) * sqTime;
-            }
-}
+    const float     sqTime      = timeStep * timeStep;
+    const float*    lifetime    = particles.column(ParticlePool::LIFETIME);
+    const float*    timeLived   = particles.column(ParticlePool::TIME_LIVED);
+    float*          x           = particles.column(ParticlePool::X);
+    float*          y           = particles.column(ParticlePool::Y);
+    float*          z           = particles.column(ParticlePool::Z);
+
+    for (unsigned int particleIndex = begin; particleIndex < end; ++particleIndex)
+    {
+        const float t = lifetime[particleIndex] > 0.0f
+            ? timeLived[particleIndex] / lifetime[particleIndex]
+            : 0.0f;
 
+        x[particleIndex] += _x->value(t) * sqTime;
+        y[particleIndex] += _y->value(t) * sqTime;
+        z[particleIndex] += _z->value(t) * sqTime;
+    }
+}
 
 unsigned int
 ForceOverTime::getNeededComponents() const
@@ -41,7 +41,7 @@ SizeBySpeed::SizeBySpeed(LinearlyInterpolatedValue<float>::Ptr size):
 }
 
 void
-SizeBySpeed::update(std::vector<ParticleData>&, float) const
+SizeBySpeed::update(ParticlePool&, unsigned int, unsigned int, float) const
 {
 
 }
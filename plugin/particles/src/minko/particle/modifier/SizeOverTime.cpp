@@ -41,7 +41,7 @@ SizeOverTime::SizeOverTime(LinearlyInterpolatedValue<float>::Ptr size):
 }
 
 void
-SizeOverTime::update(std::vector<ParticleData>&, float) const
+SizeOverTime::update(ParticlePool&, unsigned int, unsigned int, float) const
 {
 
 }
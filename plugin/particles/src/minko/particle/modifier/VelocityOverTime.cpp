@@ -18,7 +18,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/particle/modifier/VelocityOverTime.hpp"
-#include "minko/particle/ParticleData.hpp"
+#include "minko/particle/ParticlePool.hpp"
 #include "minko/particle/sampler/Sampler.hpp"
 #include "minko/particle/tools/VertexComponentFlags.hpp"
 
@@ -36,27 +36,29 @@ VelocityOverTime::VelocityOverTime(SamplerPtr vx,
 }
 
 void
-VelocityOverTime::update(std::vector<ParticleData>& particles,
-                             float                      timeStep) const
+VelocityOverTime::update(ParticlePool& particles,
+                         unsigned int  begin,
+                         unsigned int  end,
+                         float         timeStep) const
 {
-    for (auto& particle : particles)
-        if (particle.alive())
-            {
-                const float t = particle.lifetime > 0.0f
-                    ? particle.timeLived / particle.lifetime
-                    : 0.0f;
+    const float*    lifetime    = particles.column(ParticlePool::LIFETIME);
+    const float*    timeLived   = particles.column(ParticlePool::TIME_LIVED);
+    float*          x           = particles.column(ParticlePool::X);
+    float*          y           = particles.column(ParticlePool::Y);
+    float*          z           = particles.column(ParticlePool::Z);
 
-                const float dx = _x->value(t) * timeStep;
-                const float dy = _y->value(t) * timeStep;
-                const float dz = _z->value(t) * timeStep;
+    for (unsigned int particleIndex = begin; particleIndex < end; ++particleIndex)
+    {
+        const float t = lifetime[particleIndex] > 0.0f
+            ? timeLived[particleIndex] / lifetime[particleIndex]
+            : 0.0f;
 
-                particle.x += dx;
-                particle.y += dy;
-                particle.z += dz;
-            }
+        x[particleIndex] += _x->value(t) * timeStep;
+        y[particleIndex] += _y->value(t) * timeStep;
+        z[particleIndex] += _z->value(t) * timeStep;
+    }
 }
 
-
 unsigned int
 VelocityOverTime::getNeededComponents() const
 {
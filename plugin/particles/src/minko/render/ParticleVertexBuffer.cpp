@@ -31,52 +31,50 @@ ParticleVertexBuffer::ParticleVertexBuffer(std::shared_ptr<AbstractContext> cont
 }
 
 void
-ParticleVertexBuffer::initialize()
+ParticleVertexBuffer::resize(unsigned int numVertices)
 {
-    addAttribute("offset",      2, 0);
-    addAttribute("position",    3, 2);
-}
+    std::vector<float>& vertexData  = data();
+    unsigned int        size        = numVertices * vertexSize();
+
+    if (vertexData.size() != size)
+        dispose();
 
-// void
-// ParticleVertexBuffer::update(unsigned int nParticles, unsigned int vertexSize)
-// {
-//     unsigned int size = nParticles * vertexSize * 4;
+    vertexData.resize(size);
 
-//     _context->uploadVertexBufferData(_id, 0, size, &data()[0]);
-// }
+    upload();
+}
 
 void
-ParticleVertexBuffer::resize(unsigned int nParticles, unsigned int vertexSize)
+ParticleVertexBuffer::resizeQuads(unsigned int numQuads)
 {
     std::vector<float>& vertexData  = data();
-    unsigned int        oldSize     = vertexData.size();
-    unsigned int        size        = (nParticles * vertexSize) << 2;
+    unsigned int        size        = (numQuads * vertexSize()) << 2;
 
-    if (oldSize != size)
+    if (vertexData.size() != size)
         dispose();
 
     vertexData.resize(size);
 
     float*          ptr = &vertexData[0];
     unsigned int    idx = 0;
-    for (unsigned int i = 0; i < nParticles; ++i)
+    for (unsigned int i = 0; i < numQuads; ++i)
     {
         ptr[idx]       = -0.5f;
         ptr[idx + 1]   = -0.5f;
-        idx += vertexSize;
+        idx += vertexSize();
 
         ptr[idx]       =  0.5f;
         ptr[idx + 1]   = -0.5f;
-        idx += vertexSize;
+        idx += vertexSize();
 
         ptr[idx]       = -0.5f;
         ptr[idx + 1]   =  0.5f;
-        idx += vertexSize;
+        idx += vertexSize();
 
         ptr[idx]       =  0.5f;
         ptr[idx + 1]   =  0.5f;
-        idx += vertexSize;
+        idx += vertexSize();
     }
 
     upload();
-}
\ No newline at end of file
+}
@@ -38,33 +38,21 @@ namespace minko
             Ptr
             create(std::shared_ptr<render::AbstractContext> context)
             {
-                auto vb = std::shared_ptr<ParticleVertexBuffer>(new ParticleVertexBuffer(context));
-
-                vb->initialize();
-
-                return vb;
+                return std::shared_ptr<ParticleVertexBuffer>(new ParticleVertexBuffer(context));
             }
 
+            /**
+             * Resizes the buffer to numVertices vertices of the current vertex size.
+             */
             void
-            initialize();
-
-            // void
-            // update(unsigned int    nParticles, unsigned int vertexSize);
+            resize(unsigned int numVertices);
 
+            /**
+             * Resizes the buffer to the 4 vertices of numQuads quads, writing the offset of each vertex
+             * from the center of its quad in the first 2 floats.
+             */
             void
-            resize(unsigned int nParticles, unsigned int vertexSize);
-
-            void
-            resetAttributes()
-            {
-                /*
-                attributes().resize(0);
-                vertexSize(0);
-
-                addAttribute("offset", 2, 0);
-                addAttribute("position", 3, 2);
-                */
-            };
+            resizeQuads(unsigned int numQuads);
 
         private:
             ParticleVertexBuffer(std::shared_ptr<AbstractContext> context);
@@ -33,6 +33,12 @@ namespace minko
         public:
             typedef std::shared_ptr<PNGParser> Ptr;
 
+        private:
+            std::vector<unsigned char>  _pixels;
+            unsigned int                _width;
+            unsigned int                _height;
+            std::string                 _decodingError;
+
         public:
             inline static
             Ptr
@@ -48,10 +54,43 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>    AssetLibrary);
 
-        private:
-            PNGParser()
+            void
+            parseFile(std::shared_ptr<File>             file,
+                      std::shared_ptr<Options>          options,
+                      std::shared_ptr<AssetLibrary>     assetLibrary);
+
+            inline
+            bool
+            threadSafe() const
+            {
+                return true;
+            }
+
+            void
+            decode(std::shared_ptr<File> file, std::shared_ptr<Options> options);
+
+            void
+            commit(std::shared_ptr<File>            file,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary);
+
+            inline
+            uint
+            stagedSize() const
             {
+                return _pixels.size();
             }
+
+        private:
+            PNGParser();
+
+            void
+            decode(const std::string& filename, const unsigned char* data, std::size_t size);
+
+            void
+            commit(const std::string&               filename,
+                   std::shared_ptr<Options>         options,
+                   std::shared_ptr<AssetLibrary>    assetLibrary);
         };
     }
 }
@@ -29,6 +29,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::file;
 
+PNGParser::PNGParser() :
+    _pixels(),
+    _width(0),
+    _height(0),
+    _decodingError()
+{
+}
+
 void
 PNGParser::parse(const std::string&                 filename,
                  const std::string&                 resolvedFilename,
@@ -36,17 +44,50 @@ PNGParser::parse(const std::string&                 filename,
                  const std::vector<unsigned char>&  data,
                  std::shared_ptr<AssetLibrary>      assetLibrary)
 {
-    std::vector<unsigned char> out;
-    unsigned int width;
-    unsigned int height;
+    decode(filename, data.data(), data.size());
+    commit(filename, options, assetLibrary);
+}
+
+void
+PNGParser::parseFile(std::shared_ptr<File>          file,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary)
+{
+    decode(file->filename(), file->bytes(), file->size());
+    commit(file->filename(), options, assetLibrary);
+}
+
+void
+PNGParser::decode(std::shared_ptr<File> file, std::shared_ptr<Options> options)
+{
+    decode(file->filename(), file->bytes(), file->size());
+}
+
+void
+PNGParser::commit(std::shared_ptr<File>             file,
+                  std::shared_ptr<Options>          options,
+                  std::shared_ptr<AssetLibrary>     assetLibrary)
+{
+    commit(file->filename(), options, assetLibrary);
+}
 
-    unsigned error = lodepng::decode(out, width, height, &*data.begin(), data.size());
+void
+PNGParser::decode(const std::string& filename, const unsigned char* data, std::size_t size)
+{
+    unsigned error = lodepng::decode(_pixels, _width, _height, data, size);
 
     if (error)
-    {
-        const char* text = lodepng_error_text(error);
+        _decodingError = "file '" + filename + "' loading error (" + lodepng_error_text(error) + ")";
+}
 
-        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (" + text + ")"));
+void
+PNGParser::commit(const std::string&                filename,
+                  std::shared_ptr<Options>          options,
+                  std::shared_ptr<AssetLibrary>     assetLibrary)
+{
+    if (!_decodingError.empty())
+    {
+        _error->execute(shared_from_this(), Error(_decodingError));
         _complete->execute(shared_from_this());
         
         return;
@@ -58,8 +99,8 @@ PNGParser::parse(const std::string&                 filename,
     {
         auto texture2d = render::Texture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -74,8 +115,8 @@ PNGParser::parse(const std::string&                 filename,
     {
         auto cubeTexture = render::CubeTexture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -87,11 +128,15 @@ PNGParser::parse(const std::string&                 filename,
         assetLibrary->cubeTexture(filename, cubeTexture);
     }
 
-    texture->data(&*out.begin());
+    texture->data(&*_pixels.begin());
     texture->upload();
     
     if (options->disposeTextureAfterLoading())
         texture->disposeData();
 
+    // the texture keeps its own copy of the pixels
+    _pixels.clear();
+    _pixels.shrink_to_fit();
+
     complete()->execute(shared_from_this());
 }
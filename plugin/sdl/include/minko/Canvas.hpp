@@ -91,6 +91,7 @@ namespace minko
         time_point                                                              _startTime;
         float                                                                   _framerate;
         float                                                                   _desiredFramerate;
+        uint                                                                    _uploadBudget;
 
 #if MINKO_PLATFORM & (MINKO_PLATFORM_HTML5 | MINKO_PLATFORM_WINDOWS | MINKO_PLATFORM_ANDROID)
         std::shared_ptr<SDLAudio>                                               _audio;
@@ -110,7 +111,7 @@ namespace minko
         Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr      _joystickAdded;
         Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr      _joystickRemoved;
 
-        std::list<std::shared_ptr<async::Worker>>                               _activeWorkers;
+        std::map<std::string, std::shared_ptr<async::Worker>>                   _activeWorkers;
         std::list<Any>                                                          _workerCompleteSlots;
 
         bool                                                                    _onWindow;
@@ -290,6 +291,22 @@ namespace minko
             _desiredFramerate = desiredFramerate;
         }
 
+        inline
+        uint
+        uploadBudget() const
+        {
+            return _uploadBudget;
+        }
+
+        // Maximum number of bytes uploaded each frame by the main thread tasks of
+        // async::TaskScheduler::instance(), such as the creation of the resources parsed asynchronously.
+        inline
+        void
+        uploadBudget(uint uploadBudget)
+        {
+            _uploadBudget = uploadBudget;
+        }
+
         // Current frame execution time in milliseconds.
         inline
         float
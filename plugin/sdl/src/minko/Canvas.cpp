@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Provider.hpp"
 #include "minko/math/Vector4.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/TaskScheduler.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/log/Logger.hpp"
 #include "minko/SDLBackend.hpp"
@@ -62,6 +63,7 @@ Canvas::Canvas(const std::string& name, const uint width, const uint height, int
     _startTime(std::chrono::high_resolution_clock::now()),
     _framerate(0.f),
     _desiredFramerate(60.f),
+    _uploadBudget(4 << 20),
     _enterFrame(Signal<Canvas::Ptr, float, float>::create()),
     _resized(Signal<AbstractCanvas::Ptr, uint, uint>::create()),
     _fileDropped(Signal<const std::string&>::create()),
@@ -834,10 +836,12 @@ Canvas::step()
     }
 
 #if MINKO_PLATFORM != MINKO_PLATFORM_HTML5
-    for (auto worker : _activeWorkers)
-        worker->poll();
+    for (auto& nameAndWorker : _activeWorkers)
+        nameAndWorker.second->poll();
 #endif
 
+    async::TaskScheduler::instance()->runMainThreadTasks(-1.f, _uploadBudget);
+
     auto absoluteTime = std::chrono::high_resolution_clock::now();
     _relativeTime   = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(absoluteTime - _startTime).count(); // in milliseconds
     _frameDuration  = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(absoluteTime - _previousTime).count(); // in milliseconds
@@ -883,9 +887,15 @@ Canvas::getWorker(const std::string& name)
     if (!_workers.count(name))
         return nullptr;
 
+    // workers tag their messages with a request id, so concurrent requests can share the same worker
+    auto workerIt = _activeWorkers.find(name);
+
+    if (workerIt != _activeWorkers.end())
+        return workerIt->second;
+
     auto worker = _workers[name]();
 
-    _activeWorkers.push_back(worker);
+    _activeWorkers[name] = worker;
 
     return worker;
 }
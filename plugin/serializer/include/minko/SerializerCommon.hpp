@@ -9,7 +9,10 @@
 
 #define MINKO_SCENE_VERSION_HI          0
 #define MINKO_SCENE_VERSION_LO          2
-#define MINKO_SCENE_VERSION_BUILD       3
+#define MINKO_SCENE_VERSION_BUILD       4
+
+#define MINKO_GEOMETRY_CHUNK_MAGIC      0x4D4B4743 // MKGC, aligned binary geometry chunk
+#define MINKO_GEOMETRY_CHUNK_ALIGNMENT  16
 
 namespace minko
 {
@@ -100,6 +100,20 @@ namespace minko
                                 std::shared_ptr<Options>                options,
                                 std::string&                            assetFilePath);
 
+            void
+            extractDependencies(AssetLibraryPtr                         assetLibrary,
+                                const unsigned char*                    data,
+                                short                                   dataOffset,
+                                unsigned int                            dependenciesSize,
+                                std::shared_ptr<Options>                options,
+                                std::string&                            assetFilePath);
+
+            bool
+            unpackDependencies(const unsigned char*                     data,
+                               short                                    dataOffset,
+                               unsigned int                             dependenciesSize,
+                               std::vector<SerializedAsset>&            assets);
+
             inline
             void
             dependecy(std::shared_ptr<Dependency> dependecies)
@@ -124,20 +138,51 @@ namespace minko
                        const std::vector<unsigned char>&    data,
                        int                                  extension = 0x00);
 
+            bool
+            readHeader(const std::string&                   filename,
+                       const unsigned char*                 data,
+                       size_t                               size,
+                       int                                  extension = 0x00);
+
+            bool
+            readHeader(const std::string&                   filename,
+                       const unsigned char*                 data,
+                       size_t                               size,
+                       int                                  extension,
+                       std::string&                         errorMessage);
+
             int
             readInt(const std::vector<unsigned char>& data, int offset)
+            {
+                return readInt(data.data(), offset);
+            }
+
+            int
+            readInt(const unsigned char* data, int offset)
             {
                 return (int)(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]);
             }
 
             unsigned int
             readUInt(const std::vector<unsigned char>& data, int offset)
+            {
+                return readUInt(data.data(), offset);
+            }
+
+            unsigned int
+            readUInt(const unsigned char* data, int offset)
             {
                 return (unsigned int)(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]);
             }
 
             short
             readShort(const std::vector<unsigned char>& data, int offset)
+            {
+                return readShort(data.data(), offset);
+            }
+
+            short
+            readShort(const unsigned char* data, int offset)
             {
                 return (short)(data[offset] << 8 | data[offset + 1]);
             }
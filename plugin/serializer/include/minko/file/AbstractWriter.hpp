@@ -73,6 +73,7 @@ namespace minko
             std::shared_ptr<Dependency>                         _parentDependencies;
 
             int                                                 _magicNumber;
+            unsigned int                                        _dataAlignment;
 
         public:
             inline
@@ -159,6 +160,9 @@ namespace minko
 
                         msgpack::type::tuple<SerializedDependency> res(serializedDependencies);
 
+                        auto dependenciesPadding = dataPadding(dependenciesSize);
+
+                        dependenciesSize += dependenciesPadding;
 
                         auto dataSize = serializedData.size();
 
@@ -178,6 +182,7 @@ namespace minko
                             dependencyBuffer.clear();
                         }
 
+                        file.write(std::string(dependenciesPadding, '\0').c_str(), dependenciesPadding);
                         file.write(serializedData.c_str(), serializedData.size());
                         file.close();
                     }
@@ -230,6 +235,21 @@ namespace minko
                 return header;
             }
 
+            /**
+             * Number of zero bytes to append to the dependencies so that the embedded data starts
+             * on a multiple of _dataAlignment from the beginning of the file.
+             */
+            unsigned int
+            dataPadding(unsigned int dependenciesSize) const
+            {
+                if (_dataAlignment <= 1)
+                    return 0;
+
+                auto dataOffset = MINKO_SCENE_HEADER_SIZE + dependenciesSize;
+
+                return (_dataAlignment - dataOffset % _dataAlignment) % _dataAlignment;
+            }
+
             void
             writeInt(std::ofstream& file, int i)
             {
@@ -304,14 +324,17 @@ namespace minko
                 std::stringstream sbuf;
                 msgpack::pack(sbuf, res);
 
-                auto dependenciesSize = sbuf.str().size();
+                auto serializedDependenciesSize = sbuf.str().size();
+                auto dependenciesPadding = dataPadding(serializedDependenciesSize);
+                auto dependenciesSize = serializedDependenciesSize + dependenciesPadding;
                 auto sceneDataSize = serializedData.size();
                 auto header = getHeader(dependenciesSize, sceneDataSize);
 
                 auto headerSize = MINKO_SCENE_HEADER_SIZE;
 
                 data.write(header, headerSize);
-                data.write(sbuf.str().c_str(), dependenciesSize);
+                data.write(sbuf.str().c_str(), serializedDependenciesSize);
+                data.write(std::string(dependenciesPadding, '\0').c_str(), dependenciesPadding);
                 data.write(serializedData.c_str(), sceneDataSize);
 
                 complete()->execute(this->shared_from_this());
@@ -346,7 +369,9 @@ namespace minko
             AbstractWriter() :
                 _complete(Signal<Ptr>::create()),
                 _error(Signal<Ptr, const WriterError&>::create()),
-                _parentDependencies(nullptr)
+                _parentDependencies(nullptr),
+                _magicNumber(0),
+                _dataAlignment(1)
             {
             }
         };
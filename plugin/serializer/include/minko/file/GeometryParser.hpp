@@ -59,6 +59,11 @@ namespace minko
                   const std::vector<unsigned char>& data,
                   std::shared_ptr<AssetLibrary>     assetLibrary);
 
+            void
+            parseFile(std::shared_ptr<File>            file,
+                      std::shared_ptr<Options>         options,
+                      std::shared_ptr<AssetLibrary>    assetLibrary);
+
             inline
             static
             void
@@ -86,6 +91,23 @@ namespace minko
                 initialize();
             }
 
+            void
+            parseGeometry(const std::string&                filename,
+                          const std::string&                resolvedFilename,
+                          std::shared_ptr<Options>          options,
+                          const unsigned char*              data,
+                          size_t                            size,
+                          std::shared_ptr<AssetLibrary>     assetLibrary,
+                          std::vector<unsigned char>*       disposableData);
+
+            bool
+            parseAlignedGeometry(const std::string&                     filename,
+                                 const unsigned char*                   chunk,
+                                 size_t                                 size,
+                                 AbstractContextPtr                     context,
+                                 std::shared_ptr<geometry::Geometry>    geometry,
+                                 std::string&                           name);
+
             void
             computeMetaByte(unsigned char byte, uint& indexBufferFunctionId, uint& vertexBufferFunctionId);
 
@@ -103,6 +125,18 @@ namespace minko
             deserializeIndexBufferChar(std::string&          serializedIndexBuffer,
                                        AbstractContextPtr    context);
 
+            static
+            IndexBufferPtr
+            createIndexBuffer(const unsigned char*  data,
+                              uint                  numIndices,
+                              AbstractContextPtr    context);
+
+            static
+            VertexBufferPtr
+            createVertexBuffer(const unsigned char* data,
+                               uint                 numFloats,
+                               AbstractContextPtr   context);
+
         };
     }
 }
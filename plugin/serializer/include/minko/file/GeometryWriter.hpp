@@ -110,6 +110,18 @@ namespace minko
             std::string
             serializeVertexStream(std::shared_ptr<render::VertexBuffer> vertexBuffer);
 
+            static
+            std::string
+            serializeAlignedGeometry(std::shared_ptr<geometry::Geometry> geometry, const std::string& name);
+
+            static
+            void
+            writeUInt(std::string& buffer, unsigned int value, size_t position);
+
+            static
+            void
+            alignBuffer(std::string& buffer);
+
             GeometryWriter()
             {
                 initialize();
@@ -58,6 +58,12 @@ namespace minko
         private:
             static std::unordered_map<int8_t, ComponentReadFunction>    _componentIdToReadFunction;
 
+            std::string                                                 _headerError;
+            bool                                                        _dependenciesUnpacked;
+            std::vector<SerializedAsset>                                _serializedAssets;
+            std::vector<std::string>                                    _componentPack;
+            std::vector<SerializedNode>                                 _nodePack;
+
         public:
             inline static
             Ptr
@@ -78,7 +84,38 @@ namespace minko
                   const std::vector<unsigned char>& data,
                   AssetLibraryPtr                   assetLibrary);
 
+            inline
+            bool
+            threadSafe() const
+            {
+                return true;
+            }
+
+            void
+            decode(std::shared_ptr<File> file, std::shared_ptr<Options> options);
+
+            void
+            commit(std::shared_ptr<File>            file,
+                   std::shared_ptr<Options>         options,
+                   AssetLibraryPtr                  assetLibrary);
+
+            inline
+            uint
+            stagedSize() const
+            {
+                return _headerError.empty() ? _dependenciesSize : 0;
+            }
+
         private:
+            void
+            decode(const std::string& filename, const unsigned char* data, std::size_t size);
+
+            void
+            commit(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   AssetLibraryPtr                  assetLibrary);
+
             std::shared_ptr<scene::Node>
             parseNode(std::vector<SerializedNode>&  nodePack,
                       std::vector<std::string>&     componentPack,
@@ -113,6 +113,14 @@ namespace minko
                                    int                                 height,
                                    render::TextureType                 type,
                                    int                                 numMipmaps);
+
+            static
+            bool
+            readMipLevel(const std::string&             fileName,
+                         OptionsPtr                     options,
+                         uint64_t                       offset,
+                         unsigned int                   size,
+                         std::vector<unsigned char>&    data);
         };
     }
 }
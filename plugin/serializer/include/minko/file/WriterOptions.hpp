@@ -52,6 +52,9 @@ namespace minko
             Vector2Ptr                          _textureMaxResolution;
             render::MipFilter                   _mipFilter;
             bool                                _optimizeForNormalMapping;
+            bool                                _sRGBTextures;
+
+            bool                                _alignGeometryData;
 
         public:
             inline
@@ -82,6 +85,8 @@ namespace minko
                 instance->_textureMaxResolution = other->_textureMaxResolution;
                 instance->_mipFilter = other->_mipFilter;
                 instance->_optimizeForNormalMapping = other->_optimizeForNormalMapping;
+                instance->_sRGBTextures = other->_sRGBTextures;
+                instance->_alignGeometryData = other->_alignGeometryData;
 
                 return instance;
             }
@@ -262,6 +267,47 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            bool
+            sRGBTextures() const
+            {
+                return _sRGBTextures;
+            }
+
+            /**
+             * Whether the colors of the textures are sRGB encoded: their mip levels are then filtered after
+             * conversion to linear space. False by default, as for normal maps and other data textures.
+             */
+            inline
+            Ptr
+            sRGBTextures(bool value)
+            {
+                _sRGBTextures = value;
+
+                return shared_from_this();
+            }
+
+            inline
+            bool
+            alignGeometryData() const
+            {
+                return _alignGeometryData;
+            }
+
+            /**
+             * Write geometries as an aligned binary chunk: raw index and vertex blocks start on
+             * 16 bytes boundaries and are read in place by the GeometryParser instead of being
+             * unpacked from msgpack strings.
+             */
+            inline
+            Ptr
+            alignGeometryData(bool value)
+            {
+                _alignGeometryData = value;
+
+                return shared_from_this();
+            }
+
         private:
             WriterOptions();
         };
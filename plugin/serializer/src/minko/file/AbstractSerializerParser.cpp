@@ -94,6 +94,34 @@ AbstractSerializerParser::extractDependencies(AssetLibraryPtr
                                               unsigned int                            dependenciesSize,
                                               std::shared_ptr<Options>                options,
                                               std::string&                            assetFilePath)
+{
+    extractDependencies(assetLibrary, data.data(), dataOffset, dependenciesSize, options, assetFilePath);
+}
+
+void
+AbstractSerializerParser::extractDependencies(AssetLibraryPtr                       assetLibrary,
+                                              const unsigned char*                  data,
+                                              short                                 dataOffset,
+                                              unsigned int                          dependenciesSize,
+                                              std::shared_ptr<Options>              options,
+                                              std::string&                          assetFilePath)
+{
+    std::vector<SerializedAsset> assets;
+
+    auto dependenciesUnpacked = unpackDependencies(data, dataOffset, dependenciesSize, assets);
+
+    for (auto& serializedAsset : assets)
+        deserializeAsset(serializedAsset, assetLibrary, options, assetFilePath);
+
+    if (!dependenciesUnpacked)
+        _error->execute(shared_from_this(), Error("DependencyParsingError", "Error while parsing dependencies"));
+}
+
+bool
+AbstractSerializerParser::unpackDependencies(const unsigned char*             data,
+                                             short                            dataOffset,
+                                             unsigned int                     dependenciesSize,
+                                             std::vector<SerializedAsset>&    assets)
 {
     msgpack::object                            msgpackObject;
     msgpack::zone                            mempool;
@@ -106,10 +134,7 @@ AbstractSerializerParser::extractDependencies(AssetLibraryPtr
     for (int index = 0; index < nbDependencies; ++index)
     {
         if (offset >(dataOffset + dependenciesSize))
-        {
-            _error->execute(shared_from_this(), Error("DependencyParsingError", "Error while parsing dependencies"));
-            return;
-        }
+            return false;
 
         auto assetSize = readUInt(data, offset);
 
@@ -118,10 +143,12 @@ AbstractSerializerParser::extractDependencies(AssetLibraryPtr
         msgpack::unpack((char*)&data[offset], assetSize, NULL, &mempool, &msgpackObject);
         msgpackObject.convert(&serializedAsset);
 
-        deserializeAsset(serializedAsset, assetLibrary, options, assetFilePath);
+        assets.push_back(serializedAsset);
 
         offset += assetSize;
     }
+
+    return true;
 }
 
 void
@@ -310,12 +337,45 @@ AbstractSerializerParser::readHeader(const std::string&                    filen
                                      const std::vector<unsigned char>&     data,
                                      int                                   extension)
 {
+    return readHeader(filename, data.data(), data.size(), extension);
+}
+
+bool
+AbstractSerializerParser::readHeader(const std::string&                    filename,
+                                     const unsigned char*                  data,
+                                     size_t                                size,
+                                     int                                   extension)
+{
+    std::string errorMessage;
+
+    if (!readHeader(filename, data, size, extension, errorMessage))
+    {
+        _error->execute(shared_from_this(), Error("InvalidFile", errorMessage));
+        return false;
+    }
+
+    return true;
+}
+
+bool
+AbstractSerializerParser::readHeader(const std::string&                    filename,
+                                     const unsigned char*                  data,
+                                     size_t                                size,
+                                     int                                   extension,
+                                     std::string&                          errorMessage)
+{
+    if (size < MINKO_SCENE_HEADER_SIZE)
+    {
+        errorMessage = "Invalid scene file '" + filename + "': truncated header";
+        return false;
+    }
+
     _magicNumber = readInt(data, 0);
 
     //File should start with 0x4D4B03 (MK3). Last byte reserved for extensions (Material, Geometry...)
     if (_magicNumber != MINKO_SCENE_MAGIC_NUMBER + (extension & 0xFF))
     {
-        _error->execute(shared_from_this(), Error("InvalidFile", "Invalid scene file '" + filename + "': magic number mismatch"));
+        errorMessage = "Invalid scene file '" + filename + "': magic number mismatch";
         return false;
     }
 
@@ -330,11 +390,10 @@ AbstractSerializerParser::readHeader(const std::string&                    filen
         auto fileVersion = std::to_string(_versionHi) + "." + std::to_string(_versionLow) + "." + std::to_string(_versionBuild);
         auto sceneVersion = std::to_string(MINKO_SCENE_VERSION_HI) + "." + std::to_string(MINKO_SCENE_VERSION_LO) + "." + std::to_string(MINKO_SCENE_VERSION_BUILD);
 
-        auto message = "File " + filename + " doesn't match serializer version (file has v" + fileVersion + " while current version is v" + sceneVersion + ")";
+        errorMessage = "File " + filename + " doesn't match serializer version (file has v" + fileVersion + " while current version is v" + sceneVersion + ")";
+
+        std::cerr << errorMessage << std::endl;
 
-        std::cerr << message << std::endl;
-        
-        _error->execute(shared_from_this(), Error("InvalidFile", message));
         return false;
     }
 
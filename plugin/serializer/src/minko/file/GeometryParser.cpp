@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/deserialize/TypeDeserializer.hpp"
 #include "minko/file/Options.hpp"
+#include "minko/file/File.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -110,40 +111,93 @@ GeometryParser::parse(const std::string&                filename,
                       const std::vector<unsigned char>&    data,
                       std::shared_ptr<AssetLibrary>        assetLibrary)
 {
-    if (!readHeader(filename, data, 0x47))
+    parseGeometry(
+        filename,
+        resolvedFilename,
+        options,
+        data.data(),
+        data.size(),
+        assetLibrary,
+        (std::vector<unsigned char>*)&data
+    );
+}
+
+void
+GeometryParser::parseFile(std::shared_ptr<File>            file,
+                          std::shared_ptr<Options>         options,
+                          std::shared_ptr<AssetLibrary>    assetLibrary)
+{
+    // loaded files are released as soon as they are decoded, mapped ones are read in place
+    if (file->mappedFile() == nullptr)
+        parse(file->filename(), file->resolvedFilename(), options, file->data(), assetLibrary);
+    else
+        parseGeometry(file->filename(), file->resolvedFilename(), options, file->bytes(), file->size(), assetLibrary, nullptr);
+}
+
+void
+GeometryParser::parseGeometry(const std::string&                filename,
+                              const std::string&                resolvedFilename,
+                              std::shared_ptr<Options>          options,
+                              const unsigned char*              data,
+                              size_t                            size,
+                              std::shared_ptr<AssetLibrary>     assetLibrary,
+                              std::vector<unsigned char>*       disposableData)
+{
+    if (!readHeader(filename, data, size, 0x47))
         return;
 
-    msgpack::object            msgpackObject;
-    msgpack::zone            mempool;
     std::string                folderPathName = extractFolderPath(resolvedFilename);
     extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderPathName);
     geometry::Geometry::Ptr geom    = geometry::Geometry::create();
-    SerializedGeometry        serializedGeometry;
+    std::string                name;
+    auto                    sceneData = data + _headerSize + _dependenciesSize;
+
+    if (_sceneDataSize >= 4 && readUInt(sceneData, 0) == MINKO_GEOMETRY_CHUNK_MAGIC)
+    {
+        if (!parseAlignedGeometry(filename, sceneData, _sceneDataSize, options->context(), geom, name))
+            return;
+
+        if (disposableData)
+        {
+            disposableData->clear();
+            disposableData->shrink_to_fit();
+        }
+    }
+    else
+    {
+        msgpack::object            msgpackObject;
+        msgpack::zone            mempool;
+        SerializedGeometry        serializedGeometry;
 
-    msgpack::unpack((char*)&data[_headerSize + _dependenciesSize], _sceneDataSize, NULL, &mempool, &msgpackObject);
-    msgpackObject.convert(&serializedGeometry);
+        msgpack::unpack((char*)sceneData, _sceneDataSize, NULL, &mempool, &msgpackObject);
+        msgpackObject.convert(&serializedGeometry);
 
-    std::vector<unsigned char>* d = (std::vector<unsigned char>*)&data;
-    d->clear();
-    d->shrink_to_fit();
+        if (disposableData)
+        {
+            disposableData->clear();
+            disposableData->shrink_to_fit();
+        }
 
-    uint indexBufferFunction = 0;
-    uint vertexBufferFunction = 0;
+        uint indexBufferFunction = 0;
+        uint vertexBufferFunction = 0;
 
-    computeMetaByte(serializedGeometry.a0, indexBufferFunction, vertexBufferFunction);
+        computeMetaByte(serializedGeometry.a0, indexBufferFunction, vertexBufferFunction);
 
-    geom->indices(indexBufferParserFunctions[indexBufferFunction](serializedGeometry.a2, options->context()));
-    serializedGeometry.a2.clear();
-    serializedGeometry.a2.shrink_to_fit();
+        geom->indices(indexBufferParserFunctions[indexBufferFunction](serializedGeometry.a2, options->context()));
+        serializedGeometry.a2.clear();
+        serializedGeometry.a2.shrink_to_fit();
 
-    for (std::string serializedVertexBuffer : serializedGeometry.a3)
-    {
-        geom->addVertexBuffer(vertexBufferParserFunctions[vertexBufferFunction](serializedVertexBuffer, options->context()));
-        serializedVertexBuffer.clear();
-        serializedVertexBuffer.shrink_to_fit();
+        for (auto& serializedVertexBuffer : serializedGeometry.a3)
+        {
+            geom->addVertexBuffer(vertexBufferParserFunctions[vertexBufferFunction](serializedVertexBuffer, options->context()));
+            serializedVertexBuffer.clear();
+            serializedVertexBuffer.shrink_to_fit();
+        }
+
+        name = serializedGeometry.a1;
     }
 
-    geom = options->geometryFunction()(serializedGeometry.a1, geom);
+    geom = options->geometryFunction()(name, geom);
 
     if (options->disposeIndexBufferAfterLoading())
     {
@@ -155,8 +209,135 @@ GeometryParser::parse(const std::string&                filename,
         geom->disposeVertexBufferData();
     }
 
-    assetLibrary->geometry(serializedGeometry.a1, geom);
-    _lastParsedAssetName = serializedGeometry.a1;
+    assetLibrary->geometry(name, geom);
+    _lastParsedAssetName = name;
+}
+
+bool
+GeometryParser::parseAlignedGeometry(const std::string&         filename,
+                                     const unsigned char*       chunk,
+                                     size_t                     size,
+                                     AbstractContextPtr         context,
+                                     geometry::Geometry::Ptr    geometry,
+                                     std::string&               name)
+{
+    size_t offset = 4;
+
+    auto fits = [&](size_t position, size_t length) -> bool
+    {
+        return position <= size && length <= size - position;
+    };
+
+    if (!fits(offset, 4) || !fits(offset + 4, (size_t)readUInt(chunk, offset) + 12))
+    {
+        _error->execute(shared_from_this(), Error("InvalidFile", "Invalid geometry file '" + filename + "': truncated chunk"));
+        return false;
+    }
+
+    auto nameLength = readUInt(chunk, offset);
+
+    offset += 4;
+    name.assign(reinterpret_cast<const char*>(chunk + offset), nameLength);
+    offset += nameLength;
+
+    auto numIndices         = readUInt(chunk, offset);
+    auto indicesOffset      = readUInt(chunk, offset + 4);
+    auto numVertexBuffers   = readUInt(chunk, offset + 8);
+
+    offset += 12;
+
+    if (!fits(indicesOffset, (size_t)numIndices * sizeof(unsigned short)))
+    {
+        _error->execute(shared_from_this(), Error("InvalidFile", "Invalid geometry file '" + filename + "': index data out of bounds"));
+        return false;
+    }
+
+    geometry->indices(createIndexBuffer(chunk + indicesOffset, numIndices, context));
+
+    for (uint i = 0; i < numVertexBuffers; ++i)
+    {
+        if (!fits(offset, 9))
+        {
+            _error->execute(shared_from_this(), Error("InvalidFile", "Invalid geometry file '" + filename + "': truncated chunk"));
+            return false;
+        }
+
+        auto numFloats      = readUInt(chunk, offset);
+        auto dataOffset     = readUInt(chunk, offset + 4);
+        auto numAttributes  = chunk[offset + 8];
+
+        offset += 9;
+
+        if (!fits(dataOffset, (size_t)numFloats * sizeof(float)))
+        {
+            _error->execute(shared_from_this(), Error("InvalidFile", "Invalid geometry file '" + filename + "': vertex data out of bounds"));
+            return false;
+        }
+
+        auto vertexBuffer = createVertexBuffer(chunk + dataOffset, numFloats, context);
+
+        for (uint j = 0; j < numAttributes; ++j)
+        {
+            auto attributeNameLength = fits(offset, 1) ? chunk[offset] : 0;
+
+            if (!fits(offset, attributeNameLength + 3))
+            {
+                _error->execute(shared_from_this(), Error("InvalidFile", "Invalid geometry file '" + filename + "': truncated chunk"));
+                return false;
+            }
+
+            auto attributeName = std::string(reinterpret_cast<const char*>(chunk + offset + 1), attributeNameLength);
+
+            offset += 1 + attributeNameLength;
+            vertexBuffer->addAttribute(attributeName, chunk[offset], chunk[offset + 1]);
+            offset += 2;
+        }
+
+        geometry->addVertexBuffer(vertexBuffer);
+    }
+
+    return true;
+}
+
+GeometryParser::IndexBufferPtr
+GeometryParser::createIndexBuffer(const unsigned char*  data,
+                                  uint                  numIndices,
+                                  AbstractContextPtr    context)
+{
+    // blocks written by GeometryWriter are aligned, copy only when the chunk itself was moved
+    if (reinterpret_cast<uintptr_t>(data) % sizeof(unsigned short) == 0)
+    {
+        auto begin = reinterpret_cast<const unsigned short*>(data);
+
+        return render::IndexBuffer::create(context, begin, begin + numIndices);
+    }
+
+    std::vector<unsigned short> indices(numIndices);
+
+    if (numIndices > 0)
+        std::memcpy(indices.data(), data, numIndices * sizeof(unsigned short));
+
+    return render::IndexBuffer::create(context, indices);
+}
+
+GeometryParser::VertexBufferPtr
+GeometryParser::createVertexBuffer(const unsigned char* data,
+                                   uint                 numFloats,
+                                   AbstractContextPtr   context)
+{
+    if (reinterpret_cast<uintptr_t>(data) % sizeof(float) == 0)
+    {
+        auto begin = reinterpret_cast<const float*>(data);
+
+        return render::VertexBuffer::create(context, begin, begin + numFloats);
+    }
+
+    std::vector<float> vertices(numFloats);
+
+    if (numFloats > 0)
+        std::memcpy(vertices.data(), data, numFloats * sizeof(float));
+
+    return render::VertexBuffer::create(context, vertices);
 }
 
 void
@@ -72,6 +72,16 @@ GeometryWriter::embed(std::shared_ptr<AssetLibrary>        assetLibrary,
                       WriterOptions::Ptr                writerOptions)
 {
     geometry::Geometry::Ptr        geometry                = data();
+
+    if (writerOptions->alignGeometryData())
+    {
+        _dataAlignment = MINKO_GEOMETRY_CHUNK_ALIGNMENT;
+
+        return serializeAlignedGeometry(geometry, assetLibrary->geometryName(geometry));
+    }
+
+    _dataAlignment = 1;
+
     uint                        indexBufferFunctionId    = 0;
     uint                        vertexBufferFunctionId    = 0;
     uint                        metaByte                = computeMetaByte(geometry, indexBufferFunctionId, vertexBufferFunctionId, writerOptions);
@@ -134,6 +144,95 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
     return sbuf.str();
 }
 
+/*
+ * Aligned chunk layout, offsets are relative to the beginning of the chunk and integers of the
+ * table are big endian like the file header:
+ *
+ * uint magic | uint name length | name | uint num indices | uint indices offset | uint num vertex buffers
+ * for each vertex buffer: uint num floats | uint data offset | uchar num attributes
+ *     for each attribute: uchar name length | name | uchar size | uchar offset
+ *
+ * Index (unsigned short) and vertex (float) blocks follow the table, each one starting on a
+ * MINKO_GEOMETRY_CHUNK_ALIGNMENT boundary and stored in native byte order like TypeSerializer does.
+ */
+std::string
+GeometryWriter::serializeAlignedGeometry(std::shared_ptr<geometry::Geometry>    geometry,
+                                         const std::string&                     name)
+{
+    const auto&         indices             = geometry->indices()->data();
+    const auto&         vertexBuffers       = geometry->vertexBuffers();
+    std::vector<size_t> dataOffsetPositions;
+    std::string         chunk;
+
+    writeUInt(chunk, MINKO_GEOMETRY_CHUNK_MAGIC, chunk.size());
+    writeUInt(chunk, name.size(), chunk.size());
+    chunk += name;
+
+    writeUInt(chunk, indices.size(), chunk.size());
+    dataOffsetPositions.push_back(chunk.size());
+    writeUInt(chunk, 0, chunk.size());
+
+    writeUInt(chunk, vertexBuffers.size(), chunk.size());
+
+    for (const auto& vertexBuffer : vertexBuffers)
+    {
+        const auto& attributes = vertexBuffer->attributes();
+
+        writeUInt(chunk, vertexBuffer->data().size(), chunk.size());
+        dataOffsetPositions.push_back(chunk.size());
+        writeUInt(chunk, 0, chunk.size());
+
+        chunk.push_back(static_cast<char>(attributes.size()));
+
+        for (const auto& attribute : attributes)
+        {
+            const auto& attributeName = std::get<0>(*attribute);
+
+            chunk.push_back(static_cast<char>(attributeName.size()));
+            chunk += attributeName;
+            chunk.push_back(static_cast<char>(std::get<1>(*attribute)));
+            chunk.push_back(static_cast<char>(std::get<2>(*attribute)));
+        }
+    }
+
+    alignBuffer(chunk);
+    writeUInt(chunk, chunk.size(), dataOffsetPositions[0]);
+    chunk.append(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(unsigned short));
+
+    auto dataOffsetPositionIt = dataOffsetPositions.begin() + 1;
+
+    for (const auto& vertexBuffer : vertexBuffers)
+    {
+        const auto& vertices = vertexBuffer->data();
+
+        alignBuffer(chunk);
+        writeUInt(chunk, chunk.size(), *dataOffsetPositionIt++);
+        chunk.append(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(float));
+    }
+
+    return chunk;
+}
+
+void
+GeometryWriter::writeUInt(std::string& buffer, unsigned int value, size_t position)
+{
+    if (buffer.size() < position + 4)
+        buffer.resize(position + 4);
+
+    buffer[position] = static_cast<char>((value >> 24) & 0xFF);
+    buffer[position + 1] = static_cast<char>((value >> 16) & 0xFF);
+    buffer[position + 2] = static_cast<char>((value >> 8) & 0xFF);
+    buffer[position + 3] = static_cast<char>(value & 0xFF);
+}
+
+void
+GeometryWriter::alignBuffer(std::string& buffer)
+{
+    const auto alignment = MINKO_GEOMETRY_CHUNK_ALIGNMENT;
+
+    buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, '\0');
+}
+
 unsigned char
 GeometryWriter::computeMetaByte(std::shared_ptr<geometry::Geometry> geometry,
                                 uint&                                indexBufferFunctionId,
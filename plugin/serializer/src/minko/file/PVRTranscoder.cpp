@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/PVRTranscoder.hpp"
 #include "minko/file/WriterOptions.hpp"
 #include "minko/log/Logger.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/MipFilter.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
@@ -77,18 +78,45 @@ PVRTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
     {
         auto texture2d = std::static_pointer_cast<Texture>(texture);
 
+        const auto generateMipmaps = writerOptions->generateMipmaps();
+
+        // the mip levels of uncompressed textures are filtered on the CPU, in linear space if they are sRGB encoded
+        // and with their alpha as a coverage
+        const auto precomputeMipmaps = generateMipmaps && texture2d->format() == TextureFormat::RGBA;
+
+        auto mipChain = std::vector<unsigned char>();
+        auto numMipLevels = 1u;
+
+        if (precomputeMipmaps)
+        {
+            numMipLevels = ImageResampler::generateMipChain(
+                texture2d->width(),
+                texture2d->height(),
+                texture2d->data().data(),
+                writerOptions->mipFilter() == MipFilter::LINEAR
+                    ? ImageResampler::Filter::KAISER
+                    : ImageResampler::Filter::BOX,
+                writerOptions->sRGBTextures(),
+                mipChain,
+                true
+            );
+        }
+
         pvrtexture::CPVRTextureHeader pvrHeader(
             textureFormatToPvrTextureFomat.at(texture->format()),
             texture->height(),
             texture->width(),
             1u,
-            1u,
+            numMipLevels,
             1u,
             1u,
             ePVRTCSpacesRGB
         );
 
-        pvrTexture = std::unique_ptr<pvrtexture::CPVRTexture>(new pvrtexture::CPVRTexture(pvrHeader, texture2d->data().data()));
+        pvrTexture = std::unique_ptr<pvrtexture::CPVRTexture>(new pvrtexture::CPVRTexture(
+            pvrHeader,
+            precomputeMipmaps ? mipChain.data() : texture2d->data().data()
+        ));
 
         if (TextureFormatInfo::isCompressed(texture2d->format()))
         {
@@ -102,9 +130,7 @@ PVRTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
             }
         }
 
-        const auto generateMipmaps = writerOptions->generateMipmaps();
-
-        if (generateMipmaps)
+        if (generateMipmaps && !precomputeMipmaps)
         {
             static const auto mipFilterToPvrMipFilter = std::map<MipFilter, pvrtexture::EResizeMode>
             {
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/QTranscoder.hpp"
 #include "minko/file/WriterOptions.hpp"
 #include "minko/log/Logger.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/MipFilter.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
@@ -106,7 +107,58 @@ QTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
 
         const auto generateMipmaps = writerOptions->generateMipmaps();
 
-        if (generateMipmaps)
+        if (generateMipmaps && texture2d->format() == TextureFormat::RGBA)
+        {
+            // the mip levels of uncompressed textures are filtered on the CPU, in linear space if they
+            // are sRGB encoded and with their alpha as a coverage, then compressed one by one
+            auto mipChain = std::vector<unsigned char>();
+
+            const auto numMipmaps = ImageResampler::generateMipChain(
+                texture2d->width(),
+                texture2d->height(),
+                texture2dData.data(),
+                writerOptions->mipFilter() == MipFilter::LINEAR
+                    ? ImageResampler::Filter::KAISER
+                    : ImageResampler::Filter::BOX,
+                writerOptions->sRGBTextures(),
+                mipChain,
+                true
+            );
+
+            auto mipLevelOffset = 0u;
+
+            for (auto i = 0u; i < numMipmaps; ++i)
+            {
+                const auto mipLevelWidth = std::max(texture2d->width() >> i, 1u);
+                const auto mipLevelHeight = std::max(texture2d->height() >> i, 1u);
+
+                auto qMipLevelTexture = qSrcTexture;
+                qMipLevelTexture.nWidth = mipLevelWidth;
+                qMipLevelTexture.nHeight = mipLevelHeight;
+                qMipLevelTexture.nDataSize = mipLevelWidth * mipLevelHeight * 4;
+                qMipLevelTexture.pData = mipChain.data() + mipLevelOffset;
+
+                auto qDstTexture = TQonvertImage();
+
+                if (!Compress(
+                    &qMipLevelTexture,
+                    &qDstTexture,
+                    textureFormatToQTextureFomat.at(outFormat),
+                    mipLevelWidth,
+                    mipLevelHeight))
+                {
+                    return false;
+                }
+
+                out.insert(out.end(), qDstTexture.pData, qDstTexture.pData + qDstTexture.nDataSize);
+
+                delete qDstTexture.pFormatFlags;
+                delete qDstTexture.pData;
+
+                mipLevelOffset += qMipLevelTexture.nDataSize;
+            }
+        }
+        else if (generateMipmaps)
         {
             const auto numMipmaps = CountNumMipLevels(texture2d->width(), texture2d->height());
 
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/file/SceneParser.hpp"
 #include "minko/file/Options.hpp"
+#include "minko/file/File.hpp"
 #include "minko/file/Dependency.hpp"
 #include "minko/file/TextureParser.hpp"
 #include "minko/Types.hpp"
@@ -42,7 +43,12 @@ using namespace minko::math;
 std::unordered_map<int8_t, SceneParser::ComponentReadFunction> SceneParser::_componentIdToReadFunction;
 
 
-SceneParser::SceneParser()
+SceneParser::SceneParser() :
+    _headerError(),
+    _dependenciesUnpacked(false),
+    _serializedAssets(),
+    _componentPack(),
+    _nodePack()
 {
     _geometryParser = file::GeometryParser::create();
     _materialParser = file::MaterialParser::create();
@@ -129,14 +135,40 @@ SceneParser::parse(const std::string&                    filename,
                    const std::vector<unsigned char>&    data,
                    AssetLibraryPtr                        assetLibrary)
 {
-    _dependencies->options(options);
+    decode(filename, data.data(), data.size());
 
-    if (!readHeader(filename, data))
-        return;
+    std::vector<unsigned char>* d = (std::vector<unsigned char>*)&data;
+    d->clear();
+    d->shrink_to_fit();
 
-    std::string         folderPath = extractFolderPath(resolvedFilename);
+    commit(filename, resolvedFilename, options, assetLibrary);
+}
+
+void
+SceneParser::decode(std::shared_ptr<File> file, std::shared_ptr<Options> options)
+{
+    decode(file->filename(), file->bytes(), file->size());
+}
 
-    extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderPath);
+void
+SceneParser::commit(std::shared_ptr<File>            file,
+                    std::shared_ptr<Options>         options,
+                    AssetLibraryPtr                  assetLibrary)
+{
+    commit(file->filename(), file->resolvedFilename(), options, assetLibrary);
+}
+
+void
+SceneParser::decode(const std::string& filename, const unsigned char* data, std::size_t size)
+{
+    _headerError.clear();
+    _serializedAssets.clear();
+
+    if (!readHeader(filename, data, size, 0x00, _headerError))
+        return;
+
+    // the assets are only unpacked here: creating them needs the rendering context
+    _dependenciesUnpacked = unpackDependencies(data, _headerSize, _dependenciesSize, _serializedAssets);
 
     msgpack::object        deserialized;
     msgpack::zone        mempool;
@@ -145,11 +177,39 @@ SceneParser::parse(const std::string&                    filename,
     msgpack::type::tuple<std::vector<std::string>, std::vector<SerializedNode>> dst;
     deserialized.convert(&dst);
 
-    std::vector<unsigned char>* d = (std::vector<unsigned char>*)&data;
-    d->clear();
-    d->shrink_to_fit();
+    _componentPack = std::move(dst.a0);
+    _nodePack = std::move(dst.a1);
+}
+
+void
+SceneParser::commit(const std::string&               filename,
+                    const std::string&               resolvedFilename,
+                    std::shared_ptr<Options>         options,
+                    AssetLibraryPtr                  assetLibrary)
+{
+    _dependencies->options(options);
+
+    if (!_headerError.empty())
+    {
+        _error->execute(shared_from_this(), Error("InvalidFile", _headerError));
+
+        return;
+    }
 
-    assetLibrary->symbol(filename, parseNode(dst.a1, dst.a0, assetLibrary, options));
+    std::string         folderPath = extractFolderPath(resolvedFilename);
+
+    for (auto& serializedAsset : _serializedAssets)
+        deserializeAsset(serializedAsset, assetLibrary, options, folderPath);
+
+    _serializedAssets.clear();
+
+    if (!_dependenciesUnpacked)
+        _error->execute(shared_from_this(), Error("DependencyParsingError", "Error while parsing dependencies"));
+
+    assetLibrary->symbol(filename, parseNode(_nodePack, _componentPack, assetLibrary, options));
+
+    _nodePack.clear();
+    _componentPack.clear();
 
     if (_jobList.size() > 0)
     {
@@ -174,6 +234,7 @@ SceneParser::parseNode(std::vector<SerializedNode>&            nodePack,
     std::queue<std::tuple<scene::Node::Ptr, uint>>        nodeStack;
     std::map<int, std::vector<scene::Node::Ptr>>        componentIdToNodes;
     std::map<scene::Node::Ptr, scene::Node::Ptr>        nodeToParentMap;
+    std::map<scene::Node::Ptr, std::vector<scene::Node::Ptr>>    parentToChildren;
 
     for (uint i = 0; i < nodePack.size(); ++i)
     {
@@ -206,20 +267,16 @@ SceneParser::parseNode(std::vector<SerializedNode>&            nodePack,
                 nodeStack.pop();
 
             nodeToParentMap.insert(std::make_pair(newNode, parent));
+            parentToChildren[parent].push_back(newNode);
         }
 
         if (numChildren > 0)
             nodeStack.push(std::make_tuple(newNode, numChildren));
     }
 
-    for (auto nodeToParentPair : nodeToParentMap)
-    {
-        auto node = nodeToParentPair.first;
-        auto parent = nodeToParentPair.second;
-
-        if (parent != nullptr)
-            parent->addChild(node);
-    }
+    // each parent gets all its children at once
+    for (auto& parentToChildrenPair : parentToChildren)
+        parentToChildrenPair.first->addChildren(parentToChildrenPair.second);
 
     _dependencies->loadedRoot(root);
 
@@ -18,6 +18,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/file/AssetLibrary.hpp"
+#include "minko/file/File.hpp"
 #include "minko/file/Loader.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/PNGParser.hpp"
@@ -28,6 +29,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/OpenGLES2Context.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/TextureStreamer.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -175,7 +177,14 @@ TextureParser::parse(const std::string&                filename,
         const auto textureDataEnd = textureDataBegin + length;
         const auto textureData = std::vector<unsigned char>(textureDataBegin, textureDataEnd);
 
-        if (!_formatParserFunctions.at(desiredFormat)(filename, options, textureData, assetLibrary, textureWidth, textureHeight, textureType, textureNumMipmaps))
+        // streamed mip levels are read back from the file: give the position of the texture in it
+        auto textureOptions = options->textureStreamer()
+            ? options->clone()
+                ->seekingOffset(options->seekingOffset() + offset)
+                ->seekedLength(length)
+            : options;
+
+        if (!_formatParserFunctions.at(desiredFormat)(filename, textureOptions, textureData, assetLibrary, textureWidth, textureHeight, textureType, textureNumMipmaps))
         {
             _error->execute(
                 shared_from_this(),
@@ -251,6 +260,40 @@ TextureParser::parseCompressedTexture(TextureFormat                        forma
             fileName
         );
 
+        if (hasMipmaps && numMipmaps > 1 && options->textureStreamer())
+        {
+            // the streamer reads each mip level from the file when it is requested: no copy of the
+            // chain is kept, whether the texture data is disposed after loading or not
+            const auto chainOffset = options->seekingOffset();
+            auto mipLevelOffsets = std::vector<unsigned int>(numMipmaps + 1, 0u);
+
+            for (auto i = 0; i < numMipmaps; ++i)
+            {
+                const auto mipLevelWidth = std::max<unsigned int>(width >> i, TextureFormatInfo::minimumWidth(format));
+                const auto mipLevelHeight = std::max<unsigned int>(height >> i, TextureFormatInfo::minimumHeight(format));
+
+                mipLevelOffsets[i + 1] = mipLevelOffsets[i] + TextureFormatInfo::textureSize(format, mipLevelWidth, mipLevelHeight);
+            }
+
+            if (mipLevelOffsets.back() > textureData.size())
+                return false;
+
+            options->textureStreamer()->add(texture, numMipmaps, [=](unsigned int level, std::vector<unsigned char>& mipLevelData)
+            {
+                return readMipLevel(
+                    fileName,
+                    options,
+                    chainOffset + mipLevelOffsets[level],
+                    mipLevelOffsets[level + 1] - mipLevelOffsets[level],
+                    mipLevelData
+                );
+            });
+
+            assetLibrary->texture(fileName, texture);
+
+            break;
+        }
+
         const auto storeTextureData = !options->disposeTextureAfterLoading();
 
         if (storeTextureData)
@@ -297,3 +340,45 @@ TextureParser::parseCompressedTexture(TextureFormat                        forma
 
     return true;
 }
+
+bool
+TextureParser::readMipLevel(const std::string&             fileName,
+                            Options::Ptr                   options,
+                            uint64_t                       offset,
+                            unsigned int                   size,
+                            std::vector<unsigned char>&    data)
+{
+    auto mipLevelOptions = options->clone()
+        ->seekingOffset(offset)
+        ->seekedLength(size)
+        ->loadAsynchronously(false)
+        ->storeDataIfNotParsed(false);
+
+    auto loader = Loader::create();
+    auto success = false;
+
+    loader->options(mipLevelOptions);
+
+    auto errorSlot = loader->error()->connect([&](Loader::Ptr, const Error&)
+    {
+        success = false;
+    });
+
+    auto completeSlot = loader->complete()->connect([&](Loader::Ptr loaderThis)
+    {
+        const auto& file = loaderThis->files().at(fileName);
+
+        // memory-mapped files are read in place
+        if (file->size() == size)
+        {
+            data.assign(file->bytes(), file->bytes() + size);
+            success = true;
+        }
+    });
+
+    loader
+        ->queue(fileName)
+        ->load();
+
+    return success;
+}
@@ -38,6 +38,8 @@ WriterOptions::WriterOptions() :
     _upscaleTextureWhenProcessedForMipmapping(true),
     _textureMaxResolution(Vector2::create(2048, 2048)),
     _mipFilter(MipFilter::LINEAR),
-    _optimizeForNormalMapping(false)
+    _optimizeForNormalMapping(false),
+    _sRGBTextures(false),
+    _alignGeometryData(false)
 {
 }
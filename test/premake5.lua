@@ -14,6 +14,7 @@ minko.project.application "minko-tests"
 	-- plugin
 	minko.plugin.enable("sdl")
 	minko.plugin.enable("serializer")
+	minko.plugin.enable("particles")
 
 	-- googletest framework
 	links { "googletest" }
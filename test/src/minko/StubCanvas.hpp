@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+namespace minko
+{
+	/**
+	 * An AbstractCanvas without any window, exposing the given context along with a mouse and a touch
+	 * device that never receive any event.
+	 */
+	class StubCanvas :
+		public AbstractCanvas
+	{
+	public:
+		typedef std::shared_ptr<StubCanvas>	Ptr;
+
+	private:
+		typedef Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>	JoystickSignal;
+
+		class Touch :
+			public input::Touch
+		{
+		public:
+			Touch(AbstractCanvas::Ptr canvas) :
+				input::Touch(canvas)
+			{
+			}
+		};
+
+	private:
+		std::shared_ptr<render::AbstractContext>	_context;
+		std::shared_ptr<data::Provider>				_data;
+		std::shared_ptr<input::Mouse>				_mouse;
+		std::shared_ptr<input::Touch>				_touch;
+		Signal<AbstractCanvas::Ptr, uint, uint>::Ptr	_resized;
+		JoystickSignal::Ptr							_joystickAdded;
+		JoystickSignal::Ptr							_joystickRemoved;
+
+	public:
+		inline static
+		Ptr
+		create(std::shared_ptr<render::AbstractContext> context)
+		{
+			auto canvas = std::shared_ptr<StubCanvas>(new StubCanvas(context));
+
+			canvas->_mouse = input::Mouse::create(canvas);
+			canvas->_touch = std::make_shared<Touch>(canvas);
+
+			return canvas;
+		}
+
+		uint x() { return 0; }
+		uint y() { return 0; }
+		uint width() { return _context->viewportWidth(); }
+		uint height() { return _context->viewportHeight(); }
+		std::shared_ptr<data::Provider> data() const { return _data; }
+		std::shared_ptr<render::AbstractContext> context() { return _context; }
+		std::shared_ptr<input::Mouse> mouse() { return _mouse; }
+		std::shared_ptr<input::Keyboard> keyboard() { return nullptr; }
+		std::shared_ptr<input::Touch> touch() { return _touch; }
+		std::shared_ptr<input::Joystick> joystick(uint id) { return nullptr; }
+		uint numJoysticks() { return 0; }
+		Signal<AbstractCanvas::Ptr, uint, uint>::Ptr resized() { return _resized; }
+		JoystickSignal::Ptr joystickAdded() { return _joystickAdded; }
+		JoystickSignal::Ptr joystickRemoved() { return _joystickRemoved; }
+		int getJoystickAxis(std::shared_ptr<input::Joystick> joystick, int axis) { return 0; }
+		std::shared_ptr<async::Worker> getWorker(const std::string& name) { return nullptr; }
+		float frameDuration() const { return 0.f; }
+		float relativeTime() const { return 0.f; }
+		bool isWorkerRegistered(const std::string& name) { return false; }
+
+	private:
+		StubCanvas(std::shared_ptr<render::AbstractContext> context) :
+			_context(context),
+			_data(data::Provider::create()),
+			_mouse(nullptr),
+			_touch(nullptr),
+			_resized(Signal<AbstractCanvas::Ptr, uint, uint>::create()),
+			_joystickAdded(JoystickSignal::create()),
+			_joystickRemoved(JoystickSignal::create())
+		{
+		}
+	};
+}
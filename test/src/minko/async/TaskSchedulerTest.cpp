@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TaskSchedulerTest.hpp"
+
+using namespace minko;
+using namespace minko::async;
+using namespace minko::component;
+
+TEST_F(TaskSchedulerTest, DependenciesRunFirst)
+{
+	auto scheduler = TaskScheduler::create(3);
+	std::mutex mutex;
+	std::vector<int> order;
+
+	auto log = [&](int id)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		order.push_back(id);
+	};
+
+	auto a = scheduler->schedule([&]() { std::this_thread::sleep_for(std::chrono::milliseconds(10)); log(0); });
+	auto b = scheduler->schedule([&]() { log(1); });
+	auto c = scheduler->schedule([&]() { log(2); }, { a, b });
+
+	scheduler->wait(c);
+
+	ASSERT_EQ(3, order.size());
+	ASSERT_EQ(2, order.back());
+}
+
+TEST_F(TaskSchedulerTest, MainThreadContinuation)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto workerId = std::this_thread::get_id();
+	auto continuationId = workerId;
+
+	auto work = scheduler->schedule([&]() { workerId = std::this_thread::get_id(); });
+	auto continuation = scheduler->schedule([&]() { continuationId = std::this_thread::get_id(); }, { work }, true);
+
+	while (!work->complete())
+		std::this_thread::yield();
+
+	ASSERT_FALSE(continuation->complete());
+	ASSERT_EQ(1, scheduler->runMainThreadTasks());
+	ASSERT_TRUE(continuation->complete());
+	ASSERT_TRUE(workerId != std::this_thread::get_id());
+	ASSERT_TRUE(continuationId == std::this_thread::get_id());
+}
+
+TEST_F(TaskSchedulerTest, WaitRethrows)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto task = scheduler->schedule([]() { throw std::runtime_error("task"); });
+
+	ASSERT_THROW(scheduler->wait(task), std::runtime_error);
+}
+
+TEST_F(TaskSchedulerTest, NestedTasks)
+{
+	auto scheduler = TaskScheduler::create(4);
+	std::atomic<uint> count(0);
+	std::vector<TaskScheduler::TaskPtr> children(100);
+
+	auto parent = scheduler->schedule([&]()
+	{
+		for (auto& child : children)
+			child = scheduler->schedule([&]() { ++count; });
+	});
+
+	scheduler->wait(parent);
+
+	for (auto& child : children)
+		scheduler->wait(child);
+
+	ASSERT_EQ(100, count);
+}
+
+TEST_F(TaskSchedulerTest, WithoutWorkers)
+{
+	auto scheduler = TaskScheduler::create(0);
+	auto done = false;
+	auto task = scheduler->schedule([&]() { done = true; });
+
+	ASSERT_FALSE(done);
+	ASSERT_EQ(1, scheduler->runMainThreadTasks());
+	ASSERT_TRUE(done);
+	ASSERT_TRUE(task->complete());
+}
+
+TEST_F(TaskSchedulerTest, MainThreadCostBudget)
+{
+	auto scheduler = TaskScheduler::create(0);
+	auto numRuns = 0;
+
+	for (auto i = 0; i < 3; ++i)
+		scheduler->schedule([&]() { ++numRuns; }, {}, true, []() { return 3u; });
+
+	ASSERT_EQ(1, scheduler->runMainThreadTasks(-1.f, 2));
+	ASSERT_EQ(1, numRuns);
+	ASSERT_EQ(2, scheduler->runMainThreadTasks(-1.f, 6));
+	ASSERT_EQ(3, numRuns);
+}
+
+class CountJob :
+	public JobManager::Job
+{
+public:
+	int		numSteps;
+	bool	finished;
+
+	CountJob() :
+		numSteps(0),
+		finished(false)
+	{
+	}
+
+	bool
+	complete()
+	{
+		return numSteps == 1000;
+	}
+
+	void
+	beforeFirstStep()
+	{
+	}
+
+	void
+	step()
+	{
+		++numSteps;
+	}
+
+	float
+	priority()
+	{
+		return 1.f;
+	}
+
+	void
+	afterLastStep()
+	{
+		finished = true;
+	}
+};
+
+TEST_F(TaskSchedulerTest, JobManagerOffMainThreadJob)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto jobManager = JobManager::create(30, scheduler);
+	auto job = std::make_shared<CountJob>();
+
+	job->offMainThread(true);
+	jobManager->pushJob(job);
+
+	for (auto i = 0; i < 100 && !job->finished; ++i)
+	{
+		jobManager->update(nullptr);
+		jobManager->end(nullptr);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_TRUE(job->finished);
+	ASSERT_EQ(1000, job->numSteps);
+}
@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadPoolTest.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+TEST_F(ThreadPoolTest, ParallelForCoversRangeOnce)
+{
+	auto pool = ThreadPool::create(3);
+	std::vector<int> counts(10000, 0);
+
+	pool->parallelFor(0, counts.size(), 64, [&](uint begin, uint end)
+	{
+		for (auto i = begin; i < end; ++i)
+			++counts[i];
+	});
+
+	ASSERT_EQ(std::count(counts.begin(), counts.end(), 1), counts.size());
+}
+
+TEST_F(ThreadPoolTest, ParallelForWithoutThreads)
+{
+	auto pool = ThreadPool::create(0);
+	auto chunks = std::vector<std::pair<uint, uint>>();
+
+	pool->parallelFor(10, 25, 10, [&](uint begin, uint end)
+	{
+		chunks.push_back(std::make_pair(begin, end));
+	});
+
+	ASSERT_EQ(pool->numThreads(), 0);
+	ASSERT_EQ(chunks.size(), 2);
+	ASSERT_EQ(chunks[0], std::make_pair(10u, 20u));
+	ASSERT_EQ(chunks[1], std::make_pair(20u, 25u));
+}
+
+TEST_F(ThreadPoolTest, ParallelForRethrows)
+{
+	auto pool = ThreadPool::create(2);
+
+	ASSERT_THROW(
+		pool->parallelFor(0, 100, 1, [&](uint begin, uint end)
+		{
+			if (begin == 42)
+				throw std::runtime_error("42");
+		}),
+		std::runtime_error
+	);
+}
+
+TEST_F(ThreadPoolTest, NestedParallelFor)
+{
+	auto pool = ThreadPool::create(2);
+	std::vector<int> counts(64 * 64, 0);
+
+	pool->parallelFor(0, 64, 1, [&](uint i, uint)
+	{
+		pool->parallelFor(0, 64, 8, [&](uint begin, uint end)
+		{
+			for (auto j = begin; j < end; ++j)
+				++counts[i * 64 + j];
+		});
+	});
+
+	ASSERT_EQ(std::count(counts.begin(), counts.end(), 1), counts.size());
+}
+
+TEST_F(ThreadPoolTest, SharedPoolRunsOnTheSharedScheduler)
+{
+	ASSERT_EQ(ThreadPool::instance()->numThreads(), TaskScheduler::instance()->numWorkers());
+}
+
+TEST_F(ThreadPoolTest, ParallelForFromSchedulerTasks)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto pool = ThreadPool::create(scheduler);
+	std::vector<int> counts(8 * 1024, 0);
+	std::vector<TaskScheduler::TaskPtr> tasks;
+
+	// the loops share the workers running the tasks that start them
+	for (uint i = 0; i < 8; ++i)
+		tasks.push_back(scheduler->schedule([&, i]()
+		{
+			pool->parallelFor(i * 1024, (i + 1) * 1024, 16, [&](uint begin, uint end)
+			{
+				for (auto j = begin; j < end; ++j)
+					++counts[j];
+			});
+		}));
+
+	for (auto& task : tasks)
+		scheduler->wait(task);
+
+	ASSERT_EQ(pool->numThreads(), 2);
+	ASSERT_EQ(std::count(counts.begin(), counts.end(), 1), counts.size());
+}
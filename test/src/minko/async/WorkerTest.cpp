@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "WorkerTest.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+namespace minko
+{
+	namespace async
+	{
+		MINKO_DEFINE_WORKER(EchoWorker,
+		{
+			for (auto i = 0; i < 10; ++i)
+				post(Message { "progress" }.set(i));
+
+			post(Message { "complete" }.set(std::vector<char>(input)));
+		});
+	}
+}
+
+TEST_F(WorkerTest, MpscQueueKeepsOrderPerProducer)
+{
+	MpscQueue<std::pair<int, int>> queue;
+	std::vector<std::thread> producers;
+
+	for (auto producer = 0; producer < 4; ++producer)
+		producers.push_back(std::thread([&, producer]()
+		{
+			for (auto i = 0; i < 10000; ++i)
+				queue.push(std::make_pair(producer, i));
+		}));
+
+	std::vector<int> next(4, 0);
+	auto numPopped = 0;
+	std::pair<int, int> value;
+
+	while (numPopped < 40000)
+	{
+		if (!queue.pop(value))
+			continue;
+
+		ASSERT_EQ(next[value.first], value.second);
+		++next[value.first];
+		++numPopped;
+	}
+
+	for (auto& producer : producers)
+		producer.join();
+
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(WorkerTest, ConcurrentRequestsDoNotCrossTalk)
+{
+	auto worker = EchoWorker::create("echo");
+	std::map<uint, std::string> outputs;
+	std::map<uint, int> numProgressMessages;
+
+	auto _ = worker->message()->connect([&](Worker::Ptr, const Worker::Message& message)
+	{
+		if (message.type == "complete")
+			outputs[message.requestId] = std::string(message.data.begin(), message.data.end());
+		else
+			++numProgressMessages[message.requestId];
+	});
+
+	std::map<uint, std::string> inputs;
+
+	for (auto i = 0; i < 20; ++i)
+	{
+		auto input = "request " + std::to_string(i);
+
+		inputs[worker->start(std::vector<char>(input.begin(), input.end()))] = input;
+	}
+
+	for (auto i = 0; i < 1000 && outputs.size() < inputs.size(); ++i)
+	{
+		worker->poll();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_TRUE(outputs == inputs);
+
+	for (auto& requestIdAndInput : inputs)
+		ASSERT_EQ(10, numProgressMessages[requestIdAndInput.first]);
+}
+
+TEST_F(WorkerTest, HandlersOnlyReceiveTheirMessages)
+{
+	auto worker = EchoWorker::create("echo");
+	std::map<uint, std::string> inputs;
+	std::map<uint, std::string> outputs;
+	std::map<uint, int> numProgressMessages;
+	auto numMessages = 0;
+
+	auto _ = worker->message()->connect([&](Worker::Ptr, const Worker::Message&)
+	{
+		++numMessages;
+	});
+
+	for (auto i = 0; i < 20; ++i)
+	{
+		auto input = "request " + std::to_string(i);
+		auto requestId = std::make_shared<uint>(0);
+
+		*requestId = worker->start(std::vector<char>(input.begin(), input.end()), [&, requestId](const Worker::Message& message)
+		{
+			ASSERT_EQ(*requestId, message.requestId);
+			ASSERT_EQ(0, outputs.count(message.requestId));
+
+			if (message.type == "complete")
+				outputs[message.requestId] = std::string(message.data.begin(), message.data.end());
+			else
+				++numProgressMessages[message.requestId];
+		});
+		inputs[*requestId] = input;
+	}
+
+	for (auto i = 0; i < 1000 && outputs.size() < inputs.size(); ++i)
+	{
+		worker->poll();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_TRUE(outputs == inputs);
+	ASSERT_EQ(20 * 11, numMessages);
+
+	for (auto& requestIdAndInput : inputs)
+		ASSERT_EQ(10, numProgressMessages[requestIdAndInput.first]);
+}
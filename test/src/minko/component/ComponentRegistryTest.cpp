@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/ComponentRegistryTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+namespace
+{
+	class TestComponent :
+		public AbstractComponent
+	{
+	public:
+		static
+		std::shared_ptr<TestComponent>
+		create()
+		{
+			return std::shared_ptr<TestComponent>(new TestComponent());
+		}
+	};
+}
+
+TEST_F(ComponentRegistryTest, IndexesExistingComponents)
+{
+	auto component1 = TestComponent::create();
+	auto component2 = TestComponent::create();
+	auto root = Node::create()
+		->addComponent(component1)
+		->addChild(Node::create()->addComponent(component2));
+	auto registry = ComponentRegistry<TestComponent>::create();
+
+	root->addComponent(registry);
+
+	ASSERT_EQ(registry->components().size(), 2);
+	ASSERT_TRUE(registry->contains(component1));
+	ASSERT_TRUE(registry->contains(component2));
+}
+
+TEST_F(ComponentRegistryTest, IndexesAddedChildren)
+{
+	auto root = Node::create();
+	auto registry = ComponentRegistry<TestComponent>::create();
+	auto component = TestComponent::create();
+
+	root->addComponent(registry);
+	root->addChild(Node::create()->addChild(Node::create()->addComponent(component)));
+
+	ASSERT_EQ(registry->components().size(), 1);
+	ASSERT_TRUE(registry->contains(component));
+}
+
+TEST_F(ComponentRegistryTest, UnindexesRemovedChildren)
+{
+	auto root = Node::create();
+	auto child = Node::create();
+	auto registry = ComponentRegistry<TestComponent>::create();
+	auto component1 = TestComponent::create();
+	auto component2 = TestComponent::create();
+
+	root->addComponent(registry)->addComponent(component1)->addChild(child);
+	child->addComponent(component2);
+
+	ASSERT_EQ(registry->components().size(), 2);
+
+	root->removeChild(child);
+
+	ASSERT_EQ(registry->components().size(), 1);
+	ASSERT_EQ(registry->components()[0], component1);
+}
+
+TEST_F(ComponentRegistryTest, ComponentAddedAndRemoved)
+{
+	auto root = Node::create();
+	auto child = Node::create();
+	auto registry = ComponentRegistry<TestComponent>::create();
+	auto component = TestComponent::create();
+
+	root->addComponent(registry)->addChild(child);
+	child->addComponent(component);
+
+	ASSERT_TRUE(registry->contains(component));
+
+	child->removeComponent(component);
+
+	ASSERT_FALSE(registry->contains(component));
+	ASSERT_TRUE(registry->components().empty());
+}
+
+TEST_F(ComponentRegistryTest, BatchedChildrenIndexedOnce)
+{
+	auto root = Node::create();
+	auto child = Node::create();
+	auto registry = ComponentRegistry<TestComponent>::create();
+
+	root->addComponent(registry);
+
+	root->beginBatch();
+	root->addChild(child);
+	child->addComponent(TestComponent::create());
+	root->commitBatch();
+
+	ASSERT_EQ(registry->components().size(), 1);
+}
+
+TEST_F(ComponentRegistryTest, RegistryMovedToAnotherScene)
+{
+	auto scene1 = Node::create()->addComponent(TestComponent::create());
+	auto scene2 = Node::create()->addComponent(TestComponent::create())->addComponent(TestComponent::create());
+	auto node = Node::create();
+	auto registry = ComponentRegistry<TestComponent>::create();
+
+	node->addComponent(registry);
+	scene1->addChild(node);
+
+	ASSERT_EQ(registry->components().size(), 1);
+
+	scene2->addChild(node);
+
+	ASSERT_EQ(registry->components().size(), 2);
+}
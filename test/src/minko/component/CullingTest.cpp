@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CullingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/render/StubEffect.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(CullingTest, SurfacesCollectedByAddChildren)
+{
+	auto context = MinkoTests::canvas()->context();
+	auto root = Node::create("root")->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto renderer = Renderer::create();
+	auto camera = Node::create("camera")
+		->addComponent(renderer)
+		->addComponent(PerspectiveCamera::create(1.f))
+		->addComponent(Culling::create(math::Frustum::create(), "camera.worldToScreenMatrix"));
+	auto effect = render::StubEffect::create(context);
+	auto group = Node::create("group");
+	auto culled = render::StubEffect::createSurfaceNode(context, effect);
+	auto notCulled = render::StubEffect::createSurfaceNode(context, effect);
+
+	culled->layouts(culled->layouts() | Layout::Group::CULLING);
+	root->addChild(camera);
+	group->addChildren({ culled, notCulled });
+	root->addChildren({ group });
+
+	// surfaces are culled from the time they are collected until the next frustum test
+	ASSERT_TRUE(renderer->culled(culled->component<Surface>()));
+	ASSERT_FALSE(renderer->culled(notCulled->component<Surface>()));
+}
+
+TEST_F(CullingTest, SurfacesReleasedByRemoveChildren)
+{
+	auto context = MinkoTests::canvas()->context();
+	auto root = Node::create("root")->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto renderer = Renderer::create();
+	auto camera = Node::create("camera")
+		->addComponent(renderer)
+		->addComponent(PerspectiveCamera::create(1.f))
+		->addComponent(Culling::create(math::Frustum::create(), "camera.worldToScreenMatrix"));
+	auto effect = render::StubEffect::create(context);
+	auto group = Node::create("group");
+	auto surfaceNodes = std::vector<Node::Ptr>({ render::StubEffect::createSurfaceNode(context, effect), render::StubEffect::createSurfaceNode(context, effect) });
+
+	for (auto node : surfaceNodes)
+		node->layouts(node->layouts() | Layout::Group::CULLING);
+	group->addChildren(surfaceNodes);
+	root->addChildren({ camera, group });
+
+	for (auto node : surfaceNodes)
+		ASSERT_TRUE(renderer->culled(node->component<Surface>()));
+
+	group->removeChildren();
+
+	for (auto node : surfaceNodes)
+		ASSERT_FALSE(renderer->culled(node->component<Surface>()));
+
+	// surfaces outside of the culling layout must not be collected when they come back
+	surfaceNodes[1]->layouts(surfaceNodes[1]->layouts() & ~Layout::Group::CULLING);
+	group->beginBatch();
+	for (auto node : surfaceNodes)
+		group->addChild(node);
+	group->commitBatch();
+
+	ASSERT_TRUE(renderer->culled(surfaceNodes[0]->component<Surface>()));
+	ASSERT_FALSE(renderer->culled(surfaceNodes[1]->component<Surface>()));
+}
@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleSystemTest.hpp"
+#include "minko/render/StubContext.hpp"
+#include "minko/render/StubEffect.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::particle;
+
+ParticleSystem::Ptr
+ParticleSystemTest::createParticleSystem(std::shared_ptr<render::AbstractContext> context)
+{
+	auto assets = file::AssetLibrary::create(context);
+
+	assets->effect("particles", render::StubEffect::create(context));
+
+	// one particle per second living 100 seconds: the system holds up to 100 particles
+	auto particleSystem = ParticleSystem::create(
+		assets,
+		1.f,
+		sampler::Constant<float>::create(100.f),
+		shape::Point::create(),
+		StartDirection::NONE,
+		nullptr
+	);
+
+	auto localToWorld = particleSystem->localToWorld();
+
+	for (auto i = 0; i < 16; ++i)
+		localToWorld[i] = i % 5 == 0 ? 1.f : 0.f;
+
+	return particleSystem->emitting(false);
+}
+
+void
+ParticleSystemTest::spawnParticles(ParticleSystem::Ptr particleSystem, const std::vector<float>& x)
+{
+	for (auto value : x)
+	{
+		ParticleData particle;
+
+		particle.x = value;
+		particle.lifetime = 100.f;
+
+		particleSystem->particles()->spawn(particle);
+	}
+}
+
+std::vector<float>
+ParticleSystemTest::particlePositionsX(geometry::ParticlesGeometry::Ptr geometry, uint numParticles)
+{
+	auto vertexBuffer = geometry->particlesData()->get<render::VertexBuffer::Ptr>("position");
+	auto vertexSize = vertexBuffer->vertexSize();
+	auto particleSize = geometry->verticesPerParticle() * vertexSize;
+	auto x = std::vector<float>();
+
+	for (auto i = 0u; i < numParticles; ++i)
+	{
+		// without instancing, the attributes of a particle are repeated for the 4 corners of its quad
+		for (auto j = 1u; j < geometry->verticesPerParticle(); ++j)
+			EXPECT_EQ(vertexBuffer->data()[i * particleSize + j * vertexSize], vertexBuffer->data()[i * particleSize]);
+
+		x.push_back(vertexBuffer->data()[i * particleSize]);
+	}
+
+	return x;
+}
+
+TEST_F(ParticleSystemTest, SortedFarthestFirst)
+{
+	auto context = render::StubContext::create();
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto particleSystem = createParticleSystem(context)->isZSorted(true)->play();
+	auto root = scene::Node::create("root")->addComponent(sceneManager)->addComponent(particleSystem);
+	auto geometry = std::static_pointer_cast<geometry::ParticlesGeometry>(root->component<Surface>()->geometry());
+
+	particleSystem->cameraPos()[0] = 10.f;
+	spawnParticles(particleSystem, { 3.f, 0.f, 4.f, 1.f, 2.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(particlePositionsX(geometry, 5), std::vector<float>({ 0.f, 1.f, 2.f, 3.f, 4.f }));
+
+	particleSystem->cameraPos()[0] = 2.4f;
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(particlePositionsX(geometry, 5), std::vector<float>({ 0.f, 4.f, 1.f, 3.f, 2.f }));
+}
+
+TEST_F(ParticleSystemTest, SortedAfterSpawnAndKill)
+{
+	auto context = render::StubContext::create();
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto particleSystem = createParticleSystem(context)->isZSorted(true)->play();
+	auto root = scene::Node::create("root")->addComponent(sceneManager)->addComponent(particleSystem);
+	auto geometry = std::static_pointer_cast<geometry::ParticlesGeometry>(root->component<Surface>()->geometry());
+	auto particles = particleSystem->particles();
+
+	particleSystem->cameraPos()[0] = 10.f;
+	spawnParticles(particleSystem, { 3.f, 0.f, 4.f, 1.f, 2.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	// the particle at x = 0 expires and the last one takes its slot
+	particles->column(ParticlePool::TIME_LIVED)[1] = 100.f;
+	spawnParticles(particleSystem, { 2.5f, -1.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(particles->numAlive(), 6);
+	ASSERT_EQ(particlePositionsX(geometry, 6), std::vector<float>({ -1.f, 1.f, 2.f, 2.5f, 3.f, 4.f }));
+}
+
+TEST_F(ParticleSystemTest, SortedAfterCameraMovesAcross)
+{
+	auto context = render::StubContext::create();
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto particleSystem = createParticleSystem(context)->isZSorted(true)->play();
+	auto root = scene::Node::create("root")->addComponent(sceneManager)->addComponent(particleSystem);
+	auto geometry = std::static_pointer_cast<geometry::ParticlesGeometry>(root->component<Surface>()->geometry());
+	auto x = std::vector<float>();
+
+	for (auto i = 0; i < 20; ++i)
+		x.push_back(float(i));
+
+	particleSystem->cameraPos()[0] = 100.f;
+	spawnParticles(particleSystem, x);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(particlePositionsX(geometry, 20), x);
+
+	// reversing the order takes too many moves for an insertion sort
+	particleSystem->cameraPos()[0] = -100.f;
+	sceneManager->nextFrame(0.f, 0.f);
+	std::reverse(x.begin(), x.end());
+
+	ASSERT_EQ(particlePositionsX(geometry, 20), x);
+}
+
+TEST_F(ParticleSystemTest, InstancedQuads)
+{
+	auto context = render::StubContext::create();
+
+	context->supportsInstancing(true);
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto particleSystem = createParticleSystem(context)->play();
+	auto root = scene::Node::create("root")->addComponent(sceneManager)->addComponent(particleSystem);
+	auto geometry = std::static_pointer_cast<geometry::ParticlesGeometry>(root->component<Surface>()->geometry());
+
+	ASSERT_TRUE(geometry->instanced());
+	ASSERT_EQ(geometry->vertexBuffer("offset")->numVertices(), 4);
+	ASSERT_EQ(geometry->particlesData()->get<render::VertexBuffer::Ptr>("position")->numVertices(), 100);
+
+	spawnParticles(particleSystem, { 1.f, 2.f, 3.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(geometry->indices()->numIndices(), 6);
+	ASSERT_EQ(geometry->particlesData()->get<int>("numInstances"), 3);
+	ASSERT_EQ(particlePositionsX(geometry, 3), std::vector<float>({ 1.f, 2.f, 3.f }));
+
+	particleSystem->stop();
+
+	ASSERT_EQ(geometry->indices()->numIndices(), 0);
+	ASSERT_EQ(geometry->particlesData()->get<int>("numInstances"), 0);
+
+	particleSystem->play();
+	spawnParticles(particleSystem, { 4.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(geometry->indices()->numIndices(), 6);
+	ASSERT_EQ(geometry->particlesData()->get<int>("numInstances"), 1);
+}
+
+TEST_F(ParticleSystemTest, QuadsWithoutInstancing)
+{
+	auto context = render::StubContext::create();
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto particleSystem = createParticleSystem(context)->play();
+	auto root = scene::Node::create("root")->addComponent(sceneManager)->addComponent(particleSystem);
+	auto geometry = std::static_pointer_cast<geometry::ParticlesGeometry>(root->component<Surface>()->geometry());
+
+	ASSERT_FALSE(geometry->instanced());
+	ASSERT_EQ(geometry->vertexBuffer("offset")->numVertices(), 400);
+	ASSERT_EQ(geometry->particlesData()->get<render::VertexBuffer::Ptr>("position")->numVertices(), 400);
+
+	spawnParticles(particleSystem, { 1.f, 2.f, 3.f });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(geometry->indices()->numIndices(), 18);
+	ASSERT_FALSE(geometry->particlesData()->hasProperty("numInstances"));
+	ASSERT_EQ(particlePositionsX(geometry, 3), std::vector<float>({ 1.f, 2.f, 3.f }));
+
+	particleSystem->stop();
+
+	ASSERT_EQ(geometry->indices()->numIndices(), 0);
+}
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PickingTest.hpp"
+#include "minko/render/StubContext.hpp"
+#include "minko/render/StubEffect.hpp"
+
+#include "minko/StubCanvas.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+Node::Ptr
+PickingTest::createScene(std::shared_ptr<render::AbstractContext> context)
+{
+	auto sceneManager = SceneManager::create(StubCanvas::create(context));
+
+	sceneManager->assets()->effect("effect/Picking.effect", render::StubEffect::create(context));
+
+	auto root = Node::create("root")->addComponent(sceneManager);
+	auto camera = Node::create("camera")
+		->addComponent(Renderer::create())
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f));
+
+	root->addChild(camera);
+
+	return root;
+}
+
+uint
+PickingTest::pickingColor(Node::Ptr node)
+{
+	auto color = node->data()->get<math::Vector4::Ptr>("picking.color");
+
+	return (uint(color->x() * 255.f + .5f) << 24)
+		+ (uint(color->y() * 255.f + .5f) << 16)
+		+ (uint(color->z() * 255.f + .5f) << 8)
+		+ 0xff;
+}
+
+TEST_F(PickingTest, AsynchronousPicksCompleteAfterReadLatency)
+{
+	auto context = render::StubContext::create(16, 16);
+	auto root = createScene(context);
+	auto sceneManager = root->component<SceneManager>();
+	auto effect = render::StubEffect::create(context);
+	auto a = render::StubEffect::createSurfaceNode(context, effect);
+	auto b = render::StubEffect::createSurfaceNode(context, effect);
+
+	root->addChildren({ a, b });
+
+	auto picking = Picking::create(root->children()[0], true, true, true);
+
+	root->addComponent(picking);
+
+	auto picked = std::vector<Node::Ptr>();
+
+	context->readPixelsLatency(2);
+
+	// each pick request of a frame reads its own pixel of the picking render target
+	context->pixel(0, 0, pickingColor(b));
+	context->pixel(1, 0, pickingColor(a));
+	context->pixel(2, 0, 0x000000ff);
+
+	picking->pick(1.f, 1.f, [&](Node::Ptr node) { picked.push_back(node); });
+	picking->pick(5.f, 5.f, [&](Node::Ptr node) { picked.push_back(node); });
+	picking->pick(9.f, 9.f, [&](Node::Ptr node) { picked.push_back(node); });
+
+	// the renderer of the camera presents every frame
+	sceneManager->nextFrame(0.f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_TRUE(picked.empty());
+
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picked, std::vector<Node::Ptr>({ b, a, nullptr }));
+	ASSERT_EQ(context->numReadPixels(), 0);
+	ASSERT_EQ(context->numPendingPixelReads(), 0);
+}
+
+TEST_F(PickingTest, SynchronousPickCompletesInTheSameFrame)
+{
+	auto context = render::StubContext::create(16, 16);
+	auto root = createScene(context);
+	auto sceneManager = root->component<SceneManager>();
+	auto effect = render::StubEffect::create(context);
+	auto a = render::StubEffect::createSurfaceNode(context, effect);
+
+	root->addChild(a);
+
+	auto picking = Picking::create(root->children()[0]);
+
+	root->addComponent(picking);
+
+	Node::Ptr picked = nullptr;
+
+	context->pixel(0, 0, pickingColor(a));
+
+	picking->pick(3.f, 3.f, [&](Node::Ptr node) { picked = node; });
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picked, a);
+	ASSERT_EQ(context->numPendingPixelReads(), 0);
+}
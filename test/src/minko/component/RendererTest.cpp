@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RendererTest.hpp"
+#include "minko/render/StubContext.hpp"
+#include "minko/render/StubEffect.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(RendererTest, SurfacesAddedByAddChildren)
+{
+	auto context = render::StubContext::create();
+	auto renderer = Renderer::create();
+	auto root = Node::create("root")->addComponent(renderer);
+	auto effect = render::StubEffect::create(context);
+	auto group = Node::create("group");
+
+	group->addChildren({ render::StubEffect::createSurfaceNode(context, effect), render::StubEffect::createSurfaceNode(context, effect) });
+	root->addChildren({ render::StubEffect::createSurfaceNode(context, effect), group });
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 3);
+
+	group->addChildren({ render::StubEffect::createSurfaceNode(context, effect), render::StubEffect::createSurfaceNode(context, effect) });
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 5);
+}
+
+TEST_F(RendererTest, SurfacesRemovedByRemoveChildren)
+{
+	auto context = render::StubContext::create();
+	auto renderer = Renderer::create();
+	auto root = Node::create("root")->addComponent(renderer);
+	auto effect = render::StubEffect::create(context);
+	auto group = Node::create("group");
+
+	group->addChildren({ render::StubEffect::createSurfaceNode(context, effect), render::StubEffect::createSurfaceNode(context, effect) });
+	root->addChildren({ render::StubEffect::createSurfaceNode(context, effect), group });
+	renderer->render(context);
+
+	group->removeChildren();
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+
+	root->removeChildren();
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 0);
+}
+
+TEST_F(RendererTest, SurfacesChangedInsideBatch)
+{
+	auto context = render::StubContext::create();
+	auto renderer = Renderer::create();
+	auto root = Node::create("root")->addComponent(renderer);
+	auto effect = render::StubEffect::create(context);
+	auto group = Node::create("group");
+	auto removed = render::StubEffect::createSurfaceNode(context, effect);
+	auto moved = render::StubEffect::createSurfaceNode(context, effect);
+
+	root->addChildren({ group, removed, moved });
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+
+	root->beginBatch();
+	root->removeChild(removed);
+	root->removeChild(moved);
+	group->addChild(moved);
+	group->addChild(render::StubEffect::createSurfaceNode(context, effect));
+	root->commitBatch();
+	renderer->render(context);
+
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+}
@@ -26,45 +26,40 @@ using namespace minko::math;
 using namespace minko::component;
 using namespace minko::scene;
 
-TEST_F(TransformTest, UniqueRootTransform)
+TEST_F(TransformTest, ModelToWorldAfterChangingRoot)
 {
 	auto root = Node::create();
 	auto n1 = Node::create()->addComponent(Transform::create());
 	auto n2 = Node::create()->addComponent(Transform::create());
 	auto n3 = Node::create();
 
-	ASSERT_FALSE(root->hasComponent<Transform::RootTransform>());
-	ASSERT_TRUE(n1->hasComponent<Transform::RootTransform>());
-	ASSERT_TRUE(n2->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n3->hasComponent<Transform::RootTransform>());
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+	n2->component<Transform>()->matrix()->appendTranslation(2.f);
+
+	// each root of a hierarchy of transforms updates the world matrices of its descendants
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 1.f);
+	ASSERT_EQ(n2->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 2.f);
 
+	n3->addComponent(Transform::create());
+	n3->component<Transform>()->matrix()->appendTranslation(10.f);
 	n3->addChild(n1);
-	ASSERT_FALSE(root->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n1->hasComponent<Transform::RootTransform>());
-	ASSERT_TRUE(n2->hasComponent<Transform::RootTransform>());
-	ASSERT_TRUE(n3->hasComponent<Transform::RootTransform>());
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 11.f);
 
 	root->addChild(n3);
-	ASSERT_TRUE(root->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n1->hasComponent<Transform::RootTransform>());
-	ASSERT_TRUE(n2->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n3->hasComponent<Transform::RootTransform>());
-
 	root->addChild(n2);
-	ASSERT_TRUE(root->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n1->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n2->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n3->hasComponent<Transform::RootTransform>());
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 11.f);
+	ASSERT_EQ(n2->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 2.f);
+
+	n3->component<Transform>()->matrix()->appendTranslation(10.f);
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 21.f);
 
 	auto n4 = Node::create()->addComponent(Transform::create());
-	ASSERT_TRUE(n4->hasComponent<Transform::RootTransform>());
+
+	n4->component<Transform>()->matrix()->appendTranslation(4.f);
+	ASSERT_EQ(n4->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 4.f);
 
 	n2->addChild(n4);
-	ASSERT_TRUE(root->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n1->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n2->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n3->hasComponent<Transform::RootTransform>());
-	ASSERT_FALSE(n4->hasComponent<Transform::RootTransform>());
+	ASSERT_EQ(n4->component<Transform>()->modelToWorldMatrix(true)->translation()->x(), 6.f);
 }
 
 TEST_F(TransformTest, ModelToWorldUpdate)
@@ -329,3 +324,129 @@ TEST_F(TransformTest, Clone)
 
 	ASSERT_FALSE(n2->component<Transform>()->matrix()->equals(n1->component<Transform>()->matrix()));
 }
+
+TEST_F(TransformTest, ModelToWorldChangedOncePerFrame)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create());
+	auto n2 = Node::create()->addComponent(Transform::create());
+	auto n3 = Node::create()->addComponent(Transform::create());
+
+	root->addChild(n1)->addChild(n3);
+	n1->addChild(n2);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto numChanges = 0;
+	auto numUnchanged = 0;
+	auto _ = n2->component<Transform>()->modelToWorldMatrix()->changed()->connect(
+		[&](data::Value::Ptr value)
+		{
+			++numChanges;
+		}
+	);
+	auto __ = n3->component<Transform>()->modelToWorldMatrix()->changed()->connect(
+		[&](data::Value::Ptr value)
+		{
+			++numUnchanged;
+		}
+	);
+
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(numChanges, 1);
+	ASSERT_EQ(numUnchanged, 0);
+	ASSERT_EQ(n2->component<Transform>()->modelToWorldMatrix()->translation()->x(), 2.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(numChanges, 1);
+}
+
+TEST_F(TransformTest, ModelToWorldAfterReparent)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create());
+	auto n2 = Node::create()->addComponent(Transform::create());
+	auto n3 = Node::create()->addComponent(Transform::create());
+
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+	n2->component<Transform>()->matrix()->appendTranslation(2.f);
+
+	root->addChild(n1);
+	root->addChild(n2);
+	n1->addChild(n3);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(n3->component<Transform>()->modelToWorldMatrix()->translation()->x(), 1.f);
+
+	n2->addChild(n3);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(n3->component<Transform>()->modelToWorldMatrix()->translation()->x(), 2.f);
+
+	n2->removeComponent(n2->component<Transform>());
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(n3->component<Transform>()->modelToWorldMatrix()->translation()->x(), 0.f);
+}
+
+TEST_F(TransformTest, ModelToWorldAfterAddChildren)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto parent = Node::create()->addComponent(Transform::create());
+	auto n1 = Node::create()->addComponent(Transform::create());
+	auto n2 = Node::create()->addComponent(Transform::create());
+	auto n3 = Node::create()->addComponent(Transform::create());
+
+	parent->component<Transform>()->matrix()->appendTranslation(1.f);
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+	n2->component<Transform>()->matrix()->appendTranslation(2.f);
+	n3->component<Transform>()->matrix()->appendTranslation(3.f);
+
+	root->addChild(parent);
+	parent->addChildren({ n1, n2, n3 });
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix()->translation()->x(), 2.f);
+	ASSERT_EQ(n2->component<Transform>()->modelToWorldMatrix()->translation()->x(), 3.f);
+	ASSERT_EQ(n3->component<Transform>()->modelToWorldMatrix()->translation()->x(), 4.f);
+
+	parent->removeChildren();
+	root->addChildren({ n1, n2 });
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(n1->component<Transform>()->modelToWorldMatrix()->translation()->x(), 1.f);
+	ASSERT_EQ(n2->component<Transform>()->modelToWorldMatrix()->translation()->x(), 2.f);
+}
+
+TEST_F(TransformTest, TransformAddedInsideBatch)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto parent = Node::create()->addComponent(Transform::create());
+	auto child = Node::create();
+
+	parent->component<Transform>()->matrix()->appendTranslation(1.f);
+	root->addChild(parent);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	parent->beginBatch();
+	parent->addChild(child);
+	child->addComponent(Transform::create());
+	child->component<Transform>()->matrix()->appendTranslation(2.f);
+	parent->commitBatch();
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(child->component<Transform>()->modelToWorldMatrix()->translation()->x(), 3.f);
+
+	parent->component<Transform>()->matrix()->appendTranslation(1.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(child->component<Transform>()->modelToWorldMatrix()->translation()->x(), 4.f);
+}
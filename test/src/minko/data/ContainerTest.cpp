@@ -247,3 +247,57 @@ TEST_F(ContainerTest, ArrayRemoveAdd)
 	ASSERT_TRUE(c->hasProvider(array2));
 	ASSERT_FALSE(c->hasProvider(array3));
 }
+
+TEST_F(ContainerTest, GetWithPropertyId)
+{
+	auto p = Provider::create();
+	auto c = Container::create();
+
+	p->set("foo", 42);
+	c->addProvider(p);
+
+	ASSERT_TRUE(c->hasProperty(PropertyId("foo")));
+	ASSERT_FALSE(c->hasProperty(PropertyId("bar")));
+	ASSERT_EQ(c->get<int>(PropertyId("foo")), 42);
+
+	p->set("foo", 24);
+
+	ASSERT_EQ(c->get<int>(PropertyId("foo")), 24);
+}
+
+TEST_F(ContainerTest, GetWithPropertyIdAfterRemoveProvider)
+{
+	auto p = Provider::create();
+	auto c = Container::create();
+
+	p->set("foo", 42);
+	c->addProvider(p);
+
+	ASSERT_EQ(c->get<int>(PropertyId("foo")), 42);
+
+	c->removeProvider(p);
+
+	ASSERT_FALSE(c->hasProperty(PropertyId("foo")));
+}
+
+TEST_F(ContainerTest, ArrayGetWithPropertyId)
+{
+	auto array1 = ArrayProvider::create("array");
+	auto array2 = ArrayProvider::create("array");
+	auto c = Container::create();
+
+	array1->set("foo", 42);
+	array2->set("foo", 24);
+
+	c->addProvider(array1);
+	c->addProvider(array2);
+
+	ASSERT_EQ(c->get<int>("array[0].foo"), 42);
+	ASSERT_EQ(c->get<int>(PropertyId("array[0].foo")), 42);
+	ASSERT_EQ(c->get<int>(PropertyId("array[1].foo")), 24);
+
+	c->removeProvider(array1);
+
+	ASSERT_EQ(c->get<int>(PropertyId("array[0].foo")), 24);
+	ASSERT_FALSE(c->hasProperty(PropertyId("array[1].foo")));
+}
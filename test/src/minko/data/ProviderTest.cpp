@@ -81,6 +81,94 @@ TEST_F(ProviderTest, TestFloat)
 	ASSERT_EQ(provider->get<float>("foo"), v);
 }
 
+TEST_F(ProviderTest, SetSameTypeTwice)
+{
+	auto provider = Provider::create();
+
+	provider->set("foo", 42);
+	provider->set("foo", 24);
+
+	ASSERT_EQ(provider->get<int>("foo"), 24);
+	ASSERT_EQ(provider->propertyNames().size(), 1u);
+}
+
+TEST_F(ProviderTest, SetOtherType)
+{
+	auto provider = Provider::create();
+
+	provider->set("foo", 42);
+	provider->set("foo", std::string("bar"));
+
+	ASSERT_TRUE(provider->propertyHasType<std::string>("foo"));
+	ASSERT_EQ(provider->get<std::string>("foo"), "bar");
+}
+
+TEST_F(ProviderTest, SetInt4)
+{
+	auto provider = Provider::create();
+	auto value = std::make_tuple(1, 2, 3, 4);
+
+	provider->set("foo", value);
+	std::get<3>(value) = 42;
+	provider->set("foo", value);
+
+	ASSERT_EQ(std::get<3>(provider->get<std::tuple<int, int, int, int>>("foo")), 42);
+}
+
+TEST_F(ProviderTest, SetSharedPointerTwice)
+{
+	auto provider = Provider::create();
+	auto position = math::Vector3::create(1.f, 2.f, 3.f);
+	auto copy = Provider::create();
+
+	provider->set("foo", position);
+	copy->copyFrom(provider);
+	ASSERT_EQ(position.use_count(), 3);
+
+	// the shared pointers are held inline but must still release their value
+	provider->set("foo", math::Vector3::create());
+	ASSERT_EQ(position.use_count(), 2);
+	ASSERT_NE(provider->get<math::Vector3::Ptr>("foo"), position);
+
+	copy->unset("foo");
+	ASSERT_EQ(position.use_count(), 1);
+}
+
+TEST_F(ProviderTest, ReferenceChangedOnSetSameType)
+{
+	auto provider = Provider::create();
+	auto numCalls = 0;
+
+	provider->set("foo", 42.f);
+
+	auto _ = provider->propertyReferenceChanged()->connect(
+		[&](Provider::Ptr p, const std::string& propertyName)
+		{
+			if (p == provider && propertyName == "foo")
+				++numCalls;
+		}
+	);
+
+	provider->set("foo", 24.f);
+
+	ASSERT_EQ(numCalls, 1);
+	ASSERT_EQ(provider->get<float>("foo"), 24.f);
+}
+
+TEST_F(ProviderTest, GetWithPropertyId)
+{
+	auto provider = Provider::create();
+
+	provider->set("foo", 42);
+
+	ASSERT_TRUE(provider->hasProperty(PropertyId("foo")));
+	ASSERT_EQ(provider->get<int>(PropertyId("foo")), 42);
+
+	provider->unset("foo");
+
+	ASSERT_FALSE(provider->hasProperty(PropertyId("foo")));
+}
+
 TEST_F(ProviderTest, PropertyAdded)
 {
 	auto p = Provider::create();
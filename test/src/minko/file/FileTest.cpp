@@ -64,3 +64,124 @@ TEST_F(FileTest, SanitizeFilename)
 	ASSERT_EQ("../foo", File::sanitizeFilename("../foo"));
 	ASSERT_EQ("../foo", File::sanitizeFilename("..\\foo"));
 }
+
+TEST_F(FileTest, MemoryMappedFileRange)
+{
+	std::vector<unsigned char> bytes(100000);
+
+	for (uint i = 0; i < bytes.size(); ++i)
+		bytes[i] = i % 251;
+
+	std::ofstream("memory-mapped-file.bin", std::ios::binary).write((const char*)bytes.data(), bytes.size());
+
+	auto mappedFile = MemoryMappedFile::create("memory-mapped-file.bin", 5003, 70000);
+
+	ASSERT_EQ(70000, mappedFile->size());
+	ASSERT_TRUE(std::equal(bytes.begin() + 5003, bytes.begin() + 75003, mappedFile->data()));
+
+	mappedFile = MemoryMappedFile::create("memory-mapped-file.bin", 99000);
+
+	ASSERT_EQ(1000, mappedFile->size());
+	ASSERT_TRUE(std::equal(bytes.begin() + 99000, bytes.end(), mappedFile->data()));
+
+	ASSERT_THROW(MemoryMappedFile::create("missing-memory-mapped-file.bin"), std::runtime_error);
+
+	std::remove("memory-mapped-file.bin");
+}
+
+TEST_F(FileTest, FileProtocolRangedLoad)
+{
+	std::vector<unsigned char> bytes(3000000);
+
+	for (uint i = 0; i < bytes.size(); ++i)
+		bytes[i] = i % 253;
+
+	std::ofstream("file-protocol.bin", std::ios::binary).write((const char*)bytes.data(), bytes.size());
+
+	for (auto memoryMapFiles : { false, true })
+	{
+		auto options = Options::create()
+			->memoryMapFiles(memoryMapFiles)
+			->seekingOffset(1000)
+			->seekedLength(2000000);
+		auto protocol = FileProtocol::create();
+		auto numProgressSteps = 0;
+		auto lastProgress = 0.f;
+		auto complete = false;
+
+		auto _ = protocol->progress()->connect([&](AbstractProtocol::Ptr, float progress)
+		{
+			ASSERT_TRUE(progress >= lastProgress);
+			lastProgress = progress;
+			++numProgressSteps;
+		});
+		auto __ = protocol->complete()->connect([&](AbstractProtocol::Ptr)
+		{
+			complete = true;
+		});
+
+		protocol->AbstractProtocol::load("file-protocol.bin", "file://file-protocol.bin", options);
+
+		auto file = protocol->file();
+
+		ASSERT_TRUE(complete);
+		ASSERT_EQ(1.f, lastProgress);
+		// mapped files loaded synchronously are read from the disk when their pages are accessed
+		ASSERT_TRUE(memoryMapFiles ? numProgressSteps >= 2 : numProgressSteps > 2);
+		ASSERT_EQ(memoryMapFiles, file->mappedFile() != nullptr);
+		ASSERT_EQ(2000000, file->size());
+		ASSERT_TRUE(std::equal(bytes.begin() + 1000, bytes.begin() + 2001000, file->bytes()));
+	}
+
+	std::remove("file-protocol.bin");
+}
+
+TEST_F(FileTest, FileProtocolRangedLoadPast2GB)
+{
+	static_assert(std::is_same<uint64_t, decltype(Options::create()->seekingOffset())>::value, "64-bit seeking offsets");
+	static_assert(std::is_same<uint64_t, decltype(Options::create()->seekedLength())>::value, "64-bit seeked lengths");
+
+	const uint64_t offset = (uint64_t(1) << 31) + 5003;
+	std::vector<unsigned char> bytes(70000);
+
+	for (uint i = 0; i < bytes.size(); ++i)
+		bytes[i] = i % 251;
+
+	// the file is sparse: only the range after the offset is written to the disk
+	{
+		std::ofstream file("file-protocol-2gb.bin", std::ios::binary);
+
+		file.seekp(std::streamoff(offset));
+		file.write((const char*)bytes.data(), bytes.size());
+	}
+
+	auto mappedFile = MemoryMappedFile::create("file-protocol-2gb.bin", offset, 60000);
+
+	ASSERT_EQ(60000, mappedFile->size());
+	ASSERT_TRUE(std::equal(bytes.begin(), bytes.begin() + 60000, mappedFile->data()));
+
+	for (auto memoryMapFiles : { false, true })
+	{
+		auto options = Options::create()
+			->memoryMapFiles(memoryMapFiles)
+			->seekingOffset(offset + 1000)
+			->seekedLength(50000);
+		auto protocol = FileProtocol::create();
+		auto complete = false;
+
+		auto _ = protocol->complete()->connect([&](AbstractProtocol::Ptr)
+		{
+			complete = true;
+		});
+
+		protocol->AbstractProtocol::load("file-protocol-2gb.bin", "file://file-protocol-2gb.bin", options);
+
+		auto file = protocol->file();
+
+		ASSERT_TRUE(complete);
+		ASSERT_EQ(50000, file->size());
+		ASSERT_TRUE(std::equal(bytes.begin() + 1000, bytes.begin() + 51000, file->bytes()));
+	}
+
+	std::remove("file-protocol-2gb.bin");
+}
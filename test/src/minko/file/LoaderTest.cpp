@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LoaderTest.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+std::thread::id StagingParser::decodingThread;
+std::thread::id StagingParser::commitThread;
+
+TEST_F(LoaderTest, ParseAsynchronously)
+{
+	std::ofstream("loader-test.staging", std::ios::binary) << "abcdef";
+
+	auto assets = AssetLibrary::create(nullptr);
+	auto options = Options::create(assets->loader()->options())
+		->parseAsynchronously(true)
+		->registerParser<StagingParser>("staging");
+	auto loader = Loader::create(options);
+	auto complete = false;
+
+	auto _ = loader->complete()->connect([&](Loader::Ptr)
+	{
+		complete = true;
+	});
+
+	loader->queue("loader-test.staging")->load();
+
+	// the resources are only created by the main thread tasks
+	for (auto i = 0; i < 1000 && !complete; ++i)
+	{
+		async::TaskScheduler::instance()->runMainThreadTasks();
+		std::this_thread::yield();
+	}
+
+	std::remove("loader-test.staging");
+
+	ASSERT_TRUE(complete);
+	ASSERT_EQ("fedcba", std::string(assets->blob("loader-test.staging").begin(), assets->blob("loader-test.staging").end()));
+	ASSERT_TRUE(StagingParser::commitThread == std::this_thread::get_id());
+
+	if (async::TaskScheduler::instance()->numWorkers() > 0)
+		ASSERT_TRUE(StagingParser::decodingThread != std::this_thread::get_id());
+}
+
+TEST_F(LoaderTest, ParseSynchronously)
+{
+	std::ofstream("loader-test.staging", std::ios::binary) << "abcdef";
+
+	auto assets = AssetLibrary::create(nullptr);
+	auto options = Options::create(assets->loader()->options())
+		->registerParser<StagingParser>("staging");
+	auto loader = Loader::create(options);
+	auto complete = false;
+
+	auto _ = loader->complete()->connect([&](Loader::Ptr)
+	{
+		complete = true;
+	});
+
+	loader->queue("loader-test.staging")->load();
+
+	std::remove("loader-test.staging");
+
+	ASSERT_TRUE(complete);
+	ASSERT_EQ("abcdef", std::string(assets->blob("loader-test.staging").begin(), assets->blob("loader-test.staging").end()));
+}
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+#include "gtest/gtest.h"
+
+namespace minko
+{
+	namespace file
+	{
+		class LoaderTest :
+			public ::testing::Test
+		{
+		};
+
+		class StagingParser :
+			public AbstractParser
+		{
+		public:
+			typedef std::shared_ptr<StagingParser> Ptr;
+
+			static std::thread::id	decodingThread;
+			static std::thread::id	commitThread;
+
+		private:
+			std::string				_staged;
+
+		public:
+			static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<StagingParser>(new StagingParser());
+			}
+
+			void
+			parse(const std::string&				filename,
+				  const std::string&				resolvedFilename,
+				  std::shared_ptr<Options>			options,
+				  const std::vector<unsigned char>&	data,
+				  std::shared_ptr<AssetLibrary>		assetLibrary)
+			{
+				assetLibrary->blob(filename, data);
+				_complete->execute(shared_from_this());
+			}
+
+			bool
+			threadSafe() const
+			{
+				return true;
+			}
+
+			void
+			decode(std::shared_ptr<File> file, std::shared_ptr<Options> options)
+			{
+				decodingThread = std::this_thread::get_id();
+				_staged.assign(file->bytes(), file->bytes() + file->size());
+				std::reverse(_staged.begin(), _staged.end());
+			}
+
+			void
+			commit(std::shared_ptr<File> file, std::shared_ptr<Options> options, std::shared_ptr<AssetLibrary> assetLibrary)
+			{
+				commitThread = std::this_thread::get_id();
+				assetLibrary->blob(file->filename(), std::vector<unsigned char>(_staged.begin(), _staged.end()));
+				_complete->execute(shared_from_this());
+			}
+		};
+	}
+}
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "minko/geometry/SkinTest.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+// each bone spins, bounces and scales up at its own pace
+static
+Skin::Ptr
+createAnimatedSkin(uint numBones, uint numFrames)
+{
+	auto skin = Skin::create(numBones, numFrames * 1000 / 30, numFrames);
+
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+		for (uint boneId = 0; boneId < numBones; ++boneId)
+		{
+			float t = frameId / float(numFrames);
+
+			skin->matrix(frameId, boneId, math::Matrix4x4::create()
+				->appendScale(1.f + .5f * t, 1.f, 1.f + boneId * .1f)
+				->appendRotationY(t * 6.f * (boneId + 1))
+				->appendRotationX(sinf(t * 10.f + boneId))
+				->appendTranslation(boneId * 1.f, sinf(t * 20.f) * 3.f, t * 10.f));
+		}
+
+	return skin;
+}
+
+TEST_F(SkinTest, CompressWithinTolerance)
+{
+	auto skin = createAnimatedSkin(4, 120);
+	auto reference = skin->getBoneMatricesPerFrame();
+	auto tolerance = 1e-3f;
+
+	skin->compress(tolerance);
+
+	ASSERT_TRUE(skin->compressed());
+	ASSERT_EQ(120, skin->numFrames());
+	ASSERT_LT(skin->numKeyframes(), 4u * 3u * 120u);
+
+	for (uint frameId = 0; frameId < skin->numFrames(); ++frameId)
+	{
+		auto& matrices = skin->matrices(frameId);
+
+		for (uint i = 0; i < matrices.size(); ++i)
+			ASSERT_NEAR(matrices[i], reference[frameId][i], tolerance);
+	}
+}
+
+TEST_F(SkinTest, CompressLinearAnimation)
+{
+	auto skin = Skin::create(1, 2000, 60);
+
+	for (uint frameId = 0; frameId < 60; ++frameId)
+		skin->matrix(frameId, 0, math::Matrix4x4::create()->appendTranslation(frameId * .5f, 1.f, -2.f * frameId));
+
+	skin->compress();
+
+	ASSERT_EQ(6, skin->numKeyframes());
+
+	auto& matrices = skin->matrices(30);
+
+	ASSERT_NEAR(matrices[3], 15.f, 1e-3f);
+	ASSERT_NEAR(matrices[7], 1.f, 1e-3f);
+	ASSERT_NEAR(matrices[11], -60.f, 1e-2f);
+}
+
+TEST_F(SkinTest, CompressTransposedMatrices)
+{
+	auto skin = createAnimatedSkin(2, 30);
+
+	skin->transposeMatrices();
+
+	auto reference = skin->getBoneMatricesPerFrame();
+
+	skin->compress();
+
+	for (uint frameId = 0; frameId < skin->numFrames(); ++frameId)
+	{
+		auto& matrices = skin->matrices(frameId);
+
+		ASSERT_NEAR(matrices[12], reference[frameId][12], 1e-2f);
+		ASSERT_NEAR(matrices[13], reference[frameId][13], 1e-2f);
+		ASSERT_NEAR(matrices[14], reference[frameId][14], 1e-2f);
+		ASSERT_NEAR(matrices[3], 0.f, 1e-6f);
+	}
+}
+
+TEST_F(SkinTest, PoseCacheKeepsRecentFrames)
+{
+	auto skin = createAnimatedSkin(2, 30)->compress();
+	auto& first = skin->matrices(3);
+	auto firstValues = first;
+	auto& second = skin->matrices(4);
+
+	ASSERT_TRUE(&first == &skin->matrices(3));
+	ASSERT_TRUE(firstValues == first);
+	ASSERT_TRUE(first != second);
+}
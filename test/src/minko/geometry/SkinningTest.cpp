@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SkinningTest.hpp"
+#include "minko/render/StubContext.hpp"
+#include "minko/render/StubEffect.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+using namespace minko::component;
+
+TEST_F(SkinningTest, SoftwareSkinningUploadsDirtyVertices)
+{
+	auto context = render::StubContext::create();
+	auto geometry = QuadGeometry::create(context);
+	auto vertexBuffer = geometry->vertexBuffer("position");
+	auto input = vertexBuffer->data();
+	auto vertexSize = vertexBuffer->vertexSize();
+	auto skin = Skin::create(2, 3000, 3);
+
+	// the first bone moves the bottom vertices of the quad, the second one the top vertices
+	skin->bone(0, Bone::create(math::Matrix4x4::create(), { 0, 1 }, { 1.f, 1.f }));
+	skin->bone(1, Bone::create(math::Matrix4x4::create(), { 2, 3 }, { 1.f, 1.f }));
+
+	std::vector<std::vector<math::Matrix4x4::Ptr>> matrices = {
+		{ math::Matrix4x4::create(), math::Matrix4x4::create() },
+		{ math::Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f), math::Matrix4x4::create() },
+		{ math::Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f), math::Matrix4x4::create()->appendRotationX(1.f)->appendTranslation(0.f, 2.f, 0.f) }
+	};
+
+	for (uint frameId = 0; frameId < 3; ++frameId)
+		for (uint boneId = 0; boneId < 2; ++boneId)
+			skin->matrix(frameId, boneId, matrices[frameId][boneId]);
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = scene::Node::create("root")->addComponent(sceneManager);
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, context, root);
+	auto mesh = scene::Node::create("mesh")
+		->addComponent(Surface::create(geometry, material::Material::create(), render::StubEffect::create(context)))
+		->addComponent(skinning);
+
+	root->addChild(mesh);
+
+	const auto& uploads = context->vertexBufferUploads();
+
+	for (uint frameId = 0; frameId < 3; ++frameId)
+	{
+		auto numUploads = uploads.size();
+
+		ASSERT_EQ(frameId, skin->getFrameId(frameId * 1000));
+		// a stopped animation updates once on the next frame
+		skinning->seek(frameId * 1000)->stop();
+		sceneManager->nextFrame(0.f, 0.f);
+
+		// every vertex the first time, then only the vertices of the bone that moved
+		const uint firstVertex = frameId == 2 ? 2 : 0;
+		const uint numVertices = frameId == 0 ? 4 : 2;
+
+		ASSERT_EQ(numUploads + 1, uploads.size());
+		ASSERT_EQ(firstVertex * vertexSize, uploads.back().offset);
+		ASSERT_EQ(std::vector<float>(
+			vertexBuffer->data().begin() + firstVertex * vertexSize,
+			vertexBuffer->data().begin() + (firstVertex + numVertices) * vertexSize
+		), uploads.back().data);
+
+		for (uint vertexId = 0; vertexId < 4; ++vertexId)
+		{
+			auto matrix = matrices[frameId][vertexId / 2];
+			auto position = matrix->transform(math::Vector3::create(
+				input[vertexId * vertexSize], input[vertexId * vertexSize + 1], input[vertexId * vertexSize + 2]
+			));
+			auto normal = matrix->transform(math::Vector4::create(
+				input[vertexId * vertexSize + 3], input[vertexId * vertexSize + 4], input[vertexId * vertexSize + 5], 0.f
+			));
+			const float* output = &vertexBuffer->data()[vertexId * vertexSize];
+
+			ASSERT_NEAR(position->x(), output[0], 1e-5f);
+			ASSERT_NEAR(position->y(), output[1], 1e-5f);
+			ASSERT_NEAR(position->z(), output[2], 1e-5f);
+			ASSERT_NEAR(normal->x(), output[3], 1e-5f);
+			ASSERT_NEAR(normal->y(), output[4], 1e-5f);
+			ASSERT_NEAR(normal->z(), output[5], 1e-5f);
+		}
+	}
+
+	// nothing to skin nor upload when the frame does not change
+	auto numUploads = uploads.size();
+
+	skinning->seek(2000)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(numUploads, uploads.size());
+}
+
+TEST_F(SkinningTest, RayCastsHitTheSkinnedPose)
+{
+	auto context = render::StubContext::create();
+	auto geometry = QuadGeometry::create(context);
+	auto skin = Skin::create(1, 2000, 2);
+
+	skin->bone(0, Bone::create(math::Matrix4x4::create(), { 0, 1, 2, 3 }, { 1.f, 1.f, 1.f, 1.f }));
+	skin->matrix(0, 0, math::Matrix4x4::create());
+	skin->matrix(1, 0, math::Matrix4x4::create()->appendTranslation(10.f, 0.f, 0.f));
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = scene::Node::create("root")->addComponent(sceneManager);
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, context, root);
+
+	root->addChild(scene::Node::create("mesh")
+		->addComponent(Surface::create(geometry, material::Material::create(), render::StubEffect::create(context)))
+		->addComponent(skinning));
+
+	auto rayAtOrigin = math::Ray::create(math::Vector3::create(0.f, 0.f, 1.f), math::Vector3::create(0.f, 0.f, -1.f));
+	auto rayAtPose = math::Ray::create(math::Vector3::create(10.f, 0.f, 1.f), math::Vector3::create(0.f, 0.f, -1.f));
+	auto distance = 0.f;
+	auto triangle = 0u;
+
+	skinning->seek(0)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+	ASSERT_TRUE(geometry->cast(rayAtOrigin, distance, triangle));
+	ASSERT_FALSE(geometry->cast(rayAtPose, distance, triangle));
+
+	// the hierarchy built for the first pose must not be reused for the next one
+	skinning->seek(1000)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+	ASSERT_FALSE(geometry->cast(rayAtOrigin, distance, triangle));
+	ASSERT_TRUE(geometry->cast(rayAtPose, distance, triangle));
+	ASSERT_NEAR(distance, 1.f, 1e-5f);
+}
@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "minko/geometry/TriangleBvhTest.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+// a 16x16 grid of unit quads on the z = 0 plane and a single triangle on the z = 5 plane
+static
+TriangleBvh::Ptr
+createGridBvh(std::vector<float>& xyz, std::vector<unsigned short>& indices)
+{
+	for (uint y = 0; y <= 16; ++y)
+		for (uint x = 0; x <= 16; ++x)
+		{
+			xyz.push_back((float)x);
+			xyz.push_back((float)y);
+			xyz.push_back(0.f);
+		}
+
+	for (uint y = 0; y < 16; ++y)
+		for (uint x = 0; x < 16; ++x)
+		{
+			unsigned short i = y * 17 + x;
+
+			indices.push_back(i);
+			indices.push_back(i + 1);
+			indices.push_back(i + 18);
+			indices.push_back(i);
+			indices.push_back(i + 18);
+			indices.push_back(i + 17);
+		}
+
+	unsigned short first = xyz.size() / 3;
+	float triangle[] = { 2.f, 2.f, 5.f, 4.f, 2.f, 5.f, 2.f, 4.f, 5.f };
+
+	xyz.insert(xyz.end(), triangle, triangle + 9);
+	indices.push_back(first);
+	indices.push_back(first + 1);
+	indices.push_back(first + 2);
+
+	return TriangleBvh::create(&xyz[0], 3, indices);
+}
+
+TEST_F(TriangleBvhTest, CastClosestTriangle)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+	auto bvh = createGridBvh(xyz, indices);
+	float origin[] = { 2.5f, 2.5f, 10.f };
+	float direction[] = { 0.f, 0.f, -1.f };
+	auto distance = 0.f;
+	uint triangle = 0;
+	auto u = 0.f;
+	auto v = 0.f;
+
+	ASSERT_EQ(bvh->numTriangles(), 513);
+	ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+	ASSERT_FLOAT_EQ(distance, 5.f);
+	ASSERT_EQ(triangle, 512 * 3);
+	ASSERT_FLOAT_EQ(u, .25f);
+	ASSERT_FLOAT_EQ(v, .25f);
+
+	origin[0] = 10.25f;
+	origin[1] = 7.75f;
+
+	ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+	ASSERT_FLOAT_EQ(distance, 10.f);
+	ASSERT_EQ(triangle, (7 * 16 + 10) * 6 + 3);
+}
+
+TEST_F(TriangleBvhTest, CastIgnoresTrianglesBehindOrigin)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+	auto bvh = createGridBvh(xyz, indices);
+	float origin[] = { 2.5f, 2.5f, 1.f };
+	float direction[] = { 0.f, 0.f, 1.f };
+	auto distance = 0.f;
+	uint triangle = 0;
+	auto u = 0.f;
+	auto v = 0.f;
+
+	ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+	ASSERT_FLOAT_EQ(distance, 4.f);
+
+	origin[2] = 6.f;
+
+	ASSERT_FALSE(bvh->cast(origin, direction, distance, triangle, u, v));
+}
+
+TEST_F(TriangleBvhTest, CastBatch)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+	auto bvh = createGridBvh(xyz, indices);
+	std::vector<float> origins;
+	std::vector<float> directions;
+
+	for (uint i = 0; i < 64; ++i)
+	{
+		origins.push_back((float)(i % 8) * 2.f + .5f + (i >= 32 ? 20.f : 0.f));
+		origins.push_back((float)(i / 8 % 4) * 4.f + .5f);
+		origins.push_back(-1.f);
+		directions.push_back(0.f);
+		directions.push_back(0.f);
+		directions.push_back(2.f);
+	}
+
+	std::vector<float> distances(64);
+	std::vector<uint> triangles(64);
+
+	ASSERT_EQ(bvh->cast(&origins[0], &directions[0], 64, &distances[0], &triangles[0]), 32);
+
+	for (uint i = 0; i < 64; ++i)
+	{
+		if (i < 32)
+		{
+			float u = 0.f;
+			float v = 0.f;
+			float distance = 0.f;
+			uint triangle = 0;
+
+			ASSERT_TRUE(bvh->cast(&origins[i * 3], &directions[i * 3], distance, triangle, u, v));
+			ASSERT_FLOAT_EQ(distances[i], .5f);
+			ASSERT_EQ(triangles[i], triangle);
+		}
+		else
+			ASSERT_EQ(distances[i], std::numeric_limits<float>::infinity());
+	}
+}
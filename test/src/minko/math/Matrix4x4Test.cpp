@@ -706,4 +706,27 @@ TEST_F(Matrix4x4Test, DecomposeRecompose)
 
 		ASSERT_TRUE(nearEqual(mat1, mat2, epsilon));
 	}
-}
\ No newline at end of file
+}
+
+TEST_F(Matrix4x4Test, MultiplyMatchesAppend)
+{
+	auto a = randomMatrix(10.f);
+	auto b = randomMatrix(10.f);
+	auto expected = Matrix4x4::create(b)->append(a);
+	auto result = Matrix4x4::create();
+
+	Matrix4x4::multiply(&a->data()[0], &b->data()[0], &result->data()[0]);
+
+	ASSERT_TRUE(nearEqual(result, expected));
+}
+
+TEST_F(Matrix4x4Test, MultiplyInPlace)
+{
+	auto a = randomMatrix(10.f);
+	auto b = randomMatrix(10.f);
+	auto expected = Matrix4x4::create(b)->append(a);
+
+	Matrix4x4::multiply(&a->data()[0], &b->data()[0], &b->data()[0]);
+
+	ASSERT_TRUE(nearEqual(b, expected));
+}
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "minko/math/OctTreeTest.hpp"
+
+#include "minko/math/OctTree.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::component;
+
+static
+scene::Node::Ptr
+createNode(float x, float y, float z, data::Provider::Ptr transform = nullptr)
+{
+	auto node = scene::Node::create()
+		->addComponent(BoundingBox::create(1.f, Vector3::create(0.f, 0.f, 0.f)));
+
+	if (transform == nullptr)
+		transform = data::Provider::create();
+	transform->set("transform.modelToWorldMatrix", Matrix4x4::create()->appendTranslation(x, y, z));
+	node->data()->addProvider(transform);
+
+	return node;
+}
+
+static
+std::set<scene::Node::Ptr>
+visibleNodes(OctTree::Ptr octTree, Box::Ptr shape)
+{
+	std::set<scene::Node::Ptr> nodes;
+
+	octTree->testFrustum(shape, [&](scene::Node::Ptr node) { nodes.insert(node); });
+
+	return nodes;
+}
+
+TEST_F(OctTreeTest, GrowsToFitNodesOutsideOfTheWorld)
+{
+	auto octTree = OctTree::create(10.f, 4, Vector3::create(0.f, 0.f, 0.f));
+	auto near = createNode(1.f, 1.f, 1.f);
+	auto far = createNode(1000.f, -500.f, 250.f);
+
+	octTree->insert(near)->insert(far);
+
+	ASSERT_EQ(octTree->numNodes(), 2);
+
+	auto visible = visibleNodes(octTree, Box::create(Vector3::create(1010.f, -490.f, 260.f), Vector3::create(990.f, -510.f, 240.f)));
+
+	ASSERT_EQ(visible.size(), 1);
+	ASSERT_EQ(visible.count(far), 1);
+}
+
+TEST_F(OctTreeTest, TracksMovingNodes)
+{
+	auto octTree = OctTree::create(10.f, 4, Vector3::create(0.f, 0.f, 0.f));
+	auto transform = data::Provider::create();
+	auto node = createNode(-3.f, -3.f, -3.f, transform);
+	auto shape = Box::create(Vector3::create(5.f, 5.f, 5.f), Vector3::create(2.f, 2.f, 2.f));
+
+	octTree->insert(node);
+
+	ASSERT_TRUE(visibleNodes(octTree, shape).empty());
+
+	transform->set("transform.modelToWorldMatrix", Matrix4x4::create()->appendTranslation(3.5f, 3.5f, 3.5f));
+
+	ASSERT_EQ(visibleNodes(octTree, shape).count(node), 1);
+}
+
+TEST_F(OctTreeTest, Remove)
+{
+	auto octTree = OctTree::create(10.f, 4, Vector3::create(0.f, 0.f, 0.f));
+	auto node = createNode(1.f, 1.f, 1.f);
+	auto shape = Box::create(Vector3::create(5.f, 5.f, 5.f), Vector3::create(-5.f, -5.f, -5.f));
+
+	octTree->insert(node);
+
+	ASSERT_EQ(visibleNodes(octTree, shape).size(), 1);
+
+	octTree->remove(node);
+
+	ASSERT_FALSE(octTree->hasNode(node));
+	ASSERT_EQ(octTree->numNodes(), 0);
+	ASSERT_TRUE(visibleNodes(octTree, shape).empty());
+}
+
+TEST_F(OctTreeTest, GrowingDoesNotMoveTheGivenCenter)
+{
+	auto center = Vector3::create(0.f, 0.f, 0.f);
+	auto octTree = OctTree::create(10.f, 4, center);
+
+	octTree->insert(createNode(1000.f, -500.f, 250.f));
+	octTree->update();
+
+	ASSERT_EQ(center->x(), 0.f);
+	ASSERT_EQ(center->y(), 0.f);
+	ASSERT_EQ(center->z(), 0.f);
+}
@@ -0,0 +1,241 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticlePoolTest.hpp"
+
+using namespace minko;
+using namespace minko::particle;
+
+ParticleData
+ParticlePoolTest::createParticle(float x, float lifetime, float timeLived)
+{
+	ParticleData particle;
+
+	particle.x = x;
+	particle.y = x + 1.f;
+	particle.z = x + 2.f;
+	particle.startvx = 1.f;
+	particle.startvy = 2.f;
+	particle.startvz = 3.f;
+	particle.startfx = 0.5f;
+	particle.startfy = -0.5f;
+	particle.startfz = 0.25f;
+	particle.startAngularVelocity = 2.f;
+	particle.lifetime = lifetime;
+	particle.timeLived = timeLived;
+	particle.spriteIndex = x;
+
+	return particle;
+}
+
+TEST_F(ParticlePoolTest, Create)
+{
+	auto pool = ParticlePool::create(10);
+
+	ASSERT_EQ(pool->capacity(), 10);
+	ASSERT_EQ(pool->numAlive(), 0);
+}
+
+TEST_F(ParticlePoolTest, ColumnsAreAlignedOnFourFloats)
+{
+	auto pool = ParticlePool::create(5);
+
+	ASSERT_EQ(pool->column(ParticlePool::Y) - pool->column(ParticlePool::X), 8);
+	ASSERT_EQ(pool->column(ParticlePool::SPRITE_INDEX) - pool->column(ParticlePool::X), 8 * ParticlePool::SPRITE_INDEX);
+}
+
+TEST_F(ParticlePoolTest, SpawnAndGet)
+{
+	auto pool = ParticlePool::create(4);
+	auto particle = createParticle(3.f, 2.f, 0.5f);
+	ParticleData result;
+
+	ASSERT_EQ(pool->spawn(createParticle(1.f, 1.f)), 0);
+	ASSERT_EQ(pool->spawn(particle), 1);
+	ASSERT_EQ(pool->numAlive(), 2);
+
+	pool->get(1, result);
+
+	ASSERT_EQ(result.x, particle.x);
+	ASSERT_EQ(result.y, particle.y);
+	ASSERT_EQ(result.z, particle.z);
+	ASSERT_EQ(result.startvx, particle.startvx);
+	ASSERT_EQ(result.startfz, particle.startfz);
+	ASSERT_EQ(result.startAngularVelocity, particle.startAngularVelocity);
+	ASSERT_EQ(result.lifetime, particle.lifetime);
+	ASSERT_EQ(result.timeLived, particle.timeLived);
+	ASSERT_EQ(result.spriteIndex, particle.spriteIndex);
+	ASSERT_EQ(pool->column(ParticlePool::X)[1], particle.x);
+	ASSERT_EQ(pool->column(ParticlePool::LIFETIME)[1], particle.lifetime);
+}
+
+TEST_F(ParticlePoolTest, SpawnThrowsWhenFull)
+{
+	auto pool = ParticlePool::create(1);
+
+	pool->spawn(createParticle(0.f, 1.f));
+
+	ASSERT_THROW(pool->spawn(createParticle(1.f, 1.f)), std::length_error);
+	ASSERT_EQ(pool->numAlive(), 1);
+}
+
+TEST_F(ParticlePoolTest, KillMovesLastParticle)
+{
+	auto pool = ParticlePool::create(4);
+
+	for (auto i = 0; i < 4; ++i)
+		pool->spawn(createParticle(float(i), 1.f));
+
+	pool->kill(1);
+
+	ASSERT_EQ(pool->numAlive(), 3);
+	ASSERT_EQ(pool->column(ParticlePool::X)[0], 0.f);
+	ASSERT_EQ(pool->column(ParticlePool::X)[1], 3.f);
+	ASSERT_EQ(pool->column(ParticlePool::Y)[1], 4.f);
+	ASSERT_EQ(pool->column(ParticlePool::SPRITE_INDEX)[1], 3.f);
+	ASSERT_EQ(pool->column(ParticlePool::X)[2], 2.f);
+
+	pool->kill(2);
+
+	ASSERT_EQ(pool->numAlive(), 2);
+	ASSERT_EQ(pool->column(ParticlePool::X)[1], 3.f);
+}
+
+TEST_F(ParticlePoolTest, KillExpiredKeepsLiveParticlesPacked)
+{
+	auto pool = ParticlePool::create(6);
+
+	pool->spawn(createParticle(0.f, 1.f, 1.f));
+	pool->spawn(createParticle(1.f, 1.f));
+	pool->spawn(createParticle(2.f, 1.f, 2.f));
+	pool->spawn(createParticle(3.f, 1.f));
+	pool->spawn(createParticle(4.f, 1.f));
+	pool->spawn(createParticle(5.f, 1.f, 1.5f));
+
+	ASSERT_EQ(pool->killExpired(), 3);
+	ASSERT_EQ(pool->numAlive(), 3);
+
+	std::vector<float> alive(pool->column(ParticlePool::X), pool->column(ParticlePool::X) + pool->numAlive());
+
+	std::sort(alive.begin(), alive.end());
+	ASSERT_EQ(alive, std::vector<float>({ 1.f, 3.f, 4.f }));
+
+	for (auto i = 0u; i < pool->numAlive(); ++i)
+		ASSERT_LT(pool->column(ParticlePool::TIME_LIVED)[i], pool->column(ParticlePool::LIFETIME)[i]);
+}
+
+TEST_F(ParticlePoolTest, ShrinkCapacityDiscardsLastParticles)
+{
+	auto pool = ParticlePool::create(6);
+
+	for (auto i = 0; i < 6; ++i)
+		pool->spawn(createParticle(float(i), 1.f));
+
+	pool->capacity(3);
+
+	ASSERT_EQ(pool->capacity(), 3);
+	ASSERT_EQ(pool->numAlive(), 3);
+	ASSERT_EQ(pool->column(ParticlePool::X)[2], 2.f);
+	ASSERT_EQ(pool->column(ParticlePool::Z)[2], 4.f);
+
+	pool->capacity(8);
+
+	ASSERT_EQ(pool->numAlive(), 3);
+	ASSERT_EQ(pool->column(ParticlePool::X)[2], 2.f);
+	ASSERT_EQ(pool->column(ParticlePool::Z)[2], 4.f);
+}
+
+TEST_F(ParticlePoolTest, MultiplyAddMatchesScalarLoop)
+{
+	std::vector<float> values(11);
+	std::vector<float> factors(11);
+
+	for (auto i = 0u; i < values.size(); ++i)
+	{
+		values[i] = float(i);
+		factors[i] = float(i) * 0.5f - 1.f;
+	}
+
+	auto expected = values;
+
+	// unaligned begin and an end that leaves a scalar tail
+	for (auto i = 1u; i < 10u; ++i)
+		expected[i] += factors[i] * 0.25f;
+
+	ParticlePool::multiplyAdd(values.data(), factors.data(), 0.25f, 1, 10);
+
+	ASSERT_EQ(values, expected);
+}
+
+TEST_F(ParticlePoolTest, AddMatchesScalarLoop)
+{
+	std::vector<float> values(9, 1.f);
+	auto expected = values;
+
+	for (auto i = 2u; i < 9u; ++i)
+		expected[i] += 0.5f;
+
+	ParticlePool::add(values.data(), 0.5f, 2, 9);
+
+	ASSERT_EQ(values, expected);
+}
+
+TEST_F(ParticlePoolTest, AgeAndIntegrate)
+{
+	auto pool = ParticlePool::create(7);
+	auto timeStep = 0.5f;
+
+	for (auto i = 0; i < 7; ++i)
+		pool->spawn(createParticle(float(i), 10.f));
+
+	pool->age(1, 6, timeStep);
+	pool->integrate(1, 6, timeStep);
+
+	for (auto i = 0u; i < 7; ++i)
+	{
+		auto particle = createParticle(float(i), 10.f);
+		ParticleData result;
+
+		pool->get(i, result);
+
+		if (i < 1 || i >= 6)
+		{
+			ASSERT_EQ(result.timeLived, 0.f);
+			ASSERT_EQ(result.x, particle.x);
+			ASSERT_EQ(result.rotation, 0.f);
+			continue;
+		}
+
+		auto vx = particle.startvx + particle.startfx * timeStep;
+		auto vy = particle.startvy + particle.startfy * timeStep;
+		auto vz = particle.startvz + particle.startfz * timeStep;
+
+		ASSERT_FLOAT_EQ(result.timeLived, timeStep);
+		ASSERT_FLOAT_EQ(result.oldx, particle.x);
+		ASSERT_FLOAT_EQ(result.oldy, particle.y);
+		ASSERT_FLOAT_EQ(result.oldz, particle.z);
+		ASSERT_FLOAT_EQ(result.startvx, vx);
+		ASSERT_FLOAT_EQ(result.startvy, vy);
+		ASSERT_FLOAT_EQ(result.startvz, vz);
+		ASSERT_FLOAT_EQ(result.x, particle.x + vx * timeStep);
+		ASSERT_FLOAT_EQ(result.y, particle.y + vy * timeStep);
+		ASSERT_FLOAT_EQ(result.z, particle.z + vz * timeStep);
+		ASSERT_FLOAT_EQ(result.rotation, particle.startAngularVelocity * timeStep);
+	}
+}
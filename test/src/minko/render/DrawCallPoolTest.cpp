@@ -0,0 +1,443 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCallPoolTest.hpp"
+#include "StubContext.hpp"
+#include "StubEffect.hpp"
+
+#include "minko/render/DrawCall.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+Effect::Ptr
+DrawCallPoolTest::createEffect(std::shared_ptr<AbstractContext> context)
+{
+	data::MacroBindingDefault macroDefault;
+	data::MacroBindingMap macroBindings;
+
+	macroDefault.semantic = data::MacroBindingDefaultValueSemantic::UNSET;
+	macroBindings["HAS_COLOR"] = data::MacroBinding("material[${materialId}].color", data::BindingSource::TARGET, macroDefault, 0, 10, nullptr);
+
+	return StubEffect::create(context, data::BindingMap(), data::BindingMap(), data::BindingMap(), macroBindings);
+}
+
+component::Surface::Ptr
+DrawCallPoolTest::addSurface(scene::Node::Ptr					root,
+							 std::shared_ptr<AbstractContext>	context,
+							 Effect::Ptr						effect,
+							 material::Material::Ptr			material)
+{
+	auto node = StubEffect::createSurfaceNode(context, effect, material);
+
+	root->addChild(node);
+
+	return node->component<component::Surface>();
+}
+
+component::Surface::Ptr
+DrawCallPoolTest::addSurface(scene::Node::Ptr			root,
+							 geometry::Geometry::Ptr	geometry,
+							 Effect::Ptr				effect,
+							 material::Material::Ptr	material)
+{
+	auto surface = component::Surface::create(geometry, material, effect);
+
+	root->addChild(scene::Node::create()->addComponent(surface));
+
+	return surface;
+}
+
+Effect::Ptr
+DrawCallPoolTest::createTexturedEffect(std::shared_ptr<AbstractContext> context)
+{
+	data::BindingMap attributeBindings;
+	data::BindingMap uniformBindings;
+	data::BindingMap stateBindings;
+
+	attributeBindings["aPosition"] = data::Binding("geometry[${geometryId}].position", data::BindingSource::TARGET);
+	uniformBindings["uDiffuseMap"] = data::Binding("material[${materialId}].diffuseMap", data::BindingSource::TARGET);
+	stateBindings["priority"] = data::Binding("material[${materialId}].priority", data::BindingSource::TARGET);
+
+	return StubEffect::create(
+		context,
+		attributeBindings,
+		uniformBindings,
+		stateBindings,
+		data::MacroBindingMap(),
+		"attribute vec3 aPosition; uniform sampler2D uDiffuseMap;"
+	);
+}
+
+material::Material::Ptr
+DrawCallPoolTest::createTexturedMaterial(AbstractTexture::Ptr texture, float priority)
+{
+	return material::Material::create()
+		->set("diffuseMap", texture)
+		->set("priority", priority);
+}
+
+Effect::Ptr
+DrawCallPoolTest::createInstancedEffect(std::shared_ptr<AbstractContext> context)
+{
+	data::BindingMap attributeBindings;
+
+	attributeBindings["instanceModelToWorldMatrix"] = data::Binding("instancing.modelToWorldMatrix", data::BindingSource::TARGET);
+
+	return StubEffect::create(context, attributeBindings);
+}
+
+component::Surface::Ptr
+DrawCallPoolTest::addInstance(scene::Node::Ptr			root,
+							  geometry::Geometry::Ptr	geometry,
+							  Effect::Ptr				effect,
+							  material::Material::Ptr	material,
+							  float						x)
+{
+	auto surface = component::Surface::create(geometry, material, effect);
+	auto transform = data::StructureProvider::create("transform");
+	auto node = scene::Node::create()->addComponent(surface);
+
+	transform->set("modelToWorldMatrix", math::Matrix4x4::create()->appendTranslation(x));
+	node->data()->addProvider(transform);
+	root->addChild(node);
+
+	return surface;
+}
+
+TEST_F(DrawCallPoolTest, InvisibleSurfacesKeepTheirDrawCalls)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createEffect(context);
+	auto material = material::Material::create();
+	auto hidden = addSurface(root, context, effect, material);
+	auto visible = addSurface(root, context, effect, material);
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+
+	auto drawCalls = std::set<DrawCall::Ptr>(renderer->drawCalls().begin(), renderer->drawCalls().end());
+
+	hidden->visible(renderer, false);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+	ASSERT_EQ(drawCalls.count(renderer->drawCalls().front()), 1);
+
+	hidden->visible(renderer, true);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+	ASSERT_EQ(std::set<DrawCall::Ptr>(renderer->drawCalls().begin(), renderer->drawCalls().end()), drawCalls);
+
+	// hiding a surface twice must not park its draw calls twice
+	hidden->visible(renderer, false);
+	hidden->visible(renderer, false);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+
+	root->removeChild(hidden->targets()[0]);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+}
+
+TEST_F(DrawCallPoolTest, DrawCallsShareProgramsAndInputBindings)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createEffect(context);
+	auto coloredMaterial = material::Material::create();
+
+	coloredMaterial->set("color", 1);
+	addSurface(root, context, effect, material::Material::create());
+	addSurface(root, context, effect, material::Material::create());
+	addSurface(root, context, effect, coloredMaterial);
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 3);
+
+	std::map<Program::Ptr, std::set<DrawCall::InputBindingsPtr>> programToInputBindings;
+
+	for (auto& drawCall : renderer->drawCalls())
+		programToInputBindings[drawCall->program()].insert(drawCall->inputBindings());
+
+	// one variant without and one with the macro, each selected and resolved once
+	ASSERT_EQ(programToInputBindings.size(), 2);
+	for (auto& programAndInputBindings : programToInputBindings)
+		ASSERT_EQ(programAndInputBindings.second.size(), 1);
+	ASSERT_EQ(context->numLinkedPrograms(), 2);
+}
+
+TEST_F(DrawCallPoolTest, InstancedBatchIsSplitWhenLayoutsChange)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createInstancedEffect(context);
+	auto geometry = geometry::QuadGeometry::create(context);
+	auto material = material::Material::create();
+
+	context->supportsInstancing(true);
+	renderer->instancing(true);
+	addInstance(root, geometry, effect, material, 0.f);
+	auto instance = addInstance(root, geometry, effect, material, 1.f);
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+	ASSERT_EQ(renderer->drawCalls().front()->numInstances(), 2);
+
+	instance->targets()[0]->layouts(scene::Layout::Group::DEFAULT | scene::Layout::Group::PICKING);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+	for (auto& drawCall : renderer->drawCalls())
+		ASSERT_EQ(drawCall->numInstances(), 1);
+
+	instance->targets()[0]->layouts(scene::Layout::Group::DEFAULT);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+	ASSERT_EQ(renderer->drawCalls().front()->numInstances(), 2);
+}
+
+TEST_F(DrawCallPoolTest, InstancesDoNotShareTheirOwnProviders)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createInstancedEffect(context);
+	auto geometry = geometry::QuadGeometry::create(context);
+	auto material = material::Material::create();
+	auto provider = data::StructureProvider::create("picking");
+
+	context->supportsInstancing(true);
+	renderer->instancing(true);
+	addInstance(root, geometry, effect, material, 0.f);
+	auto instance = addInstance(root, geometry, effect, material, 1.f);
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+
+	// only the transform is instanced: the batch leader properties cannot be used for the other instances
+	provider->set("color", math::Vector4::create(1.f, 0.f, 0.f, 1.f));
+	instance->targets()[0]->data()->addProvider(provider);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 2);
+
+	instance->targets()[0]->data()->removeProvider(provider);
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+	ASSERT_EQ(renderer->drawCalls().front()->numInstances(), 2);
+}
+
+TEST_F(DrawCallPoolTest, InstancedTransformsAreUpdatedWhenChanged)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createInstancedEffect(context);
+	auto geometry = geometry::QuadGeometry::create(context);
+	auto material = material::Material::create();
+
+	context->supportsInstancing(true);
+	renderer->instancing(true);
+	addInstance(root, geometry, effect, material, 0.f);
+	auto instance = addInstance(root, geometry, effect, material, 1.f);
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->numDrawCalls(), 1);
+
+	auto drawCall = renderer->drawCalls().front();
+	auto matrices = drawCall->targetData()->get<VertexBuffer::Ptr>("instancing.modelToWorldMatrix");
+	auto numUploads = context->vertexBufferUploads().size();
+
+	// the matrices are stored one column per attribute location: the translation is the last column
+	ASSERT_FLOAT_EQ(matrices->data()[12], 0.f);
+	ASSERT_FLOAT_EQ(matrices->data()[16 + 12], 1.f);
+
+	// unchanged batches are not packed nor uploaded again
+	renderer->render(context);
+	ASSERT_EQ(context->vertexBufferUploads().size(), numUploads);
+
+	instance->targets()[0]->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix")->appendTranslation(2.f);
+	renderer->render(context);
+	ASSERT_EQ(renderer->drawCalls().front(), drawCall);
+	ASSERT_FLOAT_EQ(matrices->data()[16 + 12], 3.f);
+	ASSERT_GT(context->vertexBufferUploads().size(), numUploads);
+}
+
+TEST_F(DrawCallPoolTest, StateSortGroupsDrawCallsByProgram)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effects = std::vector<Effect::Ptr>({ createTexturedEffect(context), createTexturedEffect(context) });
+	auto texture = Texture::create(context, 4, 4);
+
+	texture->upload();
+	for (auto i = 0; i < 6; ++i)
+		addSurface(root, context, effects[i % 2], createTexturedMaterial(texture));
+	addSurface(root, context, effects[1], createTexturedMaterial(texture, 10.f));
+
+	renderer->sortMode(DrawCallSortMode::STATE);
+	ASSERT_EQ(renderer->sortMode(), DrawCallSortMode::STATE);
+	context->clearDraws();
+	renderer->render(context);
+
+	const auto& drawCalls = renderer->drawCalls();
+
+	ASSERT_EQ(drawCalls.size(), 7);
+	// the priority comes first, then the draw calls of each program follow each other
+	ASSERT_EQ(drawCalls.front()->priority(), 10.f);
+
+	auto numProgramChanges = 0;
+
+	for (auto drawCallIt = std::next(drawCalls.begin(), 2); drawCallIt != drawCalls.end(); ++drawCallIt)
+		if ((*drawCallIt)->program() != (*std::prev(drawCallIt))->program())
+			++numProgramChanges;
+	ASSERT_EQ(numProgramChanges, 1);
+
+	// the context is only given a program when it changes
+	const auto& draws = context->draws();
+
+	ASSERT_EQ(draws.size(), 7);
+	for (uint i = 1; i < draws.size(); ++i)
+		ASSERT_EQ(draws[i].numProgramChanges, draws[i].program != draws[i - 1].program ? 1 : 0);
+}
+
+TEST_F(DrawCallPoolTest, StateSortGroupsDrawCallsByTexture)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effect = createTexturedEffect(context);
+	auto textures = std::vector<AbstractTexture::Ptr>({ Texture::create(context, 4, 4), Texture::create(context, 4, 4) });
+
+	for (auto& texture : textures)
+		texture->upload();
+	for (auto i = 0; i < 6; ++i)
+		addSurface(root, context, effect, createTexturedMaterial(textures[i % 2]));
+
+	renderer->sortMode(DrawCallSortMode::STATE);
+	context->clearDraws();
+	renderer->render(context);
+
+	const auto& drawCalls = renderer->drawCalls();
+	const auto& draws = context->draws();
+
+	ASSERT_EQ(draws.size(), 6);
+
+	auto previous = drawCalls.begin();
+	auto numTextureChanges = 0;
+
+	for (auto drawCallIt = std::next(previous); drawCallIt != drawCalls.end(); previous = drawCallIt++)
+		if ((*drawCallIt)->textureIds() != (*previous)->textureIds())
+			++numTextureChanges;
+	ASSERT_EQ(numTextureChanges, 1);
+
+	// the textures are bound for the first draw call, then once when they change
+	auto numTextureBindingChanges = 0;
+
+	for (uint i = 1; i < draws.size(); ++i)
+		if (draws[i].numTextureBindings > 0)
+			++numTextureBindingChanges;
+	ASSERT_TRUE(draws[0].numTextureBindings > 0);
+	ASSERT_EQ(numTextureBindingChanges, 1);
+}
+
+TEST_F(DrawCallPoolTest, PrioritySortIsStable)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effects = std::vector<Effect::Ptr>({ createTexturedEffect(context), createTexturedEffect(context) });
+	auto texture = Texture::create(context, 4, 4);
+	auto priorities = std::vector<float>({ 10.f, 0.f, -10.f });
+
+	texture->upload();
+	for (auto i = 0; i < 9; ++i)
+		addSurface(root, context, effects[i % 2], createTexturedMaterial(texture, priorities[i % 3]));
+
+	renderer->sortMode(DrawCallSortMode::STATE);
+	renderer->render(context);
+
+	auto drawCalls = std::vector<DrawCall::Ptr>(renderer->drawCalls().begin(), renderer->drawCalls().end());
+
+	// the draw calls sorted by state are sorted by priority too: sorting them again by priority keeps
+	// the order of the ones with the same priority
+	renderer->sortMode(DrawCallSortMode::PRIORITY);
+	renderer->render(context);
+
+	auto sortedDrawCalls = std::vector<DrawCall::Ptr>(renderer->drawCalls().begin(), renderer->drawCalls().end());
+
+	ASSERT_EQ(sortedDrawCalls.size(), 9);
+	for (uint i = 1; i < sortedDrawCalls.size(); ++i)
+		ASSERT_TRUE(sortedDrawCalls[i - 1]->priority() >= sortedDrawCalls[i]->priority());
+	ASSERT_TRUE(std::equal(drawCalls.begin(), drawCalls.end(), sortedDrawCalls.begin()));
+}
+
+TEST_F(DrawCallPoolTest, StatesAreOnlySetWhenThePreviousDrawCallDiffers)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")->addComponent(renderer);
+	auto effects = std::vector<Effect::Ptr>({ createTexturedEffect(context), createTexturedEffect(context) });
+	auto geometries = std::vector<geometry::Geometry::Ptr>({
+		geometry::QuadGeometry::create(context),
+		geometry::QuadGeometry::create(context)
+	});
+	auto textures = std::vector<AbstractTexture::Ptr>({ Texture::create(context, 4, 4), Texture::create(context, 4, 4) });
+
+	for (auto& texture : textures)
+		texture->upload();
+
+	// decreasing priorities render the surfaces in this order
+	addSurface(root, geometries[0], effects[0], createTexturedMaterial(textures[0], 5.f));
+	addSurface(root, geometries[0], effects[0], createTexturedMaterial(textures[0], 4.f));
+	addSurface(root, geometries[0], effects[0], createTexturedMaterial(textures[1], 3.f));
+	addSurface(root, geometries[1], effects[0], createTexturedMaterial(textures[1], 2.f));
+	addSurface(root, geometries[1], effects[1], createTexturedMaterial(textures[1], 1.f));
+
+	context->clearDraws();
+	renderer->render(context);
+
+	const auto& draws = context->draws();
+
+	ASSERT_EQ(draws.size(), 5);
+
+	// the first draw call sets everything
+	ASSERT_EQ(draws[0].numProgramChanges, 1);
+	ASSERT_TRUE(draws[0].numTextureBindings > 0);
+	ASSERT_TRUE(draws[0].numVertexBufferBindings > 0);
+	// same program, textures and vertex buffers
+	ASSERT_EQ(draws[1].numProgramChanges, 0);
+	ASSERT_EQ(draws[1].numTextureBindings, 0);
+	ASSERT_EQ(draws[1].numVertexBufferBindings, 0);
+	// other texture
+	ASSERT_EQ(draws[2].numProgramChanges, 0);
+	ASSERT_TRUE(draws[2].numTextureBindings > 0);
+	ASSERT_EQ(draws[2].numVertexBufferBindings, 0);
+	// other geometry
+	ASSERT_EQ(draws[3].numProgramChanges, 0);
+	ASSERT_EQ(draws[3].numTextureBindings, 0);
+	ASSERT_TRUE(draws[3].numVertexBufferBindings > 0);
+	// other program: its textures and vertex attributes have to be set too
+	ASSERT_EQ(draws[4].numProgramChanges, 1);
+	ASSERT_TRUE(draws[4].numTextureBindings > 0);
+	ASSERT_TRUE(draws[4].numVertexBufferBindings > 0);
+}
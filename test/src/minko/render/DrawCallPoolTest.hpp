@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+#include "gtest/gtest.h"
+
+namespace minko
+{
+	namespace render
+	{
+		class DrawCallPoolTest :
+			public ::testing::Test
+		{
+		protected:
+			static
+			Effect::Ptr
+			createEffect(std::shared_ptr<AbstractContext> context);
+
+			static
+			component::Surface::Ptr
+			addSurface(scene::Node::Ptr					root,
+					   std::shared_ptr<AbstractContext>	context,
+					   Effect::Ptr						effect,
+					   material::Material::Ptr			material);
+
+			static
+			component::Surface::Ptr
+			addSurface(scene::Node::Ptr			root,
+					   geometry::Geometry::Ptr	geometry,
+					   Effect::Ptr				effect,
+					   material::Material::Ptr	material);
+
+			// samples material.diffuseMap with the positions of the geometry, at the priority of the material
+			static
+			Effect::Ptr
+			createTexturedEffect(std::shared_ptr<AbstractContext> context);
+
+			static
+			material::Material::Ptr
+			createTexturedMaterial(AbstractTexture::Ptr texture, float priority = 0.f);
+
+			static
+			Effect::Ptr
+			createInstancedEffect(std::shared_ptr<AbstractContext> context);
+
+			static
+			component::Surface::Ptr
+			addInstance(scene::Node::Ptr			root,
+						geometry::Geometry::Ptr		geometry,
+						Effect::Ptr					effect,
+						material::Material::Ptr		material,
+						float						x);
+		};
+	}
+}
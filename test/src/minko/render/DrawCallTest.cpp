@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCallTest.hpp"
+#include "StubContext.hpp"
+#include "StubEffect.hpp"
+
+#include "minko/render/DrawCall.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+Effect::Ptr
+DrawCallTest::createEffect(std::shared_ptr<AbstractContext> context)
+{
+	data::BindingMap uniformBindings;
+
+	uniformBindings["uColor"] = data::Binding("material[${materialId}].color", data::BindingSource::TARGET);
+	uniformBindings["uAlpha"] = data::Binding("material[${materialId}].alpha", data::BindingSource::TARGET);
+	uniformBindings["uIndex"] = data::Binding("material[${materialId}].index", data::BindingSource::TARGET);
+
+	return StubEffect::create(
+		context,
+		data::BindingMap(),
+		uniformBindings,
+		data::BindingMap(),
+		data::MacroBindingMap(),
+		"uniform vec4 uColor; uniform float uAlpha; uniform int uIndex;"
+	);
+}
+
+material::Material::Ptr
+DrawCallTest::createMaterial(float red, float alpha, int index)
+{
+	return material::Material::create()
+		->set("color", math::Vector4::create(red, 0.f, 0.f, 1.f))
+		->set("alpha", alpha)
+		->set("index", index);
+}
+
+TEST_F(DrawCallTest, UnchangedUniformsAreNotUploadedAgain)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto material = createMaterial(1.f, .5f, 2);
+	auto root = scene::Node::create("root")
+		->addComponent(renderer)
+		->addChild(StubEffect::createSurfaceNode(context, createEffect(context), material));
+
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws().size(), 1);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 3);
+
+	// the program still holds the values of the draw call
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws().size(), 1);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 0);
+
+	// only the uniforms that changed are uploaded
+	material->get<math::Vector4::Ptr>("color")->x(0.f);
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 1);
+
+	material->set("alpha", .25f);
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 1);
+
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 0);
+}
+
+TEST_F(DrawCallTest, ProgramSetUniformForcesUpload)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto root = scene::Node::create("root")
+		->addComponent(renderer)
+		->addChild(StubEffect::createSurfaceNode(context, createEffect(context), createMaterial(1.f, .5f, 2)));
+
+	renderer->render(context);
+
+	auto program = renderer->drawCalls().front()->program();
+
+	// the value set by the program replaces the one of the draw call: every uniform is uploaded again
+	program->setUniform("uIndex", 7);
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws().size(), 1);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 3);
+
+	context->clearDraws();
+	renderer->render(context);
+	ASSERT_EQ(context->draws()[0].numUniformUploads, 0);
+}
+
+TEST_F(DrawCallTest, DrawCallsSharingAProgramUploadTheirOwnUniforms)
+{
+	auto context = StubContext::create();
+	auto renderer = component::Renderer::create();
+	auto effect = createEffect(context);
+	auto root = scene::Node::create("root")
+		->addComponent(renderer)
+		->addChild(StubEffect::createSurfaceNode(context, effect, createMaterial(1.f, .5f, 2)))
+		->addChild(StubEffect::createSurfaceNode(context, effect, createMaterial(0.f, .25f, 3)));
+
+	renderer->render(context);
+	ASSERT_EQ(renderer->drawCalls().front()->program(), renderer->drawCalls().back()->program());
+
+	// each draw call replaces the values of the other one
+	for (auto frame = 0; frame < 2; ++frame)
+	{
+		context->clearDraws();
+		renderer->render(context);
+		ASSERT_EQ(context->draws().size(), 2);
+		ASSERT_EQ(context->draws()[0].numUniformUploads, 3);
+		ASSERT_EQ(context->draws()[1].numUniformUploads, 3);
+	}
+}
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageResamplerTest.hpp"
+
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(ImageResamplerTest, ResizeToSameSizeCopies)
+{
+	auto data = std::vector<unsigned char>({ 1, 2, 3, 4, 5, 6, 7, 8 });
+	auto newData = std::vector<unsigned char>();
+
+	ImageResampler::resize(2, 1, data.data(), 2, 1, ImageResampler::Filter::KAISER, true, newData);
+
+	ASSERT_EQ(newData, data);
+}
+
+TEST_F(ImageResamplerTest, BoxDownsampleAveragesPixels)
+{
+	auto data = std::vector<unsigned char>({
+		0, 0, 0, 255,		255, 255, 255, 255,
+		100, 0, 0, 255,		0, 100, 0, 255
+	});
+	auto newData = std::vector<unsigned char>();
+
+	ImageResampler::resize(2, 2, data.data(), 1, 1, ImageResampler::Filter::BOX, false, newData);
+
+	ASSERT_EQ(newData, std::vector<unsigned char>({ 89, 89, 64, 255 }));
+}
+
+TEST_F(ImageResamplerTest, SRGBDownsampleIsFilteredInLinearSpace)
+{
+	auto data = std::vector<unsigned char>({ 0, 0, 0, 255, 255, 255, 255, 255 });
+	auto newData = std::vector<unsigned char>();
+
+	ImageResampler::resize(2, 1, data.data(), 1, 1, ImageResampler::Filter::BOX, true, newData);
+	ASSERT_EQ(newData, std::vector<unsigned char>({ 188, 188, 188, 255 }));
+
+	ImageResampler::resize(2, 1, data.data(), 1, 1, ImageResampler::Filter::BOX, false, newData);
+	ASSERT_EQ(newData, std::vector<unsigned char>({ 128, 128, 128, 255 }));
+}
+
+TEST_F(ImageResamplerTest, TransparentPixelsDoNotBleedInMipChains)
+{
+	// a transparent red pixel next to an opaque blue one
+	auto data = std::vector<unsigned char>({ 255, 0, 0, 0, 0, 0, 255, 255 });
+	auto mipChain = std::vector<unsigned char>();
+
+	ImageResampler::generateMipChain(2, 1, data.data(), ImageResampler::Filter::BOX, false, mipChain, true);
+	ASSERT_EQ(std::vector<unsigned char>(mipChain.begin() + 8, mipChain.end()), std::vector<unsigned char>({ 0, 0, 255, 128 }));
+
+	mipChain.clear();
+	ImageResampler::generateMipChain(2, 1, data.data(), ImageResampler::Filter::BOX, true, mipChain, true);
+	ASSERT_EQ(std::vector<unsigned char>(mipChain.begin() + 8, mipChain.end()), std::vector<unsigned char>({ 0, 0, 255, 128 }));
+}
+
+TEST_F(ImageResamplerTest, ResizeKeepsStraightAlpha)
+{
+	// alpha is data in packed textures: the color of a transparent texel must be kept
+	auto data = std::vector<unsigned char>({ 200, 100, 50, 0, 10, 20, 30, 255 });
+	auto newData = std::vector<unsigned char>();
+
+	ImageResampler::resize(2, 1, data.data(), 4, 1, ImageResampler::Filter::NEAREST, true, newData);
+	ASSERT_EQ(newData, std::vector<unsigned char>({
+		200, 100, 50, 0,	200, 100, 50, 0,	10, 20, 30, 255,	10, 20, 30, 255
+	}));
+
+	ImageResampler::resize(2, 1, data.data(), 1, 1, ImageResampler::Filter::BOX, false, newData);
+	ASSERT_EQ(newData, std::vector<unsigned char>({ 105, 60, 40, 128 }));
+}
+
+TEST_F(ImageResamplerTest, NearestUpsampleReplicatesPixels)
+{
+	auto data = std::vector<unsigned char>({ 10, 20, 30, 40, 50, 60, 70, 80 });
+	auto newData = std::vector<unsigned char>();
+
+	ImageResampler::resize(2, 1, data.data(), 4, 1, ImageResampler::Filter::NEAREST, false, newData);
+
+	ASSERT_EQ(newData, std::vector<unsigned char>({
+		10, 20, 30, 40,		10, 20, 30, 40,		50, 60, 70, 80,		50, 60, 70, 80
+	}));
+}
+
+TEST_F(ImageResamplerTest, FiltersPreserveConstantImages)
+{
+	const uint width = 301;
+	const uint height = 203;
+	auto data = std::vector<unsigned char>(width * height * 4);
+	auto newData = std::vector<unsigned char>();
+
+	for (uint i = 0; i < data.size(); i += 4)
+	{
+		data[i] = 12;
+		data[i + 1] = 34;
+		data[i + 2] = 56;
+		data[i + 3] = 78;
+	}
+
+	for (auto filter : { ImageResampler::Filter::NEAREST, ImageResampler::Filter::LINEAR,
+						 ImageResampler::Filter::BOX, ImageResampler::Filter::KAISER })
+	{
+		ImageResampler::resize(width, height, data.data(), 128, 64, filter, true, newData);
+
+		ASSERT_EQ(newData.size(), 128 * 64 * 4);
+		for (uint i = 0; i < newData.size(); i += 4)
+		{
+			ASSERT_EQ(newData[i], 12);
+			ASSERT_EQ(newData[i + 1], 34);
+			ASSERT_EQ(newData[i + 2], 56);
+			ASSERT_EQ(newData[i + 3], 78);
+		}
+
+		ImageResampler::resize(width, height, data.data(), 512, 256, filter, true, newData);
+
+		ASSERT_EQ(newData.size(), 512 * 256 * 4);
+		ASSERT_EQ(newData[0], 12);
+		ASSERT_EQ(newData[newData.size() - 1], 78);
+	}
+}
+
+TEST_F(ImageResamplerTest, GenerateMipChain)
+{
+	auto data = std::vector<unsigned char>(8 * 4 * 4, 255);
+	auto mipChain = std::vector<unsigned char>({ 1, 2, 3 });
+
+	const auto numLevels = ImageResampler::generateMipChain(
+		8, 4, data.data(), ImageResampler::Filter::KAISER, true, mipChain
+	);
+
+	ASSERT_EQ(numLevels, 4);
+	ASSERT_EQ(ImageResampler::numMipLevels(8, 4), 4);
+	ASSERT_EQ(mipChain.size(), 3 + (8 * 4 + 4 * 2 + 2 * 1 + 1 * 1) * 4);
+	ASSERT_EQ(mipChain[0], 1);
+	ASSERT_TRUE(std::all_of(mipChain.begin() + 3, mipChain.end(), [](unsigned char c) { return c == 255; }));
+}
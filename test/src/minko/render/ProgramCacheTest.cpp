@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProgramCacheTest.hpp"
+#include "StubContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+Pass::Ptr
+ProgramCacheTest::createPass(std::shared_ptr<AbstractContext> context)
+{
+	data::MacroBindingDefault macroDefault;
+	data::MacroBindingMap macroBindings;
+
+	macroDefault.semantic = data::MacroBindingDefaultValueSemantic::UNSET;
+	macroBindings["HAS_COLOR"] = data::MacroBinding("color", data::BindingSource::TARGET, macroDefault, 0, 10, nullptr);
+
+	auto program = Program::create(
+		context,
+		Shader::create(context, Shader::Type::VERTEX_SHADER, "void main() { }"),
+		Shader::create(context, Shader::Type::FRAGMENT_SHADER, "void main() { }")
+	);
+
+	return Pass::create("pass", program, data::BindingMap(), data::BindingMap(), data::BindingMap(), macroBindings, States::create(), "");
+}
+
+Program::Ptr
+ProgramCacheTest::selectProgram(Pass::Ptr pass, std::shared_ptr<data::Container> targetData)
+{
+	std::list<std::string> booleanMacros;
+	std::list<std::string> integerMacros;
+	std::list<std::string> incorrectIntegerMacros;
+
+	return pass->selectProgram(
+		[](const std::string& name) { return name; },
+		targetData,
+		data::Container::create(),
+		data::Container::create(),
+		booleanMacros,
+		integerMacros,
+		incorrectIntegerMacros
+	);
+}
+
+TEST_F(ProgramCacheTest, ProgramsAreLoadedFromBinaries)
+{
+	auto context = StubContext::create();
+	auto targetData = data::Container::create();
+	auto cache = ProgramCache::create(context, "program-cache.bin");
+	auto pass = createPass(context);
+	auto provider = data::Provider::create();
+
+	provider->set("color", 1);
+	targetData->addProvider(provider);
+	pass->programCache(cache);
+
+	ASSERT_TRUE(selectProgram(pass, targetData)->isReady());
+	ASSERT_EQ(1, context->numLinkedPrograms());
+	ASSERT_EQ(1, cache->numPrograms());
+	ASSERT_TRUE(cache->changed());
+
+	cache->save();
+	ASSERT_FALSE(cache->changed());
+
+	auto reloadedCache = ProgramCache::create(context, "program-cache.bin");
+	auto reloadedPass = createPass(context);
+
+	reloadedPass->programCache(reloadedCache);
+
+	auto program = selectProgram(reloadedPass, targetData);
+
+	ASSERT_TRUE(program->isReady());
+	ASSERT_FALSE(program->vertexShader()->isReady());
+	ASSERT_EQ(1, context->numLinkedPrograms());
+
+	std::remove("program-cache.bin");
+}
+
+TEST_F(ProgramCacheTest, PrewarmBuildsRecordedVariants)
+{
+	auto context = StubContext::create();
+	auto cache = ProgramCache::create(context, "program-cache.bin");
+	auto pass = createPass(context);
+	auto colorData = data::Container::create();
+	auto provider = data::Provider::create();
+
+	provider->set("color", 1);
+	colorData->addProvider(provider);
+	pass->programCache(cache);
+	selectProgram(pass, data::Container::create());
+	selectProgram(pass, colorData);
+	cache->save();
+
+	ASSERT_EQ(2, context->numLinkedPrograms());
+
+	auto reloadedPass = createPass(context);
+
+	reloadedPass->programCache(ProgramCache::create(context, "program-cache.bin"));
+	reloadedPass->prewarm();
+
+	// both variants now exist: selecting them neither compiles nor links anything
+	auto withColor = selectProgram(reloadedPass, colorData);
+	auto withoutColor = selectProgram(reloadedPass, data::Container::create());
+
+	ASSERT_TRUE(withColor->isReady());
+	ASSERT_TRUE(withoutColor->isReady());
+	ASSERT_TRUE(withColor != withoutColor);
+	ASSERT_EQ(2, context->numLinkedPrograms());
+
+	std::remove("program-cache.bin");
+}
+
+TEST_F(ProgramCacheTest, DriverChangeDropsBinariesButKeepsVariants)
+{
+	auto context = StubContext::create();
+	auto cache = ProgramCache::create(context, "program-cache.bin");
+	auto pass = createPass(context);
+	auto targetData = data::Container::create();
+
+	pass->programCache(cache);
+	selectProgram(pass, targetData);
+	cache->save();
+
+	context->driverInfo("updated stub");
+
+	auto reloadedCache = ProgramCache::create(context, "program-cache.bin");
+	auto reloadedPass = createPass(context);
+
+	ASSERT_EQ(1, reloadedCache->numPrograms());
+	ASSERT_TRUE(reloadedCache->changed());
+
+	reloadedPass->programCache(reloadedCache);
+	reloadedPass->prewarm();
+
+	ASSERT_EQ(2, context->numLinkedPrograms());
+	ASSERT_TRUE(selectProgram(reloadedPass, targetData)->isReady());
+	ASSERT_EQ(2, context->numLinkedPrograms());
+
+	std::remove("program-cache.bin");
+}
+
+TEST_F(ProgramCacheTest, SourceChangeMissesCache)
+{
+	auto context = StubContext::create();
+	auto cache = ProgramCache::create(context, "program-cache.bin");
+	auto pass = createPass(context);
+
+	pass->programCache(cache);
+	selectProgram(pass, data::Container::create());
+
+	pass->program()->fragmentShader()->source("void main() { gl_FragColor = vec4(1.0); }");
+
+	auto otherPass = createPass(context);
+
+	otherPass->program()->fragmentShader()->source("void main() { gl_FragColor = vec4(1.0); }");
+	otherPass->programCache(cache);
+	otherPass->prewarm();
+
+	ASSERT_EQ(1, context->numLinkedPrograms());
+	ASSERT_TRUE(selectProgram(otherPass, data::Container::create())->isReady());
+	ASSERT_EQ(2, context->numLinkedPrograms());
+	ASSERT_EQ(2, cache->numPrograms());
+}
+
+TEST_F(ProgramCacheTest, MacroBindingChangeMissesCache)
+{
+	auto context = StubContext::create();
+	auto program = createPass(context)->program();
+	auto macroBindings = createPass(context)->macroBindings();
+	auto sourceHash = ProgramCache::sourceHash(program, macroBindings);
+
+	ASSERT_EQ(sourceHash, ProgramCache::sourceHash(program, createPass(context)->macroBindings()));
+
+	std::get<0>(macroBindings["HAS_COLOR"]) = "diffuseColor";
+	ASSERT_NE(sourceHash, ProgramCache::sourceHash(program, macroBindings));
+
+	macroBindings = createPass(context)->macroBindings();
+	std::get<2>(macroBindings["HAS_COLOR"]).semantic = data::MacroBindingDefaultValueSemantic::VALUE;
+	std::get<2>(macroBindings["HAS_COLOR"]).value.value = 2;
+	ASSERT_NE(sourceHash, ProgramCache::sourceHash(program, macroBindings));
+
+	macroBindings = createPass(context)->macroBindings();
+	macroBindings["HAS_NORMAL"] = macroBindings["HAS_COLOR"];
+	ASSERT_NE(sourceHash, ProgramCache::sourceHash(program, macroBindings));
+}
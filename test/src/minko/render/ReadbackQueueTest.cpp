@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ReadbackQueueTest.hpp"
+#include "StubContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(ReadbackQueueTest, CallbackIsDelayedUntilReadCompletes)
+{
+	auto context = StubContext::create(16, 1);
+	auto queue = ReadbackQueue::create(context);
+	auto pixels = std::vector<unsigned char>();
+
+	context->readPixelsLatency(2);
+	context->pixel(3, 0, 0x010203ff);
+
+	queue->read(3, 0, 1, 1, [&](const std::vector<unsigned char>& result)
+	{
+		pixels = result;
+	});
+
+	ASSERT_EQ(queue->update(), 1);
+	context->present();
+	ASSERT_EQ(queue->update(), 1);
+	ASSERT_TRUE(pixels.empty());
+
+	context->present();
+	ASSERT_EQ(queue->update(), 0);
+	ASSERT_EQ(pixels, std::vector<unsigned char>({ 1, 2, 3, 0xff }));
+	ASSERT_EQ(context->numReadPixels(), 0);
+	ASSERT_EQ(context->numPendingPixelReads(), 0);
+}
+
+TEST_F(ReadbackQueueTest, ReadsPixelsRenderedWhenStarted)
+{
+	auto context = StubContext::create(16, 1);
+	auto queue = ReadbackQueue::create(context);
+	auto pixels = std::vector<unsigned char>();
+
+	context->pixel(0, 0, 0x0000ffff);
+	context->pixel(1, 0, 0x00ff00ff);
+
+	queue->read(0, 0, 2, 1, [&](const std::vector<unsigned char>& result)
+	{
+		pixels = result;
+	});
+
+	context->pixel(0, 0, 0xff0000ff);
+	context->present();
+	queue->update();
+
+	ASSERT_EQ(pixels, std::vector<unsigned char>({ 0, 0, 0xff, 0xff, 0, 0xff, 0, 0xff }));
+}
+
+TEST_F(ReadbackQueueTest, CallbacksAreExecutedInOrder)
+{
+	auto context = StubContext::create(16, 1);
+	auto queue = ReadbackQueue::create(context);
+	auto colors = std::vector<unsigned char>();
+
+	for (uint i = 0; i < 4; ++i)
+	{
+		context->pixel(i, 0, i << 24);
+		// the first read is the slowest one: it must still be the first callback executed
+		context->readPixelsLatency(i == 0 ? 3 : 1);
+		queue->read(i, 0, 1, 1, [&](const std::vector<unsigned char>& result)
+		{
+			colors.push_back(result[0]);
+		});
+	}
+
+	context->present();
+	ASSERT_EQ(queue->update(), 4);
+	ASSERT_TRUE(colors.empty());
+
+	context->present();
+	context->present();
+	ASSERT_EQ(queue->update(), 0);
+	ASSERT_EQ(colors, std::vector<unsigned char>({ 0, 1, 2, 3 }));
+}
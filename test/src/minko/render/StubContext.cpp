@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StubContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+StubContext::StubContext(uint viewportWidth, uint viewportHeight) :
+	_driverInfo("stub"),
+	_nextId(0),
+	_renderTarget(0),
+	_viewportWidth(viewportWidth),
+	_viewportHeight(viewportHeight),
+	_currentProgram(0),
+	_readPixelsLatency(1),
+	_pixels(viewportWidth * viewportHeight * 4, 0),
+	_pixelReads(),
+	_numReadPixels(0),
+	_numLinkedPrograms(0),
+	_vertexBufferUploads(),
+	_supportsInstancing(false),
+	_shaderSources(),
+	_programShaders(),
+	_nextDraw(),
+	_draws()
+{
+}
+
+void
+StubContext::uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data)
+{
+	VertexBufferUpload upload;
+
+	upload.vertexBuffer = vertexBuffer;
+	upload.offset = offset;
+	upload.data.assign(static_cast<float*>(data), static_cast<float*>(data) + size);
+
+	_vertexBufferUploads.push_back(upload);
+}
+
+void
+StubContext::pixel(uint x, uint y, uint rgba)
+{
+	auto offset = (y * _viewportWidth + x) * 4;
+
+	_pixels[offset] = (rgba >> 24) & 0xff;
+	_pixels[offset + 1] = (rgba >> 16) & 0xff;
+	_pixels[offset + 2] = (rgba >> 8) & 0xff;
+	_pixels[offset + 3] = rgba & 0xff;
+}
+
+void
+StubContext::present()
+{
+	for (auto& idAndRead : _pixelReads)
+		if (idAndRead.second.numFramesLeft > 0)
+			--idAndRead.second.numFramesLeft;
+}
+
+bool
+StubContext::getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary)
+{
+	format = 1;
+	binary.assign(_driverInfo.begin(), _driverInfo.end());
+
+	return true;
+}
+
+bool
+StubContext::setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary)
+{
+	return format == 1 && std::string(binary.begin(), binary.end()) == _driverInfo;
+}
+
+std::shared_ptr<ProgramInputs>
+StubContext::getProgramInputs(const uint program)
+{
+	static const std::regex declaration("(uniform|attribute)\\s+(\\w+)\\s+(\\w+)\\s*;");
+	static const std::unordered_map<std::string, ProgramInputs::Type> uniformTypes = {
+		{ "int", ProgramInputs::Type::int1 },
+		{ "ivec2", ProgramInputs::Type::int2 },
+		{ "ivec3", ProgramInputs::Type::int3 },
+		{ "ivec4", ProgramInputs::Type::int4 },
+		{ "float", ProgramInputs::Type::float1 },
+		{ "vec2", ProgramInputs::Type::float2 },
+		{ "vec3", ProgramInputs::Type::float3 },
+		{ "vec4", ProgramInputs::Type::float4 },
+		{ "mat4", ProgramInputs::Type::float16 },
+		{ "sampler2D", ProgramInputs::Type::sampler2d },
+		{ "samplerCube", ProgramInputs::Type::samplerCube }
+	};
+
+	std::vector<std::string> names;
+	std::vector<ProgramInputs::Type> types;
+	std::vector<uint> locations;
+	uint numUniforms = 0;
+	uint numAttributes = 0;
+
+	// uniforms and attributes have their own locations, in the order of their declarations
+	for (auto shader : _programShaders[program])
+	{
+		const auto& source = _shaderSources[shader];
+
+		for (std::sregex_iterator match(source.begin(), source.end(), declaration), end; match != end; ++match)
+		{
+			const auto name = (*match)[3].str();
+
+			if (std::find(names.begin(), names.end(), name) != names.end())
+				continue;
+
+			const auto isAttribute = (*match)[1].str() == "attribute";
+			const auto typeIt = uniformTypes.find((*match)[2].str());
+
+			names.push_back(name);
+			types.push_back(isAttribute ? ProgramInputs::Type::attribute
+				: typeIt != uniformTypes.end() ? typeIt->second
+				: ProgramInputs::Type::unknown);
+			locations.push_back(isAttribute ? numAttributes++ : numUniforms++);
+		}
+	}
+
+	return ProgramInputs::create(shared_from_this(), program, names, types, locations);
+}
+
+void
+StubContext::clearDraws()
+{
+	_nextDraw = Draw();
+	_draws.clear();
+}
+
+void
+StubContext::draw()
+{
+	_nextDraw.program = _currentProgram;
+	_draws.push_back(_nextDraw);
+	_nextDraw = Draw();
+}
+
+void
+StubContext::readPixels(unsigned char* pixels)
+{
+	readPixels(0, 0, _viewportWidth, _viewportHeight, pixels);
+}
+
+void
+StubContext::readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels)
+{
+	++_numReadPixels;
+
+	copyPixels(x, y, width, height, pixels);
+}
+
+uint
+StubContext::readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+	auto id = ++_nextId;
+	auto& read = _pixelReads[id];
+
+	read.numFramesLeft = _readPixelsLatency;
+	read.pixels.resize(width * height * 4);
+	copyPixels(x, y, width, height, &read.pixels[0]);
+
+	return id;
+}
+
+bool
+StubContext::readPixelsAsyncResult(uint id, unsigned char* pixels)
+{
+	auto readIt = _pixelReads.find(id);
+
+	if (readIt == _pixelReads.end())
+		throw std::invalid_argument("read");
+	if (readIt->second.numFramesLeft > 0)
+		return false;
+
+	std::copy(readIt->second.pixels.begin(), readIt->second.pixels.end(), pixels);
+	_pixelReads.erase(readIt);
+
+	return true;
+}
+
+void
+StubContext::copyPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels)
+{
+	for (uint j = 0; j < height; ++j)
+		std::copy(
+			_pixels.begin() + ((y + j) * _viewportWidth + x) * 4,
+			_pixels.begin() + ((y + j) * _viewportWidth + x + width) * 4,
+			pixels + j * width * 4
+		);
+}
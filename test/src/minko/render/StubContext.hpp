@@ -0,0 +1,257 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		/**
+		 * An AbstractContext that does not render anything, to test the engine without a GPU. Asynchronous
+		 * reads of pixels complete after a configurable number of calls to present(). Programs have the
+		 * uniforms and attributes declared in their shaders, and the state changes made before each
+		 * draw call are recorded.
+		 */
+		class StubContext :
+			public AbstractContext,
+			public std::enable_shared_from_this<StubContext>
+		{
+		public:
+			typedef std::shared_ptr<StubContext>	Ptr;
+
+			// offset and data are in floats, like the arguments of uploadVertexBufferData()
+			struct VertexBufferUpload
+			{
+				uint						vertexBuffer;
+				uint						offset;
+				std::vector<float>			data;
+			};
+
+			// the state changes made since the previous draw call
+			struct Draw
+			{
+				uint						program;
+				uint						numProgramChanges;
+				uint						numTextureBindings;
+				uint						numVertexBufferBindings;
+				uint						numUniformUploads;
+			};
+
+		private:
+			struct PixelRead
+			{
+				uint						numFramesLeft;
+				std::vector<unsigned char>	pixels;
+			};
+
+		private:
+			std::string							_driverInfo;
+			uint								_nextId;
+			uint								_renderTarget;
+			uint								_viewportWidth;
+			uint								_viewportHeight;
+			uint								_currentProgram;
+			uint								_readPixelsLatency;
+			std::vector<unsigned char>			_pixels;
+			std::unordered_map<uint, PixelRead>	_pixelReads;
+			uint								_numReadPixels;
+			uint								_numLinkedPrograms;
+			std::vector<VertexBufferUpload>		_vertexBufferUploads;
+			bool								_supportsInstancing;
+			std::unordered_map<uint, std::string>		_shaderSources;
+			std::unordered_map<uint, std::vector<uint>>	_programShaders;
+			Draw								_nextDraw;
+			std::vector<Draw>					_draws;
+
+		public:
+			inline static
+			Ptr
+			create(uint viewportWidth = 64, uint viewportHeight = 64)
+			{
+				return std::shared_ptr<StubContext>(new StubContext(viewportWidth, viewportHeight));
+			}
+
+			// number of calls to present() before an asynchronous read completes
+			inline
+			void
+			readPixelsLatency(uint numFrames)
+			{
+				_readPixelsLatency = numFrames;
+			}
+
+			// the color "rendered" at (x, y), as 0xRRGGBBAA
+			void
+			pixel(uint x, uint y, uint rgba);
+
+			// number of synchronous reads, each of which would have stalled a real GPU
+			inline
+			uint
+			numReadPixels() const
+			{
+				return _numReadPixels;
+			}
+
+			// number of programs linked from their shaders, program binaries excluded
+			inline
+			uint
+			numLinkedPrograms() const
+			{
+				return _numLinkedPrograms;
+			}
+
+			inline
+			const std::vector<VertexBufferUpload>&
+			vertexBufferUploads() const
+			{
+				return _vertexBufferUploads;
+			}
+
+			// program binaries are only accepted by a context with the same driver info
+			inline
+			void
+			driverInfo(const std::string& value)
+			{
+				_driverInfo = value;
+			}
+
+			// the draw calls made since the last call to clearDraws()
+			inline
+			const std::vector<Draw>&
+			draws() const
+			{
+				return _draws;
+			}
+
+			void
+			clearDraws();
+
+			inline
+			void
+			supportsInstancing(bool value)
+			{
+				_supportsInstancing = value;
+			}
+
+			inline
+			uint
+			numPendingPixelReads() const
+			{
+				return _pixelReads.size();
+			}
+
+			bool errorsEnabled() { return false; }
+			void errorsEnabled(bool errorsEnabled) { }
+			const std::string& driverInfo() { return _driverInfo; }
+			uint renderTarget() { return _renderTarget; }
+			uint viewportWidth() { return _viewportWidth; }
+			uint viewportHeight() { return _viewportHeight; }
+			uint currentProgram() { return _currentProgram; }
+
+			void configureViewport(const uint x, const uint y, const uint width, const uint height) { }
+			void clear(float red, float green, float blue, float alpha, float depth, unsigned int stencil, unsigned int mask) { }
+			void present();
+
+			void drawTriangles(const uint indexBuffer, const int numTriangles) { draw(); }
+			bool supportsInstancing() { return _supportsInstancing; }
+			void drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances) { draw(); }
+			void setVertexAttributeDivisor(const uint position, const uint divisor) { }
+
+			const uint createVertexBuffer(const uint size) { return ++_nextId; }
+			void setVertexBufferAt(const uint position, const uint vertexBuffer, const uint size, const uint stride, const uint offset) { ++_nextDraw.numVertexBufferBindings; }
+			void uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data);
+			void deleteVertexBuffer(const uint vertexBuffer) { }
+			const uint createIndexBuffer(const uint size) { return ++_nextId; }
+			void uploaderIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data) { }
+			void deleteIndexBuffer(const uint indexBuffer) { }
+
+			uint createTexture(TextureType type, unsigned int width, unsigned int height, bool mipMapping, bool optimizeForRenderToTexture) { return ++_nextId; }
+			uint createCompressedTexture(TextureType type, TextureFormat format, unsigned int width, unsigned int height, bool mipMapping) { return ++_nextId; }
+			void uploadTexture2dData(uint texture, unsigned int width, unsigned int height, unsigned int mipLevel, void* data) { }
+			void uploadCubeTextureData(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height, unsigned int mipLevel, void* data) { }
+			void uploadCompressedTexture2dData(uint texture, TextureFormat format, unsigned int width, unsigned int height, unsigned int size, unsigned int mipLevel, void* data) { }
+			void uploadCompressedCubeTextureData(uint texture, CubeTexture::Face face, TextureFormat format, unsigned int width, unsigned int height, unsigned int mipLevel, void* data) { }
+			void activateMipMapping(uint texture) { }
+			void deleteTexture(uint texture) { }
+			void setTextureAt(uint position, int texture, int location) { ++_nextDraw.numTextureBindings; }
+			void setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering) { }
+
+			const uint createProgram() { return ++_nextId; }
+			void attachShader(const uint program, const uint shader) { _programShaders[program].push_back(shader); }
+			void linkProgram(const uint program) { ++_numLinkedPrograms; }
+			void deleteProgram(const uint program) { }
+			bool getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary);
+			bool setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary);
+			void setProgram(const uint program) { _currentProgram = program; ++_nextDraw.numProgramChanges; }
+			void compileShader(const uint shader) { }
+			void setShaderSource(const uint shader, const std::string& source) { _shaderSources[shader] = source; }
+			const uint createVertexShader() { return ++_nextId; }
+			void deleteVertexShader(const uint vertexShader) { }
+			const uint createFragmentShader() { return ++_nextId; }
+			void deleteFragmentShader(const uint fragmentShader) { }
+			std::shared_ptr<ProgramInputs> getProgramInputs(const uint program);
+
+			void setUniform(uint location, int value) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, int v1, int v2) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, int v1, int v2, int v3) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, int v1, int v2, int v3, int v4) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, float value) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, float v1, float v2) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, float v1, float v2, float v3) { ++_nextDraw.numUniformUploads; }
+			void setUniform(uint location, float v1, float v2, float v3, float v4) { ++_nextDraw.numUniformUploads; }
+			void setUniform(const uint& location, const uint& size, bool transpose, const float* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms(uint location, uint size, const float* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms2(uint location, uint size, const float* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms3(uint location, uint size, const float* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms4(uint location, uint size, const float* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms(uint location, uint size, const int* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms2(uint location, uint size, const int* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms3(uint location, uint size, const int* values) { ++_nextDraw.numUniformUploads; }
+			void setUniforms4(uint location, uint size, const int* values) { ++_nextDraw.numUniformUploads; }
+
+			void setBlendMode(Blending::Source source, Blending::Destination destination) { }
+			void setBlendMode(Blending::Mode blendMode) { }
+			void setColorMask(bool colorMask) { }
+			void setDepthTest(bool depthMask, CompareMode depthFunc) { }
+			void setStencilTest(CompareMode stencilFunc, int stencilRef, uint stencilMask, StencilOperation stencilFailOp, StencilOperation stencilZFailOp, StencilOperation stencilZPassOp) { }
+			void setScissorTest(bool scissorTest, const render::ScissorBox& scissorBox) { }
+
+			void readPixels(unsigned char* pixels);
+			void readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels);
+			uint readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+			bool readPixelsAsyncResult(uint read, unsigned char* pixels);
+
+			void setTriangleCulling(TriangleCulling triangleCulling) { }
+			void setRenderToBackBuffer() { _renderTarget = 0; }
+			void setRenderToTexture(unsigned int texture, bool enableDepthAndStencil) { _renderTarget = texture; }
+			void generateMipmaps(unsigned int texture) { }
+
+		private:
+			StubContext(uint viewportWidth, uint viewportHeight);
+
+			void
+			draw();
+
+			void
+			copyPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels);
+		};
+	}
+}
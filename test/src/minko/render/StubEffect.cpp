@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StubEffect.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+Effect::Ptr
+StubEffect::create(std::shared_ptr<AbstractContext>	context,
+				   const data::BindingMap&			attributeBindings,
+				   const data::BindingMap&			uniformBindings,
+				   const data::BindingMap&			stateBindings,
+				   const data::MacroBindingMap&		macroBindings,
+				   const std::string&				inputs)
+{
+	auto program = Program::create(
+		context,
+		Shader::create(context, Shader::Type::VERTEX_SHADER, inputs + "void main() { }"),
+		Shader::create(context, Shader::Type::FRAGMENT_SHADER, "void main() { }")
+	);
+	auto passes = std::vector<Pass::Ptr>({
+		Pass::create("pass", program, attributeBindings, uniformBindings, stateBindings, macroBindings, States::create(), "")
+	});
+
+	return Effect::create(passes);
+}
+
+scene::Node::Ptr
+StubEffect::createSurfaceNode(std::shared_ptr<AbstractContext>	context,
+							  Effect::Ptr						effect,
+							  material::Material::Ptr			material)
+{
+	return scene::Node::create()->addComponent(component::Surface::create(
+		geometry::QuadGeometry::create(context),
+		material != nullptr ? material : material::Material::create(),
+		effect
+	));
+}
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		/**
+		 * Single pass effects with empty shaders, and surfaces using them, to test the rendering of
+		 * scenes on a StubContext.
+		 */
+		class StubEffect
+		{
+		public:
+			// each call creates its own program, with the uniforms and attributes declared by inputs
+			static
+			Effect::Ptr
+			create(std::shared_ptr<AbstractContext>	context,
+				   const data::BindingMap&			attributeBindings	= data::BindingMap(),
+				   const data::BindingMap&			uniformBindings		= data::BindingMap(),
+				   const data::BindingMap&			stateBindings		= data::BindingMap(),
+				   const data::MacroBindingMap&		macroBindings		= data::MacroBindingMap(),
+				   const std::string&				inputs				= "");
+
+			// a node with a quad surface, rendered with effect and a new material if none is given
+			static
+			scene::Node::Ptr
+			createSurfaceNode(std::shared_ptr<AbstractContext>	context,
+							  Effect::Ptr						effect,
+							  material::Material::Ptr			material = nullptr);
+		};
+	}
+}
@@ -0,0 +1,227 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamerTest.hpp"
+#include "StubContext.hpp"
+
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+	TextureStreamer::MipLevelFunction
+	mipLevels(Texture::Ptr texture, uint& numReads)
+	{
+		return [=, &numReads](uint level, std::vector<unsigned char>& data)
+		{
+			++numReads;
+			data.resize(texture->mipLevelSize(level));
+
+			return true;
+		};
+	}
+
+	uint
+	chainSize(Texture::Ptr texture, uint level)
+	{
+		uint size = 0;
+
+		for (auto i = level; (texture->width() >> i) != 0; ++i)
+			size += texture->mipLevelSize(i);
+
+		return size;
+	}
+}
+
+TEST_F(TextureStreamerTest, AddUploadsSmallestMipLevels)
+{
+	auto context = StubContext::create();
+	auto streamer = TextureStreamer::create(16 * 1024 * 1024);
+	auto texture = Texture::create(context, 1024, 1024, true);
+	uint numReads = 0;
+
+	streamer->add(texture, 11, mipLevels(texture, numReads));
+
+	ASSERT_TRUE(texture->isReady());
+	ASSERT_EQ(streamer->residentLevel(texture), 4);
+	ASSERT_EQ(texture->firstMipLevel(), 4);
+	ASSERT_EQ(numReads, 7);
+
+	auto statistics = streamer->statistics();
+
+	ASSERT_EQ(statistics.numTextures, 1);
+	ASSERT_EQ(statistics.numFullyResident, 0);
+	ASSERT_EQ(statistics.residentSize, chainSize(texture, 4));
+	ASSERT_EQ(statistics.numUploads, 1);
+}
+
+TEST_F(TextureStreamerTest, RequestRaisesOneMipLevelPerUpdate)
+{
+	auto context = StubContext::create();
+	auto streamer = TextureStreamer::create(16 * 1024 * 1024);
+	auto texture = Texture::create(context, 1024, 1024, true);
+	uint numReads = 0;
+
+	streamer->add(texture, 11, mipLevels(texture, numReads));
+
+	streamer->requestSize(texture, 300.f);
+	streamer->update();
+	ASSERT_EQ(streamer->residentLevel(texture), 3);
+
+	streamer->requestSize(texture, 300.f);
+	streamer->update();
+	ASSERT_EQ(streamer->residentLevel(texture), 2);
+
+	streamer->requestSize(texture, 300.f);
+	streamer->update();
+	ASSERT_EQ(streamer->residentLevel(texture), 1);
+
+	// 1024 / 300 is between 2 and 4: level 1 is enough
+	streamer->requestSize(texture, 300.f);
+	streamer->update();
+	ASSERT_EQ(streamer->residentLevel(texture), 1);
+
+	streamer->requestSize(texture, 2048.f);
+	streamer->update();
+	ASSERT_EQ(streamer->residentLevel(texture), 0);
+	ASSERT_EQ(streamer->statistics().numFullyResident, 1);
+	ASSERT_EQ(streamer->statistics().residentSize, chainSize(texture, 0));
+	ASSERT_EQ(streamer->statistics().numEvictions, 0);
+}
+
+TEST_F(TextureStreamerTest, LeastRecentlyUsedTexturesAreEvicted)
+{
+	auto context = StubContext::create();
+	auto a = Texture::create(context, 256, 256, true);
+	auto b = Texture::create(context, 256, 256, true);
+	auto streamer = TextureStreamer::create(chainSize(a, 0) + chainSize(b, 2) + 1000);
+	uint numReads = 0;
+
+	streamer->add(a, 9, mipLevels(a, numReads));
+	streamer->add(b, 9, mipLevels(b, numReads));
+
+	for (auto i = 0; i < 2; ++i)
+	{
+		streamer->requestSize(a, 256.f);
+		streamer->update();
+	}
+	ASSERT_EQ(streamer->residentLevel(a), 0);
+	ASSERT_EQ(streamer->residentLevel(b), 2);
+
+	for (auto i = 0; i < 2; ++i)
+	{
+		streamer->requestSize(b, 256.f);
+		streamer->update();
+	}
+	ASSERT_EQ(streamer->residentLevel(a), 2);
+	ASSERT_EQ(streamer->residentLevel(b), 0);
+
+	auto statistics = streamer->statistics();
+
+	ASSERT_LE(statistics.residentSize, streamer->budget());
+	ASSERT_EQ(statistics.numEvictions, 2);
+}
+
+TEST_F(TextureStreamerTest, RaiseIsLimitedByBudget)
+{
+	auto context = StubContext::create();
+	auto texture = Texture::create(context, 256, 256, true);
+	auto streamer = TextureStreamer::create(chainSize(texture, 1));
+	uint numReads = 0;
+
+	streamer->add(texture, 9, mipLevels(texture, numReads));
+
+	for (auto i = 0; i < 3; ++i)
+	{
+		streamer->requestSize(texture, 256.f);
+		streamer->update();
+	}
+
+	ASSERT_EQ(streamer->residentLevel(texture), 1);
+	ASSERT_EQ(streamer->statistics().requestedSize, chainSize(texture, 0));
+}
+
+TEST_F(TextureStreamerTest, UnmanagedTexturesAreIgnored)
+{
+	auto context = StubContext::create();
+	auto streamer = TextureStreamer::create(16 * 1024 * 1024);
+	auto texture = Texture::create(context, 256, 256, true);
+	uint numReads = 0;
+
+	streamer->requestSize(texture, 256.f);
+	streamer->update();
+	ASSERT_FALSE(streamer->contains(texture));
+
+	streamer->add(texture, 9, mipLevels(texture, numReads));
+	ASSERT_TRUE(streamer->contains(texture));
+
+	streamer->remove(texture);
+	ASSERT_FALSE(streamer->contains(texture));
+	ASSERT_EQ(streamer->statistics().numTextures, 0);
+	ASSERT_EQ(streamer->statistics().residentSize, 0);
+}
+
+TEST_F(TextureStreamerTest, DisposedTexturesAreForgotten)
+{
+	auto context = StubContext::create();
+	auto streamer = TextureStreamer::create(16 * 1024 * 1024);
+	auto texture = Texture::create(context, 256, 256, true);
+	uint numReads = 0;
+
+	streamer->add(texture, 9, mipLevels(texture, numReads));
+	texture->dispose();
+
+	const auto numUploads = streamer->statistics().numUploads;
+
+	streamer->requestSize(texture, 256.f);
+	streamer->update();
+
+	ASSERT_FALSE(texture->isReady());
+	ASSERT_FALSE(streamer->contains(texture));
+	ASSERT_EQ(streamer->statistics().numUploads, numUploads);
+	ASSERT_EQ(streamer->statistics().residentSize, 0);
+}
+
+TEST_F(TextureStreamerTest, DestroyedTexturesAreForgotten)
+{
+	auto context = StubContext::create();
+	auto streamer = TextureStreamer::create(16 * 1024 * 1024);
+	auto texture = Texture::create(context, 256, 256, true);
+	auto weakTexture = std::weak_ptr<Texture>(texture);
+	auto levelSizes = std::vector<uint>();
+
+	for (auto i = 0; i < 9; ++i)
+		levelSizes.push_back(texture->mipLevelSize(i));
+
+	streamer->add(texture, 9, [=](uint level, std::vector<unsigned char>& data)
+	{
+		data.resize(levelSizes[level]);
+
+		return true;
+	});
+	texture = nullptr;
+
+	ASSERT_TRUE(weakTexture.expired());
+
+	streamer->update();
+
+	ASSERT_EQ(streamer->statistics().numTextures, 0);
+	ASSERT_EQ(streamer->statistics().residentSize, 0);
+}
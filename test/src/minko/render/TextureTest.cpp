@@ -56,4 +56,33 @@ TEST_F(TextureTest, UploadRenderTarget)
     {
         ASSERT_TRUE(false);
     }
-}
\ No newline at end of file
+}
+TEST_F(TextureTest, ResizeKeepsTransparentTexels)
+{
+    // packed textures store data in alpha: a transparent texel must keep its color
+    for (auto resizeSmoothly : { false, true })
+    {
+        auto texture = render::Texture::create(MinkoTests::canvas()->context(), 2, 2, false, false, resizeSmoothly);
+        auto texels = std::vector<unsigned char>(2 * 2 * 4);
+
+        for (uint i = 0; i < texels.size(); i += 4)
+        {
+            texels[i] = 200;
+            texels[i + 1] = 100;
+            texels[i + 2] = 50;
+            texels[i + 3] = 0;
+        }
+
+        texture->data(texels.data());
+        texture->resize(4, 4, resizeSmoothly);
+
+        ASSERT_EQ(texture->data().size(), 4 * 4 * 4);
+        for (uint i = 0; i < texture->data().size(); i += 4)
+        {
+            ASSERT_EQ(texture->data()[i], 200);
+            ASSERT_EQ(texture->data()[i + 1], 100);
+            ASSERT_EQ(texture->data()[i + 2], 50);
+            ASSERT_EQ(texture->data()[i + 3], 0);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexBufferTest.hpp"
+#include "StubContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(VertexBufferTest, UploadRangeSendsDataFromOffset)
+{
+	auto context = StubContext::create();
+	auto data = std::vector<float>({ 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f });
+	auto vertexBuffer = VertexBuffer::create(context, data);
+
+	vertexBuffer->addAttribute("position", 3, 0);
+	vertexBuffer->upload(2, 1);
+
+	const auto& upload = context->vertexBufferUploads().back();
+
+	ASSERT_EQ(upload.vertexBuffer, vertexBuffer->id());
+	ASSERT_EQ(upload.offset, 6);
+	ASSERT_EQ(upload.data, std::vector<float>({ 6.f, 7.f, 8.f }));
+}
+
+TEST_F(VertexBufferTest, UploadAll)
+{
+	auto context = StubContext::create();
+	auto data = std::vector<float>({ 0.f, 1.f, 2.f, 3.f, 4.f, 5.f });
+	auto vertexBuffer = VertexBuffer::create(context, data);
+
+	vertexBuffer->addAttribute("position", 3, 0);
+	vertexBuffer->upload();
+
+	const auto& upload = context->vertexBufferUploads().back();
+
+	ASSERT_EQ(upload.offset, 0);
+	ASSERT_EQ(upload.data, data);
+}
@@ -0,0 +1,310 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/scene/NodeTest.hpp"
+
+using namespace minko;
+using namespace minko::scene;
+
+namespace
+{
+	class TestComponent :
+		public component::AbstractComponent
+	{
+	public:
+		static
+		std::shared_ptr<TestComponent>
+		create()
+		{
+			return std::shared_ptr<TestComponent>(new TestComponent());
+		}
+	};
+
+	class OtherTestComponent :
+		public component::AbstractComponent
+	{
+	public:
+		static
+		std::shared_ptr<OtherTestComponent>
+		create()
+		{
+			return std::shared_ptr<OtherTestComponent>(new OtherTestComponent());
+		}
+	};
+}
+
+TEST_F(NodeTest, AddChildNotifiesAncestorsOnce)
+{
+	auto root = Node::create();
+	auto parent = Node::create();
+	auto numChildrenAdded = 0;
+
+	root->addChild(parent);
+
+	auto _ = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr p)
+	{
+		ASSERT_EQ(node, root);
+		ASSERT_EQ(p, parent);
+		ASSERT_EQ(children.size(), 1);
+		++numChildrenAdded;
+	});
+
+	parent->addChild(Node::create());
+
+	ASSERT_EQ(numChildrenAdded, 1);
+}
+
+TEST_F(NodeTest, BatchDefersAncestorsNotifications)
+{
+	auto root = Node::create();
+	auto child1 = Node::create();
+	auto child2 = Node::create();
+	auto numAdded = 0;
+	auto numChildrenAdded = 0;
+	auto numChildren = 0;
+
+	auto slot1 = root->added()->connect([&](Node::Ptr node, Node::Ptr target, Node::Ptr parent)
+	{
+		++numAdded;
+	});
+	auto slot2 = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		++numChildrenAdded;
+		numChildren += children.size();
+	});
+
+	root->beginBatch();
+	root->addChild(child1);
+	root->addChild(child2);
+
+	ASSERT_EQ(root->children().size(), 2);
+	ASSERT_EQ(child1->root(), root);
+	ASSERT_EQ(numAdded, 0);
+	ASSERT_EQ(numChildrenAdded, 0);
+
+	root->commitBatch();
+
+	ASSERT_EQ(numAdded, 2);
+	ASSERT_EQ(numChildrenAdded, 1);
+	ASSERT_EQ(numChildren, 2);
+}
+
+TEST_F(NodeTest, BatchNotifiesDescendantsImmediately)
+{
+	auto root = Node::create();
+	auto child = Node::create();
+	auto added = false;
+
+	auto _ = child->added()->connect([&](Node::Ptr node, Node::Ptr target, Node::Ptr parent)
+	{
+		added = true;
+	});
+
+	root->beginBatch();
+	root->addChild(child);
+
+	ASSERT_TRUE(added);
+
+	root->commitBatch();
+}
+
+TEST_F(NodeTest, AddChildren)
+{
+	auto root = Node::create();
+	auto numChildrenAdded = 0;
+
+	auto _ = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		ASSERT_EQ(children.size(), 3);
+		++numChildrenAdded;
+	});
+
+	root->addChildren({ Node::create(), Node::create(), Node::create() });
+
+	ASSERT_EQ(root->children().size(), 3);
+	ASSERT_EQ(numChildrenAdded, 1);
+	ASSERT_FALSE(root->batching());
+}
+
+TEST_F(NodeTest, RemoveChildrenNotifiesOnce)
+{
+	auto root = Node::create()
+		->addChild(Node::create())
+		->addChild(Node::create());
+	auto numChildrenRemoved = 0;
+
+	auto _ = root->childrenRemoved()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		ASSERT_EQ(children.size(), 2);
+		++numChildrenRemoved;
+	});
+
+	root->removeChildren();
+
+	ASSERT_EQ(root->children().size(), 0);
+	ASSERT_EQ(numChildrenRemoved, 1);
+}
+
+TEST_F(NodeTest, BatchCancelsAddedThenRemoved)
+{
+	auto root = Node::create();
+	auto child = Node::create();
+	auto numNotifications = 0;
+
+	auto slot1 = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		++numNotifications;
+	});
+	auto slot2 = root->childrenRemoved()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		++numNotifications;
+	});
+
+	root->beginBatch();
+	root->addChild(child);
+	root->removeChild(child);
+	root->commitBatch();
+
+	ASSERT_EQ(numNotifications, 0);
+}
+
+TEST_F(NodeTest, BatchFlushedWhenChildMovesToAnotherParent)
+{
+	auto root = Node::create();
+	auto parent1 = Node::create();
+	auto parent2 = Node::create();
+	auto child = Node::create();
+	std::vector<std::string> events;
+
+	root->addChild(parent1)->addChild(parent2);
+	parent1->addChild(child);
+
+	auto slot1 = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		events.push_back("added");
+	});
+	auto slot2 = root->childrenRemoved()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr parent)
+	{
+		events.push_back("removed");
+	});
+
+	parent1->beginBatch();
+	parent1->removeChild(child);
+	parent2->addChild(child);
+	parent1->commitBatch();
+
+	ASSERT_EQ(events.size(), 2);
+	ASSERT_EQ(events[0], "removed");
+	ASSERT_EQ(events[1], "added");
+}
+
+TEST_F(NodeTest, BatchFlushedWhenBatchingNodeMoves)
+{
+	auto root = Node::create();
+	auto parent = Node::create();
+	auto numChildren = 0;
+
+	auto _ = root->childrenAdded()->connect([&](Node::Ptr node, const std::vector<Node::Ptr>& children, Node::Ptr p)
+	{
+		numChildren += children.size();
+	});
+
+	parent->beginBatch();
+	parent->addChild(Node::create());
+	root->addChild(parent);
+	parent->addChild(Node::create());
+	parent->commitBatch();
+
+	// the first child is notified with parent, the second one when the batch is committed
+	ASSERT_EQ(numChildren, 2);
+}
+
+TEST_F(NodeTest, CommitBatchWithoutBegin)
+{
+	auto node = Node::create();
+
+	ASSERT_THROW(node->commitBatch(), std::logic_error);
+}
+
+TEST_F(NodeTest, ComponentsByType)
+{
+	auto node = Node::create();
+	auto component1 = TestComponent::create();
+	auto component2 = TestComponent::create();
+	auto other = OtherTestComponent::create();
+
+	ASSERT_FALSE(node->hasComponent<TestComponent>());
+
+	node->addComponent(component1)->addComponent(other)->addComponent(component2);
+
+	ASSERT_TRUE(node->hasComponent<TestComponent>());
+	ASSERT_EQ(node->components<TestComponent>().size(), 2);
+	ASSERT_EQ(node->component<TestComponent>(), component1);
+	ASSERT_EQ(node->component<TestComponent>(1), component2);
+	ASSERT_EQ(node->component<TestComponent>(2), nullptr);
+	ASSERT_EQ(node->component<OtherTestComponent>(), other);
+	ASSERT_EQ(node->components<component::AbstractComponent>().size(), 3);
+}
+
+TEST_F(NodeTest, ComponentsByTypeAfterRemoveComponent)
+{
+	auto node = Node::create();
+	auto component1 = TestComponent::create();
+	auto component2 = TestComponent::create();
+
+	node->addComponent(component1)->addComponent(component2);
+
+	ASSERT_EQ(node->component<TestComponent>(), component1);
+
+	node->removeComponent(component1);
+
+	ASSERT_EQ(node->components<TestComponent>().size(), 1);
+	ASSERT_EQ(node->component<TestComponent>(), component2);
+
+	node->removeComponent(component2);
+
+	ASSERT_FALSE(node->hasComponent<TestComponent>());
+}
+
+TEST_F(NodeTest, CachedComponentsByTypeAfterAddComponent)
+{
+	auto node = Node::create();
+	auto component1 = TestComponent::create();
+	auto component2 = TestComponent::create();
+	auto other = OtherTestComponent::create();
+
+	node->addComponent(component1);
+
+	// query every type first so that adding and removing components updates the cached lists
+	ASSERT_EQ(node->components<TestComponent>().size(), 1);
+	ASSERT_FALSE(node->hasComponent<OtherTestComponent>());
+	ASSERT_EQ(node->components<component::AbstractComponent>().size(), 1);
+
+	node->addComponent(other)->addComponent(component2);
+
+	ASSERT_EQ(node->component<TestComponent>(1), component2);
+	ASSERT_EQ(node->component<OtherTestComponent>(), other);
+	ASSERT_EQ(node->components<component::AbstractComponent>().size(), 3);
+
+	node->removeComponent(other);
+
+	ASSERT_FALSE(node->hasComponent<OtherTestComponent>());
+	ASSERT_EQ(node->components<TestComponent>().size(), 2);
+	ASSERT_EQ(node->components<component::AbstractComponent>().size(), 2);
+}
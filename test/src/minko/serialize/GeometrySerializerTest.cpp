@@ -95,3 +95,49 @@ TEST_F(GeometrySerializerTest, SphereGeometrySerialization)
 	ASSERT_TRUE(outputAssetLibrary->geometry("Sphere") != nullptr);
 	ASSERT_TRUE(sphereGeometry->equals(outputAssetLibrary->geometry("Sphere")));
 }
+
+TEST_F(GeometrySerializerTest, AlignedGeometrySerialization)
+{
+	auto sphereGeometry		= geometry::SphereGeometry::create(MinkoTests::canvas()->context(), 20, 20);
+	auto assetLibrary		= file::AssetLibrary::create(MinkoTests::canvas()->context());
+	auto geometryWriter		= file::GeometryWriter::create();
+	auto outputAssetLibrary	= file::AssetLibrary::create(MinkoTests::canvas()->context());
+	auto geometryParser		= file::GeometryParser::create();
+	std::string	filename	= "asset.tmp";
+
+	assetLibrary->geometry("Sphere", sphereGeometry);
+	geometryWriter->data(sphereGeometry);
+	geometryWriter->write(filename,
+						  assetLibrary,
+						  file::Options::create(MinkoTests::canvas()->context()),
+						  file::WriterOptions::create()->alignGeometryData(true));
+
+	std::vector<unsigned char>  data;
+	auto						flags = std::ios::in | std::ios::ate | std::ios::binary;
+	std::fstream				file(filename, flags);
+	unsigned int				size = (unsigned int)file.tellg();
+
+	data.resize(size);
+	file.seekg(0, std::ios::beg);
+	file.read((char*)&data[0], size);
+	file.close();
+
+	geometryParser->parse(filename, filename, file::Options::create(MinkoTests::canvas()->context()), data, outputAssetLibrary);
+
+	auto outputGeometry = outputAssetLibrary->geometry("Sphere");
+
+	ASSERT_TRUE(outputGeometry != nullptr);
+	ASSERT_EQ(outputGeometry->indices()->data(), sphereGeometry->indices()->data());
+	ASSERT_EQ(outputGeometry->vertexBuffers().size(), sphereGeometry->vertexBuffers().size());
+
+	auto outputVertexBufferIt = outputGeometry->vertexBuffers().begin();
+
+	for (auto& vertexBuffer : sphereGeometry->vertexBuffers())
+	{
+		auto outputVertexBuffer = *outputVertexBufferIt++;
+
+		ASSERT_EQ(outputVertexBuffer->vertexSize(), vertexBuffer->vertexSize());
+		ASSERT_EQ(outputVertexBuffer->attributes().size(), vertexBuffer->attributes().size());
+		ASSERT_EQ(outputVertexBuffer->data(), vertexBuffer->data());
+	}
+}